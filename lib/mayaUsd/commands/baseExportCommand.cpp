@@ -75,6 +75,9 @@ MSyntax MayaUSDExportCommand::createSyntax()
     syntax.addFlag(kNormalizeNurbsFlag,
                    UsdMayaJobExportArgsTokens->normalizeNurbs.GetText() ,
                    MSyntax::kBoolean);
+    syntax.addFlag(kParallelFrameWriteFlag,
+                   UsdMayaJobExportArgsTokens->parallelFrameWrite.GetText(),
+                   MSyntax::kBoolean);
     syntax.addFlag(kExportColorSetsFlag,
                    UsdMayaJobExportArgsTokens->exportColorSets.GetText(),
                    MSyntax::kBoolean);
@@ -69,6 +69,14 @@ UsdMaya_FunctorPrimWriter::Write(const UsdTimeCode& usdTime)
     _modelPaths = ctx.GetModelPaths();
 }
 
+/* virtual */
+bool
+UsdMaya_FunctorPrimWriter::SupportsFrameCapture() const
+{
+    // The functor writes on top of the transform, and cannot be captured.
+    return false;
+}
+
 /* virtual */
 bool
 UsdMaya_FunctorPrimWriter::ExportsGprims() const
@@ -317,6 +317,9 @@ UsdMayaJobExportArgs::UsdMayaJobExportArgs(
                 UsdMayaJobExportArgsTokens->mergeTransformAndShape)),
         normalizeNurbs(
             _Boolean(userArgs, UsdMayaJobExportArgsTokens->normalizeNurbs)),
+        parallelFrameWrite(
+            _Boolean(userArgs,
+                UsdMayaJobExportArgsTokens->parallelFrameWrite)),
         stripNamespaces(
             _Boolean(userArgs,
                 UsdMayaJobExportArgsTokens->stripNamespaces)),
@@ -384,6 +387,7 @@ operator <<(std::ostream& out, const UsdMayaJobExportArgs& exportArgs)
         << "materialsScopeName: " << exportArgs.materialsScopeName << std::endl
         << "mergeTransformAndShape: " << TfStringify(exportArgs.mergeTransformAndShape) << std::endl
         << "normalizeNurbs: " << TfStringify(exportArgs.normalizeNurbs) << std::endl
+        << "parallelFrameWrite: " << TfStringify(exportArgs.parallelFrameWrite) << std::endl
         << "parentScope: " << exportArgs.parentScope << std::endl
         << "renderLayerMode: " << exportArgs.renderLayerMode << std::endl
         << "rootKind: " << exportArgs.rootKind << std::endl
@@ -478,6 +482,7 @@ UsdMayaJobExportArgs::GetDefaultDictionary()
         d[UsdMayaJobExportArgsTokens->melPostCallback] = std::string();
         d[UsdMayaJobExportArgsTokens->mergeTransformAndShape] = true;
         d[UsdMayaJobExportArgsTokens->normalizeNurbs] = false;
+        d[UsdMayaJobExportArgsTokens->parallelFrameWrite] = false;
         d[UsdMayaJobExportArgsTokens->parentScope] = std::string();
         d[UsdMayaJobExportArgsTokens->pythonPerFrameCallback] = std::string();
         d[UsdMayaJobExportArgsTokens->pythonPostCallback] = std::string();
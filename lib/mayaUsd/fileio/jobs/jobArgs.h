@@ -74,6 +74,7 @@ TF_DECLARE_PUBLIC_TOKENS(
     (melPostCallback) \
     (mergeTransformAndShape) \
     (normalizeNurbs) \
+    (parallelFrameWrite) \
     (parentScope) \
     (pythonPerFrameCallback) \
     (pythonPostCallback) \
@@ -159,6 +160,12 @@ struct UsdMayaJobExportArgs
     /// a single node in the output USD.
     const bool mergeTransformAndShape;
     const bool normalizeNurbs;
+
+    /// Whether animated frames are written through a pipeline: Maya data for
+    /// a frame is captured on the main thread, then converted and authored on
+    /// worker threads while the next frame is evaluated. The resulting layer
+    /// is identical to the one written by the serial path.
+    const bool parallelFrameWrite;
     const bool stripNamespaces;
 
     /// This is the path of the USD prim under which *all* prims will be
@@ -15,6 +15,9 @@
 //
 #include "readJob.h"
 
+#include <algorithm>
+#include <iterator>
+#include <list>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -31,6 +34,7 @@
 #include <maya/MStatus.h>
 #include <maya/MTime.h>
 
+#include <pxr/base/tf/envSetting.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/path.h>
@@ -54,9 +58,16 @@
 #include <mayaUsd/utils/stageCache.h>
 #include <mayaUsd/utils/util.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+TF_DEFINE_ENV_SETTING(
+    MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE, 256,
+    "Number of prims whose USD data is gathered in parallel ahead of the "
+    "creation of their Maya nodes during import. 0 disables the prefetch.");
+
 UsdMaya_ReadJob::UsdMaya_ReadJob(
         const MayaUsd::ImportData &iImportData,
         const UsdMayaJobImportArgs &iArgs) :
@@ -309,13 +320,64 @@ bool UsdMaya_ReadJob::OverridePrimReader(
 bool
 UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
 {
+    const size_t prefetchBatchSize =
+        std::max(0, TfGetEnvSetting(MAYAUSD_IMPORT_PREFETCH_BATCH_SIZE));
+
+    // The reader factory of each type name with a Prefetch step, or an empty
+    // factory for the other types, so that the registry is only queried once
+    // per type rather than for every prim and every look ahead.
+    std::unordered_map<TfToken, UsdMayaPrimReaderRegistry::ReaderFactoryFn,
+            TfToken::HashFunctor> prefetchFactories;
+    auto findPrefetchFactory = [&prefetchFactories](const TfToken& typeName)
+            -> const UsdMayaPrimReaderRegistry::ReaderFactoryFn& {
+        auto it = prefetchFactories.find(typeName);
+        if (it == prefetchFactories.end()) {
+            UsdMayaPrimReaderRegistry::ReaderFactoryFn factoryFn;
+            if (UsdMayaPrimReaderRegistry::HasPrefetch(typeName)) {
+                factoryFn = UsdMayaPrimReaderRegistry::Find(typeName);
+            }
+            it = prefetchFactories.emplace(typeName, std::move(factoryFn)).first;
+        }
+        return it->second;
+    };
+
     // We want both pre- and post- visit iterations over the prims in this
     // method. To do so, iterate over all the root prims of the input range,
     // and create new PrimRanges to iterate over their subtrees.
+
     for (auto rootIt = rootRange.begin(); rootIt != rootRange.end(); ++rootIt) {
         const UsdPrim& rootPrim = *rootIt;
         rootIt.PruneChildren();
 
+        // The prim readers of the types that can prefetch their USD data
+        // are created ahead of the walk below, one batch of upcoming prims at
+        // a time, so that the data of the batch is gathered in parallel
+        // before their Maya nodes are created. The prim readers args refer to
+        // the prims, which are kept alive here.
+        struct PrefetchEntry
+        {
+            std::list<UsdPrim>::iterator prim;
+            UsdMayaPrimReaderSharedPtr reader;
+        };
+        std::list<UsdPrim> prefetchPrims;
+        std::unordered_map<SdfPath, PrefetchEntry,
+                SdfPath::Hash> prefetchReaders;
+
+        // The walk never reaches the prims under a pruned prim, so the
+        // readers prefetched for them are dropped as soon as it is pruned.
+        auto dropPrefetchReaders = [&prefetchPrims, &prefetchReaders](
+                const SdfPath& prunedPath) {
+            for (auto it = prefetchReaders.begin(); it != prefetchReaders.end();) {
+                if (it->first.HasPrefix(prunedPath)) {
+                    prefetchPrims.erase(it->second.prim);
+                    it = prefetchReaders.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+        };
+
         std::unordered_map<SdfPath, UsdMayaPrimReaderSharedPtr,
                 SdfPath::Hash> primReaders;
         const UsdPrimRange range = UsdPrimRange::PreAndPostVisit(rootPrim);
@@ -331,21 +393,80 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
                 UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
 
                 if (OverridePrimReader(usdRootPrim, prim, args, readCtx, primIt)) {
+                    if (readCtx.GetPruneChildren()) {
+                        dropPrefetchReaders(prim.GetPath());
+                    }
+                    else {
+                        prefetchReaders.erase(prim.GetPath());
+                    }
                     continue;
                 }
 
-                TfToken typeName = prim.GetTypeName();
-                if (UsdMayaPrimReaderRegistry::ReaderFactoryFn factoryFn
-                        = UsdMayaPrimReaderRegistry::FindOrFallback(typeName)) {
-                    UsdMayaPrimReaderSharedPtr primReader = factoryFn(args);
-                    if (primReader) {
-                        primReader->Read(&readCtx);
-                        if (primReader->HasPostReadSubtree()) {
-                            primReaders[prim.GetPath()] = primReader;
-                        }
-                        if (readCtx.GetPruneChildren()) {
-                            primIt.PruneChildren();
+                UsdMayaPrimReaderSharedPtr primReader;
+                if (prefetchBatchSize > 0u &&
+                        findPrefetchFactory(prim.GetTypeName())) {
+                    auto prefetchIt = prefetchReaders.find(prim.GetPath());
+                    if (prefetchIt == prefetchReaders.end()) {
+                        // Gather the data of the next batch of prims, looking
+                        // ahead from this one. Subtrees already pruned by the
+                        // walk are skipped by the look ahead as well.
+                        std::vector<UsdMayaPrimReaderSharedPtr> batch;
+                        for (auto aheadIt = primIt;
+                                aheadIt != range.end() &&
+                                batch.size() < prefetchBatchSize;
+                                ++aheadIt) {
+                            const UsdPrim& aheadPrim = *aheadIt;
+                            if (aheadIt.IsPostVisit() ||
+                                    prefetchReaders.count(aheadPrim.GetPath())) {
+                                continue;
+                            }
+                            const UsdMayaPrimReaderRegistry::ReaderFactoryFn&
+                                aheadFactoryFn = findPrefetchFactory(
+                                    aheadPrim.GetTypeName());
+                            if (!aheadFactoryFn) {
+                                continue;
+                            }
+                            prefetchPrims.push_back(aheadPrim);
+                            UsdMayaPrimReaderArgs aheadArgs(prefetchPrims.back(), mArgs);
+                            UsdMayaPrimReaderSharedPtr aheadReader =
+                                aheadFactoryFn(aheadArgs);
+                            if (aheadReader && aheadReader->HasPrefetch()) {
+                                prefetchReaders[aheadPrim.GetPath()] = PrefetchEntry {
+                                    std::prev(prefetchPrims.end()), aheadReader };
+                                batch.push_back(std::move(aheadReader));
+                            }
+                            else {
+                                prefetchPrims.pop_back();
+                            }
                         }
+                        tbb::parallel_for(
+                            tbb::blocked_range<size_t>(0, batch.size()),
+                            [&batch](const tbb::blocked_range<size_t>& r) {
+                                for (size_t i = r.begin(); i < r.end(); ++i) {
+                                    batch[i]->Prefetch();
+                                }
+                            });
+                        prefetchIt = prefetchReaders.find(prim.GetPath());
+                    }
+                    if (prefetchIt != prefetchReaders.end()) {
+                        primReader = std::move(prefetchIt->second.reader);
+                        prefetchReaders.erase(prefetchIt);
+                    }
+                }
+                if (!primReader) {
+                    if (UsdMayaPrimReaderRegistry::ReaderFactoryFn factoryFn
+                            = UsdMayaPrimReaderRegistry::FindOrFallback(prim.GetTypeName())) {
+                        primReader = factoryFn(args);
+                    }
+                }
+                if (primReader) {
+                    primReader->Read(&readCtx);
+                    if (primReader->HasPostReadSubtree()) {
+                        primReaders[prim.GetPath()] = primReader;
+                    }
+                    if (readCtx.GetPruneChildren()) {
+                        primIt.PruneChildren();
+                        dropPrefetchReaders(prim.GetPath());
                     }
                 }
             }
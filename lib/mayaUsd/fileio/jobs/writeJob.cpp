@@ -40,6 +40,7 @@
 #include <pxr/base/tf/stringUtils.h>
 #include <pxr/usd/ar/resolver.h>
 #include <pxr/usd/kind/registry.h>
+#include <pxr/usd/sdf/changeBlock.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/primSpec.h>
 // Needed for directly removing a UsdVariant via Sdf
@@ -57,6 +58,9 @@
 #include <pxr/usd/usdUtils/pipeline.h>
 #include <pxr/usd/usdUtils/dependencies.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <mayaUsd/fileio/chaser/chaser.h>
 #include <mayaUsd/fileio/chaser/chaserRegistry.h>
 #include <mayaUsd/fileio/jobs/jobArgs.h>
@@ -135,6 +139,7 @@ UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
     // Time-sampled export.
     if (!timeSamples.empty()) {
         const MTime oldCurTime = MAnimControl::currentTime();
+        const bool pipelineFrames = _CanPipelineFrames();
 
         int progress = 0;
         for (double t : timeSamples) {
@@ -146,7 +151,10 @@ UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
             progress++;
 
             // Process per frame data.
-            if (!_WriteFrame(t)) {
+            const bool frameWritten = pipelineFrames ?
+                    _WriteFramePipelined(t) : _WriteFrame(t);
+            if (!frameWritten) {
+                _WaitForPipelinedFrame();
                 MGlobal::viewFrame(oldCurTime);
                 computation.endComputation();
                 return false;
@@ -158,6 +166,9 @@ UsdMaya_WriteJob::Write(const std::string& fileName, bool append)
             }
         }
 
+        // The last pipelined frame must be authored before finishing.
+        _WaitForPipelinedFrame();
+
         // Set the time back.
         MGlobal::viewFrame(oldCurTime);
     }
@@ -459,6 +470,102 @@ UsdMaya_WriteJob::_WriteFrame(double iFrame)
     return true;
 }
 
+bool
+UsdMaya_WriteJob::_CanPipelineFrames() const
+{
+    if (!mJobCtx.mArgs.parallelFrameWrite) {
+        return false;
+    }
+
+    if (!mChasers.empty() ||
+            !mJobCtx.mArgs.melPerFrameCallback.empty() ||
+            !mJobCtx.mArgs.pythonPerFrameCallback.empty()) {
+        TF_WARN("parallelFrameWrite is ignored when exporting with chasers or "
+                "per-frame callbacks; frames will be written serially.");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+UsdMaya_WriteJob::_WriteFramePipelined(double iFrame)
+{
+    // Maya has evaluated iFrame by now, so the previous frame may still be
+    // authoring on the workers. Wait for it before capturing: capture may
+    // author on the stage, and writers only hold one frame of data.
+    _WaitForPipelinedFrame();
+
+    const UsdTimeCode usdTime(iFrame);
+    const std::vector<UsdMayaPrimWriterSharedPtr>& primWriters =
+            mJobCtx.mMayaPrimWriterList;
+
+    _pipelinedFrameData.clear();
+    _pipelinedFrameData.resize(primWriters.size());
+
+    bool hasPipelinedWriters = false;
+    for (size_t i = 0u; i < primWriters.size(); ++i) {
+        const UsdMayaPrimWriterSharedPtr& primWriter = primWriters[i];
+        if (!primWriter->GetUsdPrim()) {
+            continue;
+        }
+
+        if (primWriter->SupportsFrameCapture()) {
+            _pipelinedFrameData[i] = primWriter->CaptureFrame(usdTime);
+        }
+        if (_pipelinedFrameData[i]) {
+            hasPipelinedWriters = true;
+        }
+        else {
+            // This writer does not support pipelining. Nothing else is
+            // authoring right now, so it is safe to write it directly.
+            primWriter->Write(usdTime);
+        }
+    }
+
+    if (!hasPipelinedWriters) {
+        return true;
+    }
+
+    _pipelinedFrameTasks.run([this, usdTime]() {
+        const std::vector<UsdMayaPrimWriterSharedPtr>& primWriters =
+                mJobCtx.mMayaPrimWriterList;
+
+        // Value conversion only touches each writer's own state, so it can
+        // be spread over the workers.
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0u, _pipelinedFrameData.size()),
+            [this, &primWriters, &usdTime](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i < r.end(); ++i) {
+                    if (_pipelinedFrameData[i]) {
+                        primWriters[i]->ConvertFrame(
+                            usdTime, _pipelinedFrameData[i].get());
+                    }
+                }
+            });
+
+        // Authoring is serial and follows the writer order used by
+        // _WriteFrame(), so every layer receives the same edits in the same
+        // order as in a serial export.
+        SdfChangeBlock changeBlock;
+        for (size_t i = 0u; i < _pipelinedFrameData.size(); ++i) {
+            if (_pipelinedFrameData[i]) {
+                primWriters[i]->FlushFrame(
+                    usdTime, _pipelinedFrameData[i].get());
+            }
+        }
+    });
+
+    return true;
+}
+
+void
+UsdMaya_WriteJob::_WaitForPipelinedFrame()
+{
+    _pipelinedFrameTasks.wait();
+    _pipelinedFrameData.clear();
+}
+
 bool
 UsdMaya_WriteJob::_FinishWriting()
 {
@@ -17,14 +17,18 @@
 #define PXRUSDMAYA_WRITE_JOB_H
 
 #include <string>
+#include <vector>
 
 #include <maya/MObjectHandle.h>
 
 #include <pxr/pxr.h>
 #include <pxr/base/tf/hashmap.h>
 
+#include <tbb/task_group.h>
+
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/fileio/chaser/chaser.h>
+#include <mayaUsd/fileio/primWriter.h>
 #include <mayaUsd/fileio/writeJobContext.h>
 #include <mayaUsd/utils/util.h>
 
@@ -60,6 +64,22 @@ private:
     /// WriteFrame() call, internal code may generate errors.
     bool _WriteFrame(double iFrame);
 
+    /// Whether time samples can be written with _WriteFramePipelined().
+    /// Chasers and per-frame callbacks expect the USD stage to hold the
+    /// current frame's values, so they force the serial path.
+    bool _CanPipelineFrames() const;
+
+    /// Pipelined variant of _WriteFrame(), used when the export args enable
+    /// parallelFrameWrite. Captures Maya data for \p iFrame on the calling
+    /// thread, then converts and authors it on worker threads while the
+    /// caller evaluates the next frame. The same ordering rules as
+    /// _WriteFrame() apply.
+    bool _WriteFramePipelined(double iFrame);
+
+    /// Waits for the frame started by the last _WriteFramePipelined() call
+    /// to be authored.
+    void _WaitForPipelinedFrame();
+
     /// Runs any post-export processes, closes the USD stage, and writes it out
     /// to disk.
     bool _FinishWriting();
@@ -94,6 +114,12 @@ private:
 
     UsdMayaChaserRefPtrVector mChasers;
 
+    // Data captured for the frame being authored by the pipelined path,
+    // indexed like mJobCtx.mMayaPrimWriterList. Null entries are for writers
+    // that were written serially.
+    std::vector<UsdMayaPrimWriterFrameDataUniquePtr> _pipelinedFrameData;
+    tbb::task_group _pipelinedFrameTasks;
+
     UsdMayaWriteJobContext mJobCtx;
 
     std::unique_ptr<UsdMaya_ModelKindProcessor> _modelKindProcessor;
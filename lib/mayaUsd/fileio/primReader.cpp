@@ -22,6 +22,17 @@ UsdMayaPrimReader::UsdMayaPrimReader(const UsdMayaPrimReaderArgs& args)
 {
 }
 
+bool
+UsdMayaPrimReader::HasPrefetch() const
+{
+    return false;
+}
+
+void
+UsdMayaPrimReader::Prefetch()
+{
+}
+
 bool
 UsdMayaPrimReader::HasPostReadSubtree() const
 {
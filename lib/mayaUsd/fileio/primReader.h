@@ -31,6 +31,20 @@ public:
     UsdMayaPrimReader(const UsdMayaPrimReaderArgs&);
     virtual ~UsdMayaPrimReader() {};
 
+    /// Whether this prim reader specifies a Prefetch step.
+    /// Only the readers of types registered with hasPrefetch in
+    /// UsdMayaPrimReaderRegistry are asked.
+    MAYAUSD_CORE_PUBLIC
+    virtual bool HasPrefetch() const;
+
+    /// An optional import step that gathers the USD data needed by Read,
+    /// before any Maya node is created for the prim.
+    /// The prefetch of many prims runs concurrently on worker threads, so
+    /// it must only read from the USD stage: it must not call the Maya API
+    /// nor issue diagnostics, which should be left to Read.
+    MAYAUSD_CORE_PUBLIC
+    virtual void Prefetch();
+
     /// Reads the USD prim given by the prim reader args into a Maya shape,
     /// modifying the prim reader context as a result.
     /// Callers must ensure \p context is non-null.
@@ -16,6 +16,7 @@
 #include "primReaderRegistry.h"
 
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -42,12 +43,24 @@ TF_DEFINE_PRIVATE_TOKENS(_tokens,
 typedef std::map<TfToken, UsdMayaPrimReaderRegistry::ReaderFactoryFn> _Registry;
 static _Registry _reg;
 
+// The types whose readers were registered as having a Prefetch step.
+static std::set<TfToken> _prefetchTypes;
+
+// The registry is keyed by TfType name, which differs from the usd typeName.
+static TfToken
+_GetTfTypeName(const TfToken& usdTypeName)
+{
+    TfType tfType = PlugRegistry::FindDerivedTypeByName<UsdSchemaBase>(usdTypeName);
+    return TfToken(tfType.GetTypeName());
+}
+
 
 /* static */
 void
 UsdMayaPrimReaderRegistry::Register(
         const TfType& t,
-        UsdMayaPrimReaderRegistry::ReaderFactoryFn fn)
+        UsdMayaPrimReaderRegistry::ReaderFactoryFn fn,
+        bool hasPrefetch)
 {
     TfToken tfTypeName(t.GetTypeName());
     TF_DEBUG(PXRUSDMAYA_REGISTRY).Msg(
@@ -55,8 +68,12 @@ UsdMayaPrimReaderRegistry::Register(
     std::pair< _Registry::iterator, bool> insertStatus =
         _reg.insert(std::make_pair(tfTypeName, fn));
     if (insertStatus.second) {
+        if (hasPrefetch) {
+            _prefetchTypes.insert(tfTypeName);
+        }
         UsdMaya_RegistryHelper::AddUnloader([tfTypeName]() {
             _reg.erase(tfTypeName);
+            _prefetchTypes.erase(tfTypeName);
         });
     }
     else {
@@ -81,9 +98,8 @@ UsdMayaPrimReaderRegistry::Find(const TfToken& usdTypeName)
 
     // unfortunately, usdTypeName is diff from the tfTypeName which we use to
     // register.  do the conversion here.
-    TfType tfType = PlugRegistry::FindDerivedTypeByName<UsdSchemaBase>(usdTypeName);
-    std::string typeNameStr = tfType.GetTypeName();
-    TfToken typeName(typeNameStr);
+    TfToken typeName = _GetTfTypeName(usdTypeName);
+    const std::string& typeNameStr = typeName.GetString();
     ReaderFactoryFn ret = nullptr;
     if (TfMapLookup(_reg, typeName, &ret)) {
         return ret;
@@ -117,5 +133,17 @@ UsdMayaPrimReaderRegistry::FindOrFallback(const TfToken& usdTypeName)
     return UsdMaya_FallbackPrimReader::CreateFactory();
 }
 
+/* static */
+bool
+UsdMayaPrimReaderRegistry::HasPrefetch(const TfToken& usdTypeName)
+{
+    // Find the reader first, which loads the plugin that registers it.
+    if (!Find(usdTypeName)) {
+        return false;
+    }
+
+    return _prefetchTypes.count(_GetTfTypeName(usdTypeName)) != 0;
+}
+
 
 PXR_NAMESPACE_CLOSE_SCOPE
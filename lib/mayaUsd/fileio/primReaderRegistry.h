@@ -62,8 +62,15 @@ struct UsdMayaPrimReaderRegistry
             UsdMayaPrimReaderContext*) > ReaderFn;
 
     /// \brief Register \p fn as a reader provider for \p type.
+    ///
+    /// \p hasPrefetch declares that the readers created by \p fn may have a
+    /// Prefetch step, so that the import creates them ahead of their Read.
+    /// Readers of other types are only created when their prim is read.
     MAYAUSD_CORE_PUBLIC
-    static void Register(const TfType& type, ReaderFactoryFn fn);
+    static void Register(
+            const TfType& type,
+            ReaderFactoryFn fn,
+            bool hasPrefetch = false);
 
     /// \brief Register \p fn as a reader provider for \p T.
     ///
@@ -79,10 +86,10 @@ struct UsdMayaPrimReaderRegistry
     /// }
     /// \endcode
     template <typename T>
-    static void Register(ReaderFactoryFn fn)
+    static void Register(ReaderFactoryFn fn, bool hasPrefetch = false)
     {
         if (TfType t = TfType::Find<T>()) {
-            Register(t, fn);
+            Register(t, fn, hasPrefetch);
         }
         else {
             TF_CODING_ERROR("Cannot register unknown TfType: %s.",
@@ -129,6 +136,11 @@ struct UsdMayaPrimReaderRegistry
     /// reader factory.
     MAYAUSD_CORE_PUBLIC
     static ReaderFactoryFn FindOrFallback(const TfToken& usdTypeName);
+
+    /// Returns true if the reader registered for \p usdTypeName was
+    /// declared as having a Prefetch step.
+    MAYAUSD_CORE_PUBLIC
+    static bool HasPrefetch(const TfToken& usdTypeName);
 };
 
 #define PXRUSDMAYA_DEFINE_READER(T, argsVarName, ctxVarName)\
@@ -58,6 +58,34 @@ TF_DEFINE_PRIVATE_TOKENS(
     (USD_inheritClassNames)
 );
 
+/* virtual */
+UsdMayaPrimWriterFrameData::~UsdMayaPrimWriterFrameData()
+{
+}
+
+void
+UsdMayaPrimWriterFrameData::StageValue(
+        const UsdAttribute& attr,
+        VtValue* value)
+{
+    _stagedValues.emplace_back(attr, VtValue());
+    _stagedValues.back().second.Swap(*value);
+}
+
+void
+UsdMayaPrimWriterFrameData::Flush(
+        const UsdTimeCode& usdTime,
+        UsdUtilsSparseValueWriter* valueWriter)
+{
+    for (auto& stagedValue : _stagedValues) {
+        valueWriter->SetAttribute(
+            stagedValue.first,
+            &stagedValue.second,
+            usdTime);
+    }
+    _stagedValues.clear();
+}
+
 static
 bool
 _IsAnimated(const UsdMayaJobExportArgs& args, const MObject& obj)
@@ -228,6 +256,38 @@ UsdMayaPrimWriter::Write(const UsdTimeCode& usdTime)
         _GetSparseValueWriter());
 }
 
+/* virtual */
+bool
+UsdMayaPrimWriter::SupportsFrameCapture() const
+{
+    return false;
+}
+
+/* virtual */
+UsdMayaPrimWriterFrameDataUniquePtr
+UsdMayaPrimWriter::CaptureFrame(const UsdTimeCode& usdTime)
+{
+    return nullptr;
+}
+
+/* virtual */
+void
+UsdMayaPrimWriter::ConvertFrame(
+        const UsdTimeCode& usdTime,
+        UsdMayaPrimWriterFrameData* frameData)
+{
+}
+
+void
+UsdMayaPrimWriter::FlushFrame(
+        const UsdTimeCode& usdTime,
+        UsdMayaPrimWriterFrameData* frameData)
+{
+    if (frameData) {
+        frameData->Flush(usdTime, &_valueWriter);
+    }
+}
+
 /* virtual */
 bool
 UsdMayaPrimWriter::ExportsGprims() const
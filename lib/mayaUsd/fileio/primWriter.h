@@ -17,6 +17,8 @@
 #define PXRUSDMAYA_PRIM_WRITER_H
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <maya/MDagPath.h>
 #include <maya/MFnDependencyNode.h>
@@ -39,6 +41,40 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 class UsdMayaWriteJobContext;
 
+/// Per-frame data for the pipelined export path (see
+/// UsdMayaJobExportArgs::parallelFrameWrite).
+///
+/// Prim writers that support pipelining derive from this class to hold the
+/// Maya values captured on the main thread in
+/// UsdMayaPrimWriter::CaptureFrame(). UsdMayaPrimWriter::ConvertFrame() then
+/// turns them into USD values on a worker thread and queues them with
+/// StageValue(); the write job authors the queued values afterwards, one
+/// writer at a time and in traversal order.
+class UsdMayaPrimWriterFrameData
+{
+public:
+    MAYAUSD_CORE_PUBLIC
+    virtual ~UsdMayaPrimWriterFrameData();
+
+    /// Queues \p value to be authored on \p attr. The value is swapped out of
+    /// \p value, leaving it empty.
+    MAYAUSD_CORE_PUBLIC
+    void StageValue(const UsdAttribute& attr, VtValue* value);
+
+    /// Authors all queued values at \p usdTime through \p valueWriter in the
+    /// order they were staged, then clears the queue.
+    MAYAUSD_CORE_PUBLIC
+    void Flush(
+            const UsdTimeCode& usdTime,
+            UsdUtilsSparseValueWriter* valueWriter);
+
+private:
+    std::vector<std::pair<UsdAttribute, VtValue>> _stagedValues;
+};
+
+typedef std::unique_ptr<UsdMayaPrimWriterFrameData>
+        UsdMayaPrimWriterFrameDataUniquePtr;
+
 /// Base class for all built-in and user-defined prim writers. Translates Maya
 /// node data into USD prim(s).
 ///
@@ -74,6 +110,53 @@ public:
     MAYAUSD_CORE_PUBLIC
     virtual void Write(const UsdTimeCode& usdTime);
 
+    /// Whether CaptureFrame() and ConvertFrame() together do all that
+    /// Write() does for an animated time sample, so that they can be used
+    /// instead of Write().
+    ///
+    /// The base implementation returns false. A subclass of a writer that
+    /// returns true must override it to return false if it extends Write()
+    /// without extending CaptureFrame() and ConvertFrame() to match, or its
+    /// additions would be skipped by pipelined exports.
+    MAYAUSD_CORE_PUBLIC
+    virtual bool SupportsFrameCapture() const;
+
+    /// Main-thread half of a pipelined Write() for an animated time sample.
+    /// Used instead of Write() when the export args enable
+    /// parallelFrameWrite and SupportsFrameCapture() returns true.
+    ///
+    /// Implementations must gather every Maya value they need for
+    /// \p usdTime into the returned object. They may also author USD data
+    /// directly, since no other thread writes to the stage during capture.
+    ///
+    /// The base implementation returns nullptr. When nullptr is returned,
+    /// Write() is called on the main thread as usual.
+    MAYAUSD_CORE_PUBLIC
+    virtual UsdMayaPrimWriterFrameDataUniquePtr CaptureFrame(
+            const UsdTimeCode& usdTime);
+
+    /// Worker-thread half of a pipelined Write(). Converts the data captured
+    /// by CaptureFrame() into USD values and queues them on \p frameData with
+    /// UsdMayaPrimWriterFrameData::StageValue().
+    ///
+    /// Writers are converted concurrently, so implementations must not call
+    /// into Maya, author on the stage, or touch state shared with other
+    /// writers.
+    ///
+    /// Base implementation does nothing.
+    MAYAUSD_CORE_PUBLIC
+    virtual void ConvertFrame(
+            const UsdTimeCode& usdTime,
+            UsdMayaPrimWriterFrameData* frameData);
+
+    /// Authors the values queued on \p frameData at \p usdTime through this
+    /// writer's sparse value writer, so that pipelined and serial exports
+    /// produce the same time samples.
+    MAYAUSD_CORE_PUBLIC
+    void FlushFrame(
+            const UsdTimeCode& usdTime,
+            UsdMayaPrimWriterFrameData* frameData);
+
     /// Post export function that runs before saving the stage.
     ///
     /// Base implementation does nothing.
@@ -47,18 +47,16 @@ PXR_NAMESPACE_OPEN_SCOPE
 PXRUSDMAYA_REGISTER_WRITER(transform, UsdMayaTransformWriter);
 PXRUSDMAYA_REGISTER_ADAPTOR_SCHEMA(transform, UsdGeomXform);
 
-// Given an Op, value and time, set the Op value based on op type and precision
+// Given an Op and value, convert the value based on op type and precision
 static
-void
-setXformOp(
+VtValue
+getXformOpValue(
         const UsdGeomXformOp& op,
-        const GfVec3d& value,
-        const UsdTimeCode& usdTime,
-        UsdUtilsSparseValueWriter* valueWriter)
+        const GfVec3d& value)
 {
     if (!op) {
         TF_CODING_ERROR("Xform op is not valid");
-        return;
+        return VtValue();
     }
 
     if (op.GetOpType() == UsdGeomXformOp::TypeTransform) {
@@ -66,48 +64,43 @@ setXformOp(
         shearXForm[1][0] = value[0]; //xyVal
         shearXForm[2][0] = value[1]; //xzVal
         shearXForm[2][1] = value[2]; //yzVal
-        valueWriter->SetAttribute(op.GetAttr(), shearXForm, usdTime);
-        return;
+        return VtValue(shearXForm);
     }
 
-    VtValue vtValue;
     if (UsdGeomXformOp::GetPrecisionFromValueTypeName(op.GetAttr().GetTypeName())
             == UsdGeomXformOp::PrecisionDouble) {
-        vtValue = VtValue(value);
+        return VtValue(value);
     }
-    else { // float precision
-        vtValue = VtValue(GfVec3f(value));
-    }
-    valueWriter->SetAttribute(op.GetAttr(), vtValue, usdTime);
+    // float precision
+    return VtValue(GfVec3f(value));
 }
 
 /* static */
 void
-UsdMayaTransformWriter::_ComputeXformOps(
+UsdMayaTransformWriter::_SampleXformOps(
         const std::vector<_AnimChannel>& animChanList,
         const UsdTimeCode& usdTime,
-        const bool eulerFilter,
-        UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
-        UsdUtilsSparseValueWriter* valueWriter)
+        std::vector<_ChannelSample>* samples)
 {
-    if (!TF_VERIFY(previousRotates)) {
-        return;
-    }
+    samples->resize(animChanList.size());
 
     // Iterate over each _AnimChannel, retrieve the default value and pull the
-    // Maya data if needed. Then store it on the USD Ops
-    for (const auto& animChannel : animChanList) {
+    // Maya data if needed.
+    for (size_t c = 0u; c < animChanList.size(); ++c) {
+        const _AnimChannel& animChannel = animChanList[c];
+        _ChannelSample& sample = (*samples)[c];
+        sample.shouldWrite = false;
 
         if (animChannel.isInverse) {
             continue;
         }
 
-        GfVec3d value = animChannel.defValue;
+        sample.value = animChannel.defValue;
         bool hasAnimated = false;
         bool hasStatic = false;
         for (unsigned int i = 0u; i < 3u; ++i) {
             if (animChannel.sampleType[i] == _SampleType::Animated) {
-                value[i] = animChannel.plug[i].asDouble();
+                sample.value[i] = animChannel.plug[i].asDouble();
                 hasAnimated = true;
             }
             else if (animChannel.sampleType[i] == _SampleType::Static) {
@@ -123,43 +116,98 @@ UsdMayaTransformWriter::_ComputeXformOps(
         //
         // This to make sure static channels are setting their default while
         // animating ones are actually animating
-        if ((usdTime == UsdTimeCode::Default() && hasStatic && !hasAnimated) ||
-                (usdTime != UsdTimeCode::Default() && hasAnimated)) {
-
-            if (animChannel.opType == _XformType::Rotate) {
-                if (hasAnimated && eulerFilter) {
-                    const TfToken& lookupName = animChannel.opName.IsEmpty() ?
-                            UsdGeomXformOp::GetOpTypeToken(animChannel.usdOpType) :
-                            animChannel.opName;
-                    auto findResult = previousRotates->find(lookupName);
-                    if (findResult == previousRotates->end()) {
-                        MEulerRotation::RotationOrder rotOrder =
-                                UsdMayaXformStack::RotateOrderFromOpType(
-                                        animChannel.usdOpType,
-                                        MEulerRotation::kXYZ);
-                        MEulerRotation currentRotate(value[0], value[1], value[2], rotOrder);
-                        (*previousRotates)[lookupName] = currentRotate;
-                    }
-                    else {
-                        MEulerRotation& previousRotate = findResult->second;
-                        MEulerRotation::RotationOrder rotOrder =
-                                UsdMayaXformStack::RotateOrderFromOpType(
-                                        animChannel.usdOpType,
-                                        previousRotate.order);
-                        MEulerRotation currentRotate(value[0], value[1], value[2], rotOrder);
-                        currentRotate.setToClosestSolution(previousRotate);
-                        for (unsigned int i = 0; i<3; i++) {
-                            value[i] = currentRotate[i];
-                        }
-                        (*previousRotates)[lookupName] = currentRotate;
-                    }
+        sample.shouldWrite =
+                (usdTime == UsdTimeCode::Default() && hasStatic && !hasAnimated) ||
+                (usdTime != UsdTimeCode::Default() && hasAnimated);
+    }
+}
+
+/* static */
+void
+UsdMayaTransformWriter::_ConvertXformOps(
+        const std::vector<_AnimChannel>& animChanList,
+        const std::vector<_ChannelSample>& samples,
+        const bool eulerFilter,
+        UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
+        std::vector<VtValue>* opValues)
+{
+    if (!TF_VERIFY(previousRotates) ||
+            !TF_VERIFY(samples.size() == animChanList.size())) {
+        return;
+    }
+
+    opValues->assign(animChanList.size(), VtValue());
+
+    for (size_t c = 0u; c < animChanList.size(); ++c) {
+        const _AnimChannel& animChannel = animChanList[c];
+        if (!samples[c].shouldWrite) {
+            continue;
+        }
+
+        GfVec3d value = samples[c].value;
+        if (animChannel.opType == _XformType::Rotate) {
+            // Only animated channels are written at non-default times.
+            const bool hasAnimated =
+                    animChannel.sampleType[0] == _SampleType::Animated ||
+                    animChannel.sampleType[1] == _SampleType::Animated ||
+                    animChannel.sampleType[2] == _SampleType::Animated;
+            if (hasAnimated && eulerFilter) {
+                const TfToken& lookupName = animChannel.opName.IsEmpty() ?
+                        UsdGeomXformOp::GetOpTypeToken(animChannel.usdOpType) :
+                        animChannel.opName;
+                auto findResult = previousRotates->find(lookupName);
+                if (findResult == previousRotates->end()) {
+                    MEulerRotation::RotationOrder rotOrder =
+                            UsdMayaXformStack::RotateOrderFromOpType(
+                                    animChannel.usdOpType,
+                                    MEulerRotation::kXYZ);
+                    MEulerRotation currentRotate(value[0], value[1], value[2], rotOrder);
+                    (*previousRotates)[lookupName] = currentRotate;
                 }
-                for (unsigned int i = 0; i<3; i++) {
-                    value[i] = GfRadiansToDegrees(value[i]);
+                else {
+                    MEulerRotation& previousRotate = findResult->second;
+                    MEulerRotation::RotationOrder rotOrder =
+                            UsdMayaXformStack::RotateOrderFromOpType(
+                                    animChannel.usdOpType,
+                                    previousRotate.order);
+                    MEulerRotation currentRotate(value[0], value[1], value[2], rotOrder);
+                    currentRotate.setToClosestSolution(previousRotate);
+                    for (unsigned int i = 0; i<3; i++) {
+                        value[i] = currentRotate[i];
+                    }
+                    (*previousRotates)[lookupName] = currentRotate;
                 }
             }
+            for (unsigned int i = 0; i<3; i++) {
+                value[i] = GfRadiansToDegrees(value[i]);
+            }
+        }
 
-            setXformOp(animChannel.op, value, usdTime, valueWriter);
+        (*opValues)[c] = getXformOpValue(animChannel.op, value);
+    }
+}
+
+/* static */
+void
+UsdMayaTransformWriter::_ComputeXformOps(
+        const std::vector<_AnimChannel>& animChanList,
+        const UsdTimeCode& usdTime,
+        const bool eulerFilter,
+        UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
+        UsdUtilsSparseValueWriter* valueWriter)
+{
+    std::vector<_ChannelSample> samples;
+    _SampleXformOps(animChanList, usdTime, &samples);
+
+    std::vector<VtValue> opValues;
+    _ConvertXformOps(
+        animChanList, samples, eulerFilter, previousRotates, &opValues);
+
+    // Store the values on the USD Ops
+    for (size_t c = 0u; c < opValues.size(); ++c) {
+        if (!opValues[c].IsEmpty()) {
+            valueWriter->SetAttribute(
+                animChanList[c].op.GetAttr(), &opValues[c], usdTime);
         }
     }
 }
@@ -471,5 +519,54 @@ UsdMayaTransformWriter::Write(const UsdTimeCode& usdTime)
     }
 }
 
+/* virtual */
+bool
+UsdMayaTransformWriter::SupportsFrameCapture() const
+{
+    return true;
+}
+
+/* virtual */
+UsdMayaPrimWriterFrameDataUniquePtr
+UsdMayaTransformWriter::CaptureFrame(const UsdTimeCode& usdTime)
+{
+    UsdMayaPrimWriter::Write(usdTime);
+
+    _FrameData* frameData = new _FrameData();
+    if (GetMayaObject().hasFn(MFn::kTransform) &&
+            UsdGeomXformable(_usdPrim)) {
+        _SampleXformOps(_animChannels, usdTime, &frameData->samples);
+    }
+
+    return UsdMayaPrimWriterFrameDataUniquePtr(frameData);
+}
+
+/* virtual */
+void
+UsdMayaTransformWriter::ConvertFrame(
+        const UsdTimeCode& usdTime,
+        UsdMayaPrimWriterFrameData* frameData)
+{
+    _FrameData* xformFrameData = static_cast<_FrameData*>(frameData);
+    if (!xformFrameData || xformFrameData->samples.empty()) {
+        return;
+    }
+
+    std::vector<VtValue> opValues;
+    _ConvertXformOps(
+        _animChannels,
+        xformFrameData->samples,
+        _GetExportArgs().eulerFilter,
+        &_previousRotates,
+        &opValues);
+
+    for (size_t c = 0u; c < opValues.size(); ++c) {
+        if (!opValues[c].IsEmpty()) {
+            xformFrameData->StageValue(
+                _animChannels[c].op.GetAttr(), &opValues[c]);
+        }
+    }
+}
+
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -28,6 +28,7 @@
 #include <pxr/pxr.h>
 #include <pxr/base/gf/vec3d.h>
 #include <pxr/base/tf/token.h>
+#include <pxr/base/vt/value.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdGeom/xformable.h>
@@ -57,6 +58,24 @@ public:
     MAYAUSD_CORE_PUBLIC
     void Write(const UsdTimeCode& usdTime) override;
 
+    /// Returns true, since the xform ops are all that Write() adds to
+    /// UsdMayaPrimWriter::Write(). Subclasses that extend Write() must
+    /// override it.
+    MAYAUSD_CORE_PUBLIC
+    bool SupportsFrameCapture() const override;
+
+    /// Captures the animated channel values for the pipelined export path.
+    MAYAUSD_CORE_PUBLIC
+    UsdMayaPrimWriterFrameDataUniquePtr CaptureFrame(
+            const UsdTimeCode& usdTime) override;
+
+    /// Converts the captured channel values into xformOp values, applying
+    /// the euler filter if requested.
+    MAYAUSD_CORE_PUBLIC
+    void ConvertFrame(
+            const UsdTimeCode& usdTime,
+            UsdMayaPrimWriterFrameData* frameData) override;
+
 private:
     using _TokenRotationMap = std::unordered_map<
             const TfToken, MEulerRotation, TfToken::HashFunctor>;
@@ -83,6 +102,37 @@ private:
         UsdGeomXformOp op;
     };
 
+    // Maya value of an _AnimChannel at a given time, and whether it must be
+    // written at that time.
+    struct _ChannelSample
+    {
+        GfVec3d value;
+        bool shouldWrite;
+    };
+
+    // Per-frame data for the pipelined export path.
+    struct _FrameData : public UsdMayaPrimWriterFrameData
+    {
+        std::vector<_ChannelSample> samples;
+    };
+
+    // For a given array of _AnimChannels and time, read the Maya value of
+    // every channel that needs to be written. This is the only part of the
+    // xformOp computation that calls into Maya.
+    static void _SampleXformOps(
+            const std::vector<_AnimChannel>& animChanList,
+            const UsdTimeCode& usdTime,
+            std::vector<_ChannelSample>* samples);
+
+    // Converts the channel samples read by _SampleXformOps() into xformOp
+    // values. Channels that should not be written get an empty value.
+    static void _ConvertXformOps(
+            const std::vector<_AnimChannel>& animChanList,
+            const std::vector<_ChannelSample>& samples,
+            const bool eulerFilter,
+            UsdMayaTransformWriter::_TokenRotationMap* previousRotates,
+            std::vector<VtValue>* opValues);
+
     // For a given array of _AnimChannels and time, compute the xformOp data if
     // needed and set the xformOps' values.
     static void _ComputeXformOps(
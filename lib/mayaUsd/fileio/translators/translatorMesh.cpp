@@ -47,6 +47,51 @@
 
 MAYAUSD_NS_DEF {
 
+TranslatorMeshReadData::TranslatorMeshReadData(const UsdGeomMesh& mesh,
+                                               const GfInterval& frameRange)
+{
+    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
+    faceVertexCountsVarying = fvc.ValueMightBeTimeVarying();
+    if (!faceVertexCountsVarying) {
+        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
+    }
+
+    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
+    faceVertexIndicesVarying = fvi.ValueMightBeTimeVarying();
+    if (!faceVertexIndicesVarying) {
+        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
+    }
+
+    // Gather points and normals
+    // If timeInterval is non-empty, pick the first available sample in the
+    // timeInterval or default.
+    UsdTimeCode pointsTimeSample = UsdTimeCode::EarliestTime();
+    UsdTimeCode normalsTimeSample = UsdTimeCode::EarliestTime();
+
+    if (!frameRange.IsEmpty()) {
+        mesh.GetPointsAttr().GetTimeSamplesInInterval(frameRange,
+                                                      &pointsTimeSamples);
+        if (!pointsTimeSamples.empty()) {
+            pointsTimeSample = pointsTimeSamples.front();
+        }
+
+        std::vector<double> normalsTimeSamples;
+        mesh.GetNormalsAttr().GetTimeSamplesInInterval(frameRange,
+                                                       &normalsTimeSamples);
+        if (!normalsTimeSamples.empty()) {
+            normalsTimeSample = normalsTimeSamples.front();
+        }
+    }
+
+    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
+    mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
+
+    hasSubdivisionScheme = mesh.GetSubdivisionSchemeAttr().Get(&subdivisionScheme);
+    if (hasSubdivisionScheme && subdivisionScheme == UsdGeomTokens->none) {
+        normalsInterpolation = mesh.GetNormalsInterpolation();
+    }
+}
+
 TranslatorMeshRead::TranslatorMeshRead(const UsdGeomMesh& mesh, 
                                        const UsdPrim& prim, 
                                        const MObject& transformObj,
@@ -54,19 +99,35 @@ TranslatorMeshRead::TranslatorMeshRead(const UsdGeomMesh& mesh,
                                        const GfInterval& frameRange,
                                        bool wantCacheAnimation,
                                        MStatus * status)
+    : TranslatorMeshRead(TranslatorMeshReadData(mesh, frameRange),
+                         mesh,
+                         prim,
+                         transformObj,
+                         stageNode,
+                         wantCacheAnimation,
+                         status)
+{
+}
+
+TranslatorMeshRead::TranslatorMeshRead(const TranslatorMeshReadData& data,
+                                       const UsdGeomMesh& mesh, 
+                                       const UsdPrim& prim, 
+                                       const MObject& transformObj,
+                                       const MObject& stageNode,
+                                       bool wantCacheAnimation,
+                                       MStatus * status)
     : m_wantCacheAnimation(wantCacheAnimation)
-    , m_pointsNumTimeSamples(0u)
+    , m_pointsNumTimeSamples(data.pointsTimeSamples.size())
 {
     MStatus stat{MS::kSuccess};
 
     // ==============================================
     // construct a Maya mesh
     // ==============================================
-    VtIntArray faceVertexCounts;
-    VtIntArray faceVertexIndices;
+    const VtIntArray& faceVertexCounts = data.faceVertexCounts;
+    const VtIntArray& faceVertexIndices = data.faceVertexIndices;
 
-    const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
-    if (fvc.ValueMightBeTimeVarying()){
+    if (data.faceVertexCountsVarying){
         // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
         // for the mesh, perhaps?  For now, better to give a more specific error
         TF_RUNTIME_ERROR(
@@ -74,12 +135,9 @@ TranslatorMeshRead::TranslatorMeshRead(const UsdGeomMesh& mesh,
                 "faceVertexCounts), which isn't currently supported. "
                 "Skipping...",
                 prim.GetPath().GetText());
-    } else {
-        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
     }
 
-    const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
-    if (fvi.ValueMightBeTimeVarying()){
+    if (data.faceVertexIndicesVarying){
         // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
         // for the mesh, perhaps?  For now, better to give a more specific error
         TF_RUNTIME_ERROR(
@@ -87,8 +145,6 @@ TranslatorMeshRead::TranslatorMeshRead(const UsdGeomMesh& mesh,
                 "faceVertexIndices), which isn't currently supported. "
                 "Skipping...",
                 prim.GetPath().GetText());
-    } else {
-        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
     }
 
     // Sanity Checks. If the vertex arrays are empty, skip this mesh
@@ -100,33 +156,9 @@ TranslatorMeshRead::TranslatorMeshRead(const UsdGeomMesh& mesh,
                 prim.GetPath().GetText());
     }
 
-    // Gather points and normals
-    // If timeInterval is non-empty, pick the first available sample in the
-    // timeInterval or default.
-    VtVec3fArray points;
-    VtVec3fArray normals;
-    UsdTimeCode pointsTimeSample = UsdTimeCode::EarliestTime();
-    UsdTimeCode normalsTimeSample = UsdTimeCode::EarliestTime();
-    std::vector<double> pointsTimeSamples;
-
-    if (!frameRange.IsEmpty()) {
-        mesh.GetPointsAttr().GetTimeSamplesInInterval(frameRange,
-                                                      &pointsTimeSamples);
-        if (!pointsTimeSamples.empty()) {
-            m_pointsNumTimeSamples = pointsTimeSamples.size();
-            pointsTimeSample = pointsTimeSamples.front();
-        }
-
-        std::vector<double> normalsTimeSamples;
-        mesh.GetNormalsAttr().GetTimeSamplesInInterval(frameRange,
-                                                       &normalsTimeSamples);
-        if (!normalsTimeSamples.empty()) {
-            normalsTimeSample = normalsTimeSamples.front();
-        }
-    }
-
-    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
-    mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
+    VtVec3fArray points = data.points;
+    VtVec3fArray normals = data.normals;
+    const std::vector<double>& pointsTimeSamples = data.pointsTimeSamples;
 
     if (points.empty()) {
         TF_RUNTIME_ERROR("points array is empty on Mesh <%s>. Skipping...",
@@ -208,10 +240,9 @@ TranslatorMeshRead::TranslatorMeshRead(const UsdGeomMesh& mesh,
     // If we are dealing with polys, check if there are normals and set the
     // internal emit-normals tag so that the normals will round-trip.
     // If we are dealing with a subdiv, read additional subdiv tags.
-    TfToken subdScheme;
-    if (mesh.GetSubdivisionSchemeAttr().Get(&subdScheme) && subdScheme == UsdGeomTokens->none) {
+    if (data.hasSubdivisionScheme && data.subdivisionScheme == UsdGeomTokens->none) {
          if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices()) &&
-                 mesh.GetNormalsInterpolation() == UsdGeomTokens->faceVarying) {
+                 data.normalsInterpolation == UsdGeomTokens->faceVarying) {
              UsdMayaMeshReadUtils::setEmitNormalsTag(meshFn, true);
          }
     } 
@@ -26,10 +26,32 @@
 #include <pxr/pxr.h>
 #include <pxr/usd/usdGeom/mesh.h>
 
+#include <vector>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 MAYAUSD_NS_DEF {
 
+/// The USD data needed to create a Maya mesh from a UsdGeomMesh prim.
+/// Gathering it only reads from the USD stage, so that it can be done ahead
+/// of the mesh creation, on a worker thread.
+struct MAYAUSD_CORE_PUBLIC TranslatorMeshReadData
+{
+    TranslatorMeshReadData(const UsdGeomMesh& mesh,
+                           const GfInterval& frameRange);
+
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+    VtVec3fArray points;
+    VtVec3fArray normals;
+    TfToken normalsInterpolation;
+    TfToken subdivisionScheme;
+    std::vector<double> pointsTimeSamples;
+    bool faceVertexCountsVarying{false};
+    bool faceVertexIndicesVarying{false};
+    bool hasSubdivisionScheme{false};
+};
+
 /// Provides helper functions for translating UsdGeomMesh prims into Maya
 /// meshes.
 class MAYAUSD_CORE_PUBLIC TranslatorMeshRead
@@ -43,6 +65,15 @@ public:
                        bool wantCacheAnimation,
                        MStatus * status = nullptr);
 
+    /// Creates the Maya mesh from data gathered beforehand.
+    TranslatorMeshRead(const TranslatorMeshReadData& data,
+                       const UsdGeomMesh& mesh,
+                       const UsdPrim& prim, 
+                       const MObject& transformObj,
+                       const MObject& stageNode,
+                       bool wantCacheAnimation,
+                       MStatus * status = nullptr);
+
     ~TranslatorMeshRead() = default;
 
     TranslatorMeshRead(const TranslatorMeshRead&) = delete;
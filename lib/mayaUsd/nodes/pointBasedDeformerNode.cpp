@@ -16,7 +16,9 @@
 #include "pointBasedDeformerNode.h"
 
 #include <string>
+#include <vector>
 
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MFnData.h>
@@ -29,6 +31,7 @@
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPoint.h>
+#include <maya/MPointArray.h>
 #include <maya/MPxDeformerNode.h>
 #include <maya/MStatus.h>
 #include <maya/MString.h>
@@ -50,7 +53,11 @@
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdGeom/pointBased.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <mayaUsd/nodes/stageData.h>
+#include <mayaUsdUtils/SIMD.h>
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -68,6 +75,71 @@ MObject UsdMayaPointBasedDeformerNode::primPathAttr;
 MObject UsdMayaPointBasedDeformerNode::timeAttr;
 
 
+namespace {
+
+// Number of points blended by each task.
+constexpr size_t _deformGrainSize = 4096;
+
+// Blends the Maya points in [begin, end) towards the USD points with the
+// same component index, as GfLerp<GfVec3f> would.
+void
+_LerpPoints(
+        const VtVec3fArray& usdPoints,
+        const std::vector<int>& indices,
+        const std::vector<float>& weights,
+        const float envelope,
+        MPointArray& mayaPoints,
+        const size_t begin,
+        const size_t end)
+{
+    const size_t numUsdPoints = usdPoints.size();
+    const GfVec3f* const usdData = usdPoints.cdata();
+
+    for (size_t i = begin; i < end; ++i) {
+        const int index = indices[i];
+        if (index < 0 || static_cast<size_t>(index) >= numUsdPoints) {
+            continue;
+        }
+
+        const float alpha = weights[index] * envelope;
+        const GfVec3f& usdPoint = usdData[index];
+        MPoint& mayaPoint = mayaPoints[i];
+
+#if defined(__SSE2__)
+        using namespace MayaUsdUtils;
+
+        const f128 mayaXyz = movelh4f(
+            cvt2d_to_2f(loadu2d(&mayaPoint.x)),
+            cvt2d_to_2f(loadu2d(&mayaPoint.z)));
+
+        // A 4-wide load would read past the end of the last point.
+        const f128 usdXyz =
+            static_cast<size_t>(index) + 1u < numUsdPoints ?
+                loadu4f(usdPoint.data()) :
+                set4f(usdPoint[0], usdPoint[1], usdPoint[2], 0.0f);
+
+        const f128 result = add4f(
+            mul4f(splat4f(1.0f - alpha), mayaXyz),
+            mul4f(splat4f(alpha), usdXyz));
+
+        storeu2d(&mayaPoint.x, cvt2f_to_2d(result));
+        storeu2d(&mayaPoint.z, cvt2f_to_2d(movehl4f(result, result)));
+        mayaPoint.w = 1.0;
+#else
+        const GfVec3f deformedPoint =
+            GfLerp<GfVec3f>(alpha,
+                            GfVec3f(mayaPoint[0], mayaPoint[1], mayaPoint[2]),
+                            usdPoint);
+
+        mayaPoint =
+            MPoint(deformedPoint[0], deformedPoint[1], deformedPoint[2]);
+#endif
+    }
+}
+
+} // anonymous namespace
+
+
 /* static */
 void*
 UsdMayaPointBasedDeformerNode::creator()
@@ -159,18 +231,9 @@ UsdMayaPointBasedDeformerNode::deform(
     const MDataHandle primPathHandle = block.inputValue(primPathAttr, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
-    const std::string primPathString =
-        TfStringTrim(primPathHandle.asString().asChar());
-
-    if (primPathString.empty()) {
-        return MS::kFailure;
-    }
-
-    const SdfPath primPath(primPathString);
-
-    const UsdPrim& usdPrim = usdStage->GetPrimAtPath(primPath);
-    const UsdGeomPointBased usdPointBased(usdPrim);
-    if (!usdPointBased) {
+    const UsdAttribute pointsAttr =
+        _GetPointsAttr(usdStage, primPathHandle.asString());
+    if (!pointsAttr) {
         return MS::kFailure;
     }
 
@@ -183,32 +246,88 @@ UsdMayaPointBasedDeformerNode::deform(
     const float envelope = envelopeHandle.asFloat();
 
     VtVec3fArray usdPoints;
-    if (!usdPointBased.GetPointsAttr().Get(&usdPoints, usdTime) ||
-            usdPoints.empty()) {
+    if (!pointsAttr.Get(&usdPoints, usdTime) || usdPoints.empty()) {
         return MS::kFailure;
     }
 
+    // Gather the component indices being deformed.
+    std::vector<int> indices;
+    indices.reserve(iter.count());
     for ( ; !iter.isDone(); iter.next()) {
-        const int index = iter.index();
-        if (index < 0 || static_cast<size_t>(index) >= usdPoints.size()) {
-            continue;
+        indices.push_back(iter.index());
+    }
+    iter.reset();
+
+    // Gather the weights of the components with a USD point. Components
+    // without an authored weight have a weight of 1.
+    std::vector<float> weights(usdPoints.size(), 1.0f);
+    MArrayDataHandle weightListHandle =
+        block.inputArrayValue(weightList, &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (weightListHandle.jumpToElement(multiIndex) == MS::kSuccess) {
+        MArrayDataHandle weightsHandle(
+            weightListHandle.inputValue().child(MPxDeformerNode::weights));
+        const unsigned int numWeights = weightsHandle.elementCount();
+        for (unsigned int i = 0u; i < numWeights; ++i) {
+            weightsHandle.jumpToArrayElement(i);
+            const unsigned int index = weightsHandle.elementIndex();
+            if (index < weights.size()) {
+                weights[index] = weightsHandle.inputValue().asFloat();
+            }
         }
+    }
+
+    MPointArray mayaPoints;
+    status = iter.allPositions(mayaPoints);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    if (mayaPoints.length() != indices.size()) {
+        return MS::kFailure;
+    }
 
-        const MPoint mayaPoint = iter.position();
-        const float weight = weightValue(block, multiIndex, index);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0u, indices.size(), _deformGrainSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            _LerpPoints(
+                usdPoints,
+                indices,
+                weights,
+                envelope,
+                mayaPoints,
+                range.begin(),
+                range.end());
+        });
+
+    return iter.setAllPositions(mayaPoints);
+}
 
-        const GfVec3f& usdPoint = usdPoints[static_cast<size_t>(index)];
+UsdAttribute
+UsdMayaPointBasedDeformerNode::_GetPointsAttr(
+        const UsdStageRefPtr& usdStage,
+        const MString& primPath)
+{
+    // The attribute becomes invalid if its prim is removed or resynced.
+    if (get_pointer(_cachedStage) == get_pointer(usdStage) &&
+            _cachedPrimPath == primPath &&
+            _cachedPointsAttr.IsValid()) {
+        return _cachedPointsAttr;
+    }
 
-        const GfVec3f deformedPoint =
-            GfLerp<GfVec3f>(weight * envelope,
-                            GfVec3f(mayaPoint[0], mayaPoint[1], mayaPoint[2]),
-                            usdPoint);
+    _cachedStage = usdStage;
+    _cachedPrimPath = primPath;
+    _cachedPointsAttr = UsdAttribute();
 
-        iter.setPosition(
-            MPoint(deformedPoint[0], deformedPoint[1], deformedPoint[2]));
+    const std::string primPathString = TfStringTrim(primPath.asChar());
+    if (primPathString.empty()) {
+        return _cachedPointsAttr;
     }
 
-    return status;
+    const UsdPrim usdPrim = usdStage->GetPrimAtPath(SdfPath(primPathString));
+    const UsdGeomPointBased usdPointBased(usdPrim);
+    if (usdPointBased) {
+        _cachedPointsAttr = usdPointBased.GetPointsAttr();
+    }
+
+    return _cachedPointsAttr;
 }
 
 UsdMayaPointBasedDeformerNode::UsdMayaPointBasedDeformerNode() :
@@ -27,6 +27,8 @@
 
 #include <pxr/pxr.h>
 #include <pxr/base/tf/staticTokens.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/stage.h>
 
 #include <mayaUsd/base/api.h>
 
@@ -50,6 +52,10 @@ TF_DECLARE_PUBLIC_TOKENS(UsdMayaPointBasedDeformerNodeTokens,
 /// the deformer runs, it will read the points attribute of the prim at that
 /// time sample and use the positions to modify the positions of the geometry
 /// being deformed.
+///
+/// The points attribute is resolved once and reused until the stage or the
+/// prim path changes. Positions and weights are read and written in blocks,
+/// and the points are blended in parallel.
 class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
 {
     public:
@@ -87,6 +93,15 @@ class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
         UsdMayaPointBasedDeformerNode(const UsdMayaPointBasedDeformerNode&);
         UsdMayaPointBasedDeformerNode& operator=(
                 const UsdMayaPointBasedDeformerNode&);
+
+        UsdAttribute _GetPointsAttr(
+                const UsdStageRefPtr& usdStage,
+                const MString& primPath);
+
+        // Points attribute resolved from the stage and prim path last used.
+        UsdStagePtr  _cachedStage;
+        MString      _cachedPrimPath;
+        UsdAttribute _cachedPointsAttr;
 };
 
 
@@ -15,11 +15,14 @@
 //
 #include "proxyShapeBase.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <maya/M3dView.h>
 #include <maya/MBoundingBox.h>
 #include <maya/MEvaluationNode.h>
 #include <maya/MDagPath.h>
@@ -32,6 +35,7 @@
 #include <maya/MFnDagNode.h>
 #include <maya/MFnData.h>
 #include <maya/MFnDependencyNode.h>
+#include <maya/MFnCamera.h>
 #include <maya/MFnEnumAttribute.h>
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnPluginData.h>
@@ -40,6 +44,7 @@
 #include <maya/MFnUnitAttribute.h>
 #include <maya/MGlobal.h>
 #include <maya/MItDependencyNodes.h>
+#include <maya/MMatrix.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
@@ -49,6 +54,8 @@
 #include <maya/MStatus.h>
 #include <maya/MString.h>
 #include <maya/MTime.h>
+#include <maya/MTimerMessage.h>
+#include <maya/MVector.h>
 #include <maya/MViewport2Renderer.h>
 #include <maya/MEvaluationNode.h>
 
@@ -102,6 +109,13 @@ MayaUsdProxyShapeBase::_sharedClosestPointDelegate = nullptr;
 
 const std::string kAnonymousLayerName{"anonymousLayer1"};
 
+// Period, in seconds, of the payload streaming updates.
+constexpr float kPayloadStreamingPeriod = 0.25f;
+
+TF_DEFINE_ENV_SETTING(MAYAUSD_PAYLOAD_STREAMING_NON_INTERACTIVE, false,
+    "Also stream the payloads of proxy shapes in batch and mayapy sessions. "
+    "There is no active camera to follow there, so this is meant for tests.");
+
 // ========================================================
 
 // TypeID from the MayaUsd type ID range.
@@ -119,10 +133,14 @@ MObject MayaUsdProxyShapeBase::filePathAttr;
 MObject MayaUsdProxyShapeBase::primPathAttr;
 MObject MayaUsdProxyShapeBase::excludePrimPathsAttr;
 MObject MayaUsdProxyShapeBase::loadPayloadsAttr;
+MObject MayaUsdProxyShapeBase::payloadStreamingAttr;
+MObject MayaUsdProxyShapeBase::payloadStreamingBudgetAttr;
+MObject MayaUsdProxyShapeBase::payloadStreamingBatchSizeAttr;
 MObject MayaUsdProxyShapeBase::timeAttr;
 MObject MayaUsdProxyShapeBase::complexityAttr;
 MObject MayaUsdProxyShapeBase::inStageDataAttr;
 MObject MayaUsdProxyShapeBase::inStageDataCachedAttr;
+MObject MayaUsdProxyShapeBase::stageLoadedAttr;
 MObject MayaUsdProxyShapeBase::drawRenderPurposeAttr;
 MObject MayaUsdProxyShapeBase::drawProxyPurposeAttr;
 MObject MayaUsdProxyShapeBase::drawGuidePurposeAttr;
@@ -199,6 +217,66 @@ MayaUsdProxyShapeBase::initialize()
     retValue = addAttribute(loadPayloadsAttr);
     CHECK_MSTATUS_AND_RETURN_IT(retValue);
 
+    payloadStreamingAttr = numericAttrFn.create(
+        "payloadStreaming",
+        "pls",
+        MFnNumericData::kBoolean,
+        0.0,
+        &retValue);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    // Internal, so that derived shapes which open their stage outside of
+    // compute can reload it when streaming is turned on or off.
+    numericAttrFn.setInternal(true);
+    numericAttrFn.setKeyable(true);
+    numericAttrFn.setReadable(false);
+    numericAttrFn.setAffectsAppearance(true);
+    retValue = addAttribute(payloadStreamingAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
+    // The maximum number of prims brought in by the streamed payloads, zero
+    // loads every payload.
+    payloadStreamingBudgetAttr = numericAttrFn.create(
+        "payloadStreamingBudget",
+        "plsb",
+        MFnNumericData::kInt,
+        0,
+        &retValue);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    numericAttrFn.setMin(0);
+    numericAttrFn.setReadable(false);
+    retValue = addAttribute(payloadStreamingBudgetAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
+    // The maximum number of payloads loaded, and unloaded, per update.
+    payloadStreamingBatchSizeAttr = numericAttrFn.create(
+        "payloadStreamingBatchSize",
+        "plsbs",
+        MFnNumericData::kInt,
+        16,
+        &retValue);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    numericAttrFn.setMin(1);
+    numericAttrFn.setSoftMax(256);
+    numericAttrFn.setReadable(false);
+    retValue = addAttribute(payloadStreamingBatchSizeAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
+    // Bumped by the stage loader once a stage has been opened in the
+    // background, so that the cached stage data is computed again.
+    stageLoadedAttr = numericAttrFn.create(
+        "stageLoaded",
+        "stld",
+        MFnNumericData::kInt,
+        0,
+        &retValue);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    numericAttrFn.setStorable(false);
+    numericAttrFn.setReadable(false);
+    numericAttrFn.setConnectable(false);
+    numericAttrFn.setHidden(true);
+    retValue = addAttribute(stageLoadedAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
     timeAttr = unitAttrFn.create(
         "time",
         "tm",
@@ -343,6 +421,16 @@ MayaUsdProxyShapeBase::initialize()
     retValue = attributeAffects(loadPayloadsAttr, outStageDataAttr);
     CHECK_MSTATUS_AND_RETURN_IT(retValue);
 
+    retValue = attributeAffects(payloadStreamingAttr, inStageDataCachedAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    retValue = attributeAffects(payloadStreamingAttr, outStageDataAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
+    retValue = attributeAffects(stageLoadedAttr, inStageDataCachedAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+    retValue = attributeAffects(stageLoadedAttr, outStageDataAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(retValue);
+
     retValue = attributeAffects(inStageDataAttr, inStageDataCachedAttr);
     CHECK_MSTATUS_AND_RETURN_IT(retValue);
     retValue = attributeAffects(inStageDataAttr, outStageDataAttr);
@@ -559,27 +647,66 @@ MayaUsdProxyShapeBase::computeInStageDataCached(MDataBlock& dataBlock)
 
         MDataHandle loadPayloadsHandle = dataBlock.inputValue(loadPayloadsAttr, &retValue);
         CHECK_MSTATUS_AND_RETURN_IT(retValue);
-        if (!loadPayloadsHandle.asBool()) {
+        const bool payloadStreaming = _IsPayloadStreaming(dataBlock);
+        if (!loadPayloadsHandle.asBool() || payloadStreaming) {
             loadSet = UsdStage::InitialLoadSet::LoadNone;
         }
+        _EnablePayloadStreamingTimer(payloadStreaming);
+
+        const bool loadAll = (loadSet == UsdStage::InitialLoadSet::LoadAll);
+        SdfLayerRefPtr sessionLayer = computeSessionLayer(dataBlock);
+
+        // A streamed stage starts with no payload loaded, so any previously
+        // streamed stage, whose payloads were loaded by the streamer, is
+        // released rather than reused.
+        _streamedStageCache.Clear();
+        UsdStageCache& stageCache = payloadStreaming
+            ? _streamedStageCache
+            : UsdMayaStageCache::Get(loadAll);
+
+        const MayaUsdProxyShapeStageLoader::Request loadRequest {
+            fileString,
+            sessionLayer,
+            ArGetResolver().GetCurrentContext(),
+            loadSet };
+
+        // Layers which are already open are cheap to compose, so only stages
+        // whose root layer needs to be read from disk are loaded in the
+        // background.
+        if (_stageLoader.IsPending(loadRequest) ||
+                (MayaUsdProxyShapeStageLoader::IsAsyncEnabled() &&
+                 !fileString.empty() &&
+                 !SdfLayer::Find(fileString))) {
+            if (!_stageLoader.IsPending(loadRequest)) {
+                _stageLoader.Load(loadRequest, MPlug(thisMObject(), stageLoadedAttr));
+            }
+
+            if (!_stageLoader.IsLoading()) {
+                usdStage = _stageLoader.TakeStage(stageCache);
+                if (!usdStage) {
+                    UsdStageCacheContext ctx(stageCache);
+                    usdStage = UsdStage::CreateInMemory(kAnonymousLayerName, loadSet);
+                }
+            }
+        }
+        else {
+            _stageLoader.Cancel();
 
-        {
             // When opening or creating stages we must have an active UsdStageCache.
             // The stage cache is the only one who holds a strong reference to the
             // UsdStage. See https://github.com/Autodesk/maya-usd/issues/528 for
             // more information.
-            UsdStageCacheContext ctx(UsdMayaStageCache::Get(loadSet == UsdStage::InitialLoadSet::LoadAll));
+            UsdStageCacheContext ctx(stageCache);
             
             if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(fileString)) {
-                SdfLayerRefPtr sessionLayer = computeSessionLayer(dataBlock);
                 if (sessionLayer) {
                     usdStage = UsdStage::Open(rootLayer,
                             sessionLayer,
-                            ArGetResolver().GetCurrentContext(),
+                            loadRequest.resolverContext,
                             loadSet);
                 } else {
                     usdStage = UsdStage::Open(rootLayer,
-                            ArGetResolver().GetCurrentContext(),
+                            loadRequest.resolverContext,
                             loadSet);
                 }
 
@@ -630,7 +757,16 @@ MayaUsdProxyShapeBase::computeOutStageData(MDataBlock& dataBlock)
     const bool isNormalContext = dataBlock.context().isNormal();
     if(isNormalContext)
     {
+        // Keep reporting the bounds of the previous stage if the new one is
+        // loaded in the background.
+        if (!_boundingBoxCache.empty()) {
+            _loadingBoundingBox = _boundingBoxCache.begin()->second;
+        }
+
         TfReset(_boundingBoxCache);
+        _boundingBoxIsConstant = false;
+        _boundsCache.Clear();
+        _payloadStreamer.Clear();
 
         // Reset the stage listener until we determine that everything is valid.
         _stageNoticeListener.SetStage(UsdStageWeakPtr());
@@ -754,7 +890,7 @@ MayaUsdProxyShapeBase::computeOutputTime(MDataBlock& dataBlock)
 bool
 MayaUsdProxyShapeBase::isBounded() const
 {
-    return isStageValid();
+    return isStageValid() || _stageLoader.IsLoading();
 }
 
 /* virtual */
@@ -783,26 +919,11 @@ MayaUsdProxyShapeBase::boundingBox() const
     dataBlock.inputValue(outStageDataAttr, &status);
     CHECK_MSTATUS_AND_RETURN(status, MBoundingBox());
 
-    // XXX:
-    // If we could cheaply determine whether a stage only has static geometry,
-    // we could make this value a constant one for that case, avoiding the
-    // memory overhead of a cache entry per frame
-    UsdTimeCode currTime = GetOutputTime(dataBlock);
-
-    std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup =
-        _boundingBoxCache.find(currTime);
-
-    if (cacheLookup != _boundingBoxCache.end()) {
-        return cacheLookup->second;
-    }
-
     UsdPrim prim = _GetUsdPrim(dataBlock);
     if (!prim) {
-        return MBoundingBox();
+        return _stageLoader.IsLoading() ? _loadingBoundingBox : MBoundingBox();
     }
 
-    const UsdGeomImageable imageablePrim(prim);
-
     bool drawRenderPurpose = false;
     bool drawProxyPurpose = true;
     bool drawGuidePurpose = false;
@@ -812,20 +933,43 @@ MayaUsdProxyShapeBase::boundingBox() const
         &drawProxyPurpose,
         &drawGuidePurpose);
 
-    const TfToken purpose1 = UsdGeomTokens->default_;
-    const TfToken purpose2 =
-        drawRenderPurpose ? UsdGeomTokens->render : TfToken();
-    const TfToken purpose3 =
-        drawProxyPurpose ? UsdGeomTokens->proxy : TfToken();
-    const TfToken purpose4 =
-        drawGuidePurpose ? UsdGeomTokens->guide : TfToken();
-
-    const GfBBox3d allBox = imageablePrim.ComputeUntransformedBound(
-        currTime,
-        purpose1,
-        purpose2,
-        purpose3,
-        purpose4);
+    TfTokenVector purposes = { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
+
+    nonConstThis->_boundsCache.SetStage(prim.GetStage(), purposes);
+    if (_boundsCache.GetVersion() != _boundingBoxCacheVersion) {
+        TfReset(nonConstThis->_boundingBoxCache);
+        nonConstThis->_boundingBoxIsConstant = false;
+        nonConstThis->_boundingBoxCacheVersion = _boundsCache.GetVersion();
+    }
+
+    UsdTimeCode currTime = GetOutputTime(dataBlock);
+
+    std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup =
+        _boundingBoxIsConstant ?
+            _boundingBoxCache.begin() : _boundingBoxCache.find(currTime);
+
+    if (cacheLookup != _boundingBoxCache.end()) {
+        return cacheLookup->second;
+    }
+
+    const GfBBox3d allBox =
+        nonConstThis->_boundsCache.ComputeUntransformedBound(prim, currTime);
+
+    // Serve a single box for every time code if nothing contributing to the
+    // bounds is animated.
+    if (!_boundsCache.IsTimeVarying(prim.GetPath())) {
+        TfReset(nonConstThis->_boundingBoxCache);
+        nonConstThis->_boundingBoxIsConstant = true;
+    }
 
     MBoundingBox &retval = nonConstThis->_boundingBoxCache[currTime];
 
@@ -849,7 +993,9 @@ MayaUsdProxyShapeBase::boundingBox() const
 void
 MayaUsdProxyShapeBase::clearBoundingBoxCache()
 {
+    _boundsCache.Clear();
     _boundingBoxCache.clear();
+    _boundingBoxIsConstant = false;
 }
 
 bool
@@ -882,9 +1028,12 @@ MayaUsdProxyShapeBase::preEvaluation(const MDGContext& context, const MEvaluatio
         }
         else if (evaluationNode.dirtyPlugExists(outStageDataAttr) ||
             // All the plugs that affect outStageDataAttr
+            evaluationNode.dirtyPlugExists(inStageDataCachedAttr) ||
             evaluationNode.dirtyPlugExists(filePathAttr) ||
             evaluationNode.dirtyPlugExists(primPathAttr) ||
             evaluationNode.dirtyPlugExists(loadPayloadsAttr) ||
+            evaluationNode.dirtyPlugExists(payloadStreamingAttr) ||
+            evaluationNode.dirtyPlugExists(stageLoadedAttr) ||
             evaluationNode.dirtyPlugExists(inStageDataAttr)) {
             _IncreaseUsdStageVersion();
             MayaUsdProxyStageInvalidateNotice(*this).Send();
@@ -930,10 +1079,19 @@ MayaUsdProxyShapeBase::setDependentsDirty(const MPlug& plug, MPlugArray& plugArr
     }
     else if (plug == outStageDataAttr ||
         // All the plugs that affect outStageDataAttr
+        plug == inStageDataCachedAttr ||
         plug == filePathAttr ||
         plug == primPathAttr ||
         plug == loadPayloadsAttr ||
+        plug == payloadStreamingAttr ||
+        plug == stageLoadedAttr ||
         plug == inStageDataAttr) {
+        // A stage loading in the background for the previous file is no longer
+        // needed.
+        if (plug == filePathAttr) {
+            _stageLoader.Cancel();
+        }
+
         _IncreaseUsdStageVersion();
         MayaUsdProxyStageInvalidateNotice(*this).Send();
     }
@@ -1169,6 +1327,119 @@ MayaUsdProxyShapeBase::usdPrim() const
     return _GetUsdPrim( const_cast<MayaUsdProxyShapeBase*>(this)->forceCache() );
 }
 
+bool
+MayaUsdProxyShapeBase::_IsPayloadStreaming(MDataBlock dataBlock) const
+{
+    MStatus status;
+    const bool payloadStreaming =
+        dataBlock.inputValue(payloadStreamingAttr, &status).asBool();
+    CHECK_MSTATUS_AND_RETURN(status, false);
+
+    return payloadStreaming &&
+        (MGlobal::mayaState() == MGlobal::kInteractive ||
+         TfGetEnvSetting(MAYAUSD_PAYLOAD_STREAMING_NON_INTERACTIVE));
+}
+
+void
+MayaUsdProxyShapeBase::updatePayloadStreaming()
+{
+    MDataBlock dataBlock = forceCache();
+    if (!_IsPayloadStreaming(dataBlock)) {
+        return;
+    }
+
+    UsdPrim prim = _GetUsdPrim(dataBlock);
+    if (!prim) {
+        return;
+    }
+
+    MStatus status;
+    M3dView view = M3dView::active3dView(&status);
+    CHECK_MSTATUS(status);
+    MDagPath cameraPath;
+    if (!status || !view.getCamera(cameraPath)) {
+        return;
+    }
+
+    MDagPath shapePath;
+    status = MDagPath::getAPathTo(thisMObject(), shapePath);
+    CHECK_MSTATUS(status);
+
+    // The bounds of the payloads are in the space of the stage, i.e. the local
+    // space of the shape.
+    const MMatrix worldToStage = shapePath.inclusiveMatrixInverse();
+    const MFnCamera cameraFn(cameraPath);
+    const MPoint eye = cameraFn.eyePoint(MSpace::kWorld) * worldToStage;
+    const MVector viewDirection = cameraFn.viewDirection(MSpace::kWorld) * worldToStage;
+
+    MayaUsdProxyShapePayloadStreamer::Camera camera;
+    camera.position = GfVec3d(eye.x, eye.y, eye.z);
+    camera.direction = GfVec3d(viewDirection.x, viewDirection.y, viewDirection.z).GetNormalized();
+    camera.tanHalfFieldOfView = std::tan(0.5 * cameraFn.verticalFieldOfView());
+
+    bool drawRenderPurpose = false;
+    bool drawProxyPurpose = true;
+    bool drawGuidePurpose = false;
+    _GetDrawPurposeToggles(
+        dataBlock,
+        &drawRenderPurpose,
+        &drawProxyPurpose,
+        &drawGuidePurpose);
+
+    TfTokenVector purposes = { UsdGeomTokens->default_ };
+    if (drawRenderPurpose) {
+        purposes.push_back(UsdGeomTokens->render);
+    }
+    if (drawProxyPurpose) {
+        purposes.push_back(UsdGeomTokens->proxy);
+    }
+    if (drawGuidePurpose) {
+        purposes.push_back(UsdGeomTokens->guide);
+    }
+
+    MayaUsdProxyShapePayloadStreamer::Budget budget;
+    budget.primCount = std::max(0,
+        dataBlock.inputValue(payloadStreamingBudgetAttr).asInt());
+    budget.batchSize = std::max(1,
+        dataBlock.inputValue(payloadStreamingBatchSizeAttr).asInt());
+
+    _payloadStreamer.SetStage(prim.GetStage());
+    _payloadStreamer.Update(camera, _GetTime(dataBlock), purposes, budget);
+}
+
+void
+MayaUsdProxyShapeBase::_EnablePayloadStreamingTimer(bool enable)
+{
+    // Only the shapes which stream their payloads pay for the timer.
+    if (enable && !_payloadStreamingCallbackId) {
+        MStatus status;
+        _payloadStreamingCallbackId = MTimerMessage::addTimerCallback(
+                kPayloadStreamingPeriod, _OnPayloadStreamingTimer, this, &status);
+        CHECK_MSTATUS(status);
+    }
+    else if (!enable && _payloadStreamingCallbackId) {
+        MMessage::removeCallback(_payloadStreamingCallbackId);
+        _payloadStreamingCallbackId = 0;
+        _payloadStreamer.Clear();
+    }
+}
+
+void
+MayaUsdProxyShapeBase::_InvalidatePayloadStreaming(const SdfPathVector& resyncedPaths)
+{
+    _payloadStreamer.Invalidate(resyncedPaths);
+}
+
+/* static */
+void
+MayaUsdProxyShapeBase::_OnPayloadStreamingTimer(
+        float /*elapsedTime*/,
+        float /*lastTime*/,
+        void* clientData)
+{
+    static_cast<MayaUsdProxyShapeBase*>(clientData)->updatePayloadStreaming();
+}
+
 MDagPath 
 MayaUsdProxyShapeBase::parentTransform()
 {
@@ -1189,9 +1460,9 @@ MayaUsdProxyShapeBase::MayaUsdProxyShapeBase(const bool enableUfeSelection) :
 /* virtual */
 MayaUsdProxyShapeBase::~MayaUsdProxyShapeBase()
 {
-    //
-    // empty
-    //
+    if (_payloadStreamingCallbackId) {
+        MMessage::removeCallback(_payloadStreamingCallbackId);
+    }
 }
 
 MSelectionMask
@@ -1240,6 +1511,8 @@ MayaUsdProxyShapeBase::_OnStageContentsChanged(
 void 
 MayaUsdProxyShapeBase::_OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice)
 {
+    _InvalidatePayloadStreaming(SdfPathVector(notice.GetResyncedPaths()));
+
     ProxyAccessor::stageChanged(_usdAccessor, thisMObject(), notice);
 }
 
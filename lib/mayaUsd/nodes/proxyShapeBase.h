@@ -23,6 +23,7 @@
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MDGContext.h>
+#include <maya/MMessage.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
@@ -39,6 +40,7 @@
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/notice.h>
 #include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stageCache.h>
 #include <pxr/usd/usd/timeCode.h>
 
 #if defined(WANT_UFE_BUILD)
@@ -57,6 +59,9 @@ constexpr char USD_UFE_SEPARATOR = '/';
 #include <mayaUsd/base/api.h>
 #include <mayaUsd/listeners/stageNoticeListener.h>
 #include <mayaUsd/nodes/proxyAccessor.h>
+#include <mayaUsd/nodes/proxyShapeBoundsCache.h>
+#include <mayaUsd/nodes/proxyShapePayloadStreamer.h>
+#include <mayaUsd/nodes/proxyShapeStageLoader.h>
 #include <mayaUsd/nodes/proxyStageProvider.h>
 #include <mayaUsd/nodes/usdPrimProvider.h>
 
@@ -96,6 +101,12 @@ class MayaUsdProxyShapeBase : public MPxSurfaceShape,
         MAYAUSD_CORE_PUBLIC
         static MObject loadPayloadsAttr;
         MAYAUSD_CORE_PUBLIC
+        static MObject payloadStreamingAttr;
+        MAYAUSD_CORE_PUBLIC
+        static MObject payloadStreamingBudgetAttr;
+        MAYAUSD_CORE_PUBLIC
+        static MObject payloadStreamingBatchSizeAttr;
+        MAYAUSD_CORE_PUBLIC
         static MObject timeAttr;
         MAYAUSD_CORE_PUBLIC
         static MObject complexityAttr;
@@ -104,6 +115,8 @@ class MayaUsdProxyShapeBase : public MPxSurfaceShape,
         MAYAUSD_CORE_PUBLIC
         static MObject inStageDataCachedAttr;
         MAYAUSD_CORE_PUBLIC
+        static MObject stageLoadedAttr;
+        MAYAUSD_CORE_PUBLIC
         static MObject drawRenderPurposeAttr;
         MAYAUSD_CORE_PUBLIC
         static MObject drawProxyPurposeAttr;
@@ -235,6 +248,12 @@ class MayaUsdProxyShapeBase : public MPxSurfaceShape,
         MAYAUSD_CORE_PUBLIC
         void clearBoundingBoxCache();
 
+        /// \brief  Loads and unloads the next batch of payloads for the active
+        ///         camera, if payload streaming is enabled. Called periodically
+        ///         while Maya is idle.
+        MAYAUSD_CORE_PUBLIC
+        void updatePayloadStreaming();
+
         // returns the shape's parent transform
         MAYAUSD_CORE_PUBLIC
         MDagPath parentTransform();
@@ -302,6 +321,22 @@ class MayaUsdProxyShapeBase : public MPxSurfaceShape,
         MAYAUSD_CORE_PUBLIC
         virtual UsdTimeCode GetOutputTime(MDataBlock) const;
 
+        // Returns true if the payloads of the stage are streamed, in which case
+        // the stage should be opened without loading any payload. Streaming
+        // requires an interactive session, since it follows the active camera.
+        MAYAUSD_CORE_PUBLIC
+        bool _IsPayloadStreaming(MDataBlock dataBlock) const;
+
+        // Adds or removes the timer which streams the payloads. Shapes which
+        // do not compute inStageDataCached call it whenever they open a stage.
+        MAYAUSD_CORE_PUBLIC
+        void _EnablePayloadStreamingTimer(bool enable);
+
+        // Forwards the resynced paths of the stage to the payload streamer,
+        // for shapes which listen to the changes of their stage themselves.
+        MAYAUSD_CORE_PUBLIC
+        void _InvalidatePayloadStreaming(const SdfPathVector& resyncedPaths);
+
         MAYAUSD_CORE_PUBLIC
         void _IncreaseExcludePrimPathsVersion() { _excludePrimPathsVersion++; }
 
@@ -331,9 +366,40 @@ class MayaUsdProxyShapeBase : public MPxSurfaceShape,
         void _OnStageObjectsChanged(
             const UsdNotice::ObjectsChanged& notice);
 
+        static void _OnPayloadStreamingTimer(
+                float elapsedTime,
+                float lastTime,
+                void* clientData);
+
         UsdMayaStageNoticeListener _stageNoticeListener;
 
+        // Per-prim bounds, invalidated incrementally as the stage changes.
+        MayaUsdProxyShapeBoundsCache        _boundsCache;
+
+        // Prioritized loading of the payloads of the stage.
+        MayaUsdProxyShapePayloadStreamer    _payloadStreamer;
+
+        // The streamer loads and unloads payloads as the camera moves, which
+        // must not change the load set of the stages of other proxy shapes.
+        // Streamed stages are therefore not shared through UsdMayaStageCache,
+        // but held by a cache of their own.
+        UsdStageCache                       _streamedStageCache;
+        MCallbackId                         _payloadStreamingCallbackId{ 0 };
+
+        // Background load of the stage, when the stage is opened asynchronously.
+        MayaUsdProxyShapeStageLoader        _stageLoader;
+
+        // Bounds reported while the stage is loading in the background, i.e.
+        // the last bounds of the previous stage, if any.
+        MBoundingBox                        _loadingBoundingBox;
+
+        // Bounding boxes of the shape per time code. Shapes whose bounds do
+        // not vary over time hold a single entry used for every time code.
+        // The boxes are invalidated along with the bounds cache they are
+        // computed from, which follows the changes of the stage by itself.
         std::map<UsdTimeCode, MBoundingBox> _boundingBoxCache;
+        bool                                _boundingBoxIsConstant{ false };
+        size_t                              _boundingBoxCacheVersion{ 0 };
         size_t                              _excludePrimPathsVersion{ 1 };
         size_t                              _UsdStageVersion{ 1 };
 
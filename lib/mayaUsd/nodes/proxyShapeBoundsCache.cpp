@@ -0,0 +1,315 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "proxyShapeBoundsCache.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/trace/trace.h>
+#include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usdGeom/boundable.h>
+#include <pxr/usd/usdGeom/imageable.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xformable.h>
+#include <pxr/usd/usdGeom/xformOp.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace {
+
+// Returns true if the bound of the subtree rooted at prim has to be computed
+// by the UsdGeomBBoxCache as a whole instead of being assembled from the
+// cached bounds of its children.
+bool
+_IsLeaf(const UsdPrim& prim)
+{
+    if (prim.IsInstance() || prim.IsA<UsdGeomBoundable>()) {
+        return true;
+    }
+
+    bool hasChildren = false;
+    for (const UsdPrim& child : prim.GetChildren()) {
+        hasChildren = true;
+
+        // Children that reset the transform stack are not bounded in the
+        // space of their parent.
+        const UsdGeomXformable xformable(child);
+        if (xformable && xformable.GetResetXformStack()) {
+            return true;
+        }
+    }
+
+    return !hasChildren;
+}
+
+// Returns true if anything contributing to the bound of the subtree rooted at
+// prim may vary over time.
+bool
+_IsSubtreeTimeVarying(const UsdPrim& prim)
+{
+    TRACE_FUNCTION();
+
+    for (const UsdPrim& descendant :
+            UsdPrimRange(prim, UsdTraverseInstanceProxies())) {
+        const UsdGeomImageable imageable(descendant);
+        if (!imageable) {
+            continue;
+        }
+
+        if (imageable.GetVisibilityAttr().ValueMightBeTimeVarying()) {
+            return true;
+        }
+
+        // The transform of the root is not part of its untransformed bound.
+        const UsdGeomXformable xformable(descendant);
+        if (xformable && descendant != prim &&
+                xformable.TransformMightBeTimeVarying()) {
+            return true;
+        }
+
+        if (descendant.IsA<UsdGeomBoundable>()) {
+            for (const UsdAttribute& attr : descendant.GetAttributes()) {
+                if (attr.ValueMightBeTimeVarying()) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+MayaUsdProxyShapeBoundsCache::MayaUsdProxyShapeBoundsCache()
+    : _bboxCache(UsdTimeCode::Default(), { UsdGeomTokens->default_ })
+{
+    _stageNoticeListener.SetStageObjectsChangedCallback(
+        std::bind(&MayaUsdProxyShapeBoundsCache::_OnStageObjectsChanged,
+                  this,
+                  std::placeholders::_1));
+}
+
+bool
+MayaUsdProxyShapeBoundsCache::SetStage(
+        const UsdStageWeakPtr& stage,
+        const TfTokenVector& includedPurposes)
+{
+    if (stage == _stage &&
+            includedPurposes == _bboxCache.GetIncludedPurposes()) {
+        return false;
+    }
+
+    if (stage != _stage) {
+        _stage = stage;
+        _stageNoticeListener.SetStage(stage);
+    }
+    _bboxCache.SetIncludedPurposes(includedPurposes);
+    Clear();
+    return true;
+}
+
+GfBBox3d
+MayaUsdProxyShapeBoundsCache::ComputeUntransformedBound(
+        const UsdPrim& prim,
+        const UsdTimeCode time)
+{
+    TRACE_FUNCTION();
+
+    if (!prim) {
+        return GfBBox3d();
+    }
+
+    _time = time;
+    _bboxCache.SetTime(time);
+
+    const UsdGeomImageable imageable(prim);
+    const TfToken purpose =
+        imageable ? imageable.ComputePurpose() : UsdGeomTokens->default_;
+
+    return _Resolve(prim, purpose).bound;
+}
+
+bool
+MayaUsdProxyShapeBoundsCache::IsTimeVarying(const SdfPath& path) const
+{
+    const auto it = _entries.find(path);
+    return it == _entries.end() || !it->second.valid || it->second.varying;
+}
+
+void
+MayaUsdProxyShapeBoundsCache::Clear()
+{
+    _entries.clear();
+    _bboxCache.Clear();
+    ++_version;
+}
+
+void
+MayaUsdProxyShapeBoundsCache::_OnStageObjectsChanged(
+        const UsdNotice::ObjectsChanged& notice)
+{
+    if (_entries.empty()) {
+        return;
+    }
+
+    for (const SdfPath& path : notice.GetResyncedPaths()) {
+        if (path.IsPropertyPath()) {
+            _InvalidateProperty(path);
+        } else {
+            _EraseSubtree(path);
+            _EraseAncestors(path);
+        }
+    }
+
+    for (const SdfPath& path : notice.GetChangedInfoOnlyPaths()) {
+        if (path.IsPropertyPath()) {
+            _InvalidateProperty(path);
+        } else {
+            // Prim metadata may be inherited by the whole subtree.
+            _EraseSubtree(path);
+            _EraseAncestors(path);
+        }
+    }
+
+    // The UsdGeomBBoxCache cannot invalidate individual prims. Only the
+    // subtrees whose entries were erased above will be computed again.
+    _bboxCache.Clear();
+    ++_version;
+}
+
+const MayaUsdProxyShapeBoundsCache::_Entry&
+MayaUsdProxyShapeBoundsCache::_Resolve(
+        const UsdPrim& prim,
+        const TfToken& purpose)
+{
+    // std::map references remain valid while children are being inserted.
+    _Entry& entry = _entries[prim.GetPath()];
+    if (entry.valid && (!entry.varying || entry.time == _time)) {
+        return entry;
+    }
+
+    entry.time = _time;
+    entry.valid = true;
+
+    if (_IsLeaf(prim)) {
+        entry.bound = _bboxCache.ComputeUntransformedBound(prim);
+        entry.varying = _IsSubtreeTimeVarying(prim);
+        return entry;
+    }
+
+    const TfTokenVector& includedPurposes = _bboxCache.GetIncludedPurposes();
+
+    GfBBox3d bound;
+    bool varying = false;
+    for (const UsdPrim& child : prim.GetChildren()) {
+        // Only imageable and typeless prims participate in the bound, and
+        // only if they are visible and have one of the included purposes.
+        TfToken childPurpose = purpose;
+        const UsdGeomImageable imageable(child);
+        if (imageable) {
+            const UsdAttribute visibilityAttr = imageable.GetVisibilityAttr();
+            varying |= visibilityAttr.ValueMightBeTimeVarying();
+
+            TfToken visibility;
+            if (visibilityAttr.Get(&visibility, _time) &&
+                    visibility == UsdGeomTokens->invisible) {
+                continue;
+            }
+
+            const UsdAttribute purposeAttr = imageable.GetPurposeAttr();
+            if (purposeAttr.HasAuthoredValue()) {
+                purposeAttr.Get(&childPurpose);
+            }
+        } else if (!child.GetTypeName().IsEmpty()) {
+            continue;
+        }
+
+        if (std::find(
+                includedPurposes.begin(),
+                includedPurposes.end(),
+                childPurpose) == includedPurposes.end()) {
+            continue;
+        }
+
+        const _Entry& childEntry = _Resolve(child, childPurpose);
+        varying |= childEntry.varying;
+
+        GfBBox3d childBound = childEntry.bound;
+        const UsdGeomXformable xformable(child);
+        if (xformable) {
+            varying |= xformable.TransformMightBeTimeVarying();
+
+            GfMatrix4d localXform(1.0);
+            bool resetsXformStack = false;
+            if (xformable.GetLocalTransformation(
+                    &localXform, &resetsXformStack, _time)) {
+                childBound.Transform(localXform);
+            }
+        }
+
+        bound = GfBBox3d::Combine(bound, childBound);
+    }
+
+    entry.bound = bound;
+    entry.varying = varying;
+    return entry;
+}
+
+void
+MayaUsdProxyShapeBoundsCache::_InvalidateProperty(const SdfPath& propertyPath)
+{
+    const SdfPath primPath = propertyPath.GetPrimPath();
+    const TfToken& name = propertyPath.GetNameToken();
+
+    if (UsdGeomXformOp::IsXformOp(name) ||
+            name == UsdGeomTokens->xformOpOrder) {
+        // The prim's own entry does not include its transform.
+        _EraseAncestors(primPath);
+    } else if (name == UsdGeomTokens->visibility ||
+            name == UsdGeomTokens->purpose) {
+        // Inherited by the descendants.
+        _EraseSubtree(primPath);
+        _EraseAncestors(primPath);
+    } else {
+        _entries.erase(primPath);
+        _EraseAncestors(primPath);
+    }
+}
+
+void
+MayaUsdProxyShapeBoundsCache::_EraseSubtree(const SdfPath& path)
+{
+    // Descendants of a path directly follow it in the map ordering.
+    auto it = _entries.lower_bound(path);
+    while (it != _entries.end() && it->first.HasPrefix(path)) {
+        it = _entries.erase(it);
+    }
+}
+
+void
+MayaUsdProxyShapeBoundsCache::_EraseAncestors(const SdfPath& path)
+{
+    for (SdfPath ancestor = path.GetParentPath();
+            !ancestor.IsEmpty();
+            ancestor = ancestor.GetParentPath()) {
+        _entries.erase(ancestor);
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
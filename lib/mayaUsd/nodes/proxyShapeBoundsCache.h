@@ -0,0 +1,115 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_PROXY_SHAPE_BOUNDS_CACHE_H
+#define PXRUSDMAYA_PROXY_SHAPE_BOUNDS_CACHE_H
+
+#include <map>
+
+#include <pxr/pxr.h>
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/timeCode.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
+
+#include <mayaUsd/base/api.h>
+#include <mayaUsd/listeners/stageNoticeListener.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Persistent cache of untransformed prim bounds used by the proxy shape.
+///
+/// The bound of every visited prim is cached in the space of that prim, so
+/// edits only invalidate the entries of the edited prims and their ancestors
+/// instead of the whole cache. Since a prim's own transform is not part of its
+/// untransformed bound, transform edits only invalidate ancestors.
+///
+/// Entries whose subtree has no time-varying bounds, transforms or visibility
+/// are valid for every time code. Subtrees that cannot be assembled from their
+/// children (gprims, point instancers, instances, leaves) are computed with a
+/// UsdGeomBBoxCache.
+///
+/// The cache listens to the UsdNotice::ObjectsChanged notices of its stage and
+/// invalidates itself, so that every proxy shape, whichever way it processes
+/// the notices of its stage, invalidates its bounds once per notice.
+class MayaUsdProxyShapeBoundsCache
+{
+    public:
+        MAYAUSD_CORE_PUBLIC
+        MayaUsdProxyShapeBoundsCache();
+
+        /// Sets the stage and the purposes that bounds are computed for.
+        /// The cache is cleared if either differs from the current ones, in
+        /// which case true is returned.
+        MAYAUSD_CORE_PUBLIC
+        bool SetStage(
+                const UsdStageWeakPtr& stage,
+                const TfTokenVector& includedPurposes);
+
+        /// Returns the untransformed bound of \p prim at \p time, reusing
+        /// any cached entry that is still valid at that time.
+        MAYAUSD_CORE_PUBLIC
+        GfBBox3d ComputeUntransformedBound(
+                const UsdPrim& prim,
+                const UsdTimeCode time);
+
+        /// Returns true if the last bound computed for \p path may vary over
+        /// time, or if there is no cached bound for it.
+        MAYAUSD_CORE_PUBLIC
+        bool IsTimeVarying(const SdfPath& path) const;
+
+        /// Clears all the cached bounds.
+        MAYAUSD_CORE_PUBLIC
+        void Clear();
+
+        /// Returns a number which changes whenever cached bounds are
+        /// invalidated or cleared, so that bounds derived from the cache can
+        /// be invalidated along with it.
+        size_t GetVersion() const { return _version; }
+
+    private:
+        struct _Entry
+        {
+            GfBBox3d    bound;
+            UsdTimeCode time;
+            bool        varying = false;
+            bool        valid = false;
+        };
+
+        const _Entry& _Resolve(const UsdPrim& prim, const TfToken& purpose);
+
+        // Invalidates the entries affected by the paths reported in a
+        // UsdNotice::ObjectsChanged notice.
+        void _OnStageObjectsChanged(const UsdNotice::ObjectsChanged& notice);
+
+        void _InvalidateProperty(const SdfPath& propertyPath);
+        void _EraseSubtree(const SdfPath& path);
+        void _EraseAncestors(const SdfPath& path);
+
+        UsdStageWeakPtr             _stage;
+        UsdTimeCode                 _time;
+        UsdGeomBBoxCache            _bboxCache;
+        std::map<SdfPath, _Entry>   _entries;
+        size_t                      _version{ 0 };
+
+        UsdMayaStageNoticeListener  _stageNoticeListener;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
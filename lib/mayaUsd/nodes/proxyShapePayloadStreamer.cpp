@@ -0,0 +1,353 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "proxyShapePayloadStreamer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#include <pxr/base/gf/bbox3d.h>
+#include <pxr/base/tf/debug.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/primRange.h>
+
+#include <mayaUsd/base/debugCodes.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+MayaUsdProxyShapePayloadStreamer::MayaUsdProxyShapePayloadStreamer() = default;
+
+void
+MayaUsdProxyShapePayloadStreamer::SetStage(const UsdStageWeakPtr& stage)
+{
+    if (stage != _stage) {
+        Clear();
+        _stage = stage;
+    }
+}
+
+void
+MayaUsdProxyShapePayloadStreamer::Invalidate(const SdfPathVector& resyncedPaths)
+{
+    if (resyncedPaths.empty()) {
+        return;
+    }
+
+    // Only keep the roots of the resynced subtrees, which directly precede
+    // their descendants once sorted.
+    SdfPathVector sortedPaths(resyncedPaths);
+    std::sort(sortedPaths.begin(), sortedPaths.end());
+    SdfPathVector roots;
+    for (const SdfPath& path : sortedPaths) {
+        if (roots.empty() || !path.HasPrefix(roots.back())) {
+            roots.push_back(path);
+        }
+    }
+
+    if (roots.front() == SdfPath::AbsoluteRootPath()) {
+        _payloadsValid = false;
+        _dirtyPaths.clear();
+        _bounds.clear();
+        return;
+    }
+
+    // The set of payloads may have changed anywhere below the resynced paths.
+    for (const SdfPath& root : roots) {
+        const SdfPath primPath = root.GetPrimPath();
+        _dirtyPaths.push_back(primPath);
+
+        // The bound of a payload prim covers its descendants, so a resync
+        // invalidates the payloads at or below the path, and above it. The
+        // bounds below a prim path directly follow it.
+        if (root.IsPrimPath()) {
+            const auto first = _bounds.lower_bound(primPath);
+            auto last = first;
+            while (last != _bounds.end() && last->first.HasPrefix(primPath)) {
+                ++last;
+            }
+            _bounds.erase(first, last);
+        }
+        else {
+            _bounds.erase(primPath);
+        }
+
+        for (SdfPath ancestor = primPath.GetParentPath();
+                !ancestor.IsEmpty() && ancestor != SdfPath::AbsoluteRootPath();
+                ancestor = ancestor.GetParentPath()) {
+            _bounds.erase(ancestor);
+        }
+    }
+}
+
+bool
+MayaUsdProxyShapePayloadStreamer::Update(
+        const Camera& camera,
+        const UsdTimeCode time,
+        const TfTokenVector& includedPurposes,
+        const Budget& budget)
+{
+    UsdStageRefPtr stage = _stage;
+    if (!stage) {
+        return false;
+    }
+
+    if (includedPurposes != _boundsPurposes) {
+        _bounds.clear();
+        _boundsPurposes = includedPurposes;
+        _payloadsValid = false;
+    }
+
+    if (!_payloadsValid || !_dirtyPaths.empty()) {
+        _UpdatePayloads(time, includedPurposes);
+    }
+
+    if (_payloads.empty()) {
+        return false;
+    }
+
+    // Prioritize the payloads for the camera.
+    constexpr double kMax = std::numeric_limits<double>::max();
+    for (_Payload& payload : _payloads) {
+        const auto bounds = _bounds.find(payload.path);
+        if (bounds == _bounds.end() || bounds->second.IsEmpty()) {
+            payload.screenSize = 0.0;
+            payload.distance = kMax;
+            continue;
+        }
+
+        const GfVec3d toCenter = bounds->second.GetMidpoint() - camera.position;
+        const double radius = 0.5 * bounds->second.GetSize().GetLength();
+        payload.distance = toCenter.GetLength();
+
+        if (payload.distance <= radius) {
+            // The camera is within the bound.
+            payload.screenSize = kMax;
+        }
+        else if (GfDot(toCenter, camera.direction) < -radius) {
+            // The bound is behind the camera.
+            payload.screenSize = 0.0;
+        }
+        else {
+            payload.screenSize =
+                radius / (payload.distance * camera.tanHalfFieldOfView);
+        }
+    }
+
+    std::sort(_payloads.begin(), _payloads.end(),
+        [](const _Payload& a, const _Payload& b) {
+            if (a.screenSize != b.screenSize) {
+                return a.screenSize > b.screenSize;
+            }
+            if (a.distance != b.distance) {
+                return a.distance < b.distance;
+            }
+            // Keep the order of equal payloads stable across updates.
+            return a.path < b.path;
+        });
+
+    // The payloads that fit in the budget, in priority order.
+    size_t numWanted = _payloads.size();
+    if (budget.primCount > 0) {
+        size_t primCount = 0;
+        for (size_t i = 0; i < _payloads.size(); ++i) {
+            primCount += _GetCost(_payloads[i].path);
+            if (primCount > budget.primCount) {
+                numWanted = i;
+                break;
+            }
+        }
+    }
+
+    const size_t batchSize = std::max<size_t>(budget.batchSize, 1);
+
+    SdfPathSet wanted;
+    SdfPathSet loadSet;
+    for (size_t i = 0; i < numWanted; ++i) {
+        wanted.insert(_payloads[i].path);
+        if (!_payloads[i].loaded && loadSet.size() < batchSize) {
+            loadSet.insert(_payloads[i].path);
+        }
+    }
+
+    // Unload the lowest priority payloads first, but keep the ancestors of the
+    // wanted payloads, which would otherwise be unloaded with them.
+    SdfPathSet unloadSet;
+    for (size_t i = _payloads.size(); i > numWanted && unloadSet.size() < batchSize; --i) {
+        const _Payload& payload = _payloads[i - 1];
+        if (!payload.loaded) {
+            continue;
+        }
+
+        const auto descendant = wanted.lower_bound(payload.path);
+        if (descendant != wanted.end() && descendant->HasPrefix(payload.path)) {
+            continue;
+        }
+
+        unloadSet.insert(payload.path);
+    }
+
+    if (loadSet.empty() && unloadSet.empty()) {
+        return false;
+    }
+
+    TF_DEBUG(USDMAYA_PROXYSHAPEBASE).Msg(
+        "ProxyShapePayloadStreamer::Update loading %zu and unloading %zu "
+        "payloads of %zu\n",
+        loadSet.size(), unloadSet.size(), _payloads.size());
+
+    // Nested payloads are prioritized on their own, once their parent is
+    // loaded.
+    stage->LoadAndUnload(loadSet, unloadSet, UsdLoadWithoutDescendants);
+
+    for (const SdfPath& path : loadSet) {
+        _MeasureCost(path);
+    }
+
+    // The stage listener normally invalidates the payloads from the resync
+    // notices, but the nested payloads of the loaded payloads must be found,
+    // and those of the unloaded ones forgotten, in any case.
+    _dirtyPaths.insert(_dirtyPaths.end(), loadSet.begin(), loadSet.end());
+    _dirtyPaths.insert(_dirtyPaths.end(), unloadSet.begin(), unloadSet.end());
+
+    return true;
+}
+
+void
+MayaUsdProxyShapePayloadStreamer::Clear()
+{
+    _stage = UsdStageWeakPtr();
+    _payloads.clear();
+    _payloadsValid = false;
+    _dirtyPaths.clear();
+    _bounds.clear();
+    _costs.clear();
+    _boundsPurposes.clear();
+}
+
+void
+MayaUsdProxyShapePayloadStreamer::_UpdatePayloads(
+        const UsdTimeCode time,
+        const TfTokenVector& includedPurposes)
+{
+    UsdStageRefPtr stage = _stage;
+
+    // Bounds are only computed for new payloads, and use the extents hints
+    // since unloaded payload prims have no descendants to compute them from.
+    UsdGeomBBoxCache bboxCache(time, includedPurposes, /*useExtentsHint*/ true);
+
+    if (!_payloadsValid) {
+        const SdfPathSet loadable = stage->FindLoadable();
+        _payloads.clear();
+        _payloads.reserve(loadable.size());
+        _AddPayloads(loadable, bboxCache);
+        _dirtyPaths.clear();
+        _payloadsValid = true;
+        return;
+    }
+
+    // Only keep the roots of the dirty subtrees, which directly precede
+    // their descendants once sorted.
+    std::sort(_dirtyPaths.begin(), _dirtyPaths.end());
+    SdfPathSet dirtyRoots;
+    for (const SdfPath& path : _dirtyPaths) {
+        if (dirtyRoots.empty() || !path.HasPrefix(*dirtyRoots.rbegin())) {
+            dirtyRoots.insert(path);
+        }
+    }
+    _dirtyPaths.clear();
+
+    TF_DEBUG(USDMAYA_PROXYSHAPEBASE).Msg(
+        "ProxyShapePayloadStreamer::_UpdatePayloads searching %zu subtrees\n",
+        dirtyRoots.size());
+
+    // Forget the payloads in the dirty subtrees, then find them again.
+    const auto isDirty = [&dirtyRoots](const _Payload& payload) {
+        const auto root = dirtyRoots.upper_bound(payload.path);
+        return root != dirtyRoots.begin() &&
+            payload.path.HasPrefix(*std::prev(root));
+    };
+    _payloads.erase(
+        std::remove_if(_payloads.begin(), _payloads.end(), isDirty),
+        _payloads.end());
+
+    for (const SdfPath& root : dirtyRoots) {
+        // The root may have been removed, or may be below an unloaded payload.
+        if (stage->GetPrimAtPath(root)) {
+            _AddPayloads(stage->FindLoadable(root), bboxCache);
+        }
+    }
+}
+
+void
+MayaUsdProxyShapePayloadStreamer::_AddPayloads(
+        const SdfPathSet& loadable,
+        UsdGeomBBoxCache& bboxCache)
+{
+    UsdStageRefPtr stage = _stage;
+    for (const SdfPath& path : loadable) {
+        const UsdPrim prim = stage->GetPrimAtPath(path);
+        if (_bounds.find(path) == _bounds.end()) {
+            GfRange3d bounds;
+            if (prim) {
+                bounds = bboxCache.ComputeWorldBound(prim).ComputeAlignedRange();
+
+                // Without an extents hint, an unloaded payload has no bound,
+                // so fall back to the bound of its nearest ancestor that has
+                // one.
+                for (UsdPrim parent = prim.GetParent();
+                        bounds.IsEmpty() && parent && !parent.IsPseudoRoot();
+                        parent = parent.GetParent()) {
+                    bounds = bboxCache.ComputeWorldBound(parent).ComputeAlignedRange();
+                }
+            }
+            _bounds.emplace(path, bounds);
+        }
+
+        _payloads.push_back({ path, 0.0, 0.0, prim && prim.IsLoaded() });
+    }
+}
+
+size_t
+MayaUsdProxyShapePayloadStreamer::_GetCost(const SdfPath& path) const
+{
+    const auto it = _costs.find(path);
+    return it != _costs.end() ? it->second : 1;
+}
+
+void
+MayaUsdProxyShapePayloadStreamer::_MeasureCost(const SdfPath& path)
+{
+    UsdStageRefPtr stage = _stage;
+    const UsdPrim prim = stage->GetPrimAtPath(path);
+    if (!prim) {
+        return;
+    }
+
+    size_t primCount = 0;
+    UsdPrimRange range(prim);
+    for (auto it = range.begin(); it != range.end(); ++it) {
+        ++primCount;
+
+        // Nested payloads are streamed, and counted, separately.
+        if (*it != prim && it->HasAuthoredPayloads()) {
+            it.PruneChildren();
+        }
+    }
+
+    _costs[path] = primCount;
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,140 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_PROXY_SHAPE_PAYLOAD_STREAMER_H
+#define PXRUSDMAYA_PROXY_SHAPE_PAYLOAD_STREAMER_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <pxr/pxr.h>
+#include <pxr/base/gf/range3d.h>
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/timeCode.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
+
+#include <mayaUsd/base/api.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Loads and unloads the payloads of a stage in order of priority, under a
+/// budget.
+///
+/// The priority of a payload is the screen-space size of its bound from the
+/// camera, then its distance to the camera, then its path. Payloads without
+/// an extents hint use the bound of their nearest ancestor that has one. Payloads are loaded in priority
+/// order until the budget is reached, and the loaded payloads beyond the
+/// budget are unloaded, lowest priority first. Each call to Update() changes
+/// at most one batch of payloads, with a single call to
+/// UsdStage::LoadAndUnload() so the stage is recomposed once per batch.
+///
+/// The cost of a payload is the number of prims it brings in, which is only
+/// known once it has been loaded. Payloads which have never been loaded count
+/// as a single prim.
+///
+/// The whole stage is only searched for payloads the first time. After that,
+/// only the subtrees of the resynced paths and of the payloads that were just
+/// loaded or unloaded are searched again.
+class MayaUsdProxyShapePayloadStreamer
+{
+    public:
+        /// The camera that payloads are prioritized for, in stage space.
+        struct Camera
+        {
+            GfVec3d position;
+            GfVec3d direction;
+            double tanHalfFieldOfView;
+        };
+
+        /// The limits of the streaming. A zero budget loads every payload.
+        struct Budget
+        {
+            size_t primCount;
+            size_t batchSize;
+        };
+
+        MAYAUSD_CORE_PUBLIC
+        MayaUsdProxyShapePayloadStreamer();
+
+        /// Sets the stage to stream the payloads of. Everything known about
+        /// the previous stage is discarded if it differs.
+        MAYAUSD_CORE_PUBLIC
+        void SetStage(const UsdStageWeakPtr& stage);
+
+        /// Updates the payloads affected by the resynced paths of a
+        /// UsdNotice::ObjectsChanged notice on the next call to Update().
+        MAYAUSD_CORE_PUBLIC
+        void Invalidate(const SdfPathVector& resyncedPaths);
+
+        /// Loads and unloads the next batch of payloads. The bounds of new
+        /// payloads are computed at \p time. Returns true if the load state
+        /// of the stage changed.
+        MAYAUSD_CORE_PUBLIC
+        bool Update(
+                const Camera& camera,
+                const UsdTimeCode time,
+                const TfTokenVector& includedPurposes,
+                const Budget& budget);
+
+        /// Forgets the stage and everything known about its payloads.
+        MAYAUSD_CORE_PUBLIC
+        void Clear();
+
+    private:
+        struct _Payload
+        {
+            SdfPath path;
+            double screenSize;
+            double distance;
+            bool loaded;
+        };
+
+        void _UpdatePayloads(
+                const UsdTimeCode time,
+                const TfTokenVector& includedPurposes);
+        void _AddPayloads(
+                const SdfPathSet& loadable,
+                UsdGeomBBoxCache& bboxCache);
+        size_t _GetCost(const SdfPath& path) const;
+        void _MeasureCost(const SdfPath& path);
+
+        UsdStageWeakPtr                   _stage;
+        std::vector<_Payload>             _payloads;
+        bool                              _payloadsValid{ false };
+
+        // Roots of the subtrees to search for payloads again, while
+        // _payloadsValid is true.
+        SdfPathVector                     _dirtyPaths;
+
+        // Bounds of the payload prims in stage space, kept across updates
+        // since they are only invalidated by resyncs. Ordered so that the
+        // bounds of a resynced subtree form a single range.
+        std::map<SdfPath, GfRange3d>      _bounds;
+
+        // Number of prims brought in by each payload the last time it was
+        // loaded.
+        std::unordered_map<SdfPath, size_t, SdfPath::Hash>    _costs;
+
+        // Purposes the bounds were computed for.
+        TfTokenVector                     _boundsPurposes;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
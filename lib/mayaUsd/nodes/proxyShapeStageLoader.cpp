@@ -0,0 +1,217 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "proxyShapeStageLoader.h"
+
+#include <atomic>
+
+#include <maya/M3dView.h>
+#include <maya/MDagPath.h>
+#include <maya/MGlobal.h>
+#include <maya/MObjectHandle.h>
+#include <maya/MPlug.h>
+
+#include <pxr/base/tf/debug.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/work/detachedTask.h>
+
+#include <mayaUsd/base/debugCodes.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(MAYAUSD_ASYNC_STAGE_LOAD, false,
+    "Open the stages of proxy shapes on a background thread in interactive "
+    "sessions.");
+
+TF_DEFINE_ENV_SETTING(MAYAUSD_ASYNC_STAGE_LOAD_NON_INTERACTIVE, false,
+    "Also open the stages of proxy shapes on a background thread in batch and "
+    "mayapy sessions, when MAYAUSD_ASYNC_STAGE_LOAD is set. Nothing dirties "
+    "the shapes once their stage is loaded, so this is meant for tests.");
+
+struct MayaUsdProxyShapeStageLoader::_Load
+{
+    Request request;
+    MObjectHandle node;
+    MObject loadedAttr;
+
+    std::atomic<bool> cancelled{ false };
+    std::atomic<bool> done{ false };
+
+    // Written by the worker thread before done is set.
+    UsdStageRefPtr stage;
+};
+
+bool
+MayaUsdProxyShapeStageLoader::Request::operator==(const Request& other) const
+{
+    return filePath == other.filePath &&
+        sessionLayer == other.sessionLayer &&
+        resolverContext == other.resolverContext &&
+        loadSet == other.loadSet;
+}
+
+MayaUsdProxyShapeStageLoader::~MayaUsdProxyShapeStageLoader()
+{
+    Cancel();
+}
+
+/* static */
+bool
+MayaUsdProxyShapeStageLoader::IsAsyncEnabled()
+{
+    return TfGetEnvSetting(MAYAUSD_ASYNC_STAGE_LOAD) &&
+        (MGlobal::mayaState() == MGlobal::kInteractive ||
+         TfGetEnvSetting(MAYAUSD_ASYNC_STAGE_LOAD_NON_INTERACTIVE));
+}
+
+void
+MayaUsdProxyShapeStageLoader::Load(const Request& request, const MPlug& loadedPlug)
+{
+    Cancel();
+
+    TF_DEBUG(USDMAYA_PROXYSHAPEBASE).Msg(
+        "ProxyShapeStageLoader::Load started loading %s in the background\n",
+        request.filePath.c_str());
+
+    _load = std::make_shared<_Load>();
+    _load->request = request;
+    _load->node = loadedPlug.node();
+    _load->loadedAttr = loadedPlug.attribute();
+
+    std::shared_ptr<_Load> load = _load;
+    WorkRunDetachedTask([load]() { _Run(load); });
+}
+
+bool
+MayaUsdProxyShapeStageLoader::IsPending(const Request& request) const
+{
+    return _load && _load->request == request;
+}
+
+bool
+MayaUsdProxyShapeStageLoader::IsLoading() const
+{
+    return _load && !_load->done;
+}
+
+UsdStageRefPtr
+MayaUsdProxyShapeStageLoader::TakeStage(UsdStageCache& stageCache)
+{
+    if (!_load || !_load->done) {
+        return nullptr;
+    }
+
+    UsdStageRefPtr stage = std::move(_load->stage);
+    const Request request = std::move(_load->request);
+
+    // The stage may be taken before the completion is processed on idle, in
+    // which case there is no need to dirty the shape anymore.
+    Cancel();
+
+    if (!stage) {
+        return nullptr;
+    }
+
+    // Another proxy shape may have opened the same layers while this stage was
+    // loading. Share its stage, like UsdStage::Open() does with an active
+    // UsdStageCacheContext.
+    const UsdStageRefPtr cachedStage = request.sessionLayer ?
+        stageCache.FindOneMatching(
+            stage->GetRootLayer(), request.sessionLayer, request.resolverContext) :
+        stageCache.FindOneMatching(
+            stage->GetRootLayer(), request.resolverContext);
+    if (cachedStage) {
+        return cachedStage;
+    }
+
+    stageCache.Insert(stage);
+    stage->SetEditTarget(stage->GetRootLayer());
+    return stage;
+}
+
+void
+MayaUsdProxyShapeStageLoader::Cancel()
+{
+    if (_load) {
+        _load->cancelled = true;
+        _load.reset();
+    }
+}
+
+/* static */
+void
+MayaUsdProxyShapeStageLoader::_Run(const std::shared_ptr<_Load>& load)
+{
+    if (!load->cancelled) {
+        const Request& request = load->request;
+        if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(request.filePath)) {
+            // Opening the root layer can take a while, so check again before
+            // composing the stage.
+            if (!load->cancelled) {
+                load->stage = request.sessionLayer ?
+                    UsdStage::Open(rootLayer,
+                            request.sessionLayer,
+                            request.resolverContext,
+                            request.loadSet) :
+                    UsdStage::Open(rootLayer,
+                            request.resolverContext,
+                            request.loadSet);
+            }
+        }
+    }
+
+    load->done = true;
+
+    if (!load->cancelled) {
+        MGlobal::executeTaskOnIdle(
+            &MayaUsdProxyShapeStageLoader::_OnLoaded,
+            new std::shared_ptr<_Load>(load));
+    }
+}
+
+/* static */
+void
+MayaUsdProxyShapeStageLoader::_OnLoaded(void* data)
+{
+    const std::unique_ptr<std::shared_ptr<_Load>> load(
+        static_cast<std::shared_ptr<_Load>*>(data));
+
+    // The shape may have been deleted, or may have requested another stage
+    // while this one was loading.
+    if ((*load)->cancelled || !(*load)->node.isValid()) {
+        return;
+    }
+
+    MDagPath dagPath;
+    if (!MDagPath::getAPathTo((*load)->node.object(), dagPath)) {
+        return;
+    }
+
+    TF_DEBUG(USDMAYA_PROXYSHAPEBASE).Msg(
+        "ProxyShapeStageLoader::_OnLoaded finished loading %s for %s\n",
+        (*load)->request.filePath.c_str(),
+        dagPath.fullPathName().asChar());
+
+    // Bump the loaded plug, which dirties the cached stage data so that the
+    // stage is picked up by the next compute, then redraw the viewports.
+    MPlug loadedPlug((*load)->node.object(), (*load)->loadedAttr);
+    loadedPlug.setInt(loadedPlug.asInt() + 1);
+
+    if (MGlobal::mayaState() == MGlobal::kInteractive) {
+        M3dView::scheduleRefreshAllViews();
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,114 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_PROXY_SHAPE_STAGE_LOADER_H
+#define PXRUSDMAYA_PROXY_SHAPE_STAGE_LOADER_H
+
+#include <memory>
+#include <string>
+
+#include <maya/MPlug.h>
+
+#include <pxr/pxr.h>
+#include <pxr/usd/ar/resolverContext.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/stageCache.h>
+
+#include <mayaUsd/base/api.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/// Opens the stage of a proxy shape on a background thread.
+///
+/// Opening the root layer and composing the stage are done by a detached
+/// task on the Work thread pool, so that several proxy shapes load in
+/// parallel and the UI stays responsive. When the load completes, a plug of
+/// the shape which affects its cached stage data is incremented on the main
+/// thread, and the next compute of the stage data takes the loaded stage with
+/// TakeStage().
+///
+/// A load can not be interrupted once UsdStage::Open() has started, but the
+/// result of a cancelled load is discarded.
+class MayaUsdProxyShapeStageLoader
+{
+    public:
+        /// The inputs of a stage load. Two loads of equal requests produce
+        /// the same stage.
+        struct Request
+        {
+            std::string filePath;
+            SdfLayerRefPtr sessionLayer;
+            ArResolverContext resolverContext;
+            UsdStage::InitialLoadSet loadSet;
+
+            MAYAUSD_CORE_PUBLIC
+            bool operator==(const Request& other) const;
+        };
+
+        MayaUsdProxyShapeStageLoader() = default;
+
+        MAYAUSD_CORE_PUBLIC
+        ~MayaUsdProxyShapeStageLoader();
+
+        /// Returns true if stages should be opened in the background. This
+        /// requires the MAYAUSD_ASYNC_STAGE_LOAD env setting, and an
+        /// interactive session: batch and mayapy sessions open stages
+        /// synchronously, since nothing would process the completion, unless
+        /// the MAYAUSD_ASYNC_STAGE_LOAD_NON_INTERACTIVE env setting is set.
+        MAYAUSD_CORE_PUBLIC
+        static bool IsAsyncEnabled();
+
+        /// Starts loading the stage of \p request in the background, and
+        /// cancels any other pending load. \p loadedPlug is an int plug of
+        /// the proxy shape, incremented once the stage is loaded to dirty the
+        /// plugs it affects.
+        MAYAUSD_CORE_PUBLIC
+        void Load(const Request& request, const MPlug& loadedPlug);
+
+        /// Returns true if a load of \p request has been started and its
+        /// stage has not been taken yet.
+        MAYAUSD_CORE_PUBLIC
+        bool IsPending(const Request& request) const;
+
+        /// Returns true if a load has been started and has not completed yet.
+        MAYAUSD_CORE_PUBLIC
+        bool IsLoading() const;
+
+        /// Returns the stage of the completed load, or nullptr if the load is
+        /// still running or the root layer could not be opened. The stage is
+        /// added to \p stageCache, unless the cache already holds a stage
+        /// opened from the same layers, in which case that stage is returned
+        /// instead. The pending load is cleared in both cases.
+        /// Must be called on the main thread.
+        MAYAUSD_CORE_PUBLIC
+        UsdStageRefPtr TakeStage(UsdStageCache& stageCache);
+
+        /// Cancels the pending load, if any.
+        MAYAUSD_CORE_PUBLIC
+        void Cancel();
+
+    private:
+        struct _Load;
+
+        static void _Run(const std::shared_ptr<_Load>& load);
+        static void _OnLoaded(void* data);
+
+        std::shared_ptr<_Load> _load;
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -28,6 +28,8 @@
 #include <pxr/imaging/hd/mesh.h>
 #include <pxr/usd/usd/timeCode.h>
 
+#include "resource_registry.h"
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 class HdVP2RenderDelegate;
@@ -55,6 +57,9 @@ public:
         PrimvarBufferMap                            _primvarBuffers;
         //! Render item index buffer - use when updating data
         std::unique_ptr<MHWRender::MIndexBuffer>    _indexBuffer;
+        //! Index buffer shared with the render items of the same topology and
+        //! geometry style. Used instead of _indexBuffer when valid.
+        HdVP2SharedIndexBufferPtr                   _sharedIndexBuffer;
         //! Bounding box of the render item.
         MBoundingBox                                _boundingBox;
         //! World matrix of the render item.
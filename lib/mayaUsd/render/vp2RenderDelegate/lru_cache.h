@@ -0,0 +1,150 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_LRU_CACHE
+#define HD_VP2_LRU_CACHE
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include <pxr/pxr.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+/*! \brief  Values shared by key, released in least recently used order
+            once their memory exceeds a budget.
+    \class  HdVP2LruCache
+
+    Values are shared with their users through shared pointers, and a value
+    is only released once the cache holds the last reference to it. A value
+    is loading until its size is set with SetLoaded(), and is never released
+    before. A value that failed to load is erased, so that the next use
+    inserts and loads it again.
+
+    The budget is enforced whenever a value is inserted or loaded. Not thread
+    safe, accesses are serialized by the owner.
+*/
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class HdVP2LruCache final
+{
+public:
+    using ValueSharedPtr = std::shared_ptr<Value>;
+
+    explicit HdVP2LruCache(size_t budgetBytes) : _budgetBytes(budgetBytes) {}
+
+    //! Returns the value of the key and marks it as most recently used,
+    //! or a null pointer if the key is not cached.
+    ValueSharedPtr Find(const Key& key)
+    {
+        const auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            return ValueSharedPtr();
+        }
+        _lru.splice(_lru.begin(), _lru, it->second._lruIt);
+        return it->second._value;
+    }
+
+    //! Inserts a new loading value for a key not cached yet, as most recently
+    //! used. Unused values are released first if the cache exceeds its budget.
+    ValueSharedPtr Insert(const Key& key)
+    {
+        _EvictUnused();
+
+        Entry& entry = _entries[key];
+        entry._value = std::make_shared<Value>();
+        _lru.push_front(key);
+        entry._lruIt = _lru.begin();
+        return entry._value;
+    }
+
+    //! Sets the memory used by the loaded value of the key, then releases
+    //! unused values if the cache exceeds its budget. Returns false if the key
+    //! is not cached.
+    bool SetLoaded(const Key& key, size_t bytes)
+    {
+        const auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            return false;
+        }
+
+        Entry& entry = it->second;
+        _totalBytes -= entry._bytes;
+        entry._bytes = bytes;
+        entry._isLoaded = true;
+        _totalBytes += entry._bytes;
+
+        _EvictUnused();
+        return true;
+    }
+
+    //! Erases the key, whether or not its value is still used.
+    void Erase(const Key& key)
+    {
+        const auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            _totalBytes -= it->second._bytes;
+            _lru.erase(it->second._lruIt);
+            _entries.erase(it);
+        }
+    }
+
+    //! Number of cached values
+    size_t GetSize() const { return _entries.size(); }
+
+    //! Memory used by the loaded values
+    size_t GetTotalBytes() const { return _totalBytes; }
+
+private:
+    //! Cache entry
+    struct Entry
+    {
+        ValueSharedPtr                      _value;             //!< Value shared with the users
+        size_t                              _bytes{0};          //!< Memory used by the value once loaded
+        bool                                _isLoaded{false};   //!< Whether the value is loaded
+        typename std::list<Key>::iterator   _lruIt;             //!< Position in the LRU list
+    };
+
+    //! Releases the least recently used values which are loaded and not used
+    //! anymore, until the cache fits in its budget.
+    void _EvictUnused()
+    {
+        auto it = _lru.end();
+        while (_totalBytes > _budgetBytes && it != _lru.begin()) {
+            --it;
+
+            const auto entryIt = _entries.find(*it);
+            const Entry& entry = entryIt->second;
+            if (entry._value.use_count() > 1 || !entry._isLoaded) {
+                continue;
+            }
+
+            _totalBytes -= entry._bytes;
+            _entries.erase(entryIt);
+            it = _lru.erase(it);
+        }
+    }
+
+    std::unordered_map<Key, Entry, Hash>    _entries;       //!< Cached values
+    std::list<Key>                          _lru;           //!< Keys from most to least recently used
+    size_t                                  _totalBytes{0}; //!< Memory used by the loaded values
+    const size_t                            _budgetBytes;   //!< Memory budget of the cache
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
@@ -36,18 +36,11 @@
 #include <pxr/base/gf/vec3f.h>
 #include <pxr/base/gf/vec4f.h>
 #include <pxr/base/tf/diagnostic.h>
-#include <pxr/imaging/glf/image.h>
-#if USD_VERSION_NUM >= 2002
-#include <pxr/imaging/glf/udimTexture.h>
-#endif
 #include <pxr/imaging/hd/sceneDelegate.h>
 #include <pxr/usd/ar/packageUtils.h>
 #include <pxr/usd/sdf/assetPath.h>
 #include <pxr/usd/usdHydra/tokens.h>
 #include <pxr/usdImaging/usdImaging/tokens.h>
-#if USD_VERSION_NUM >= 2002
-#include <pxr/usdImaging/usdImaging/textureUtils.h>
-#endif
 #include "debugCodes.h"
 #include "render_delegate.h"
 
@@ -60,6 +53,7 @@ TF_DEFINE_PRIVATE_TOKENS(
 
     (file)
     (opacity)
+    (sourceColorSpace)
     (st)
     (varname)
 
@@ -296,230 +290,21 @@ MHWRender::MSamplerStateDesc _GetSamplerStateDesc(const HdMaterialNode& node)
     return desc;
 }
 
-#if USD_VERSION_NUM >= 2002
-MHWRender::MTexture* _LoadUdimTexture(
-    const std::string& path, bool& isColorSpaceSRGB, MFloatArray& uvScaleOffset)
+//! Get the source color space of a texture node, which may override the
+//! color space of the image.
+TfToken _GetSourceColorSpace(const HdMaterialNode& node)
 {
-    /*
-        For this method to work path needs to be an absolute file path, not an asset path.
-        That means that this function depends on the changes in 4e426565 to materialAdapther.cpp
-        to work. As of my writing this 4e426565 is not in the USD that MayaUSD normally builds
-        against so this code will fail, because UsdImaging_GetUdimTiles won't file the tiles
-        because we don't know where on disk to look for them.
-
-        https://github.com/PixarAnimationStudios/USD/commit/4e42656543f4e3a313ce31a81c27477d4dcb64b9
-    */
-
-    // test for a UDIM texture
-    if (!GlfIsSupportedUdimTexture(path))
-        return nullptr;
-    
-    /*
-        Maya's tiled texture support is implemented quite differently from Usd's UDIM support.
-        In Maya the texture tiles get combined into a single big texture, downscaling each tile
-        if necessary, and filling in empty regions of a non-square tile with the undefined color.
-
-        In USD the UDIM textures are stored in a texture array that the shader uses to draw.
-    */
-
-    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr =
-        renderer ? renderer->getTextureManager() : nullptr;
-    if (!TF_VERIFY(textureMgr)) {
-        return nullptr;
-    }
-
-    // HdSt sets the tile limit to the max number of textures in an array of 2d textures. OpenGL says
-    // the minimum number of layers in 2048 so I'll use that.
-    int tileLimit = 2048;
-    std::vector<std::tuple<int, TfToken>> tiles = UsdImaging_GetUdimTiles(path, tileLimit);
-    if (tiles.size() == 0)
-    {
-        TF_WARN("Unable to find UDIM tiles for %s", path.c_str());
-        return nullptr;
-    }
-
-    // I don't think there is a downside to setting a very high limit.
-    // Maya will clamp the texture size to the VP2 texture clamp resolution and the hardware's
-    // max texture size. And Maya doesn't make the tiled texture unnecessarily large. When I 
-    // try loading two 1k textures I end up with a tiled texture that is 2k x 1k.
-    unsigned int maxWidth = 0;
-    unsigned int maxHeight = 0;
-    renderer->GPUmaximumOutputTargetSize(maxWidth, maxHeight);
-
-    // Open the first image and get it's resolution. Assuming that all the tiles have the same
-    // resolution, warn the user if Maya's tiled texture implementation is going to result in
-    // a loss of texture data.
-    {
-        GlfImageSharedPtr image = GlfImage::OpenForReading(std::get<1>(tiles[0]).GetString());
-        if (!TF_VERIFY(image)) {
-            return nullptr;
-        }
-        isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        unsigned int tileWidth = image->GetWidth();
-        unsigned int tileHeight = image->GetHeight();
-
-        int maxTileId = std::get<0>(tiles.back());
-        int maxU = maxTileId % 10;
-        int maxV = (maxTileId - maxU) / 10;
-        if ((tileWidth * maxU > maxWidth) || (tileHeight * maxV > maxHeight))
-            TF_WARN("UDIM texture %s creates a tiled texture larger than the maximum texture size. Some"
-                "resolution will be lost.", path.c_str());
-    }
-
-    MString textureName(path.c_str()); // used for caching, using the string with <UDIM> in it is fine
-    MStringArray tilePaths;
-    MFloatArray tilePositions;
-    for(auto& tile : tiles)
-    {
-        tilePaths.append(MString(std::get<1>(tile).GetText()));
-
-        GlfImageSharedPtr image = GlfImage::OpenForReading(std::get<1>(tile).GetString());
-        if (!TF_VERIFY(image)) {
-            return nullptr;
-        }
-        if (isColorSpaceSRGB != image->IsColorSpaceSRGB())
-        {
-            TF_WARN("UDIM texture %s color space doesn't match %s color space",
-                std::get<1>(tile).GetText(), std::get<1>(tiles[0]).GetText());
-        }
-
-        // The image labeled 1001 will have id 0, 1002 will have id 1, 1011 will have id 10.
-        // image 1001 starts with UV (0.0f, 0.0f), 1002 is (1.0f, 0.0f) and 1011 is (0.0f, 1.0f)
-        int tileId = std::get<0>(tile);
-        float u = (float)(tileId % 10);
-        float v = (float)((tileId - u) / 10);
-        tilePositions.append(u);
-        tilePositions.append(v);
-    }
-
-    MColor undefinedColor(0.0f, 1.0f, 0.0f, 1.0f);
-    MStringArray failedTilePaths;
-    MHWRender::MTexture* texture = textureMgr->acquireTiledTexture(
-        textureName,
-        tilePaths,
-        tilePositions,
-        undefinedColor,
-        maxWidth, maxHeight,
-        failedTilePaths,
-        uvScaleOffset
-    );
-
-    for(unsigned int i=0; i<failedTilePaths.length(); i++)
-    {
-        TF_WARN("Failed to load <UDIM> texture tile %s", failedTilePaths[i].asChar());
-    }
-
-    return texture;
-}
-#endif
-
-//! Load texture from the specified path
-MHWRender::MTexture* _LoadTexture(
-    const std::string& path,
-    bool& isColorSpaceSRGB,
-    MFloatArray& uvScaleOffset)
-{
-#if USD_VERSION_NUM >= 2002
-    // If it is a UDIM texture we need to modify the path before calling OpenForReading
-    if (GlfIsSupportedUdimTexture(path))
-        return _LoadUdimTexture(path, isColorSpaceSRGB, uvScaleOffset);
-#endif
-
-    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr =
-        renderer ? renderer->getTextureManager() : nullptr;
-    if (!TF_VERIFY(textureMgr)) {
-        return nullptr;
-    }
-
-    GlfImageSharedPtr image = GlfImage::OpenForReading(path);
-    if (!TF_VERIFY(image)) {
-        return nullptr;
-    }
-
-    // GlfImage is used for loading pixel data from usdz only and should
-    // not trigger any OpenGL call. VP2RenderDelegate will transfer the
-    // texels to GPU memory with VP2 API which is 3D API agnostic.
-    GlfImage::StorageSpec spec;
-    spec.width = image->GetWidth();
-    spec.height = image->GetHeight();
-    spec.depth = 1;
-    spec.format = image->GetFormat();
-    spec.type = image->GetType();
-    spec.flipped = false;
-
-    const int bpp = image->GetBytesPerPixel();
-    const int bytesPerRow = spec.width * bpp;
-    const int bytesPerSlice = bytesPerRow * spec.height;
-
-    std::vector<unsigned char> storage(bytesPerSlice);
-    spec.data = storage.data();
-
-    if (!image->Read(spec)) {
-        return nullptr;
-    }
-
-    MHWRender::MTexture* texture = nullptr;
-
-    MHWRender::MTextureDescription desc;
-    desc.setToDefault2DTexture();
-    desc.fWidth = spec.width;
-    desc.fHeight = spec.height;
-    desc.fBytesPerRow = bytesPerRow;
-    desc.fBytesPerSlice = bytesPerSlice;
-
-    switch (spec.format)
-    {
-    case GL_RED:
-        desc.fFormat = (spec.type == GL_FLOAT ?
-            MHWRender::kR32_FLOAT : MHWRender::kR8_UNORM);
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    case GL_RGB:
-        if (spec.type == GL_FLOAT) {
-            desc.fFormat = MHWRender::kR32G32B32_FLOAT;
-            texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        }
-        else {
-            // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
-            constexpr int bpp_4 = 4;
-
-            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            desc.fBytesPerRow = spec.width * bpp_4;
-            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
-
-            std::vector<unsigned char> texels(desc.fBytesPerSlice);
-
-            for (int y = 0; y < spec.height; y++) {
-                for (int x = 0; x < spec.width; x++) {
-                    const int t = spec.width * y + x;
-                    texels[t*bpp_4]     = storage[t*bpp];
-                    texels[t*bpp_4 + 1] = storage[t*bpp + 1];
-                    texels[t*bpp_4 + 2] = storage[t*bpp + 2];
-                    texels[t*bpp_4 + 3] = 255;
-                }
-            }
+    TF_VERIFY(_IsUsdUVTexture(node));
 
-            texture = textureMgr->acquireTexture(path.c_str(), desc, texels.data());
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
-        }
-        break;
-    case GL_RGBA:
-        if (spec.type == GL_FLOAT) {
-            desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
-        }
-        else {
-            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
-            isColorSpaceSRGB = image->IsColorSpaceSRGB();
+    auto it = node.parameters.find(_tokens->sourceColorSpace);
+    if (it != node.parameters.end()) {
+        const VtValue& value = it->second;
+        if (value.IsHolding<TfToken>()) {
+            return value.UncheckedGet<TfToken>();
         }
-        texture = textureMgr->acquireTexture(path.c_str(), desc, spec.data);
-        break;
-    default:
-        break;
     }
 
-    return texture;
+    return TfToken();
 }
 
 } //anonymous namespace
@@ -537,19 +322,6 @@ HdVP2ShaderDeleter::operator()(MHWRender::MShaderInstance* shader)
     }
 }
 
-/*! \brief  Releases the reference to the texture owned by a smart pointer.
-*/
-void
-HdVP2TextureDeleter::operator()(MHWRender::MTexture* texture)
-{
-    MRenderer* const renderer = MRenderer::theRenderer();
-    MHWRender::MTextureManager* const textureMgr =
-        renderer ? renderer->getTextureManager() : nullptr;
-    if (TF_VERIFY(textureMgr)) {
-        textureMgr->releaseTexture(texture);
-    }
-}
-
 /*! \brief  Constructor
 */
 HdVP2Material::HdVP2Material(HdVP2RenderDelegate* renderDelegate, const SdfPath& id)
@@ -558,6 +330,13 @@ HdVP2Material::HdVP2Material(HdVP2RenderDelegate* renderDelegate, const SdfPath&
 {
 }
 
+/*! \brief  Destructor
+*/
+HdVP2Material::~HdVP2Material()
+{
+    _renderDelegate->RemovePendingTextures(this);
+}
+
 /*! \brief  Synchronize VP2 state with scene delegate state based on dirty bits
 */
 void HdVP2Material::Sync(
@@ -840,7 +619,14 @@ HdVP2Material::_CreateShaderInstance(const HdMaterialNetwork& mat) {
 */
 void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
 {
+    const bool hadPendingTextures = !_pendingTextures.empty();
+    _pendingTextures.clear();
+    _textureMap.clear();
+
     if (!_surfaceShader) {
+        if (hadPendingTextures) {
+            _renderDelegate->RemovePendingTextures(this);
+        }
         return;
     }
 
@@ -905,25 +691,24 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
                 const std::string& resolvedPath = val.GetResolvedPath();
                 const std::string& assetPath = val.GetAssetPath();
                 if (_IsUsdUVTexture(node) && token == _tokens->file) {
-                    const HdVP2TextureInfo& info = _AcquireTexture(
-                        !resolvedPath.empty() ? resolvedPath : assetPath);
-
-                    MHWRender::MTextureAssignment assignment;
-                    assignment.texture = info._texture.get();
-                    status = _surfaceShader->setParameter(paramName, assignment);
-
-                    if (status) {
-                        paramName = nodeName + "isColorSpaceSRGB";
-                        status = _surfaceShader->setParameter(paramName,
-                            info._isColorSpaceSRGB);
-                    }
-                    if (status) {
-                        paramName = nodeName + "stScale";
-                        status = _surfaceShader->setParameter(paramName, info._stScale.data());
+                    const std::string& path =
+                        !resolvedPath.empty() ? resolvedPath : assetPath;
+                    const HdVP2TextureInfoSharedPtr info =
+                        _AcquireTexture(path, _GetSourceColorSpace(node));
+                    _textureMap[nodeName.asChar()] = info;
+
+                    if (info->_isPending) {
+                        // Bind the placeholder until the texture is loaded.
+                        _pendingTextures.emplace_back(nodeName.asChar(), info);
+
+                        MHWRender::MTextureAssignment assignment;
+                        assignment.texture =
+                            _renderDelegate->GetTextureCache().GetPlaceholderTexture();
+                        status = _surfaceShader->setParameter(paramName, assignment);
                     }
-                    if (status) {
-                        paramName = nodeName + "stOffset";
-                        status = _surfaceShader->setParameter(paramName, info._stOffset.data());
+                    else {
+                        _BindTexture(nodeName, *info);
+                        status = MStatus::kSuccess;
                     }
                 }
             }
@@ -952,31 +737,80 @@ void HdVP2Material::_UpdateShaderInstance(const HdMaterialNetwork& mat)
             }
         }
     }
+
+    if (!_pendingTextures.empty()) {
+        _renderDelegate->AddPendingTextures(this);
+    }
+    else if (hadPendingTextures) {
+        _renderDelegate->RemovePendingTextures(this);
+    }
+}
+
+/*! \brief  Acquires a texture for the given image path and source color
+            space from the texture cache of the render delegate.
+*/
+HdVP2TextureInfoSharedPtr
+HdVP2Material::_AcquireTexture(const std::string& path, const TfToken& colorSpace)
+{
+    return _renderDelegate->GetTextureCache().Acquire(path, colorSpace);
+}
+
+/*! \brief  Sets the texture and the parameters depending on it for the given
+            texture node.
+*/
+void
+HdVP2Material::_BindTexture(const MString& nodeName, const HdVP2TextureInfo& info)
+{
+    MString paramName = nodeName + _tokens->file.GetText();
+
+    MHWRender::MTextureAssignment assignment;
+    assignment.texture = info._texture.get();
+    MStatus status = _surfaceShader->setParameter(paramName, assignment);
+
+    if (status) {
+        paramName = nodeName + "isColorSpaceSRGB";
+        status = _surfaceShader->setParameter(paramName,
+            info._isColorSpaceSRGB);
+    }
+    if (status) {
+        paramName = nodeName + "stScale";
+        status = _surfaceShader->setParameter(paramName, info._stScale.data());
+    }
+    if (status) {
+        paramName = nodeName + "stOffset";
+        status = _surfaceShader->setParameter(paramName, info._stOffset.data());
+    }
+
+    if (!status) {
+        TF_DEBUG(HDVP2_DEBUG_MATERIAL).Msg(
+            "Failed to set shader parameter %s\n", paramName.asChar());
+    }
 }
 
-/*! \brief  Acquires a texture for the given image path.
+/*! \brief  Binds the textures which finished loading since the last update.
+            Returns true if some textures are still pending.
 */
-const HdVP2TextureInfo&
-HdVP2Material::_AcquireTexture(const std::string& path)
+bool
+HdVP2Material::UpdatePendingTextures()
 {
-    const auto it = _textureMap.find(path);
-    if (it != _textureMap.end()) {
-        return it->second;
+    if (!_surfaceShader) {
+        _pendingTextures.clear();
+        return false;
     }
 
-    bool isSRGB = false;
-    MFloatArray          uvScaleOffset;
-    MHWRender::MTexture* texture = _LoadTexture(path, isSRGB, uvScaleOffset);
-
-    HdVP2TextureInfo& info = _textureMap[path];
-    info._texture.reset(texture);
-    info._isColorSpaceSRGB = isSRGB;
-    if (uvScaleOffset.length() > 0) {
-        TF_VERIFY(uvScaleOffset.length() == 4);
-        info._stScale.Set(uvScaleOffset[0], uvScaleOffset[1]); // The first 2 elements are the scale
-        info._stOffset.Set(uvScaleOffset[2], uvScaleOffset[3]);// The next two elements are the offset
+    auto it = _pendingTextures.begin();
+    while (it != _pendingTextures.end()) {
+        const HdVP2TextureInfo& info = *it->second;
+        if (info._isPending) {
+            ++it;
+            continue;
+        }
+
+        _BindTexture(it->first.c_str(), info);
+        it = _pendingTextures.erase(it);
     }
-    return info;
+
+    return !_pendingTextures.empty();
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE
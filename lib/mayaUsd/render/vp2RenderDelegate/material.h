@@ -16,7 +16,10 @@
 #ifndef HD_VP2_MATERIAL
 #define HD_VP2_MATERIAL
 
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <maya/MShaderManager.h>
 
@@ -24,6 +27,8 @@
 #include <pxr/imaging/hd/material.h>
 #include<pxr/base/gf/vec2f.h>
 
+#include "texture_cache.h"
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 class HdSceneDelegate;
@@ -43,33 +48,10 @@ using HdVP2ShaderUniquePtr = std::unique_ptr<
     HdVP2ShaderDeleter
 >;
 
-/*! \brief  A deleter for MTexture, for use with smart pointers.
+/*! \brief  An unordered map of the textures used by a material, indexed by
+            the name of the shader node parameter they are bound to.
 */
-struct HdVP2TextureDeleter
-{
-    void operator () (MHWRender::MTexture*);
-};
-
-/*! \brief  A MTexture owned by a std unique pointer.
-*/
-using HdVP2TextureUniquePtr = std::unique_ptr<
-    MHWRender::MTexture,
-    HdVP2TextureDeleter
->;
-
-/*! \brief  Information about the texture.
-*/
-struct HdVP2TextureInfo
-{
-    HdVP2TextureUniquePtr  _texture;                //!< Unique pointer of the texture
-    GfVec2f                _stScale{1.0f,1.0f};     //!< UV scale for tiled textures
-    GfVec2f                _stOffset{0.0f, 0.0f};   //!< UV offset for tiled textures
-    bool                   _isColorSpaceSRGB{false};//!< Whether sRGB linearization is needed
-};
-
-/*! \brief  An unordered string-indexed map to cache texture information.
-*/
-using HdVP2TextureMap = std::unordered_map<std::string, HdVP2TextureInfo>;
+using HdVP2TextureMap = std::unordered_map<std::string, HdVP2TextureInfoSharedPtr>;
 
 /*! \brief  A VP2-specific implementation for a Hydra material prim.
     \class  HdVP2Material
@@ -81,7 +63,7 @@ public:
     HdVP2Material(HdVP2RenderDelegate*, const SdfPath&);
 
     //! Destructor.
-    ~HdVP2Material() override = default;
+    ~HdVP2Material() override;
 
     void Sync(HdSceneDelegate*, HdRenderParam*, HdDirtyBits*) override;
 
@@ -98,16 +80,23 @@ public:
         return _requiredPrimvars;
     }
 
+    //! Bind the textures which finished loading. Main thread only.
+    //! Returns true if some textures are still pending.
+    bool UpdatePendingTextures();
+
 private:
     MHWRender::MShaderInstance* _CreateShaderInstance(const HdMaterialNetwork& mat);
     void _UpdateShaderInstance(const HdMaterialNetwork& mat);
-    const HdVP2TextureInfo& _AcquireTexture(const std::string& path);
+    HdVP2TextureInfoSharedPtr _AcquireTexture(const std::string& path, const TfToken& colorSpace);
+    void _BindTexture(const MString& nodeName, const HdVP2TextureInfo& info);
 
     HdVP2RenderDelegate* const _renderDelegate; //!< VP2 render delegate for which this material was created
 
     HdVP2ShaderUniquePtr  _surfaceShader;       //!< VP2 surface shader instance
     SdfPath               _surfaceShaderId;     //!< Path of the surface shader
     HdVP2TextureMap       _textureMap;          //!< Textures used by this material
+    std::vector<std::pair<std::string, HdVP2TextureInfoSharedPtr>>
+                          _pendingTextures;     //!< Textures bound to the placeholder until loaded
     TfTokenVector         _requiredPrimvars;    //!< primvars required by this material
 };
 
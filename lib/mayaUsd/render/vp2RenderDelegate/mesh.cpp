@@ -15,7 +15,7 @@
 //
 #include "mesh.h"
 
-#include <numeric>
+#include <boost/functional/hash.hpp>
 
 #include <maya/MMatrix.h>
 #include <maya/MProfiler.h>
@@ -24,10 +24,12 @@
 #include <pxr/base/gf/matrix4d.h>
 #include <pxr/imaging/hd/meshUtil.h>
 #include <pxr/imaging/hd/sceneDelegate.h>
-#include <pxr/imaging/hd/smoothNormals.h>
 #include <pxr/imaging/hd/vertexAdjacency.h>
 #include <pxr/imaging/hd/version.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "bboxGeom.h"
 #include "debugCodes.h"
 #include "draw_item.h"
@@ -52,6 +54,7 @@ namespace {
     const MColor kOpaqueBlue(0.0f, 0.0f, 1.0f, 1.0f);               //!< Opaque blue
     const MColor kOpaqueGray(.18f, .18f, .18f, 1.0f);               //!< Opaque gray
     const unsigned int kNumColorChannels = 4;                       //!< The number of color channels
+    const size_t kSmoothNormalsGrainSize = 4096;                    //!< Number of points per smooth normals task
 
     const MString kPositionsStr("positions");                       //!< Cached string for efficiency
     const MString kNormalsStr("normals");                           //!< Cached string for efficiency
@@ -327,6 +330,64 @@ namespace {
         }
     }
 
+    //! \brief  Compute smooth normals of the points referenced by the adjacency table.
+    //!
+    //!         The normal of each point is the normalized sum of the cross products
+    //!         of the edges around it. Each point only reads its own adjacency
+    //!         entries and writes its own normal, so large meshes are split across
+    //!         threads without any synchronization. Points which are referenced by
+    //!         the topology but missing from the points array get a zero normal.
+    void _ComputeSmoothNormals(
+        GfVec3f* normals,
+        const Hd_VertexAdjacency& adjacency,
+        const VtVec3fArray& points,
+        const MString& rprimId)
+    {
+        const size_t numAdjacencyPoints = adjacency.GetNumPoints();
+        const size_t numPoints = points.size();
+        if (numPoints < numAdjacencyPoints) {
+            TF_DEBUG(HDVP2_DEBUG_MESH).Msg("Invalid Hydra prim '%s': "
+                                    "points has %zu elements, while its topology "
+                                    "references %zu points.\n",
+                                    rprimId.asChar(), numPoints, numAdjacencyPoints);
+        }
+
+        const int* const entries = adjacency.GetAdjacencyTable().data();
+        const GfVec3f* const pointsData = points.cdata();
+
+        auto computeNormals = [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                GfVec3f normal(0.0f);
+                if (i < numPoints) {
+                    const int offset = entries[i * 2];
+                    const int valence = entries[i * 2 + 1];
+                    const int* edge = entries + offset;
+                    const GfVec3f& curr = pointsData[i];
+                    for (int j = 0; j < valence; ++j, edge += 2) {
+                        const size_t prev = edge[0];
+                        const size_t next = edge[1];
+                        if (prev < numPoints && next < numPoints) {
+                            normal += GfCross(pointsData[next] - curr, pointsData[prev] - curr);
+                        }
+                    }
+                    normal.Normalize();
+                }
+                normals[i] = normal;
+            }
+        };
+
+        if (numAdjacencyPoints <= kSmoothNormalsGrainSize) {
+            computeNormals(0, numAdjacencyPoints);
+        }
+        else {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, numAdjacencyPoints, kSmoothNormalsGrainSize),
+                [&computeNormals](const tbb::blocked_range<size_t>& range) {
+                    computeNormals(range.begin(), range.end());
+                });
+        }
+    }
+
     //! Helper utility function to adapt Maya API changes.
     void setWantConsolidation(MHWRender::MRenderItem& renderItem, bool state)
     {
@@ -419,30 +480,14 @@ void HdVP2Mesh::Sync(
             }
         }
 
-        if (requiresUnsharedVertices) {
-            const HdMeshTopology& topology = _meshSharedData._topology;
-
-            // Fill with sequentially increasing values, starting from 0. The
-            // new face vertex indices will then be implicitly used to assemble
-            // all primvar vertex buffers.
-            VtIntArray newFaceVtxIds;
-            newFaceVtxIds.resize(topology.GetFaceVertexIndices().size());
-            std::iota(newFaceVtxIds.begin(), newFaceVtxIds.end(), 0);
-
-            _meshSharedData._unsharedTopology.reset(
-                new HdMeshTopology(
-                    topology.GetScheme(),
-                    topology.GetOrientation(),
-                    topology.GetFaceVertexCounts(),
-                    newFaceVtxIds,
-                    topology.GetHoleIndices(),
-                    topology.GetRefineLevel()
-                )
-            );
-        }
-        else {
-            _meshSharedData._unsharedTopology.reset(nullptr);
-        }
+        _meshSharedData._topologyHash = _meshSharedData._topology.ComputeHash();
+        _meshSharedData._unsharedTopology = requiresUnsharedVertices ?
+            _delegate->GetVP2ResourceRegistry().FindOrCreateUnsharedTopology(
+                _meshSharedData._topology) :
+            nullptr;
+
+        // The adjacency is only looked up when smooth normals are needed.
+        _meshSharedData._adjacency = nullptr;
     }
 
     // Prepare position buffer. It is shared among all draw items so it should
@@ -483,6 +528,78 @@ void HdVP2Mesh::Sync(
         }
     }
 
+    // Prepare smooth normals buffer. Like the position buffer, it is shared
+    // among all draw items, so the normals are computed once per Rprim when
+    // they get dirty. Authored normals are filled per draw item instead.
+    bool hasAuthoredNormals = false;
+    const auto itNormals = _meshSharedData._primvarSourceMap.find(HdTokens->normals);
+    if (itNormals != _meshSharedData._primvarSourceMap.end()) {
+        const VtValue& value = itNormals->second.data;
+        hasAuthoredNormals = value.IsHolding<VtVec3fArray>() &&
+            !value.UncheckedGet<VtVec3fArray>().empty();
+    }
+
+    if ((*dirtyBits & DirtySmoothNormals) && !hasAuthoredNormals) {
+        const HdMeshTopology& topology = _meshSharedData._topology;
+
+        if (!_meshSharedData._adjacency) {
+            _meshSharedData._adjacency =
+                _delegate->GetVP2ResourceRegistry().FindOrCreateVertexAdjacency(topology);
+        }
+        const Hd_VertexAdjacency& adjacency = *_meshSharedData._adjacency;
+
+        const bool requiresUnsharedVertices =
+            _meshSharedData._unsharedTopology != nullptr;
+
+        const size_t numVertices = requiresUnsharedVertices ?
+            topology.GetFaceVertexIndices().size() :
+            topology.GetNumPoints();
+
+        if (!_meshSharedData._smoothNormalsBuffer) {
+            const MHWRender::MVertexBufferDescriptor vbDesc("",
+                MHWRender::MGeometry::kNormal,
+                MHWRender::MGeometry::kFloat,
+                3);
+
+            _meshSharedData._smoothNormalsBuffer.reset(
+                new MHWRender::MVertexBuffer(vbDesc));
+        }
+
+        void* bufferData = _meshSharedData._smoothNormalsBuffer->acquire(numVertices, true);
+        if (bufferData) {
+            GfVec3f* const normals = static_cast<GfVec3f*>(bufferData);
+
+            if (!requiresUnsharedVertices &&
+                numVertices == static_cast<size_t>(adjacency.GetNumPoints())) {
+                // Write the normals straight into the buffer memory.
+                _ComputeSmoothNormals(normals, adjacency, _meshSharedData._points, _rprimId);
+            }
+            else {
+                VtVec3fArray pointNormals(adjacency.GetNumPoints());
+                _ComputeSmoothNormals(pointNormals.data(), adjacency,
+                    _meshSharedData._points, _rprimId);
+
+                _FillPrimvarData(normals, numVertices, 0, requiresUnsharedVertices,
+                    _rprimId, topology, HdTokens->normals, pointNormals,
+                    HdInterpolationVertex);
+            }
+
+            // Capture class member for lambda
+            MHWRender::MVertexBuffer* const smoothNormalsBuffer =
+                _meshSharedData._smoothNormalsBuffer.get();
+            const MString& rprimId = _rprimId;
+
+            _delegate->GetVP2ResourceRegistry().EnqueueCommit(
+                [smoothNormalsBuffer, bufferData, rprimId]() {
+                    MProfilingScope profilingScope(HdVP2RenderDelegate::sProfilerCategory,
+                        MProfiler::kColorC_L2, rprimId.asChar(), "CommitSmoothNormals");
+
+                    smoothNormalsBuffer->commit(bufferData);
+                }
+            );
+        }
+    }
+
     if (HdChangeTracker::IsExtentDirty(*dirtyBits, id)) {
         _sharedData.bounds.SetRange(delegate->GetExtent(id));
     }
@@ -887,29 +1004,50 @@ void HdVP2Mesh::_UpdateDrawItem(
     if (requiresIndexUpdate && (itemDirtyBits & HdChangeTracker::DirtyTopology)) {
         const HdMeshTopology* topologyToUse = unsharedTopology ? unsharedTopology : &topology;
 
-        if (desc.geomStyle == HdMeshGeomStyleHull) {
-            HdMeshUtil meshUtil(topologyToUse, id);
-            VtVec3iArray trianglesFaceVertexIndices;
-            VtIntArray primitiveParam;
-            meshUtil.ComputeTriangleIndices(&trianglesFaceVertexIndices, &primitiveParam, nullptr);
+        if (desc.geomStyle == HdMeshGeomStyleHull ||
+            desc.geomStyle == HdMeshGeomStyleHullEdgeOnly) {
+            // The index buffer is shared among the draw items of all the Rprims
+            // with the same topology, so it is only computed by the first one.
+            size_t key = _meshSharedData._topologyHash;
+            boost::hash_combine(key, requiresUnsharedVertices);
+            boost::hash_combine(key, desc.geomStyle);
 
-            const int numIndex = trianglesFaceVertexIndices.size() * 3;
+            bool isNew = false;
+            drawItemData._sharedIndexBuffer =
+                _delegate->GetVP2ResourceRegistry().FindOrCreateIndexBuffer(key, &isNew);
 
-            stateToCommit._indexBufferData = static_cast<int*>(
-                drawItemData._indexBuffer->acquire(numIndex, true));
+            if (isNew) {
+                HdVP2SharedIndexBuffer& sharedIndexBuffer = *drawItemData._sharedIndexBuffer;
 
-            memcpy(stateToCommit._indexBufferData, trianglesFaceVertexIndices.data(), numIndex * sizeof(int));
-        }
-        else if (desc.geomStyle == HdMeshGeomStyleHullEdgeOnly) {
-            unsigned int numIndex = _GetNumOfEdgeIndices(*topologyToUse);
+                if (desc.geomStyle == HdMeshGeomStyleHull) {
+                    HdMeshUtil meshUtil(topologyToUse, id);
+                    VtVec3iArray trianglesFaceVertexIndices;
+                    VtIntArray primitiveParam;
+                    meshUtil.ComputeTriangleIndices(&trianglesFaceVertexIndices, &primitiveParam, nullptr);
+
+                    const int numIndex = trianglesFaceVertexIndices.size() * 3;
+
+                    sharedIndexBuffer._pendingData = static_cast<int*>(
+                        sharedIndexBuffer._buffer->acquire(numIndex, true));
 
-            stateToCommit._indexBufferData = static_cast<int*>(
-                drawItemData._indexBuffer->acquire(numIndex, true));
+                    memcpy(sharedIndexBuffer._pendingData, trianglesFaceVertexIndices.data(), numIndex * sizeof(int));
+                }
+                else {
+                    unsigned int numIndex = _GetNumOfEdgeIndices(*topologyToUse);
 
-            _FillEdgeIndices(stateToCommit._indexBufferData, *topologyToUse);
+                    sharedIndexBuffer._pendingData = static_cast<int*>(
+                        sharedIndexBuffer._buffer->acquire(numIndex, true));
+
+                    _FillEdgeIndices(sharedIndexBuffer._pendingData, *topologyToUse);
+                }
+            }
         }
     }
 
+    // Smooth normals are computed once per Rprim during Sync() and the buffer
+    // is bound to every draw item which needs them.
+    bool useSmoothNormals = false;
+
     if (desc.geomStyle == HdMeshGeomStyleHull) {
         // Prepare normal buffer.
         VtVec3fArray normals;
@@ -927,31 +1065,12 @@ void HdVP2Mesh::_UpdateDrawItem(
         bool prepareNormals = false;
 
         // If there is authored normals, prepare buffer only when it is dirty.
-        // otherwise, compute smooth normals from points and adjacency and we
-        // have a custom dirty bit to determine whether update is needed.
+        // otherwise, use the smooth normals computed from points and adjacency.
         if (!normals.empty()) {
             prepareNormals = ((itemDirtyBits & HdChangeTracker::DirtyNormals) != 0);
         }
-        else if (requireSmoothNormals && (itemDirtyBits & DirtySmoothNormals)) {
-            // note: normals gets dirty when points are marked as dirty,
-            // at change tracker.
-            // HdC_TODO: move the normals computation to GPU to save expensive
-            // computation and buffer transfer.
-            Hd_VertexAdjacencySharedPtr adjacency(new Hd_VertexAdjacency());
-            HdBufferSourceSharedPtr adjacencyComputation =
-                adjacency->GetSharedAdjacencyBuilderComputation(&topology);
-            adjacencyComputation->Resolve(); // IS the adjacency updated now?
-
-            // Only the points referenced by the topology are used to compute
-            // smooth normals.
-            normals = Hd_SmoothNormals::ComputeSmoothNormals(
-                adjacency.get(),
-                _meshSharedData._points.size(),
-                _meshSharedData._points.cdata());
-
-            interp = HdInterpolationVertex;
-
-            prepareNormals = !normals.empty();
+        else if (requireSmoothNormals) {
+            useSmoothNormals = (_meshSharedData._smoothNormalsBuffer != nullptr);
         }
 
         if (prepareNormals) {
@@ -1414,9 +1533,15 @@ void HdVP2Mesh::_UpdateDrawItem(
     // Reset dirty bits because we've prepared commit state for this draw item.
     drawItem->ResetDirtyBits();
 
-    // Capture the valid position buffer and index buffer
+    // Capture the valid position buffer, normals buffer and index buffer
     MHWRender::MVertexBuffer* positionsBuffer = _meshSharedData._positionsBuffer.get();
+    MHWRender::MVertexBuffer* normalsBuffer = useSmoothNormals ?
+        _meshSharedData._smoothNormalsBuffer.get() : drawItemData._normalsBuffer.get();
     MHWRender::MIndexBuffer* indexBuffer = drawItemData._indexBuffer.get();
+    HdVP2SharedIndexBufferPtr sharedIndexBuffer = drawItemData._sharedIndexBuffer;
+    if (sharedIndexBuffer) {
+        indexBuffer = sharedIndexBuffer->_buffer.get();
+    }
 
     if (isBBoxItem) {
         const HdVP2BBoxGeom& sharedBBoxGeom = _delegate->GetSharedBBoxGeom();
@@ -1427,7 +1552,7 @@ void HdVP2Mesh::_UpdateDrawItem(
     }
 
     _delegate->GetVP2ResourceRegistry().EnqueueCommit(
-        [drawItem, stateToCommit, param, positionsBuffer, indexBuffer]()
+        [drawItem, stateToCommit, param, positionsBuffer, normalsBuffer, indexBuffer, sharedIndexBuffer]()
     {
         MHWRender::MRenderItem* renderItem = drawItem->GetRenderItem();
         if (ARCH_UNLIKELY(!renderItem))
@@ -1439,7 +1564,6 @@ void HdVP2Mesh::_UpdateDrawItem(
         const HdVP2DrawItem::RenderItemData& drawItemData = stateToCommit._drawItemData;
 
         MHWRender::MVertexBuffer* colorBuffer = drawItemData._colorBuffer.get();
-        MHWRender::MVertexBuffer* normalsBuffer = drawItemData._normalsBuffer.get();
 
         const HdVP2DrawItem::PrimvarBufferMap& primvarBuffers = drawItemData._primvarBuffers;
 
@@ -1470,6 +1594,10 @@ void HdVP2Mesh::_UpdateDrawItem(
         if (stateToCommit._indexBufferData)
             indexBuffer->commit(stateToCommit._indexBufferData);
 
+        // The first commit task using a new shared index buffer commits its data
+        if (sharedIndexBuffer)
+            sharedIndexBuffer->Commit();
+
         // If available, something changed
         if (stateToCommit._shader != nullptr) {
             renderItem->setShader(stateToCommit._shader);
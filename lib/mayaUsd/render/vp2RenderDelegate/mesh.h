@@ -23,6 +23,8 @@
 
 #include <mayaUsd/render/vp2RenderDelegate/proxyRenderDelegate.h>
 
+#include "resource_registry.h"
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 class HdSceneDelegate;
@@ -42,9 +44,13 @@ struct HdVP2MeshSharedData {
     //! copy.
     HdMeshTopology _topology;
 
+    //! Hash of the topology, used to share index buffers among Rprims.
+    size_t _topologyHash{ 0 };
+
     //! Optional topology which is computed for conversion from shared vertices
-    //! to unshared when needed.
-    std::unique_ptr<HdMeshTopology> _unsharedTopology;
+    //! to unshared when needed. It is shared among Rprims with the same
+    //! topology through the resource registry.
+    HdVP2MeshTopologySharedPtr _unsharedTopology;
 
     //! A local cache of primvar scene data. "data" is a copy-on-write handle to
     //! the actual primvar buffer, and "interpolation" is the interpolation mode
@@ -62,6 +68,15 @@ struct HdVP2MeshSharedData {
     //! Position buffer of the Rprim to be shared among all its draw items.
     std::unique_ptr<MHWRender::MVertexBuffer> _positionsBuffer;
 
+    //! Vertex adjacency of the topology, used to compute smooth normals. It is
+    //! shared among Rprims with the same topology through the resource registry.
+    HdVP2VertexAdjacencySharedPtr _adjacency;
+
+    //! Smooth normals buffer of the Rprim to be shared among all its draw
+    //! items. Only created when smooth normals are computed, i.e. when there
+    //! are no authored normals.
+    std::unique_ptr<MHWRender::MVertexBuffer> _smoothNormalsBuffer;
+
     //! Render tag of the Rprim.
     TfToken _renderTag;
 };
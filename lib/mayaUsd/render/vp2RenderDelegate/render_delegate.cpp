@@ -398,6 +398,7 @@ HdVP2RenderDelegate::HdVP2RenderDelegate(ProxyRenderDelegate& drawScene) {
     }
 
     _renderParam.reset(new HdVP2RenderParam(drawScene));
+    _textureCache.reset(new HdVP2TextureCache(_resourceRegistryVP2));
 
     // Shader fragments can only be registered after VP2 initialization, thus the function cannot
     // be called when loading plugin (which can happen before VP2 initialization in the case of
@@ -453,6 +454,41 @@ void HdVP2RenderDelegate::CommitResources(HdChangeTracker* tracker) {
     //     3) Update any scene-level acceleration structures.
 
     _resourceRegistryVP2.Commit();
+
+    // Release the index buffers and topologies no longer shared by any rprim.
+    _resourceRegistryVP2.GarbageCollect();
+
+    // Bind the textures uploaded by the commit tasks above.
+    std::lock_guard<std::mutex> lock(_pendingTexturesMutex);
+    auto it = _materialsWithPendingTextures.begin();
+    while (it != _materialsWithPendingTextures.end()) {
+        if ((*it)->UpdatePendingTextures()) {
+            ++it;
+        }
+        else {
+            it = _materialsWithPendingTextures.erase(it);
+        }
+    }
+}
+
+/*! \brief  Returns the texture cache shared by the materials of this render delegate.
+*/
+HdVP2TextureCache& HdVP2RenderDelegate::GetTextureCache() {
+    return *_textureCache;
+}
+
+/*! \brief  Registers a material to be notified when its pending textures are loaded.
+*/
+void HdVP2RenderDelegate::AddPendingTextures(HdVP2Material* material) {
+    std::lock_guard<std::mutex> lock(_pendingTexturesMutex);
+    _materialsWithPendingTextures.insert(material);
+}
+
+/*! \brief  Unregisters a material waiting for textures to be loaded.
+*/
+void HdVP2RenderDelegate::RemovePendingTextures(HdVP2Material* material) {
+    std::lock_guard<std::mutex> lock(_pendingTexturesMutex);
+    _materialsWithPendingTextures.erase(material);
 }
 
 /*! \brief  Return a list of which Rprim types can be created by this class's.
@@ -18,6 +18,8 @@
 
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <unordered_set>
 
 #include <maya/MString.h>
 #include <maya/MShaderManager.h>
@@ -28,10 +30,12 @@
 
 #include "render_param.h"
 #include "resource_registry.h"
+#include "texture_cache.h"
 
 PXR_NAMESPACE_OPEN_SCOPE
 
 class HdVP2BBoxGeom;
+class HdVP2Material;
 class ProxyRenderDelegate;
 
 /*! \brief    VP2 render delegate
@@ -83,6 +87,11 @@ public:
 
     HdVP2ResourceRegistry& GetVP2ResourceRegistry();
 
+    HdVP2TextureCache& GetTextureCache();
+
+    void AddPendingTextures(HdVP2Material* material);
+    void RemovePendingTextures(HdVP2Material* material);
+
     HdRenderPassSharedPtr CreateRenderPass(HdRenderIndex* index, HdRprimCollection const& collection) override;
 
     HdInstancer* CreateInstancer(HdSceneDelegate* delegate, SdfPath const& id, SdfPath const& instancerId) override;    
@@ -132,6 +141,10 @@ private:
     std::unique_ptr<HdVP2RenderParam>     _renderParam;             //!< Render param used to provided access to VP2 during prim synchronization
     SdfPath                               _id;                      //!< Render delegate IDs
     HdVP2ResourceRegistry                 _resourceRegistryVP2;     //!< VP2 resource registry used for enqueue and execution of commits
+    std::unique_ptr<HdVP2TextureCache>    _textureCache;            //!< Textures shared by the materials, destroyed before the registry its uploads are enqueued in
+
+    std::unordered_set<HdVP2Material*>    _materialsWithPendingTextures; //!< Materials waiting for textures to be loaded
+    std::mutex                            _pendingTexturesMutex;    //!< Mutex protecting the materials with pending textures
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
@@ -0,0 +1,128 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "resource_registry.h"
+
+#include <numeric>
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+namespace
+{
+    //! Remove the entries of the map which are only referenced by the map itself.
+    template <typename Map>
+    void _RemoveUnused(Map& map)
+    {
+        for (auto it = map.begin(); it != map.end(); ) {
+            if (it->second.use_count() == 1) {
+                it = map.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+} //namespace
+
+/*! \brief  Find the index buffer registered for the key, or register a new one.
+
+    Keys are hashes, like the topology instance keys of HdSt resource registry,
+    so that rprims don't have to keep their topology around for comparison.
+*/
+HdVP2SharedIndexBufferPtr HdVP2ResourceRegistry::FindOrCreateIndexBuffer(
+    size_t key, bool* isNew)
+{
+    std::lock_guard<std::mutex> lock(_sharedResourcesMutex);
+
+    HdVP2SharedIndexBufferPtr& indexBuffer = _indexBuffers[key];
+    *isNew = !indexBuffer;
+    if (*isNew) {
+        indexBuffer = std::make_shared<HdVP2SharedIndexBuffer>();
+    }
+    return indexBuffer;
+}
+
+/*! \brief  Find the unshared vertices topology of the topology, or create a new one.
+*/
+HdVP2MeshTopologySharedPtr HdVP2ResourceRegistry::FindOrCreateUnsharedTopology(
+    const HdMeshTopology& topology)
+{
+    const size_t key = topology.ComputeHash();
+    {
+        std::lock_guard<std::mutex> lock(_sharedResourcesMutex);
+        const auto it = _unsharedTopologies.find(key);
+        if (it != _unsharedTopologies.end()) {
+            return it->second;
+        }
+    }
+
+    // Fill with sequentially increasing values, starting from 0. The new face
+    // vertex indices will then be implicitly used to assemble all primvar
+    // vertex buffers.
+    VtIntArray newFaceVtxIds;
+    newFaceVtxIds.resize(topology.GetFaceVertexIndices().size());
+    std::iota(newFaceVtxIds.begin(), newFaceVtxIds.end(), 0);
+
+    HdVP2MeshTopologySharedPtr unsharedTopology = std::make_shared<HdMeshTopology>(
+        topology.GetScheme(),
+        topology.GetOrientation(),
+        topology.GetFaceVertexCounts(),
+        newFaceVtxIds,
+        topology.GetHoleIndices(),
+        topology.GetRefineLevel()
+    );
+
+    // Another thread may have created the same topology in the meantime.
+    std::lock_guard<std::mutex> lock(_sharedResourcesMutex);
+    return _unsharedTopologies.emplace(key, unsharedTopology).first->second;
+}
+
+/*! \brief  Find the vertex adjacency of the topology, or build a new one.
+*/
+HdVP2VertexAdjacencySharedPtr HdVP2ResourceRegistry::FindOrCreateVertexAdjacency(
+    const HdMeshTopology& topology)
+{
+    const size_t key = topology.ComputeHash();
+    {
+        std::lock_guard<std::mutex> lock(_sharedResourcesMutex);
+        const auto it = _vertexAdjacencies.find(key);
+        if (it != _vertexAdjacencies.end()) {
+            return it->second;
+        }
+    }
+
+    // Build the table outside of the lock, it is linear in the number of face
+    // vertices.
+    auto adjacency = std::make_shared<Hd_VertexAdjacency>();
+    adjacency->BuildAdjacencyTable(&topology);
+
+    // Another thread may have built the same adjacency in the meantime.
+    std::lock_guard<std::mutex> lock(_sharedResourcesMutex);
+    return _vertexAdjacencies.emplace(key, std::move(adjacency)).first->second;
+}
+
+/*! \brief  Release the resources not used by any rprim anymore.
+
+    Called on main thread, after the commit tasks have been executed.
+*/
+void HdVP2ResourceRegistry::GarbageCollect()
+{
+    std::lock_guard<std::mutex> lock(_sharedResourcesMutex);
+    _RemoveUnused(_indexBuffers);
+    _RemoveUnused(_unsharedTopologies);
+    _RemoveUnused(_vertexAdjacencies);
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
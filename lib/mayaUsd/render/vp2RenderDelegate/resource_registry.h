@@ -16,13 +16,50 @@
 #ifndef HD_VP2_RESOURCE_REGISTRY
 #define HD_VP2_RESOURCE_REGISTRY
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <tbb/concurrent_queue.h>
 #include <tbb/tbb_allocator.h>
 
+#include <maya/MHWGeometry.h>
+
+#include <pxr/pxr.h>
+#include <pxr/imaging/hd/meshTopology.h>
+#include <pxr/imaging/hd/vertexAdjacency.h>
+
 #include "task_commit.h"
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+/*! \brief  Index buffer shared by the draw items of all the meshes with the same topology.
+    \class  HdVP2SharedIndexBuffer
+
+    The draw item which creates the buffer fills it on a worker thread. The
+    data is committed by the first commit task using the buffer, on main thread.
+*/
+struct HdVP2SharedIndexBuffer
+{
+    //! Index buffer
+    std::unique_ptr<MHWRender::MIndexBuffer> _buffer{
+        new MHWRender::MIndexBuffer(MHWRender::MGeometry::kUnsignedInt32) };
+    //! If valid, index data waiting for commit
+    int* _pendingData{ nullptr };
+
+    //! Commit the pending index data, if any. Main thread only.
+    void Commit() {
+        if (_pendingData) {
+            _buffer->commit(_pendingData);
+            _pendingData = nullptr;
+        }
+    }
+};
+
+using HdVP2SharedIndexBufferPtr = std::shared_ptr<HdVP2SharedIndexBuffer>;
+using HdVP2MeshTopologySharedPtr = std::shared_ptr<const HdMeshTopology>;
+using HdVP2VertexAdjacencySharedPtr = std::shared_ptr<const Hd_VertexAdjacency>;
+
 /*! \brief  Central place to manage GPU resources commits and any resources not managed by VP2 directly
     \class  HdVP2ResourceRegistry
 */
@@ -48,9 +85,34 @@ public:
     void EnqueueCommit(Body taskBody) {
         _commitTasks.push(HdVP2TaskCommitBody<Body>::construct(taskBody));
     }
+
+    //! \brief  Find the index buffer registered for the key, or register a new one. Call is thread safe.
+    //!         \p isNew is set to true when the buffer is new and must be filled by the caller.
+    HdVP2SharedIndexBufferPtr FindOrCreateIndexBuffer(size_t key, bool* isNew);
+
+    //! \brief  Find the unshared vertices topology of the topology, or create a new one. Call is thread safe.
+    //!         The unshared topology has sequentially increasing face vertex indices, one per face vertex.
+    HdVP2MeshTopologySharedPtr FindOrCreateUnsharedTopology(const HdMeshTopology& topology);
+
+    //! \brief  Find the vertex adjacency of the topology, or build a new one. Call is thread safe.
+    //!         The adjacency is used to compute smooth normals, so it only needs to be rebuilt when the topology changes.
+    HdVP2VertexAdjacencySharedPtr FindOrCreateVertexAdjacency(const HdMeshTopology& topology);
+
+    //! \brief  Release the resources not used by any rprim anymore (called by render delegate)
+    void GarbageCollect();
+
 private:
     //! Concurrent queue for commit tasks
     tbb::concurrent_queue<HdVP2TaskCommit*, tbb::tbb_allocator<HdVP2TaskCommit*>> _commitTasks;
+
+    //! Index buffers shared among draw items, keyed by topology hash and geometry style
+    std::unordered_map<size_t, HdVP2SharedIndexBufferPtr> _indexBuffers;
+    //! Unshared vertices topologies, keyed by hash of the original topology
+    std::unordered_map<size_t, HdVP2MeshTopologySharedPtr> _unsharedTopologies;
+    //! Vertex adjacencies, keyed by hash of the topology
+    std::unordered_map<size_t, HdVP2VertexAdjacencySharedPtr> _vertexAdjacencies;
+    //! Protects the shared resources maps
+    std::mutex _sharedResourcesMutex;
 };
 
 PXR_NAMESPACE_CLOSE_SCOPE
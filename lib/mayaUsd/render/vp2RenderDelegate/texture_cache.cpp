@@ -0,0 +1,460 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "texture_cache.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <maya/MFloatArray.h>
+#include <maya/MGlobal.h>
+#include <maya/MStringArray.h>
+#include <maya/MViewport2Renderer.h>
+
+#include <pxr/base/tf/diagnostic.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/tf/staticTokens.h>
+#include <pxr/imaging/glf/image.h>
+#if USD_VERSION_NUM >= 2002
+#include <pxr/imaging/glf/udimTexture.h>
+#include <pxr/usdImaging/usdImaging/textureUtils.h>
+#endif
+
+#include "resource_registry.h"
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(MAYAUSD_VP2_TEXTURE_CACHE_BUDGET_MB, 2048,
+    "Memory budget in megabytes of the textures cached by the VP2 render "
+    "delegate. Textures not used by any material are released beyond it.");
+
+namespace {
+
+TF_DEFINE_PRIVATE_TOKENS(
+    _tokens,
+
+    (raw)
+    (sRGB)
+);
+
+const MString _placeholderTextureName = "HdVP2PlaceholderTexture"; //!< Name of the placeholder texture
+
+} //anonymous namespace
+
+/*! \brief  Image data decoded by a worker thread, ready to be uploaded.
+*/
+struct HdVP2TextureCache::DecodedTexture
+{
+    MHWRender::MTextureDescription  _desc;                  //!< Description of the texels
+    std::vector<unsigned char>      _texels;                //!< Texels in a format supported by VP2
+    bool                            _isColorSpaceSRGB{false};//!< Whether the image is sRGB encoded
+
+    bool                            _isUdim{false};         //!< Whether the image is a set of UDIM tiles
+    std::vector<std::string>        _tilePaths;             //!< Paths of the UDIM tiles
+    std::vector<float>              _tilePositions;         //!< UV positions of the UDIM tiles
+    unsigned int                    _tileWidth{0};          //!< Width of the first UDIM tile
+    unsigned int                    _tileHeight{0};         //!< Height of the first UDIM tile
+    int                             _maxTileId{0};          //!< Highest UDIM tile id
+};
+
+/*! \brief  Releases the reference to the texture owned by a smart pointer.
+*/
+void
+HdVP2TextureDeleter::operator()(MHWRender::MTexture* texture)
+{
+    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr =
+        renderer ? renderer->getTextureManager() : nullptr;
+    if (TF_VERIFY(textureMgr)) {
+        textureMgr->releaseTexture(texture);
+    }
+}
+
+/*! \brief  Hash of the cache key.
+*/
+std::size_t
+HdVP2TextureCache::KeyHash::operator()(const Key& key) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.first);
+    boost::hash_combine(seed, key.second.Hash());
+    return seed;
+}
+
+/*! \brief  Constructor
+*/
+HdVP2TextureCache::HdVP2TextureCache(HdVP2ResourceRegistry& registry)
+    : _registry(registry)
+    , _entries(static_cast<size_t>(
+        std::max(TfGetEnvSetting(MAYAUSD_VP2_TEXTURE_CACHE_BUDGET_MB), 0)) << 20)
+{
+}
+
+/*! \brief  Destructor, skipping the decodes not started yet.
+*/
+HdVP2TextureCache::~HdVP2TextureCache()
+{
+    _canceled = true;
+    _decodeTasks.wait();
+}
+
+/*! \brief  Acquires the texture info for the given image path and color space.
+
+    The image is decoded asynchronously on first acquisition, and the returned
+    info is pending until the decoded texels are uploaded by the commit task.
+*/
+HdVP2TextureInfoSharedPtr
+HdVP2TextureCache::Acquire(const std::string& path, const TfToken& colorSpace)
+{
+    const Key key(path, colorSpace);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    HdVP2TextureInfoSharedPtr info = _entries.Find(key);
+    if (info) {
+        return info;
+    }
+
+    info = _entries.Insert(key);
+
+    _decodeTasks.run([this, key]() {
+        if (_canceled) {
+            return;
+        }
+
+        std::shared_ptr<DecodedTexture> decoded = std::make_shared<DecodedTexture>();
+        if (!_Decode(key.first, *decoded)) {
+            decoded.reset();
+        }
+
+        // The upload to VP2 has to happen on the main thread.
+        _registry.EnqueueCommit([this, key, decoded]() {
+            _Upload(key, decoded);
+        });
+
+        // Nothing would commit the upload until the next redraw.
+        if (!_refreshRequested.exchange(true)) {
+            MGlobal::executeCommandOnIdle("refresh -force");
+        }
+    });
+
+    return info;
+}
+
+/*! \brief  Returns the texture to bind while textures are pending.
+*/
+MHWRender::MTexture*
+HdVP2TextureCache::GetPlaceholderTexture()
+{
+    if (!_placeholderTexture) {
+        MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
+        MHWRender::MTextureManager* const textureMgr =
+            renderer ? renderer->getTextureManager() : nullptr;
+        if (!TF_VERIFY(textureMgr)) {
+            return nullptr;
+        }
+
+        MHWRender::MTextureDescription desc;
+        desc.setToDefault2DTexture();
+        desc.fWidth = 1;
+        desc.fHeight = 1;
+        desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+        desc.fBytesPerRow = 4;
+        desc.fBytesPerSlice = 4;
+
+        const unsigned char texel[4] = { 128, 128, 128, 255 };
+        _placeholderTexture.reset(
+            textureMgr->acquireTexture(_placeholderTextureName, desc, texel));
+    }
+
+    return _placeholderTexture.get();
+}
+
+/*! \brief  Decodes the image at the given path. Called from worker threads.
+*/
+bool
+HdVP2TextureCache::_Decode(const std::string& path, DecodedTexture& decoded)
+{
+#if USD_VERSION_NUM >= 2002
+    if (GlfIsSupportedUdimTexture(path)) {
+        /*
+            For this to work path needs to be an absolute file path, not an asset path.
+            That means that this function depends on the changes in 4e426565 to materialAdapther.cpp
+            to work. As of my writing this 4e426565 is not in the USD that MayaUSD normally builds
+            against so this code will fail, because UsdImaging_GetUdimTiles won't file the tiles
+            because we don't know where on disk to look for them.
+
+            https://github.com/PixarAnimationStudios/USD/commit/4e42656543f4e3a313ce31a81c27477d4dcb64b9
+        */
+
+        // HdSt sets the tile limit to the max number of textures in an array of 2d textures. OpenGL says
+        // the minimum number of layers in 2048 so I'll use that.
+        int tileLimit = 2048;
+        std::vector<std::tuple<int, TfToken>> tiles = UsdImaging_GetUdimTiles(path, tileLimit);
+        if (tiles.size() == 0)
+        {
+            TF_WARN("Unable to find UDIM tiles for %s", path.c_str());
+            return false;
+        }
+
+        // Open the first image and get it's resolution. Assuming that all the tiles have the same
+        // resolution, the upload will warn the user if Maya's tiled texture implementation is
+        // going to result in a loss of texture data.
+        {
+            GlfImageSharedPtr image = GlfImage::OpenForReading(std::get<1>(tiles[0]).GetString());
+            if (!TF_VERIFY(image)) {
+                return false;
+            }
+            decoded._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+            decoded._tileWidth = image->GetWidth();
+            decoded._tileHeight = image->GetHeight();
+            decoded._maxTileId = std::get<0>(tiles.back());
+        }
+
+        for(auto& tile : tiles)
+        {
+            decoded._tilePaths.push_back(std::get<1>(tile).GetString());
+
+            GlfImageSharedPtr image = GlfImage::OpenForReading(std::get<1>(tile).GetString());
+            if (!TF_VERIFY(image)) {
+                return false;
+            }
+            if (decoded._isColorSpaceSRGB != image->IsColorSpaceSRGB())
+            {
+                TF_WARN("UDIM texture %s color space doesn't match %s color space",
+                    std::get<1>(tile).GetText(), std::get<1>(tiles[0]).GetText());
+            }
+
+            // The image labeled 1001 will have id 0, 1002 will have id 1, 1011 will have id 10.
+            // image 1001 starts with UV (0.0f, 0.0f), 1002 is (1.0f, 0.0f) and 1011 is (0.0f, 1.0f)
+            int tileId = std::get<0>(tile);
+            float u = (float)(tileId % 10);
+            float v = (float)((tileId - u) / 10);
+            decoded._tilePositions.push_back(u);
+            decoded._tilePositions.push_back(v);
+        }
+
+        decoded._isUdim = true;
+        return true;
+    }
+#endif
+
+    GlfImageSharedPtr image = GlfImage::OpenForReading(path);
+    if (!TF_VERIFY(image)) {
+        return false;
+    }
+
+    // GlfImage is used for loading pixel data from usdz only and should
+    // not trigger any OpenGL call. VP2RenderDelegate will transfer the
+    // texels to GPU memory with VP2 API which is 3D API agnostic.
+    GlfImage::StorageSpec spec;
+    spec.width = image->GetWidth();
+    spec.height = image->GetHeight();
+    spec.depth = 1;
+    spec.format = image->GetFormat();
+    spec.type = image->GetType();
+    spec.flipped = false;
+
+    const int bpp = image->GetBytesPerPixel();
+    const int bytesPerRow = spec.width * bpp;
+    const int bytesPerSlice = bytesPerRow * spec.height;
+
+    std::vector<unsigned char> storage(bytesPerSlice);
+    spec.data = storage.data();
+
+    if (!image->Read(spec)) {
+        return false;
+    }
+
+    MHWRender::MTextureDescription& desc = decoded._desc;
+    desc.setToDefault2DTexture();
+    desc.fWidth = spec.width;
+    desc.fHeight = spec.height;
+    desc.fBytesPerRow = bytesPerRow;
+    desc.fBytesPerSlice = bytesPerSlice;
+
+    switch (spec.format)
+    {
+    case GL_RED:
+        desc.fFormat = (spec.type == GL_FLOAT ?
+            MHWRender::kR32_FLOAT : MHWRender::kR8_UNORM);
+        decoded._texels = std::move(storage);
+        break;
+    case GL_RGB:
+        if (spec.type == GL_FLOAT) {
+            desc.fFormat = MHWRender::kR32G32B32_FLOAT;
+            decoded._texels = std::move(storage);
+        }
+        else {
+            // R8G8B8 is not supported by VP2. Converted to R8G8B8A8.
+            constexpr int bpp_4 = 4;
+
+            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+            desc.fBytesPerRow = spec.width * bpp_4;
+            desc.fBytesPerSlice = desc.fBytesPerRow * spec.height;
+
+            decoded._texels.resize(desc.fBytesPerSlice);
+
+            const unsigned char* src = storage.data();
+            unsigned char* dst = decoded._texels.data();
+            const size_t numTexels = static_cast<size_t>(spec.width) * spec.height;
+            for (size_t t = 0; t < numTexels; ++t, src += bpp, dst += bpp_4) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = 255;
+            }
+
+            decoded._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        }
+        break;
+    case GL_RGBA:
+        if (spec.type == GL_FLOAT) {
+            desc.fFormat = MHWRender::kR32G32B32A32_FLOAT;
+        }
+        else {
+            desc.fFormat = MHWRender::kR8G8B8A8_UNORM;
+            decoded._isColorSpaceSRGB = image->IsColorSpaceSRGB();
+        }
+        decoded._texels = std::move(storage);
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+/*! \brief  Uploads decoded texels to VP2. Executed by a commit task on the main thread.
+*/
+void
+HdVP2TextureCache::_Upload(
+    const Key& key,
+    const std::shared_ptr<DecodedTexture>& decoded)
+{
+    _refreshRequested = false;
+
+    MHWRender::MRenderer* const renderer = MHWRender::MRenderer::theRenderer();
+    MHWRender::MTextureManager* const textureMgr =
+        renderer ? renderer->getTextureManager() : nullptr;
+    if (!TF_VERIFY(textureMgr)) {
+        return;
+    }
+
+    const std::string& path = key.first;
+
+    MHWRender::MTexture* texture = nullptr;
+    MFloatArray uvScaleOffset;
+
+    if (decoded && decoded->_isUdim) {
+        /*
+            Maya's tiled texture support is implemented quite differently from Usd's UDIM support.
+            In Maya the texture tiles get combined into a single big texture, downscaling each tile
+            if necessary, and filling in empty regions of a non-square tile with the undefined color.
+
+            In USD the UDIM textures are stored in a texture array that the shader uses to draw.
+        */
+
+        // I don't think there is a downside to setting a very high limit.
+        // Maya will clamp the texture size to the VP2 texture clamp resolution and the hardware's
+        // max texture size. And Maya doesn't make the tiled texture unnecessarily large. When I
+        // try loading two 1k textures I end up with a tiled texture that is 2k x 1k.
+        unsigned int maxWidth = 0;
+        unsigned int maxHeight = 0;
+        renderer->GPUmaximumOutputTargetSize(maxWidth, maxHeight);
+
+        int maxU = decoded->_maxTileId % 10;
+        int maxV = (decoded->_maxTileId - maxU) / 10;
+        if ((decoded->_tileWidth * maxU > maxWidth) || (decoded->_tileHeight * maxV > maxHeight))
+            TF_WARN("UDIM texture %s creates a tiled texture larger than the maximum texture size. Some"
+                "resolution will be lost.", path.c_str());
+
+        MString textureName(path.c_str()); // used for caching, using the string with <UDIM> in it is fine
+        MStringArray tilePaths;
+        for (const std::string& tilePath : decoded->_tilePaths) {
+            tilePaths.append(MString(tilePath.c_str()));
+        }
+        MFloatArray tilePositions;
+        for (const float position : decoded->_tilePositions) {
+            tilePositions.append(position);
+        }
+
+        MColor undefinedColor(0.0f, 1.0f, 0.0f, 1.0f);
+        MStringArray failedTilePaths;
+        texture = textureMgr->acquireTiledTexture(
+            textureName,
+            tilePaths,
+            tilePositions,
+            undefinedColor,
+            maxWidth, maxHeight,
+            failedTilePaths,
+            uvScaleOffset
+        );
+
+        for(unsigned int i=0; i<failedTilePaths.length(); i++)
+        {
+            TF_WARN("Failed to load <UDIM> texture tile %s", failedTilePaths[i].asChar());
+        }
+    }
+    else if (decoded) {
+        texture = textureMgr->acquireTexture(
+            path.c_str(), decoded->_desc, decoded->_texels.data());
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const HdVP2TextureInfoSharedPtr infoPtr = _entries.Find(key);
+    if (!TF_VERIFY(infoPtr)) {
+        HdVP2TextureDeleter()(texture);
+        return;
+    }
+
+    HdVP2TextureInfo& info = *infoPtr;
+    info._texture.reset(texture);
+    info._isPending = false;
+
+    // An explicit source color space overrides the one of the image.
+    if (key.second == _tokens->raw) {
+        info._isColorSpaceSRGB = false;
+    }
+    else if (key.second == _tokens->sRGB) {
+        info._isColorSpaceSRGB = true;
+    }
+    else {
+        info._isColorSpaceSRGB = decoded && decoded->_isColorSpaceSRGB;
+    }
+
+    if (uvScaleOffset.length() > 0) {
+        TF_VERIFY(uvScaleOffset.length() == 4);
+        info._stScale.Set(uvScaleOffset[0], uvScaleOffset[1]); // The first 2 elements are the scale
+        info._stOffset.Set(uvScaleOffset[2], uvScaleOffset[3]);// The next two elements are the offset
+    }
+
+    if (texture) {
+        MHWRender::MTextureDescription desc;
+        texture->textureDescription(desc);
+        _entries.SetLoaded(key, desc.fBytesPerSlice);
+    }
+    else {
+        // The materials bind no texture, but the failure is not cached: the
+        // image is loaded again the next time a material acquires it.
+        _entries.Erase(key);
+    }
+}
+
+PXR_NAMESPACE_CLOSE_SCOPE
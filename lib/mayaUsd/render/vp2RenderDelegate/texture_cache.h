@@ -0,0 +1,127 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef HD_VP2_TEXTURE_CACHE
+#define HD_VP2_TEXTURE_CACHE
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <tbb/task_group.h>
+
+#include <maya/MTextureManager.h>
+
+#include <pxr/pxr.h>
+#include <pxr/base/gf/vec2f.h>
+#include <pxr/base/tf/token.h>
+
+#include "lru_cache.h"
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+class HdVP2ResourceRegistry;
+
+/*! \brief  A deleter for MTexture, for use with smart pointers.
+*/
+struct HdVP2TextureDeleter
+{
+    void operator () (MHWRender::MTexture*);
+};
+
+/*! \brief  A MTexture owned by a std unique pointer.
+*/
+using HdVP2TextureUniquePtr = std::unique_ptr<
+    MHWRender::MTexture,
+    HdVP2TextureDeleter
+>;
+
+/*! \brief  Information about the texture.
+*/
+struct HdVP2TextureInfo
+{
+    HdVP2TextureUniquePtr  _texture;                //!< Unique pointer of the texture
+    GfVec2f                _stScale{1.0f,1.0f};     //!< UV scale for tiled textures
+    GfVec2f                _stOffset{0.0f, 0.0f};   //!< UV offset for tiled textures
+    bool                   _isColorSpaceSRGB{false};//!< Whether sRGB linearization is needed
+    bool                   _isPending{true};        //!< Whether the texture is still loading
+};
+
+/*! \brief  Texture information shared between the texture cache and the materials.
+*/
+using HdVP2TextureInfoSharedPtr = std::shared_ptr<HdVP2TextureInfo>;
+
+/*! \brief  Texture cache shared by all the materials of a render delegate.
+    \class  HdVP2TextureCache
+
+    Textures are keyed by resolved path and source color space, so that an
+    image is decoded once no matter how many materials use it. Images are
+    decoded on worker threads and uploaded to VP2 by commit tasks enqueued in
+    the resource registry. Until then the texture info returned by Acquire()
+    is pending and materials bind the placeholder texture instead.
+
+    Textures not used by any material are released in least recently used
+    order once the cache exceeds the budget set with the
+    MAYAUSD_VP2_TEXTURE_CACHE_BUDGET_MB environment variable. Images which
+    fail to load are not cached, so they are loaded again on next use.
+*/
+class HdVP2TextureCache final
+{
+public:
+    HdVP2TextureCache(HdVP2ResourceRegistry& registry);
+    ~HdVP2TextureCache();
+
+    //! Acquire the texture info for the given image path and color space.
+    //! The info stays pending until the image is decoded and uploaded.
+    HdVP2TextureInfoSharedPtr Acquire(const std::string& path, const TfToken& colorSpace);
+
+    //! Texture to bind while textures are pending. Main thread only.
+    MHWRender::MTexture* GetPlaceholderTexture();
+
+private:
+    HdVP2TextureCache(const HdVP2TextureCache&) = delete;
+    HdVP2TextureCache& operator=(const HdVP2TextureCache&) = delete;
+
+    struct DecodedTexture;
+
+    //! Cache key made of the resolved path and the source color space
+    using Key = std::pair<std::string, TfToken>;
+
+    //! Hash of the cache key
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    static bool _Decode(const std::string& path, DecodedTexture& decoded);
+    void _Upload(const Key& key, const std::shared_ptr<DecodedTexture>& decoded);
+
+    HdVP2ResourceRegistry&  _registry;              //!< Registry used to enqueue the uploads
+
+    HdVP2LruCache<Key, HdVP2TextureInfo, KeyHash> _entries; //!< Cached textures
+    std::mutex              _mutex;                 //!< Protects the entries
+
+    HdVP2TextureUniquePtr   _placeholderTexture;    //!< Texture bound while loading
+
+    tbb::task_group         _decodeTasks;           //!< Image decoding tasks
+    std::atomic<bool>       _canceled{false};       //!< Whether pending decodes should be skipped
+    std::atomic<bool>       _refreshRequested{false};//!< Whether a viewport refresh was requested
+};
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+#endif
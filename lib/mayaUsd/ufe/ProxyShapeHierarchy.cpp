@@ -26,6 +26,7 @@
 
 #include <mayaUsd/ufe/Utils.h>
 #include <mayaUsd/ufe/Global.h>
+#include <mayaUsd/ufe/UsdChildCountCache.h>
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
 #if UFE_PREVIEW_VERSION_NUM >= 2013
@@ -124,7 +125,7 @@ bool ProxyShapeHierarchy::hasChildren() const
 		UFE_LOG("invalid root prim in ProxyShapeHierarchy::hasChildren()");
 		return false;
 	}
-	return !rootPrim.GetChildren().empty();
+	return UsdChildCountCache::hasChildren(rootPrim);
 }
 
 Ufe::SceneItemList ProxyShapeHierarchy::children() const
@@ -134,7 +135,7 @@ Ufe::SceneItemList ProxyShapeHierarchy::children() const
 	if (!rootPrim.IsValid())
 		return Ufe::SceneItemList();
 
-	auto usdChildren = rootPrim.GetChildren();
+	auto usdChildren = filteredChildren(rootPrim);
 	auto parentPath = fItem->path();
 
 	// We must create selection items for our children.  These will have as
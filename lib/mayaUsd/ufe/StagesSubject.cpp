@@ -15,8 +15,12 @@
 //
 #include "StagesSubject.h"
 
+#include <algorithm>
 #include <vector>
 
+#include <maya/MDagMessage.h>
+#include <maya/MDGMessage.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MSceneMessage.h>
 #include <maya/MMessage.h>
 
@@ -24,6 +28,7 @@
 #include <pxr/usd/usdGeom/xformOp.h>
 
 #include <mayaUsd/ufe/ProxyShapeHandler.h>
+#include <mayaUsd/ufe/UsdChildCountCache.h>
 #include <mayaUsd/ufe/UsdStageMap.h>
 #include <mayaUsd/ufe/Utils.h>
 #include <mayaUsd/nodes/proxyShapeBase.h>
@@ -45,6 +50,7 @@
 #endif
 #include <unordered_map>
 #endif
+#include <unordered_set>
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
 namespace {
@@ -58,7 +64,8 @@ bool inAttributeChangedNotificationGuard()
     return attributeChangedNotificationGuardCount > 0;
 }
 
-std::unordered_map<Ufe::Path, std::string> pendingAttributeChangedNotifications;
+// Attributes changed while in the guard, per UFE path.
+std::unordered_map<Ufe::Path, std::unordered_set<std::string>> pendingAttributeChangedNotifications;
 
 }
 #endif
@@ -76,6 +83,8 @@ extern Ufe::Rtid g_USDRtid;
 // StagesSubject
 //------------------------------------------------------------------------------
 
+StagesSubject::NotificationCounters StagesSubject::fNotificationCounters;
+
 StagesSubject::StagesSubject()
 {
 	// Workaround to MAYA-65920: at startup, MSceneMessage.kAfterNew file
@@ -99,6 +108,17 @@ StagesSubject::StagesSubject()
 					MSceneMessage::kAfterNew, afterNewCallback, this, &res));
 	CHECK_MSTATUS(res);
 
+	// Keep the proxy shape paths of the stage map up to date.
+	fCbIds.append(MDagMessage::addAllDagChangesCallback(
+					dagChangedCallback, this, &res));
+	CHECK_MSTATUS(res);
+	fCbIds.append(MNodeMessage::addNameChangedCallback(
+					MObject::kNullObj, nameChangedCallback, this, &res));
+	CHECK_MSTATUS(res);
+	fCbIds.append(MDGMessage::addNodeRemovedCallback(
+					nodeRemovedCallback, "dagNode", this, &res));
+	CHECK_MSTATUS(res);
+
 	TfWeakPtr<StagesSubject> me(this);
 	TfNotice::Register(me, &StagesSubject::onStageSet);
 	TfNotice::Register(me, &StagesSubject::onStageInvalidate);
@@ -160,6 +180,28 @@ void StagesSubject::afterOpenCallback(void* clientData)
 	ss->afterOpen();
 }
 
+/*static*/
+void StagesSubject::dagChangedCallback(
+	MDagMessage::DagMessage /*msgType*/, MDagPath& /*child*/,
+	MDagPath& /*parent*/, void* /*clientData*/)
+{
+	g_StageMap.setPathsDirty();
+}
+
+/*static*/
+void StagesSubject::nameChangedCallback(
+	MObject& node, const MString& /*prevName*/, void* /*clientData*/)
+{
+	if (node.hasFn(MFn::kDagNode))
+		g_StageMap.setPathsDirty();
+}
+
+/*static*/
+void StagesSubject::nodeRemovedCallback(MObject& /*node*/, void* /*clientData*/)
+{
+	g_StageMap.setPathsDirty();
+}
+
 void StagesSubject::afterOpen()
 {
 	// Observe stage changes, for all stages.  Return listener object can
@@ -181,31 +223,81 @@ void StagesSubject::afterOpen()
 	// - convert the Dag paths to UFE paths.
 	// - get their stage.
 	g_StageMap.setDirty();
+
+	// The stages may have changed, so forget their cached child counts.
+	UsdChildCountCache::clear();
 }
 
 void StagesSubject::stageChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
 {
+	// When visibility is toggled for the first time or you add a xformop we enter
+	// here with a resync path. However the changedPath is not a prim path, so we
+	// don't care about it. In those cases, the changePath will contain something like:
+	//   "/<prim>.visibility"
+	//   "/<prim>.xformOp:translate"
+	// The absolute root path is resynced when the layer stack changes (e.g.
+	// a sub layer is added, removed or muted, or the stage is reloaded): it
+	// is not a prim path, but it invalidates all the cached child counts of
+	// the stage.
+	SdfPathVector resyncedPrimPaths;
+	SdfPathVector resyncedCachePaths;
+	for (const auto& changedPath : notice.GetResyncedPaths())
+	{
+		if (changedPath.IsPrimPath())
+			resyncedPrimPaths.push_back(changedPath);
+		if (changedPath.IsAbsoluteRootOrPrimPath())
+			resyncedCachePaths.push_back(changedPath);
+	}
+
+	// The cached child counts must be up to date before observers
+	// of the notifications below query the hierarchy, and even if no
+	// notification is sent.
+	UsdChildCountCache::invalidate(sender, resyncedCachePaths);
+
+	// Assume proxy shapes (and thus stages) cannot be instanced.  We can
+	// therefore map the stage to a single UFE path.  Lifting this
+	// restriction would mean sending one add or delete notification for
+	// each Maya Dag path instancing the proxy shape / stage.
+	const Ufe::Path proxyShapePath = stagePath(sender);
+
 	// If the stage path has not been initialized yet, do nothing 
-	if (stagePath(sender).empty())
+	if (proxyShapePath.empty())
 		return;
 
 	auto stage = notice.GetStage();
-	for (const auto& changedPath : notice.GetResyncedPaths())
+
+	std::vector<std::pair<SdfPath, bool>> resyncRoots;
+#if UFE_PREVIEW_VERSION_NUM >= 2014
+	// A variant switch or a payload load can resync thousands of prims.
+	// Only notify for the resync roots: their descendants are covered by the
+	// subtree invalidate notification of the root.  Descendants directly
+	// follow their root once the paths are sorted.
+	std::sort(resyncedPrimPaths.begin(), resyncedPrimPaths.end());
+	for (const auto& changedPath : resyncedPrimPaths)
 	{
-		// When visibility is toggled for the first time or you add a xformop we enter
-		// here with a resync path. However the changedPath is not a prim path, so we
-		// don't care about it. In those cases, the changePath will contain something like:
-		//   "/<prim>.visibility"
-		//   "/<prim>.xformOp:translate"
-		if (!changedPath.IsPrimPath())
+		if (!resyncRoots.empty() && changedPath.HasPrefix(resyncRoots.back().first))
+		{
+			resyncRoots.back().second = true;
+			++fNotificationCounters.suppressed;
 			continue;
+		}
+		resyncRoots.emplace_back(changedPath, false);
+	}
+#else
+	// Without subtree invalidate notifications, nothing would cover the
+	// descendants of a resynced prim, so every resynced prim is notified.
+	resyncRoots.reserve(resyncedPrimPaths.size());
+	for (const auto& changedPath : resyncedPrimPaths)
+		resyncRoots.emplace_back(changedPath, false);
+#endif
+
+	for (const auto& resyncRoot : resyncRoots)
+	{
+		const SdfPath& changedPath = resyncRoot.first;
+		const bool hasResyncedDescendants = resyncRoot.second;
 
 		const std::string& usdPrimPathStr = changedPath.GetPrimPath().GetString();
-		// Assume proxy shapes (and thus stages) cannot be instanced.  We can
-		// therefore map the stage to a single UFE path.  Lifting this
-		// restriction would mean sending one add or delete notification for
-		// each Maya Dag path instancing the proxy shape / stage.
-		Ufe::Path ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+		Ufe::Path ufePath = proxyShapePath + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
 		auto prim = stage->GetPrimAtPath(changedPath);
 		if (prim.IsValid() && !InPathChange::inPathChange())
 		{
@@ -221,25 +313,29 @@ void StagesSubject::stageChanged(UsdNotice::ObjectsChanged const& notice, UsdSta
 
 			if (prim.IsActive())
 			{
-				if (InAddOrRemoveReference::inAddOrRemoveReference())
+				if (InAddOrRemoveReference::inAddOrRemoveReference() || hasResyncedDescendants)
 				{
 #if UFE_PREVIEW_VERSION_NUM >= 2014
-					// When we are in an add or remove reference we send the
-					// UFE subtree invalidate notif instead.
+					// When we are in an add or remove reference, or when
+					// descendants were resynced along with the prim, we send
+					// the UFE subtree invalidate notif instead.
 					auto notification = Ufe::SubtreeInvalidate(sceneItem);
 					Ufe::Scene::notifySubtreeInvalidate(notification);
+					++fNotificationCounters.sent;
 #endif
 				}
 				else
 				{
 					auto notification = Ufe::ObjectAdd(sceneItem);
 					Ufe::Scene::notifyObjectAdd(notification);
+					++fNotificationCounters.sent;
 				}
 			}
 			else
 			{
 				auto notification = Ufe::ObjectPostDelete(sceneItem);
 				Ufe::Scene::notifyObjectDelete(notification);
+				++fNotificationCounters.sent;
 			}
 		}
 #if UFE_PREVIEW_VERSION_NUM >= 2015
@@ -247,14 +343,26 @@ void StagesSubject::stageChanged(UsdNotice::ObjectsChanged const& notice, UsdSta
 		{
 			auto notification = Ufe::ObjectDestroyed(ufePath);
 			Ufe::Scene::notifyObjectDelete(notification);
+			++fNotificationCounters.sent;
 		}
 #endif
 	}
 
+	// Several properties of the same prim usually change together (e.g. the
+	// translate, rotate and scale xformOps), so the prim UFE path is only
+	// built once, and a single transform changed notification is sent per
+	// prim.
+	SdfPath lastPrimPath;
+	Ufe::Path ufePath;
+	std::unordered_set<SdfPath, SdfPath::Hash> transformChangedPrims;
 	for (const auto& changedPath : notice.GetChangedInfoOnlyPaths())
 	{
-		auto usdPrimPathStr = changedPath.GetPrimPath().GetString();
-		auto ufePath = stagePath(sender) + Ufe::PathSegment(usdPrimPathStr, g_USDRtid, '/');
+		const SdfPath primPath = changedPath.GetPrimPath();
+		if (primPath != lastPrimPath || ufePath.empty())
+		{
+			ufePath = proxyShapePath + Ufe::PathSegment(primPath.GetString(), g_USDRtid, '/');
+			lastPrimPath = primPath;
+		}
 
 #ifdef UFE_V2_FEATURES_AVAILABLE
 		// isPrimPropertyPath() does not consider relational attributes
@@ -262,11 +370,14 @@ void StagesSubject::stageChanged(UsdNotice::ObjectsChanged const& notice, UsdSta
 		// isRelationalAttributePath() considers only relational attributes
 		if (changedPath.IsPrimPropertyPath()) {
 			if (inAttributeChangedNotificationGuard()) {
-				pendingAttributeChangedNotifications[ufePath] =
-					changedPath.GetName();
+				if (!pendingAttributeChangedNotifications[ufePath].insert(
+						changedPath.GetName()).second) {
+					++fNotificationCounters.suppressed;
+				}
 			}
 			else {
 				Ufe::Attributes::notify(ufePath, changedPath.GetName());
+				++fNotificationCounters.sent;
 			}
 		}
 
@@ -276,6 +387,7 @@ void StagesSubject::stageChanged(UsdNotice::ObjectsChanged const& notice, UsdSta
 		{
 			Ufe::VisibilityChanged vis(ufePath);
 			Ufe::Object3d::notify(vis);
+			++fNotificationCounters.sent;
 		}
 #endif
 #endif
@@ -286,11 +398,31 @@ void StagesSubject::stageChanged(UsdNotice::ObjectsChanged const& notice, UsdSta
 		const TfToken nameToken = changedPath.GetNameToken();
 		if(nameToken == UsdGeomTokens->xformOpOrder || UsdGeomXformOp::IsXformOp(nameToken))
 		{
-			Ufe::Transform3d::notify(ufePath);
+			if (transformChangedPrims.insert(primPath).second)
+			{
+				Ufe::Transform3d::notify(ufePath);
+				++fNotificationCounters.sent;
+			}
+			else
+			{
+				++fNotificationCounters.suppressed;
+			}
 		}
 	}
 }
 
+/*static*/
+const StagesSubject::NotificationCounters& StagesSubject::notificationCounters()
+{
+	return fNotificationCounters;
+}
+
+/*static*/
+void StagesSubject::resetNotificationCounters()
+{
+	fNotificationCounters = NotificationCounters();
+}
+
 void StagesSubject::onStageSet(const MayaUsdProxyStageSetNotice& notice)
 {
 	// We should have no listerners and stage map is dirty.
@@ -343,7 +475,10 @@ AttributeChangedNotificationGuard::~AttributeChangedNotificationGuard()
 	}
 
 	for (const auto& notificationInfo : pendingAttributeChangedNotifications) {
-		Ufe::Attributes::notify(notificationInfo.first, notificationInfo.second);
+		for (const auto& attributeName : notificationInfo.second) {
+			Ufe::Attributes::notify(notificationInfo.first, attributeName);
+			++StagesSubject::fNotificationCounters.sent;
+		}
 	}
 
 	pendingAttributeChangedNotifications.clear();
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <maya/MCallbackIdArray.h>
+#include <maya/MDagMessage.h>
 
 #include <ufe/ufe.h>            // For UFE_V2_FEATURES_AVAILABLE
 
@@ -37,7 +38,8 @@ namespace ufe {
 /*!
 	This class observes Maya file open, to register a USD observer on each
 	stage the Maya scene contains.  This USD observer translates USD
-	notifications into UFE notifications.
+	notifications into UFE notifications.  It also observes Dag changes to
+	keep the proxy shape paths of the stage map up to date.
  */
 class MAYAUSD_CORE_PUBLIC StagesSubject : public TfWeakBase
 {
@@ -64,6 +66,19 @@ public:
 
 	void afterOpen();
 
+	//! \brief Counters of the UFE notifications translated from USD notices.
+	struct NotificationCounters
+	{
+		size_t sent{0};       //!< Notifications sent to the UFE observers.
+		size_t suppressed{0}; //!< Notifications covered by another one and not sent.
+	};
+
+	//! Return the notification counters, accumulated since the last reset.
+	static const NotificationCounters& notificationCounters();
+
+	//! Reset the notification counters.
+	static void resetNotificationCounters();
+
 private:
 	// Maya scene message callbacks
 	static void beforeNewCallback(void* clientData);
@@ -71,6 +86,13 @@ private:
 	static void afterNewCallback(void* clientData);
 	static void afterOpenCallback(void* clientData);
 
+	// Maya Dag message callbacks
+	static void dagChangedCallback(MDagMessage::DagMessage msgType,
+		MDagPath& child, MDagPath& parent, void* clientData);
+	static void nameChangedCallback(MObject& node, const MString& prevName,
+		void* clientData);
+	static void nodeRemovedCallback(MObject& node, void* clientData);
+
 	//! Call the stageChanged() methods on stage observers.
 	void stageChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender);
 
@@ -87,6 +109,10 @@ private:
 
 	bool fBeforeNewCallback = false;
 
+	static NotificationCounters fNotificationCounters;
+
+	friend class AttributeChangedNotificationGuard;
+
 	MCallbackIdArray fCbIds;
 
 }; // StagesSubject
@@ -97,9 +123,8 @@ private:
 	Instantiating an object of this class allows the attribute changed
 	notifications to be delayed until the guard expires.
 
-    The guard collapses down notifications for a given UFE path, which is
-	desirable to avoid duplicate notifications.  However, it is an error to
-	have notifications for more than one attribute within a single guard.
+    The guard collapses down notifications for a given UFE path and
+	attribute, which is desirable to avoid duplicate notifications.
  */
 class MAYAUSD_CORE_PUBLIC AttributeChangedNotificationGuard {
 public:
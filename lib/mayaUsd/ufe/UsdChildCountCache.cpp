@@ -0,0 +1,155 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "UsdChildCountCache.h"
+
+#include <iterator>
+#include <map>
+#include <unordered_map>
+
+#include <pxr/base/tf/hash.h>
+
+namespace {
+
+// Counting the children is only done when the count itself is needed, so an
+// entry can be known to have children without a known count.
+constexpr std::size_t kUnknownCount = static_cast<std::size_t>(-1);
+
+struct ChildCount
+{
+	bool hasChildren;
+	std::size_t count;
+};
+
+// Prim paths are ordered so that the descendants of a path directly follow
+// it, which allows invalidating a whole subtree with a single erase.
+using PrimChildCounts = std::map<SdfPath, ChildCount>;
+using StageChildCounts = std::unordered_map<UsdStageWeakPtr, PrimChildCounts, TfHash>;
+
+StageChildCounts stageChildCounts;
+
+PrimChildCounts& stageEntries(const UsdStageWeakPtr& stage)
+{
+	auto found = stageChildCounts.find(stage);
+	if (found != stageChildCounts.end())
+		return found->second;
+
+	// The map only grows when a stage is seen for the first time, so this
+	// is where the entries of the stages destroyed since are dropped.
+	for (auto it = stageChildCounts.begin(); it != stageChildCounts.end();)
+	{
+		if (it->first.IsExpired())
+			it = stageChildCounts.erase(it);
+		else
+			++it;
+	}
+	return stageChildCounts[stage];
+}
+
+ChildCount& childCountEntry(const UsdPrim& prim)
+{
+	PrimChildCounts& counts = stageEntries(prim.GetStage());
+	auto found = counts.find(prim.GetPath());
+	if (found == counts.end())
+	{
+		const bool hasChildren = !MayaUsd::ufe::filteredChildren(prim).empty();
+		found = counts.emplace(prim.GetPath(),
+			ChildCount{hasChildren, hasChildren ? kUnknownCount : 0}).first;
+	}
+	return found->second;
+}
+
+}
+
+MAYAUSD_NS_DEF {
+namespace ufe {
+
+UsdPrimSiblingRange filteredChildren(const UsdPrim& prim)
+{
+	// We need to be able to traverse down to instance proxies, so turn
+	// on that part of the predicate, since by default, it is off. Since
+	// the equivalent of GetChildren is
+	// GetFilteredChildren( UsdPrimDefaultPredicate ),
+	// we will use that as the initial value.
+	//
+	Usd_PrimFlagsPredicate predicate = UsdPrimDefaultPredicate;
+	predicate = predicate.TraverseInstanceProxies(true);
+	return prim.GetFilteredChildren(predicate);
+}
+
+//------------------------------------------------------------------------------
+// UsdChildCountCache
+//------------------------------------------------------------------------------
+
+/*static*/
+bool UsdChildCountCache::hasChildren(const UsdPrim& prim)
+{
+	return childCountEntry(prim).hasChildren;
+}
+
+/*static*/
+std::size_t UsdChildCountCache::childCount(const UsdPrim& prim)
+{
+	ChildCount& entry = childCountEntry(prim);
+	if (entry.count == kUnknownCount)
+	{
+		const auto children = filteredChildren(prim);
+		entry.count = std::distance(children.begin(), children.end());
+	}
+	return entry.count;
+}
+
+/*static*/
+void UsdChildCountCache::invalidate(const UsdStageWeakPtr& stage, const SdfPathVector& resyncedPaths)
+{
+	auto stageCounts = stageChildCounts.find(stage);
+	if (stageCounts == stageChildCounts.end())
+		return;
+
+	PrimChildCounts& counts = stageCounts->second;
+	for (const auto& resyncedPath : resyncedPaths)
+	{
+		if (resyncedPath == SdfPath::AbsoluteRootPath())
+		{
+			stageChildCounts.erase(stageCounts);
+			return;
+		}
+
+		// A resynced prim may have been added or removed, which changes the
+		// children of its parent, and its own subtree may have changed.
+		counts.erase(resyncedPath.GetParentPath());
+
+		auto first = counts.lower_bound(resyncedPath);
+		auto last = first;
+		while (last != counts.end() && last->first.HasPrefix(resyncedPath))
+			++last;
+		counts.erase(first, last);
+	}
+}
+
+/*static*/
+void UsdChildCountCache::clear(const UsdStageWeakPtr& stage)
+{
+	stageChildCounts.erase(stage);
+}
+
+/*static*/
+void UsdChildCountCache::clear()
+{
+	stageChildCounts.clear();
+}
+
+} // namespace ufe
+} // namespace MayaUsd
@@ -0,0 +1,71 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <mayaUsd/base/api.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+MAYAUSD_NS_DEF {
+namespace ufe {
+
+//! Return the children of the argument prim that are shown in the UFE
+//! hierarchy, including instance proxies.
+MAYAUSD_CORE_PUBLIC
+UsdPrimSiblingRange filteredChildren(const UsdPrim& prim);
+
+//! \brief Cache of the number of UFE hierarchy children of USD prims.
+/*!
+	The Outliner asks each visible item whether it has children, which
+	requires going through the children of its prim to find one that is
+	shown, and the count of a prim with many children requires going through
+	all of them.  The answers are cached per stage and prim path, and are
+	invalidated by the StagesSubject from the resynced paths of
+	UsdNotice::ObjectsChanged, since the children of a prim only change
+	through a resync of the prim itself, one of its children, or one of its
+	ancestors.  A resync of the absolute root path, e.g. when the layer stack
+	changes, invalidates the whole stage.  The answers of a stage are also
+	dropped once the stage has been destroyed.
+*/
+class MAYAUSD_CORE_PUBLIC UsdChildCountCache
+{
+public:
+	//! Return true if filteredChildren() of the argument prim is not empty.
+	static bool hasChildren(const UsdPrim& prim);
+
+	//! Return the number of children of the argument prim, as returned by
+	//! filteredChildren().
+	static std::size_t childCount(const UsdPrim& prim);
+
+	//! Invalidate the answers affected by the argument resynced paths, which
+	//! are prim paths or the absolute root path.
+	static void invalidate(const UsdStageWeakPtr& stage, const SdfPathVector& resyncedPaths);
+
+	//! Forget all answers of the argument stage.
+	static void clear(const UsdStageWeakPtr& stage);
+
+	//! Forget all answers.
+	static void clear();
+}; // UsdChildCountCache
+
+} // namespace ufe
+} // namespace MayaUsd
@@ -28,6 +28,7 @@
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/base/tf/stringUtils.h>
 
+#include <mayaUsd/ufe/UsdChildCountCache.h>
 #include <mayaUsd/ufe/Utils.h>
 
 #include <mayaUsdUtils/util.h>
@@ -42,22 +43,6 @@
 #endif
 #endif
 
-namespace {
-	UsdPrimSiblingRange filteredChildren( const UsdPrim& prim )
-	{
-		// We need to be able to traverse down to instance proxies, so turn
-		// on that part of the predicate, since by default, it is off. Since
-		// the equivalent of GetChildren is
-		// GetFilteredChildren( UsdPrimDefaultPredicate ),
-		// we will use that as the initial value.
-		//
-		Usd_PrimFlagsPredicate predicate = UsdPrimDefaultPredicate;
-		predicate = predicate.TraverseInstanceProxies(true);
-		return prim.GetFilteredChildren(predicate);
-	}
-
-}
-
 MAYAUSD_NS_DEF {
 namespace ufe {
 
@@ -103,7 +88,7 @@ Ufe::SceneItem::Ptr UsdHierarchy::sceneItem() const
 
 bool UsdHierarchy::hasChildren() const
 {
-	return !filteredChildren(fPrim).empty();
+	return UsdChildCountCache::hasChildren(fPrim);
 }
 
 Ufe::SceneItemList UsdHierarchy::children() const
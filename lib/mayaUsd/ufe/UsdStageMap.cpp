@@ -40,16 +40,19 @@ MObjectHandle proxyShapeHandle(const Ufe::Path& path)
 }
 
 // Assuming proxy shape nodes cannot be instanced, simply return the first path.
+// Returns an empty path if the node is not in the Dag, e.g. deleted but kept
+// alive by the undo queue.
 Ufe::Path firstPath(const MObjectHandle& handle)
 {
-	if (!TF_VERIFY(handle.isValid(),
-				   "Cannot get path from invalid object handle")) {
+	if (!handle.isAlive()) {
 		return Ufe::Path();
 	}
 
 	MDagPath dagPath;
 	auto status = MFnDagNode(handle.object()).getPath(dagPath);
-	CHECK_MSTATUS(status);
+	if (!status || !dagPath.isValid()) {
+		return Ufe::Path();
+	}
 	return MayaUsd::ufe::dagPathToUfe(dagPath);
 }
 
@@ -92,32 +95,57 @@ void UsdStageMap::addItem(const Ufe::Path& path, UsdStageWeakPtr stage)
 	// but since it's given here, simply store it.
 	fObjectToStage[proxyShape] = stage;
 	fStageToObject[stage] = proxyShape;
+	fPathToObject[path] = proxyShape;
+	fObjectToPath[proxyShape] = path;
 }
 
 UsdStageWeakPtr UsdStageMap::stage(const Ufe::Path& path)
 {
 	rebuildIfDirty();
+	if (fPathsDirty) {
+		rebuildPaths();
+	}
 
-	auto proxyShape = proxyShapeHandle(path);
-	if (!proxyShape.isValid()) {
-		return nullptr;
+	MObjectHandle proxyShape;
+	auto pathIter = fPathToObject.find(path);
+	if (pathIter != std::end(fPathToObject)) {
+		proxyShape = pathIter->second;
+	}
+	else {
+		// The path may have changed before we got notified, resolve it
+		// through the Dag.
+		proxyShape = proxyShapeHandle(path);
+		if (!proxyShape.isValid()) {
+			return nullptr;
+		}
 	}
 
 	// A stage is bound to a single Dag proxy shape.
 	auto iter = fObjectToStage.find(proxyShape);
-	if (iter != std::end(fObjectToStage))
-		return iter->second;
-	return nullptr;
+	if (iter == std::end(fObjectToStage))
+		return nullptr;
+
+	if (pathIter == std::end(fPathToObject)) {
+		rebuildPaths();
+	}
+	return iter->second;
 }
 
 Ufe::Path UsdStageMap::path(UsdStageWeakPtr stage)
 {
 	rebuildIfDirty();
+	if (fPathsDirty) {
+		rebuildPaths();
+	}
 
 	// A stage is bound to a single Dag proxy shape.
 	auto iter = fStageToObject.find(stage);
-	if (iter != std::end(fStageToObject))
-		return firstPath(iter->second);
+	if (iter == std::end(fStageToObject))
+		return Ufe::Path();
+
+	auto pathIter = fObjectToPath.find(iter->second);
+	if (pathIter != std::end(fObjectToPath))
+		return pathIter->second;
 	return Ufe::Path();
 }
 
@@ -125,7 +153,28 @@ void UsdStageMap::setDirty()
 {
 	fObjectToStage.clear();
 	fStageToObject.clear();
+	fPathToObject.clear();
+	fObjectToPath.clear();
 	fDirty = true;
+	fPathsDirty = true;
+}
+
+void UsdStageMap::rebuildPaths()
+{
+	fPathToObject.clear();
+	fObjectToPath.clear();
+
+	// Proxy shapes deleted but kept by the undo queue have no path, but keep
+	// their stage in case the deletion is undone.
+	for (const auto& entry : fObjectToStage)
+	{
+		Ufe::Path ufePath = firstPath(entry.first);
+		if (ufePath.empty())
+			continue;
+		fPathToObject[ufePath] = entry.first;
+		fObjectToPath[entry.first] = std::move(ufePath);
+	}
+	fPathsDirty = false;
 }
 
 void UsdStageMap::rebuildIfDirty()
@@ -141,6 +190,7 @@ void UsdStageMap::rebuildIfDirty()
 		addItem(ufePath, stage);
 	}
 	fDirty = false;
+	fPathsDirty = false;
 }
 
 } // namespace ufe
@@ -46,13 +46,18 @@ namespace ufe {
 
 	We will assume that	a USD proxy shape will not be instanced (even though
 	nothing in the data model prevents it).  To support renaming and repathing,
-	we store an MObjectHandle in the maps, which is invariant to renaming and
-	repathing, and compute the path on access.  This is slower than a scheme
-	where we cache using the Ufe::Path, but such a cache must be refreshed on
-	rename and repath, which is non-trivial, since there is no guarantee on the
-	order of notification of Ufe observers.  An earlier implementation with
-	rename observation had the Maya Outliner (which observes rename) access the
-	UsdStageMap on rename before the UsdStageMap had been updated.
+	the stages are stored against an MObjectHandle, which is invariant to
+	renaming and repathing.
+
+	Since resolving a UFE path to a Maya node is expensive, and stage lookup
+	is done for every USD scene item, the UFE path of each proxy shape is also
+	cached in a hash map.  Dag rename, reparent and delete callbacks only flag
+	this path cache as stale, and it is recomputed from the object handles on
+	the next access, which costs one Dag path query per proxy shape.  There is
+	no guarantee on the order of notification of Maya callbacks and Ufe
+	observers (e.g. the Maya Outliner observes rename), so a path missing from
+	the cache is still resolved through the Dag, and triggers a refresh of the
+	cache if it resolves to a known proxy shape.
 */
 class MAYAUSD_CORE_PUBLIC UsdStageMap
 {
@@ -79,17 +84,27 @@ public:
 	//! Returns true if the stage map is dirty (meaning it needs to be filled in).
 	bool isDirty() const { return fDirty; }
 
+	//! Set the cached proxy shape paths as stale, following a Dag rename,
+	//! reparent or delete.  The stages themselves are kept.
+	void setPathsDirty() { fPathsDirty = true; }
+
 private:
 	void addItem(const Ufe::Path& path, UsdStageWeakPtr stage);
 	void rebuildIfDirty();
+	void rebuildPaths();
 
 private:
 	// We keep two maps for fast lookup when there are many proxy shapes.
 	using ObjectToStage = std::unordered_map<MObjectHandle, UsdStageWeakPtr>;
 	using StageToObject = TfHashMap<UsdStageWeakPtr, MObjectHandle, TfHash>;
+	using PathToObject = std::unordered_map<Ufe::Path, MObjectHandle>;
+	using ObjectToPath = std::unordered_map<MObjectHandle, Ufe::Path>;
 	ObjectToStage fObjectToStage;
 	StageToObject fStageToObject;
+	PathToObject fPathToObject;
+	ObjectToPath fObjectToPath;
 	bool fDirty{true};
+	bool fPathsDirty{true};
 
 }; // UsdStageMap
 
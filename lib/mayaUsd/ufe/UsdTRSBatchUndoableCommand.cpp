@@ -0,0 +1,233 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "UsdTRSBatchUndoableCommand.h"
+
+#include <stdexcept>
+
+#include <ufe/log.h>
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/vt/value.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/propertySpec.h>
+#include <pxr/usd/usd/editTarget.h>
+#include <pxr/usd/usd/stage.h>
+
+#include "private/SceneItemPathTracker.h"
+#include "private/Utils.h"
+
+namespace {
+
+using namespace MayaUsd::ufe;
+using Operation = UsdTRSBatchUndoableCommand::Operation;
+
+const TfToken xlate("xformOp:translate");
+const TfToken rotXYZ("xformOp:rotateXYZ");
+const TfToken scaleTok("xformOp:scale");
+
+const TfToken& attributeName(Operation operation)
+{
+	switch (operation)
+	{
+	case Operation::Translate: return xlate;
+	case Operation::Rotate: return rotXYZ;
+	default: return scaleTok;
+	}
+}
+
+// Set the value of the attribute through the common transform API, which
+// adds the attribute and its transform op if needed.
+void perform(Operation operation, const UsdPrim& prim, const Ufe::Path& path, const GfVec3d& v)
+{
+	switch (operation)
+	{
+	case Operation::Translate: translateOp(prim, path, v[0], v[1], v[2]); break;
+	case Operation::Rotate: rotateOp(prim, path, v[0], v[1], v[2]); break;
+	default: scaleOp(prim, path, v[0], v[1], v[2]); break;
+	}
+}
+
+// As of 9-Apr-2020, rotate and scale use GfVec3f and translate uses GfVec3d.
+VtValue toValue(Operation operation, const GfVec3d& v)
+{
+	return operation == Operation::Translate ? VtValue(v) : VtValue(GfVec3f(v));
+}
+
+GfVec3d getValue(Operation operation, const UsdAttribute& attr)
+{
+	if (operation == Operation::Translate)
+	{
+		GfVec3d value(0.0);
+		attr.Get(&value);
+		return value;
+	}
+	GfVec3f value(0.0f);
+	attr.Get(&value);
+	return GfVec3d(value);
+}
+
+}
+
+MAYAUSD_NS_DEF {
+namespace ufe {
+
+UsdTRSBatchUndoableCommand::UsdTRSBatchUndoableCommand(Operation operation)
+	: Ufe::UndoableCommand()
+	, fOperation(operation)
+{
+}
+
+UsdTRSBatchUndoableCommand::~UsdTRSBatchUndoableCommand()
+{
+	if (fTracked)
+	{
+		for (auto& item : fItems)
+			SceneItemPathTracker::untrack(&item);
+	}
+}
+
+/*static*/
+UsdTRSBatchUndoableCommand::Ptr UsdTRSBatchUndoableCommand::create(
+	Operation operation, const Ufe::Selection& selection)
+{
+	// shared_ptr requires public ctor, dtor, so derive a class for it.
+	struct MakeSharedEnabler : public UsdTRSBatchUndoableCommand {
+		MakeSharedEnabler(Operation operation) : UsdTRSBatchUndoableCommand(operation) {}
+	};
+	auto cmd = std::make_shared<MakeSharedEnabler>(operation);
+
+	for (const auto& item : selection)
+	{
+		if (auto usdItem = std::dynamic_pointer_cast<UsdSceneItem>(item))
+			cmd->addItem(usdItem);
+	}
+
+	// The items are tracked by address, so only once they are all added.
+	for (auto& item : cmd->fItems)
+		SceneItemPathTracker::track(&item);
+	cmd->fTracked = true;
+
+	return cmd;
+}
+
+void UsdTRSBatchUndoableCommand::addItem(const UsdSceneItem::Ptr& item)
+{
+	auto prim = item->prim();
+	try {
+		// Since we want to change xformOp:rotateXYZ, and we need to store the
+		// previous rotation for undo purposes, we need to make sure we convert
+		// it to common API xformOps (In case we have rotateX, rotateY or
+		// rotateZ ops)
+		if (fOperation == Operation::Rotate && !UsdGeomXformCommonAPI(prim))
+			convertToCompatibleCommonAPI(prim);
+
+		// If prim does not have the attribute, add it.
+		if (!prim.HasAttribute(attributeName(fOperation)))
+			perform(fOperation, prim, item->path(), GfVec3d(fOperation == Operation::Scale ? 1.0 : 0.0));
+	}
+	catch (const std::exception& e) {
+		std::string err = TfStringPrintf("Ignoring prim %s in transform command - %s",
+			item->path().string().c_str(), e.what());
+		UFE_LOG(err.c_str());
+		return;
+	}
+
+	auto attr = prim.GetAttribute(attributeName(fOperation));
+	fItems.push_back(item);
+	fAttributes.push_back(attr);
+	fPrevValues.push_back(getValue(fOperation, attr));
+}
+
+UsdAttribute UsdTRSBatchUndoableCommand::attribute(std::size_t index)
+{
+	UsdAttribute& attr = fAttributes[index];
+	const auto& item = fItems[index];
+	auto prim = item->prim();
+	if (attr && attr.GetPrimPath() == prim.GetPath())
+		return attr;
+
+	if (!prim)
+		return UsdAttribute();
+
+	if (!prim.HasAttribute(attributeName(fOperation)))
+		perform(fOperation, prim, item->path(), fPrevValues[index]);
+
+	attr = prim.GetAttribute(attributeName(fOperation));
+	return attr;
+}
+
+void UsdTRSBatchUndoableCommand::setValues(const std::vector<GfVec3d>& values)
+{
+	// It is not safe to use the Usd API while a change block is open, so
+	// attributes are fetched and their specs found first.  Attributes
+	// without a spec in the edit target are set through Usd, which creates
+	// the spec, so that the next updates are batched.
+	std::vector<SdfPropertySpecHandle> specs(fItems.size());
+	for (std::size_t i = 0; i < fItems.size(); ++i)
+	{
+		auto attr = attribute(i);
+		if (!attr)
+			continue;
+
+		specs[i] = attr.GetStage()->GetEditTarget().GetPropertySpecForScenePath(attr.GetPath());
+		if (!specs[i])
+			attr.Set(toValue(fOperation, values[i]));
+	}
+
+	SdfChangeBlock changeBlock;
+	for (std::size_t i = 0; i < fItems.size(); ++i)
+	{
+		if (specs[i])
+			specs[i]->SetDefaultValue(toValue(fOperation, values[i]));
+	}
+}
+
+bool UsdTRSBatchUndoableCommand::set(const std::vector<GfVec3d>& values)
+{
+	if (values.size() != fItems.size())
+		return false;
+
+	fNewValues = values;
+	setValues(fNewValues);
+	return true;
+}
+
+void UsdTRSBatchUndoableCommand::set(double x, double y, double z)
+{
+	fNewValues.assign(fItems.size(), GfVec3d(x, y, z));
+	setValues(fNewValues);
+}
+
+//------------------------------------------------------------------------------
+// Ufe::UndoableCommand overrides
+//------------------------------------------------------------------------------
+
+void UsdTRSBatchUndoableCommand::undo()
+{
+	setValues(fPrevValues);
+	// Todo : We would want to remove the xformOp
+	// (SD-06/07/2018) Haven't found a clean way to do it - would need to investigate
+}
+
+void UsdTRSBatchUndoableCommand::redo()
+{
+	if (!fNewValues.empty())
+		setValues(fNewValues);
+}
+
+} // namespace ufe
+} // namespace MayaUsd
@@ -0,0 +1,116 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <ufe/selection.h>
+#include <ufe/undoableCommand.h>
+
+#include <pxr/base/gf/vec3d.h>
+#include <pxr/usd/usd/attribute.h>
+
+#include <mayaUsd/base/api.h>
+#include <mayaUsd/ufe/UsdSceneItem.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+MAYAUSD_NS_DEF {
+namespace ufe {
+
+//! \brief Translate, rotate or scale command of many prims.
+/*!
+	Manipulating a large selection with one UsdTranslateUndoableCommand,
+	UsdRotateUndoableCommand or UsdScaleUndoableCommand per item sends one
+	USD change notification per item on each update.  This command holds
+	the attributes and the previous and new values of all items in parallel
+	arrays, and sets all values of an update in a single SdfChangeBlock, so
+	that each update sends a single notification.
+
+	As with the single item commands, the attribute is created on the items
+	that do not have it yet when the command is created, and the scene items
+	are tracked in case their path changes before the command is used.
+	Items whose transform stack cannot be converted to the common transform
+	API are left out of the command.
+
+	The command is available in Python as mayaUsd.ufe.TRSBatchCommand, which
+	creates it from the global selection.
+ */
+class MAYAUSD_CORE_PUBLIC UsdTRSBatchUndoableCommand : public Ufe::UndoableCommand
+{
+public:
+	typedef std::shared_ptr<UsdTRSBatchUndoableCommand> Ptr;
+
+	enum class Operation { Translate, Rotate, Scale };
+
+	~UsdTRSBatchUndoableCommand() override;
+
+	UsdTRSBatchUndoableCommand(const UsdTRSBatchUndoableCommand&) = delete;
+	UsdTRSBatchUndoableCommand& operator=(const UsdTRSBatchUndoableCommand&) = delete;
+	UsdTRSBatchUndoableCommand(UsdTRSBatchUndoableCommand&&) = delete;
+	UsdTRSBatchUndoableCommand& operator=(UsdTRSBatchUndoableCommand&&) = delete;
+
+	//! Create a UsdTRSBatchUndoableCommand for the USD items of the argument
+	//! selection.  The command is not executed.
+	static UsdTRSBatchUndoableCommand::Ptr create(
+		Operation operation, const Ufe::Selection& selection);
+
+	//! Return the number of items of the command.
+	std::size_t size() const { return fItems.size(); }
+
+	//! Return the scene items of the command, in the order of their values.
+	const std::vector<UsdSceneItem::Ptr>& items() const { return fItems; }
+
+	//! Set one value per item, in the order of items(), and execute the
+	//! command.  Returns false if the number of values does not match the
+	//! number of items.  Rotations are in degrees.
+	bool set(const std::vector<GfVec3d>& values);
+
+	//! Set the same value on all items, and execute the command.
+	void set(double x, double y, double z);
+
+	// Ufe::UndoableCommand overrides
+	void undo() override;
+	void redo() override;
+
+protected:
+	UsdTRSBatchUndoableCommand(Operation operation);
+
+private:
+	void addItem(const UsdSceneItem::Ptr& item);
+
+	// Set the argument values on the attributes, in a single change block.
+	void setValues(const std::vector<GfVec3d>& values);
+
+	// Get the attribute of the item at index, and create it if needed.  The
+	// attributes of items whose path changed are stale and fetched again.
+	UsdAttribute attribute(std::size_t index);
+
+	const Operation fOperation;
+
+	// Parallel arrays, indexed by item.  The items are tracked by address,
+	// so the array must not be resized once the command is created.
+	std::vector<UsdSceneItem::Ptr> fItems;
+	std::vector<UsdAttribute> fAttributes;
+	std::vector<GfVec3d> fPrevValues;
+	std::vector<GfVec3d> fNewValues;
+	bool fTracked{false};
+
+}; // UsdTRSBatchUndoableCommand
+
+} // namespace ufe
+} // namespace MayaUsd
@@ -15,11 +15,9 @@
 //
 
 #include "UsdTRSUndoableCommandBase.h"
+#include "private/SceneItemPathTracker.h"
 #include "private/Utils.h"
 
-#include <ufe/scene.h>
-#include <ufe/sceneNotification.h>
-
 MAYAUSD_NS_DEF {
 namespace ufe {
 
@@ -29,6 +27,14 @@ UsdTRSUndoableCommandBase<V>::UsdTRSUndoableCommandBase(
 ) : fItem(item), fNewValue(x, y, z)
 {}
 
+template<class V>
+UsdTRSUndoableCommandBase<V>::~UsdTRSUndoableCommandBase()
+{
+    if (fTracked) {
+        SceneItemPathTracker::untrack(&fItem);
+    }
+}
+
 template<class V>
 void UsdTRSUndoableCommandBase<V>::initialize()
 {
@@ -43,24 +49,9 @@ void UsdTRSUndoableCommandBase<V>::initialize()
         addEmptyAttribute();
     }
 
-    // See
-    // https://stackoverflow.com/questions/17853212/using-shared-from-this-in-templated-classes
-    // for explanation of this->shared_from_this() in templated class.
     attribute().Get(&fPrevValue);
-    Ufe::Scene::instance().addObjectPathChangeObserver(this->shared_from_this());
-}
-
-template<class V>
-void UsdTRSUndoableCommandBase<V>::operator()(
-    const Ufe::Notification& n
-)
-{
-    if (auto renamed = dynamic_cast<const Ufe::ObjectRename*>(&n)) {
-        checkNotification(renamed);
-    }
-    else if (auto reparented = dynamic_cast<const Ufe::ObjectReparent*>(&n)) {
-        checkNotification(reparented);
-    }
+    SceneItemPathTracker::track(&fItem);
+    fTracked = true;
 }
 
 template<class V>
@@ -85,15 +76,6 @@ void UsdTRSUndoableCommandBase<V>::redoImp()
     perform(fNewValue[0], fNewValue[1], fNewValue[2]);
 }
 
-template<class V>
-template<class N>
-void UsdTRSUndoableCommandBase<V>::checkNotification(const N* notification)
-{
-    if (notification->previousPath() == path()) {
-        fItem = std::dynamic_pointer_cast<UsdSceneItem>(notification->item());
-    }
-}
-
 template<class V>
 void UsdTRSUndoableCommandBase<V>::perform(double x, double y, double z)
 {
@@ -20,7 +20,6 @@
 
 #include <pxr/usd/usd/attribute.h>
 
-#include <ufe/observer.h>
 #include <ufe/transform3dUndoableCommands.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -45,16 +44,17 @@ namespace ufe {
 //   used, or the undo / redo stack can cause an item to be renamed or
 //   reparented.  In such a case, the prim in the command's scene item
 //   becomes stale, and the prim in the updated scene item should be used.
+//   The scene items of all commands are tracked by a single path change
+//   observer.
 //
 template<class V>
-class MAYAUSD_CORE_PUBLIC UsdTRSUndoableCommandBase : public Ufe::Observer,
-        public std::enable_shared_from_this<UsdTRSUndoableCommandBase<V> >
+class MAYAUSD_CORE_PUBLIC UsdTRSUndoableCommandBase
 {
 protected:
 
     UsdTRSUndoableCommandBase(
         const UsdSceneItem::Ptr& item, double x, double y, double z);
-    ~UsdTRSUndoableCommandBase() = default;
+    ~UsdTRSUndoableCommandBase();
 
     // Initialize the command.
     void initialize();
@@ -82,11 +82,6 @@ protected:
 
 private:
 
-    // Overridden from Ufe::Observer
-    void operator()(const Ufe::Notification& notification) override;
-
-    template<class N> void checkNotification(const N* notification);
-
     inline UsdAttribute attribute() const {
       return prim().GetAttribute(attributeName());
     }
@@ -96,6 +91,7 @@ private:
     V                 fNewValue;
     bool              fOpAdded{false};
     bool              fDoneOnce{false};
+    bool              fTracked{false};
 }; // UsdTRSUndoableCommandBase
 
 // shared_ptr requires public ctor, dtor, so derive a class for it.
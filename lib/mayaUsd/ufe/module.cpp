@@ -19,5 +19,6 @@
 PXR_NAMESPACE_USING_DIRECTIVE
 
 TF_WRAP_MODULE {
+    TF_WRAP(TRSBatchCommand);
     TF_WRAP(Utils);
 }
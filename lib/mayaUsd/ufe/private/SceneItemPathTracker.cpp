@@ -0,0 +1,118 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "SceneItemPathTracker.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include <ufe/observer.h>
+#include <ufe/path.h>
+#include <ufe/scene.h>
+#include <ufe/sceneNotification.h>
+
+namespace {
+
+using namespace MayaUsd::ufe;
+
+class PathChangeObserver : public Ufe::Observer
+{
+public:
+	void track(UsdSceneItem::Ptr* item)
+	{
+		fItems.emplace((*item)->path(), item);
+	}
+
+	void untrack(UsdSceneItem::Ptr* item)
+	{
+		auto range = fItems.equal_range((*item)->path());
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == item)
+			{
+				fItems.erase(it);
+				return;
+			}
+		}
+	}
+
+	void operator()(const Ufe::Notification& n) override
+	{
+		if (auto renamed = dynamic_cast<const Ufe::ObjectRename*>(&n)) {
+			pathChanged(renamed->previousPath(), renamed->item());
+		}
+		else if (auto reparented = dynamic_cast<const Ufe::ObjectReparent*>(&n)) {
+			pathChanged(reparented->previousPath(), reparented->item());
+		}
+	}
+
+private:
+	void pathChanged(const Ufe::Path& previousPath, const Ufe::SceneItem::Ptr& item)
+	{
+		auto usdItem = std::dynamic_pointer_cast<UsdSceneItem>(item);
+		if (!usdItem)
+			return;
+
+		auto range = fItems.equal_range(previousPath);
+		if (range.first == range.second)
+			return;
+
+		// Re-key the tracked items under their new path.
+		std::vector<UsdSceneItem::Ptr*> items;
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			*it->second = usdItem;
+			items.push_back(it->second);
+		}
+		fItems.erase(range.first, range.second);
+		for (auto trackedItem : items)
+		{
+			fItems.emplace(usdItem->path(), trackedItem);
+		}
+	}
+
+	std::unordered_multimap<Ufe::Path, UsdSceneItem::Ptr*> fItems;
+};
+
+std::shared_ptr<PathChangeObserver> pathChangeObserver;
+
+}
+
+MAYAUSD_NS_DEF {
+namespace ufe {
+
+/*static*/
+void SceneItemPathTracker::track(UsdSceneItem::Ptr* item)
+{
+	if (!*item)
+		return;
+
+	if (!pathChangeObserver)
+	{
+		pathChangeObserver = std::make_shared<PathChangeObserver>();
+		Ufe::Scene::instance().addObjectPathChangeObserver(pathChangeObserver);
+	}
+	pathChangeObserver->track(item);
+}
+
+/*static*/
+void SceneItemPathTracker::untrack(UsdSceneItem::Ptr* item)
+{
+	if (pathChangeObserver && *item)
+		pathChangeObserver->untrack(item);
+}
+
+} // namespace ufe
+} // namespace MayaUsd
@@ -0,0 +1,49 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <mayaUsd/base/api.h>
+#include <mayaUsd/ufe/UsdSceneItem.h>
+
+MAYAUSD_NS_DEF {
+namespace ufe {
+
+//! \brief Keeps scene items held by commands up to date when their objects
+//! are renamed or reparented.
+/*!
+	A command can be created before it's used, or the undo / redo stack can
+	cause an item to be renamed or reparented, in which case the prim of the
+	scene item held by the command becomes stale.  Rather than having each
+	command observe path changes, which means one observer per item when
+	manipulating a large selection, a single observer replaces the tracked
+	scene items whose path matches the previous path of a rename or reparent
+	notification.
+
+	The tracker holds pointers to the scene items, which must be untracked
+	before they are destroyed.
+*/
+class SceneItemPathTracker
+{
+public:
+	//! Start tracking the argument scene item.
+	static void track(UsdSceneItem::Ptr* item);
+
+	//! Stop tracking the argument scene item.
+	static void untrack(UsdSceneItem::Ptr* item);
+};
+
+} // namespace ufe
+} // namespace MayaUsd
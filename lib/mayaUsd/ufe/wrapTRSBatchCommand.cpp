@@ -0,0 +1,75 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <boost/python.hpp>
+
+#include <ufe/globalSelection.h>
+
+#include <mayaUsd/ufe/UsdTRSBatchUndoableCommand.h>
+
+using namespace MayaUsd;
+using namespace boost::python;
+
+namespace {
+
+using Command = ufe::UsdTRSBatchUndoableCommand;
+
+// Because mayaUsd and UFE have incompatible Python bindings (see
+// wrapUtils.cpp), the command is created from the global selection rather
+// than from a Ufe::Selection argument.
+Command::Ptr createFromGlobalSelection(Command::Operation operation)
+{
+    return Command::create(operation, *Ufe::GlobalSelection::get());
+}
+
+// The paths of the items are returned as strings, with segments separated by
+// ',' commas.
+list paths(const Command& command)
+{
+    list result;
+    for (const auto& item : command.items())
+        result.append(item->path().string());
+    return result;
+}
+
+void setAll(Command& command, double x, double y, double z)
+{
+    command.set(x, y, z);
+}
+
+}
+
+void
+wrapTRSBatchCommand()
+{
+    // The command is executed, undone and redone from Python, and is not
+    // added to the Maya undo queue.
+    scope batchScope = class_<Command, Command::Ptr, boost::noncopyable>(
+            "TRSBatchCommand", no_init)
+        .def("create", &createFromGlobalSelection)
+        .staticmethod("create")
+        .def("size", &Command::size)
+        .def("paths", &paths)
+        .def("set", &setAll)
+        .def("undo", &Command::undo)
+        .def("redo", &Command::redo)
+        ;
+
+    enum_<Command::Operation>("Operation")
+        .value("Translate", Command::Operation::Translate)
+        .value("Rotate", Command::Operation::Rotate)
+        .value("Scale", Command::Operation::Scale)
+        ;
+}
@@ -15,13 +15,13 @@
 //
 #include "util.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
-#include <boost/functional/hash.hpp>
-
 #include <maya/MAnimControl.h>
 #include <maya/MAnimUtil.h>
 #include <maya/MArgDatabase.h>
@@ -40,9 +40,9 @@
 #include <maya/MFnSet.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MGlobal.h>
+#include <maya/MIntArray.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MItDependencyNodes.h>
-#include <maya/MItMeshFaceVertex.h>
 #include <maya/MItMeshPolygon.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
@@ -70,6 +70,10 @@
 #include <pxr/usd/usdGeom/mesh.h>
 #include <pxr/usd/usdGeom/metrics.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <mayaUsdUtils/MergeValues.h>
 #include <mayaUsd/utils/colorSpace.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -985,36 +989,6 @@ UsdMayaUtil::GetLinearShaderColor(
                                  assignmentIndices);
 }
 
-namespace {
-
-template <typename T>
-struct _ValuesHash
-{
-    std::size_t operator() (const T& value) const {
-        return hash_value(value);
-    }
-};
-
-// There is no globally defined hash_value for numeric types
-// so we need an explicit opt-in here.
-template <>
-struct _ValuesHash<float>
-{
-    std::size_t operator() (const float& value) const {
-        return boost::hash_value(value);
-    }
-};
-
-template <typename T>
-struct _ValuesEqual
-{
-    bool operator() (const T& a, const T& b) const {
-        return GfIsClose(a, b, 1e-9);
-    }
-};
-
-} // anonymous namespace
-
 template <typename T>
 static
 void
@@ -1022,6 +996,9 @@ _MergeEquivalentIndexedValues(
         VtArray<T>* valueData,
         VtIntArray* assignmentIndices)
 {
+    static_assert(sizeof(T) % sizeof(float) == 0,
+        "Values are expected to be tuples of floats");
+
     if (!valueData || !assignmentIndices) {
         return;
     }
@@ -1031,41 +1008,24 @@ _MergeEquivalentIndexedValues(
         return;
     }
 
-    // We maintain a map of values to that value's index in our uniqueValues
-    // array.
-    std::unordered_map<T, size_t, _ValuesHash<T>, _ValuesEqual<T> > valuesMap;
-    VtArray<T> uniqueValues;
-    VtIntArray uniqueIndices;
-
-    for (int index : *assignmentIndices) {
-        if (index < 0 || static_cast<size_t>(index) >= numValues) {
-            // This is an unassigned or otherwise unknown index, so just keep it.
-            uniqueIndices.push_back(index);
-            continue;
-        }
-
-        const T value = (*valueData)[index];
-
-        int uniqueIndex = -1;
-
-        auto inserted = valuesMap.insert(
-            std::pair<T, size_t>(value, uniqueValues.size()));
-        if (inserted.second) {
-            // This is a new value, so add it to the array.
-            uniqueValues.push_back(value);
-            uniqueIndex = uniqueValues.size() - 1;
-        } else {
-            // This is an existing value, so re-use the original's index.
-            uniqueIndex = inserted.first->second;
-        }
+    const size_t numIndices = assignmentIndices->size();
+    VtArray<T> uniqueValues(std::min(numValues, numIndices));
+    VtIntArray uniqueIndices(numIndices);
 
-        uniqueIndices.push_back(uniqueIndex);
-    }
+    const size_t numUniqueValues = MayaUsdUtils::mergeEquivalentIndexedValues(
+        reinterpret_cast<const float*>(valueData->cdata()),
+        numValues,
+        sizeof(T) / sizeof(float),
+        assignmentIndices->cdata(),
+        numIndices,
+        reinterpret_cast<float*>(uniqueValues.data()),
+        uniqueIndices.data());
 
     // If we reduced the number of values by merging, copy the results back.
-    if (uniqueValues.size() < numValues) {
-        (*valueData) = uniqueValues;
-        (*assignmentIndices) = uniqueIndices;
+    if (numUniqueValues < numValues) {
+        uniqueValues.resize(numUniqueValues);
+        (*valueData) = std::move(uniqueValues);
+        (*assignmentIndices) = std::move(uniqueIndices);
     }
 }
 
@@ -1109,59 +1069,98 @@ UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
         return;
     }
 
+    // Face-vertices are ordered by face, then by vertex within the face,
+    // exactly like the vertex list returned by MFnMesh::getVertices().
+    MIntArray faceVertexCounts;
+    MIntArray faceVertexIndices;
+    if (!mesh.getVertices(faceVertexCounts, faceVertexIndices) ||
+            faceVertexIndices.length() != assignmentIndices->size()) {
+        return;
+    }
+
+    const int numPolygons = static_cast<int>(faceVertexCounts.length());
+    std::vector<unsigned int> faceOffsets(numPolygons + 1, 0u);
+    for (int f = 0; f < numPolygons; ++f) {
+        faceOffsets[f + 1] = faceOffsets[f] + faceVertexCounts[f];
+    }
+
+    const int* const assigned = assignmentIndices->cdata();
+    const int* const vertexIds = &faceVertexIndices[0];
+
     // Use -2 as the initial "un-stored" sentinel value, since -1 is the
     // default unauthored value index for primvars.
-    int numPolygons = mesh.numPolygons();
     VtIntArray uniformAssignments;
     uniformAssignments.assign((size_t)numPolygons, -2);
+    int* const faceAssignments = uniformAssignments.data();
 
-    int numVertices = mesh.numVertices();
-    VtIntArray vertexAssignments;
-    vertexAssignments.assign((size_t)numVertices, -2);
+    const int numVertices = mesh.numVertices();
+    std::unique_ptr<std::atomic<int>[]> vertexAssignmentsAtomic(
+        new std::atomic<int>[numVertices]);
+    for (int v = 0; v < numVertices; ++v) {
+        vertexAssignmentsAtomic[v].store(-2, std::memory_order_relaxed);
+    }
 
     // We assume that the data is constant/uniform/vertex until we can
-    // prove otherwise that two components have differing values.
-    bool isConstant = true;
-    bool isUniform = true;
-    bool isVertex = true;
+    // prove otherwise that two components have differing values. Faces are
+    // classified in parallel, each task stopping as soon as no compression
+    // is possible anymore.
+    std::atomic<bool> isConstant(true);
+    std::atomic<bool> isUniform(true);
+    std::atomic<bool> isVertex(true);
+
+    tbb::parallel_for(
+        tbb::blocked_range<int>(0, numPolygons, 1024),
+        [&](const tbb::blocked_range<int>& range) {
+            bool localConstant = isConstant.load(std::memory_order_relaxed);
+            bool localUniform = isUniform.load(std::memory_order_relaxed);
+            bool localVertex = isVertex.load(std::memory_order_relaxed);
+
+            for (int faceIndex = range.begin();
+                    faceIndex != range.end() &&
+                        (localConstant || localUniform || localVertex);
+                    ++faceIndex) {
+                for (unsigned int fvi = faceOffsets[faceIndex];
+                        fvi < faceOffsets[faceIndex + 1]; ++fvi) {
+                    const int assignedIndex = assigned[fvi];
+
+                    if (localConstant && assignedIndex != assigned[0]) {
+                        localConstant = false;
+                    }
 
-    MItMeshFaceVertex itFV(mesh.object());
-    unsigned int fvi = 0;
-    for (itFV.reset(); !itFV.isDone(); itFV.next(), ++fvi) {
-        int faceIndex = itFV.faceId();
-        int vertexIndex = itFV.vertId();
+                    if (localUniform) {
+                        if (faceAssignments[faceIndex] < -1) {
+                            // No value for this face yet, so store one.
+                            faceAssignments[faceIndex] = assignedIndex;
+                        } else if (assignedIndex != faceAssignments[faceIndex]) {
+                            localUniform = false;
+                        }
+                    }
 
-        int assignedIndex = (*assignmentIndices)[fvi];
+                    if (localVertex) {
+                        // The first face-vertex to reach a vertex stores its
+                        // value, the others compare against it.
+                        int stored = -2;
+                        std::atomic<int>& vertexAssignment =
+                            vertexAssignmentsAtomic[vertexIds[fvi]];
+                        if (!vertexAssignment.compare_exchange_strong(
+                                    stored, assignedIndex) &&
+                                stored != assignedIndex) {
+                            localVertex = false;
+                        }
+                    }
+                }
+            }
 
-        if (isConstant) {
-            if (assignedIndex != (*assignmentIndices)[0]) {
+            if (!localConstant) {
                 isConstant = false;
             }
-        }
-
-        if (isUniform) {
-            if (uniformAssignments[faceIndex] < -1) {
-                // No value for this face yet, so store one.
-                uniformAssignments[faceIndex] = assignedIndex;
-            } else if (assignedIndex != uniformAssignments[faceIndex]) {
+            if (!localUniform) {
                 isUniform = false;
             }
-        }
-
-        if (isVertex) {
-            if (vertexAssignments[vertexIndex] < -1) {
-                // No value for this vertex yet, so store one.
-                vertexAssignments[vertexIndex] = assignedIndex;
-            } else if (assignedIndex != vertexAssignments[vertexIndex]) {
+            if (!localVertex) {
                 isVertex = false;
             }
-        }
-
-        if (!isConstant && !isUniform && !isVertex) {
-            // No compression will be possible, so stop trying.
-            break;
-        }
-    }
+        });
 
     if (isConstant) {
         assignmentIndices->resize(1);
@@ -1170,6 +1169,11 @@ UsdMayaUtil::CompressFaceVaryingPrimvarIndices(
         *assignmentIndices = uniformAssignments;
         *interpolation = UsdGeomTokens->uniform;
     } else if(isVertex) {
+        VtIntArray vertexAssignments((size_t)numVertices);
+        for (int v = 0; v < numVertices; ++v) {
+            vertexAssignments[v] =
+                vertexAssignmentsAtomic[v].load(std::memory_order_relaxed);
+        }
         *assignmentIndices = vertexAssignments;
         *interpolation = UsdGeomTokens->vertex;
     } else {
@@ -20,13 +20,13 @@
 #include <maya/MFloatArray.h>
 #include <maya/MFnMesh.h>
 #include <maya/MIntArray.h>
-#include <maya/MItMeshPolygon.h>
 #include <maya/MNodeMessage.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPolyMessage.h>
 
 #include <pxr/pxr.h>
+#include <pxr/base/arch/hash.h>
 #include <pxr/base/tf/type.h>
 #include <pxr/imaging/hd/tokens.h>
 #include <pxr/imaging/pxOsd/tokens.h>
@@ -131,27 +131,89 @@ public:
         MStatus status;
         MFnMesh mesh(GetDagPath(), &status);
         if (ARCH_UNLIKELY(!status)) { return {}; }
-        VtArray<GfVec2f> uvs;
-        uvs.reserve(static_cast<size_t>(mesh.numFaceVertices()));
-        for (MItMeshPolygon pit(GetDagPath()); !pit.isDone(); pit.next()) {
-            const auto vertexCount = pit.polygonVertexCount();
-            for (auto i = decltype(vertexCount){0}; i < vertexCount; ++i) {
-                float2 uv = {0.0f, 0.0f};
-                pit.getUV(i, uv);
-                uvs.push_back(GfVec2f(uv[0], uv[1]));
+        MIntArray uvCounts;
+        MIntArray uvIds;
+        MFloatArray us;
+        MFloatArray vs;
+        if (ARCH_UNLIKELY(
+                !mesh.getAssignedUVs(uvCounts, uvIds) ||
+                !mesh.getUVs(us, vs))) {
+            return {};
+        }
+
+        const auto numFaceVertices =
+            static_cast<unsigned int>(mesh.numFaceVertices());
+        const auto numUVs = us.length();
+        VtArray<GfVec2f> uvs(numFaceVertices, GfVec2f(0.0f, 0.0f));
+        auto* uvData = uvs.data();
+        const auto readUV = [&](unsigned int uvId) -> GfVec2f {
+            return uvId < numUVs ? GfVec2f(us[uvId], vs[uvId])
+                                 : GfVec2f(0.0f, 0.0f);
+        };
+        if (uvIds.length() == numFaceVertices) {
+            // Every face is mapped, so the face-vertices line up with the
+            // assigned uv ids.
+            for (auto i = decltype(numFaceVertices){0}; i < numFaceVertices;
+                 ++i) {
+                uvData[i] = readUV(static_cast<unsigned int>(uvIds[i]));
+            }
+        } else {
+            // Unmapped faces have no uv ids assigned, and keep the default
+            // (0, 0) uvs for their face-vertices.
+            MIntArray vertexCounts;
+            MIntArray vertexIds;
+            if (ARCH_UNLIKELY(!mesh.getVertices(vertexCounts, vertexIds))) {
+                return VtValue(uvs);
+            }
+            const auto numPolygons = vertexCounts.length();
+            unsigned int faceVertex = 0;
+            unsigned int uvIndex = 0;
+            for (auto i = decltype(numPolygons){0};
+                 i < numPolygons && i < uvCounts.length(); ++i) {
+                const auto vertexCount =
+                    static_cast<unsigned int>(vertexCounts[i]);
+                if (uvCounts[i] > 0) {
+                    for (auto j = decltype(vertexCount){0}; j < vertexCount;
+                         ++j) {
+                        uvData[faceVertex + j] = readUV(
+                            static_cast<unsigned int>(uvIds[uvIndex + j]));
+                    }
+                    uvIndex += static_cast<unsigned int>(uvCounts[i]);
+                }
+                faceVertex += vertexCount;
             }
         }
 
         return VtValue(uvs);
     }
 
-    VtValue GetPoints(const MFnMesh& mesh) {
+    static const GfVec3f* GetRawPoints(
+        const MFnMesh& mesh, size_t& numVertices, uint64_t& hash) {
         MStatus status;
         const auto* rawPoints =
             reinterpret_cast<const GfVec3f*>(mesh.getRawPoints(&status));
-        if (ARCH_UNLIKELY(!status)) { return {}; }
+        if (ARCH_UNLIKELY(!status)) { return nullptr; }
+        numVertices = static_cast<size_t>(mesh.numVertices());
+        hash = ArchHash64(rawPoints, numVertices * sizeof(GfVec3f));
+        return rawPoints;
+    }
+
+    VtValue GetPoints(const MFnMesh& mesh, uint64_t* hash = nullptr) {
+        size_t numVertices = 0;
+        uint64_t pointsHash = 0;
+        const auto* rawPoints = GetRawPoints(mesh, numVertices, pointsHash);
+        if (ARCH_UNLIKELY(rawPoints == nullptr)) { return {}; }
+        if (hash != nullptr) { *hash = pointsHash; }
+        // Hand back the previous array if the points did not change, so we
+        // share its storage instead of copying the whole point array again.
+        if (!_points.empty() && _points.size() == numVertices &&
+            _pointsHash == pointsHash) {
+            return VtValue(_points);
+        }
         VtVec3fArray ret;
-        ret.assign(rawPoints, rawPoints + mesh.numVertices());
+        ret.assign(rawPoints, rawPoints + numVertices);
+        _points = ret;
+        _pointsHash = pointsHash;
         return VtValue(ret);
     }
 
@@ -182,16 +244,25 @@ public:
             MFnMesh mesh(GetDagPath(), &status);
             if (ARCH_UNLIKELY(!status)) { return 0; }
             times[0] = 0.0f;
-            samples[0] = GetPoints(mesh);
+            uint64_t currentHash = 0;
+            samples[0] = GetPoints(mesh, &currentHash);
             if (maxSampleCount == 1 ||
                 !GetDelegate()->GetParams().enableMotionSamples) {
                 return 1;
             }
-            times[1] = 1.0f;
             MDGContextGuard guard(MAnimControl::currentTime() + 1.0);
-            samples[1] = GetPoints(mesh);
+            // Compare the hashes of the raw points rather than the arrays, so
+            // a static mesh never pays for a second copy of its points.
             // FIXME: should we do this or in the render delegate?
-            return samples[1] == samples[0] ? 1 : 2;
+            size_t numVertices = 0;
+            uint64_t nextHash = 0;
+            const auto* rawPoints = GetRawPoints(mesh, numVertices, nextHash);
+            if (rawPoints == nullptr || nextHash == currentHash) { return 1; }
+            times[1] = 1.0f;
+            VtVec3fArray nextPoints;
+            nextPoints.assign(rawPoints, rawPoints + numVertices);
+            samples[1] = VtValue(nextPoints);
+            return 2;
         } else if (key == HdMayaAdapterTokens->st) {
             times[0] = 0.0f;
             samples[0] = GetUVs();
@@ -202,18 +273,13 @@ public:
 
     HdMeshTopology GetMeshTopology() override {
         MFnMesh mesh(GetDagPath());
-        const auto numPolygons = mesh.numPolygons();
-        VtIntArray faceVertexCounts;
-        faceVertexCounts.reserve(static_cast<size_t>(numPolygons));
-        VtIntArray faceVertexIndices;
-        faceVertexIndices.reserve(static_cast<size_t>(mesh.numFaceVertices()));
-        for (MItMeshPolygon pit(GetDagPath()); !pit.isDone(); pit.next()) {
-            const auto vc = pit.polygonVertexCount();
-            faceVertexCounts.push_back(vc);
-            for (auto i = decltype(vc){0}; i < vc; ++i) {
-                faceVertexIndices.push_back(pit.vertexIndex(i));
-            }
-        }
+        MIntArray vertexCounts;
+        MIntArray vertexIds;
+        mesh.getVertices(vertexCounts, vertexIds);
+        VtIntArray faceVertexCounts(vertexCounts.length());
+        vertexCounts.get(faceVertexCounts.data());
+        VtIntArray faceVertexIndices(vertexIds.length());
+        vertexIds.get(faceVertexIndices.data());
 
         // TODO: Maybe we could use the flat shading of the display style?
         return HdMeshTopology(
@@ -410,6 +476,11 @@ private:
         adapter->MarkDirty(HdChangeTracker::DirtyPrimvar);
     }
 
+    // Last point array handed to Hydra, and the hash of the raw points it
+    // was copied from.
+    VtVec3fArray _points;
+    uint64_t _pointsHash = 0;
+
     // Maya has a bug with removing some MPolyMessage callbacks. Known
     // problem callbacks include:
     //     MPolyMessage::addPolyComponentIdChangedCallback
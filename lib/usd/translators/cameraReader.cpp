@@ -24,6 +24,10 @@
 
 PXR_NAMESPACE_OPEN_SCOPE
 
+// Cameras are not registered with a Prefetch step: their reader only gets a
+// handful of scalar attributes, interleaved with the creation of the Maya
+// camera and its animation curves, and scenes hold few cameras, so gathering
+// them ahead on the workers would cost more than it saves.
 PXRUSDMAYA_DEFINE_READER(UsdGeomCamera, args, context)
 {
     const UsdPrim& usdPrim = args.GetUsdPrim();
@@ -209,6 +209,14 @@ PxrUsdTranslators_InstancerWriter::Write(const UsdTimeCode& usdTime)
     writeInstancerAttrs(usdTime, primSchema);
 }
 
+/* virtual */
+bool
+PxrUsdTranslators_InstancerWriter::SupportsFrameCapture() const
+{
+    // The instancer attributes are written on top of the transform.
+    return false;
+}
+
 /// Returns STATIC or ANIMATED if an extra translate is needed to compensate for
 /// Maya's instancer translation behavior on the given prototype DAG node.
 /// (This function may return false positives, which are OK but will simply
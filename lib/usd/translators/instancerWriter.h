@@ -56,6 +56,7 @@ public:
             UsdMayaWriteJobContext& jobCtx);
 
     void Write(const UsdTimeCode& usdTime) override;
+    bool SupportsFrameCapture() const override;
     void PostExport() override;
     bool ShouldPruneChildren() const override;
     const SdfPathVector& GetModelPaths() const override;
@@ -30,6 +30,8 @@
 #include <mayaUsd/nodes/stageNode.h>
 #include <mayaUsd/utils/util.h>
 
+#include <memory>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 namespace
@@ -59,7 +61,12 @@ public:
 
     ~MayaUsdPrimReaderMesh() override {}
 
+    bool HasPrefetch() const override { return true; }
+    void Prefetch() override;
     bool Read(UsdMayaPrimReaderContext* context) override;
+
+private:
+    std::unique_ptr<MayaUsd::TranslatorMeshReadData> _data;
 };
 
 TF_REGISTRY_FUNCTION_WITH_TAG(UsdMayaPrimReaderRegistry, UsdGeomMesh) 
@@ -67,7 +74,17 @@ TF_REGISTRY_FUNCTION_WITH_TAG(UsdMayaPrimReaderRegistry, UsdGeomMesh)
     UsdMayaPrimReaderRegistry::Register<UsdGeomMesh>(
         [](const UsdMayaPrimReaderArgs& args) {
             return std::make_shared<MayaUsdPrimReaderMesh>(args);
-        });
+        },
+        /*hasPrefetch*/ true);
+}
+
+void
+MayaUsdPrimReaderMesh::Prefetch()
+{
+    const UsdGeomMesh mesh(_GetArgs().GetUsdPrim());
+    if (mesh) {
+        _data.reset(new MayaUsd::TranslatorMeshReadData(mesh, _GetArgs().GetTimeInterval()));
+    }
 }
 
 bool
@@ -103,13 +120,17 @@ MayaUsdPrimReaderMesh::Read(UsdMayaPrimReaderContext* context)
         stageNode = context->GetMayaNode(SdfPath(UsdMayaStageNodeTokens->MayaTypeName.GetString()),false);
     }
 
-    MayaUsd::TranslatorMeshRead meshRead(mesh, 
+    if (!_data) {
+        Prefetch();
+    }
+    MayaUsd::TranslatorMeshRead meshRead(*_data,
+                                         mesh, 
                                          prim, 
                                          transformObj, 
                                          stageNode, 
-                                         _GetArgs().GetTimeInterval(),
                                          _GetArgs().GetUseAsAnimationCache(),
                                          &status);
+    _data.reset();
     CHECK_MSTATUS_AND_RETURN(status, false);
 
     // mesh is a shape, so read Gprim properties
@@ -15,12 +15,16 @@
 //
 #include "meshWriter.h"
 
+#include <cstring>
 #include <set>
 #include <string>
 #include <vector>
 
+#include <maya/MFloatVector.h>
+#include <maya/MFloatVectorArray.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnMesh.h>
+#include <maya/MGlobal.h>
 #include <maya/MIntArray.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
@@ -100,6 +104,146 @@ PxrUsdTranslators_MeshWriter::Write(const UsdTimeCode& usdTime)
     writeMeshAttrs(usdTime, primSchema);
 }
 
+bool
+PxrUsdTranslators_MeshWriter::SupportsFrameCapture() const
+{
+    return true;
+}
+
+UsdMayaPrimWriterFrameDataUniquePtr
+PxrUsdTranslators_MeshWriter::CaptureFrame(const UsdTimeCode& usdTime)
+{
+    UsdMayaPrimWriter::Write(usdTime);
+
+    _FrameData* frameData = new _FrameData();
+    UsdMayaPrimWriterFrameDataUniquePtr frameDataPtr(frameData);
+
+    // Capture only runs for time samples, which writeMeshAttrs() skips for
+    // non-animated meshes. Animated meshes are never skinned, so the final
+    // mesh is also the geom mesh.
+    if (!isMeshAnimated()) {
+        return frameDataPtr;
+    }
+
+    MStatus status{MS::kSuccess};
+    MFnMesh finalMesh(GetDagPath(), &status);
+    if (!status) {
+        TF_RUNTIME_ERROR(
+            "Failed to get final mesh at DAG path: %s",
+            GetDagPath().fullPathName().asChar());
+        return frameDataPtr;
+    }
+
+    UsdGeomMesh primSchema(_usdPrim);
+
+    // The attributes converted on the workers are created here, so that they
+    // are ordered in the layer as in a serial export.
+    const float* rawPoints = finalMesh.getRawPoints(&status);
+    if (status) {
+        frameData->hasPoints = true;
+        frameData->points.resize(finalMesh.numVertices());
+        memcpy((GfVec3f*)frameData->points.data(), rawPoints,
+               sizeof(float) * 3 * frameData->points.size());
+        primSchema.CreatePointsAttr();
+        primSchema.CreateExtentAttr();
+    }
+    else {
+        MGlobal::displayError(MString("Unable to access mesh vertices on mesh: ") + finalMesh.fullPathName());
+    }
+
+    frameData->hasTopology = true;
+    finalMesh.getVertices(frameData->faceVertexCounts, frameData->faceVertexIndices);
+    primSchema.CreateFaceVertexCountsAttr();
+    primSchema.CreateFaceVertexIndicesAttr();
+
+    TfToken sdScheme = UsdMayaMeshWriteUtils::getSubdivScheme(finalMesh);
+    if (sdScheme.IsEmpty()) {
+        sdScheme = _GetExportArgs().defaultMeshScheme;
+    }
+    primSchema.CreateSubdivisionSchemeAttr(VtValue(sdScheme), true);
+
+    if (sdScheme == UsdGeomTokens->none) {
+        bool emitNormals = true;
+        UsdMayaMeshReadUtils::getEmitNormalsTag(finalMesh, &emitNormals);
+        if (emitNormals) {
+            MIntArray normalCounts;
+            const int numNormals = finalMesh.numNormals(&status);
+            frameData->hasNormals = status && numNormals > 0 &&
+                finalMesh.getNormals(frameData->normals) &&
+                finalMesh.getNormalIds(normalCounts, frameData->normalIds);
+            if (frameData->hasNormals) {
+                primSchema.SetNormalsInterpolation(UsdGeomTokens->faceVarying);
+            }
+        }
+    } else {
+        UsdMayaMeshWriteUtils::writeSubdivInterpBound(finalMesh, primSchema, _GetSparseValueWriter());
+
+        UsdMayaMeshWriteUtils::writeSubdivFVLinearInterpolation(finalMesh, primSchema, _GetSparseValueWriter());
+
+        UsdMayaMeshWriteUtils::assignSubDivTagsToUSDPrim(finalMesh, primSchema, _GetSparseValueWriter());
+    }
+
+    UsdMayaMeshWriteUtils::writeInvisibleFacesData(finalMesh, primSchema, _GetSparseValueWriter());
+
+    // The previous frame has been flushed before capture, so the primvars can
+    // go through the sparse value writer right away.
+    writeMeshPrimvars(usdTime, primSchema, finalMesh);
+
+    return frameDataPtr;
+}
+
+void
+PxrUsdTranslators_MeshWriter::ConvertFrame(
+        const UsdTimeCode& usdTime,
+        UsdMayaPrimWriterFrameData* frameData)
+{
+    _FrameData* meshFrameData = static_cast<_FrameData*>(frameData);
+    if (!meshFrameData) {
+        return;
+    }
+
+    const UsdGeomMesh primSchema(_usdPrim);
+
+    if (meshFrameData->hasPoints) {
+        VtVec3fArray extent(2);
+        UsdGeomPointBased::ComputeExtent(meshFrameData->points, &extent);
+
+        VtValue points(meshFrameData->points);
+        meshFrameData->StageValue(primSchema.GetPointsAttr(), &points);
+        VtValue extentValue(extent);
+        meshFrameData->StageValue(primSchema.GetExtentAttr(), &extentValue);
+    }
+
+    if (meshFrameData->hasTopology) {
+        VtIntArray faceVertexCounts(meshFrameData->faceVertexCounts.length());
+        if (!faceVertexCounts.empty()) {
+            meshFrameData->faceVertexCounts.get(faceVertexCounts.data());
+        }
+        VtValue countsValue(faceVertexCounts);
+        meshFrameData->StageValue(primSchema.GetFaceVertexCountsAttr(), &countsValue);
+
+        VtIntArray faceVertexIndices(meshFrameData->faceVertexIndices.length());
+        if (!faceVertexIndices.empty()) {
+            meshFrameData->faceVertexIndices.get(faceVertexIndices.data());
+        }
+        VtValue indicesValue(faceVertexIndices);
+        meshFrameData->StageValue(primSchema.GetFaceVertexIndicesAttr(), &indicesValue);
+    }
+
+    if (meshFrameData->hasNormals) {
+        const MFloatVectorArray& mayaNormals = meshFrameData->normals;
+        const MIntArray& normalIds = meshFrameData->normalIds;
+
+        VtVec3fArray normals(normalIds.length());
+        for (unsigned int i = 0u; i < normalIds.length(); ++i) {
+            const MFloatVector& normal = mayaNormals[normalIds[i]];
+            normals[i].Set(normal[0], normal[1], normal[2]);
+        }
+        VtValue normalsValue(normals);
+        meshFrameData->StageValue(primSchema.GetNormalsAttr(), &normalsValue);
+    }
+}
+
 bool
 PxrUsdTranslators_MeshWriter::writeMeshAttrs(const UsdTimeCode& usdTime,
                                              UsdGeomMesh& primSchema)
@@ -218,6 +362,16 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(const UsdTimeCode& usdTime,
     // Holes - we treat InvisibleFaces as holes
     UsdMayaMeshWriteUtils::writeInvisibleFacesData(finalMesh, primSchema, _GetSparseValueWriter());
 
+    writeMeshPrimvars(usdTime, primSchema, finalMesh);
+
+    return true;
+}
+
+void
+PxrUsdTranslators_MeshWriter::writeMeshPrimvars(const UsdTimeCode& usdTime,
+                                                UsdGeomMesh& primSchema,
+                                                MFnMesh& finalMesh)
+{
     // == Write UVSets as Vec2f Primvars
     if (_GetExportArgs().exportMeshUVs) {
         UsdMayaMeshWriteUtils::writeUVSetsAsVec2fPrimvars(finalMesh, primSchema, usdTime, _GetSparseValueWriter());
@@ -227,7 +381,7 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(const UsdTimeCode& usdTime,
     std::vector<std::string> colorSetNames;
     if (_GetExportArgs().exportColorSets) {
         MStringArray mayaColorSetNames;
-        status = finalMesh.getColorSetNames(mayaColorSetNames);
+        finalMesh.getColorSetNames(mayaColorSetNames);
         colorSetNames.reserve(mayaColorSetNames.length());
         for (unsigned int i = 0; i < mayaColorSetNames.length(); i++) {
             colorSetNames.emplace_back(mayaColorSetNames[i].asChar());
@@ -383,8 +537,6 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(const UsdTimeCode& usdTime,
                                             false,
                                             _GetSparseValueWriter());
     }
-
-    return true;
 }
 
 bool
@@ -21,8 +21,10 @@
 #include <set>
 #include <string>
 
+#include <maya/MFloatVectorArray.h>
 #include <maya/MFnDependencyNode.h>
 #include <maya/MFnMesh.h>
+#include <maya/MIntArray.h>
 #include <maya/MString.h>
 
 #include <pxr/pxr.h>
@@ -31,6 +33,7 @@
 #include <pxr/base/gf/vec4f.h>
 #include <pxr/base/tf/token.h>
 #include <pxr/base/vt/array.h>
+#include <pxr/base/vt/types.h>
 #include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/timeCode.h>
 #include <pxr/usd/usdGeom/gprim.h>
@@ -55,9 +58,38 @@ public:
     bool ExportsGprims() const override;
     void PostExport() override;
 
+    /// Pipelines the time samples of animated meshes. Points, extent,
+    /// topology and normals are converted on worker threads; UV sets, color
+    /// sets and display colors are gathered through Maya iterators and shader
+    /// queries, so they are authored during capture.
+    bool SupportsFrameCapture() const override;
+    UsdMayaPrimWriterFrameDataUniquePtr CaptureFrame(
+            const UsdTimeCode& usdTime) override;
+    void ConvertFrame(
+            const UsdTimeCode& usdTime,
+            UsdMayaPrimWriterFrameData* frameData) override;
+
 private:
+    /// Per-frame data for the pipelined export path.
+    struct _FrameData : public UsdMayaPrimWriterFrameData
+    {
+        bool hasPoints = false;
+        VtVec3fArray points;
+        bool hasTopology = false;
+        MIntArray faceVertexCounts;
+        MIntArray faceVertexIndices;
+        bool hasNormals = false;
+        MFloatVectorArray normals;
+        MIntArray normalIds;
+    };
+
     bool writeMeshAttrs(const UsdTimeCode& usdTime, UsdGeomMesh& primSchema);
 
+    /// Writes the UV sets, color sets and display colors of \p finalMesh.
+    void writeMeshPrimvars(const UsdTimeCode& usdTime,
+                           UsdGeomMesh& primSchema,
+                           MFnMesh& finalMesh);
+
     /// Cleans up any extra data authored by SetPrimvar().
     void cleanupPrimvars();
 
@@ -222,6 +222,14 @@ PxrUsdTranslators_ParticleWriter::Write(const UsdTimeCode& usdTime)
     writeParams(usdTime, primSchema);
 }
 
+/* virtual */
+bool
+PxrUsdTranslators_ParticleWriter::SupportsFrameCapture() const
+{
+    // The particle attributes are written on top of the transform.
+    return false;
+}
+
 void
 PxrUsdTranslators_ParticleWriter::writeParams(
         const UsdTimeCode& usdTime,
@@ -35,6 +35,11 @@ PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace MayaUsdUtils {
 
+// see SIMD.h
+#ifdef MAYA_USD_UTILS_SIMD_ISA
+inline namespace MAYA_USD_UTILS_SIMD_ISA {
+#endif
+
 #ifdef __F16C__
 
 /// converts 8xhalf to 8xfloat
@@ -255,5 +260,9 @@ inline GfHalf double2half_1f(const double f)
 }
 #endif
 
+#ifdef MAYA_USD_UTILS_SIMD_ISA
+} // MAYA_USD_UTILS_SIMD_ISA
+#endif
+
 } // MayaUsdUtils
 
@@ -22,6 +22,31 @@
 
 namespace MayaUsdUtils {
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The instruction sets the comparison functions below have been compiled for. The best one supported by the
+///         CPU is selected the first time one of the functions is called. Large arrays (more than 128K elements) are
+///         split across the worker threads, regardless of the instruction set.
+//----------------------------------------------------------------------------------------------------------------------
+enum class DiffCoreISA
+{
+  kBaseline,  ///< the instruction set the library was compiled for (SSE3 by default)
+  kAVX2       ///< AVX2, FMA & F16C (only available in x86-64 builds made with gcc or clang)
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the instruction set currently used by the comparison functions
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+DiffCoreISA diffCoreISA();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  overrides the instruction set used by the comparison functions. Mostly useful for tests & benchmarks.
+/// \param  isa the instruction set to use
+/// \return false if the instruction set is not supported by this CPU (or build), in which case nothing changes
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+bool setDiffCoreISA(DiffCoreISA isa);
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  tests to see whether the U & V coordinates are identical
 /// \param  u the U coordinate array
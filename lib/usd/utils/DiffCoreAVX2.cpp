@@ -0,0 +1,84 @@
+//
+// Copyright 2018 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// The kernels of this file are compiled with AVX2, FMA & F16C enabled through a target pragma, rather than with
+// per-file compiler flags. With -mavx2, every inline function or template instantiated here (std::abs, std::min,
+// GfHalf, ...) would be emitted with VEX encoding as a weak symbol, and the linker could pick that copy for the
+// baseline callers, which would then crash on CPUs without AVX2. So:
+//  - the headers shared with the rest of the library are included first, and are compiled for the baseline ISA.
+//  - the target pragma only applies to the functions defined by DiffCoreKernelsImpl.h, SIMD.h and ALHalf.h. The last
+//    two place their inline functions in their own inline namespace, and the kernels are in an anonymous namespace, so
+//    none of them can be merged with a baseline version.
+//  - neither gcc nor clang define the instruction set macros for a target pragma, so they are defined here for the
+//    code paths of those headers.
+//  - the kernel table accessor is not a kernel, so it is left out of the pragma.
+//
+#include "DiffCoreKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include <pxr/base/gf/half.h>
+#include <pxr/base/gf/ilmbase_half.h>
+
+#if defined(__clang__)
+# pragma clang attribute push (__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+#else
+# pragma GCC push_options
+# pragma GCC target("avx2,fma,f16c")
+#endif
+
+#ifndef __SSE4_1__
+# define __SSE4_1__ 1
+#endif
+#ifndef __SSE4_2__
+# define __SSE4_2__ 1
+#endif
+#ifndef __AVX__
+# define __AVX__ 1
+#endif
+#ifndef __AVX2__
+# define __AVX2__ 1
+#endif
+#ifndef __FMA__
+# define __FMA__ 1
+#endif
+#ifndef __F16C__
+# define __F16C__ 1
+#endif
+
+#define MAYA_USD_UTILS_SIMD_ISA avx2
+#include "DiffCoreKernelsImpl.h"
+
+#if defined(__clang__)
+# pragma clang attribute pop
+#else
+# pragma GCC pop_options
+#endif
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+const DiffCoreKernels& avx2DiffCoreKernels()
+{
+  return kernelTable;
+}
+
+} // MayaUsdUtils
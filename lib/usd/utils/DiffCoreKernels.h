@@ -0,0 +1,63 @@
+//
+// Copyright 2018 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <pxr/base/gf/half.h>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The table of comparison kernels compiled for a single instruction set. The public functions in DiffCore.h
+///         pick a table at runtime based on the capabilities of the CPU. The kernels themselves do not check for
+///         identical buffers, or split large arrays across threads; that is handled by the caller.
+//----------------------------------------------------------------------------------------------------------------------
+struct DiffCoreKernels
+{
+  bool (*vec2AreAllTheSameUV)(const float* u, const float* v, size_t count);
+  bool (*vec2AreAllTheSameFloat)(const float* array, size_t count);
+  bool (*vec3AreAllTheSameFloat)(const float* array, size_t count);
+  bool (*vec4AreAllTheSameFloat)(const float* array, size_t count);
+  bool (*vec2AreAllTheSameDouble)(const double* array, size_t count);
+  bool (*vec3AreAllTheSameDouble)(const double* array, size_t count);
+  bool (*vec4AreAllTheSameDouble)(const double* array, size_t count);
+  bool (*compareHalfFloat)(const GfHalf*, const float*, const size_t, const size_t, const float);
+  bool (*compareHalfDouble)(const GfHalf*, const double*, const size_t, const size_t, const double);
+  bool (*compareDoubleFloat)(const double*, const float*, const size_t, const size_t, const float);
+  bool (*compareDoubleDouble)(const double*, const double*, const size_t, const size_t, const double);
+  bool (*compareFloatFloat)(const float*, const float*, const size_t, const size_t, const float);
+  bool (*compareInt8)(const int8_t*, const int8_t*, const size_t, const size_t);
+  bool (*compareInt32)(const int32_t*, const int32_t*, const size_t, const size_t);
+  bool (*compareUvArray)(const float*, const float*, const float*, const size_t, const size_t, const float);
+  bool (*compareUvArrayToValue)(const float, const float, const float*, const float*, const size_t, const float);
+  bool (*compareArray3Dto4D)(const float*, const float*, const size_t, const size_t, const float);
+  bool (*compareArrayFloat3DtoDouble4D)(const float*, const double*, const size_t, const size_t, const float);
+  bool (*compareRGBAArray)(const float, const float, const float, const float, const float*, const size_t, const float);
+};
+
+/// returns the kernels built with the default compiler flags of the library
+const DiffCoreKernels& baselineDiffCoreKernels();
+
+#ifdef MAYA_USD_UTILS_HAS_AVX2_KERNELS
+/// returns the kernels built with AVX2, FMA & F16C enabled. Only call this if the CPU supports all three!
+const DiffCoreKernels& avx2DiffCoreKernels();
+#endif
+
+} // MayaUsdUtils
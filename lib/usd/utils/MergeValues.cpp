@@ -0,0 +1,158 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "MergeValues.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace MayaUsdUtils {
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+inline uint32_t hashTuple(const float* value, uint32_t dimension)
+{
+  // FNV-1a over the bits of each component, with -0 and +0 hashed alike since they compare equal.
+  uint32_t hash = 2166136261u;
+  for(uint32_t i = 0; i < dimension; ++i)
+  {
+    uint32_t bits = 0;
+    if(value[i] != 0.0f)
+    {
+      std::memcpy(&bits, value + i, sizeof(bits));
+    }
+    hash = (hash ^ bits) * 16777619u;
+  }
+  // mix the high bits into the low ones, since the table is indexed with the low bits.
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  return hash;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline bool tuplesEqual(const float* a, const float* b, uint32_t dimension)
+{
+  for(uint32_t i = 0; i < dimension; ++i)
+  {
+    if(!(a[i] == b[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t mergeEquivalentIndexedValues(
+    const float* values,
+    size_t valueCount,
+    uint32_t dimension,
+    const int32_t* indices,
+    size_t indexCount,
+    float* uniqueValues,
+    int32_t* uniqueIndices)
+{
+  if(!valueCount || !indexCount)
+  {
+    std::copy(indices, indices + indexCount, uniqueIndices);
+    return 0;
+  }
+
+  // keep the load factor of the table under 0.5, so that probe sequences stay short.
+  const size_t maxUniqueCount = std::min(valueCount, indexCount);
+  size_t capacity = 16;
+  while(capacity < maxUniqueCount * 2)
+  {
+    capacity <<= 1;
+  }
+  const size_t mask = capacity - 1;
+
+  // a slot holds the hash and the unique index + 1 of the tuple it refers to, or 0 when empty. Both are stored side by
+  // side so that a probe touches a single cache line.
+  struct Slot
+  {
+    uint32_t hash;
+    uint32_t entry;
+  };
+  std::vector<Slot> slots(capacity, Slot{0, 0});
+
+  // unique index of each source value already seen, or -1.
+  std::vector<int32_t> remapped(valueCount, -1);
+
+  size_t uniqueCount = 0;
+  for(size_t i = 0; i < indexCount; ++i)
+  {
+    const int32_t index = indices[i];
+    if(index < 0 || static_cast<size_t>(index) >= valueCount)
+    {
+      // This is an unassigned or otherwise unknown index, so just keep it.
+      uniqueIndices[i] = index;
+      continue;
+    }
+
+    if(remapped[index] >= 0)
+    {
+      uniqueIndices[i] = remapped[index];
+      continue;
+    }
+
+    const float* const value = values + static_cast<size_t>(index) * dimension;
+
+    // a NaN never compares equal, not even to itself, so a tuple containing one is never merged with another source
+    // value. It is still shared by all the indices of its own source value, through the remap, which bounds the
+    // number of unique values by min(valueCount, indexCount). It is kept out of the table, since it could never be
+    // found there.
+    if(!tuplesEqual(value, value, dimension))
+    {
+      const int32_t uniqueIndex = static_cast<int32_t>(uniqueCount++);
+      std::copy(value, value + dimension, uniqueValues + static_cast<size_t>(uniqueIndex) * dimension);
+      uniqueIndices[i] = remapped[index] = uniqueIndex;
+      continue;
+    }
+
+    // the table holds at most maxUniqueCount entries, less than half of its capacity, so there always is an empty
+    // slot to end the probe sequence.
+    const uint32_t hash = hashTuple(value, dimension);
+    int32_t uniqueIndex = -1;
+    for(size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+    {
+      const uint32_t entry = slots[slot].entry;
+      if(!entry)
+      {
+        uniqueIndex = static_cast<int32_t>(uniqueCount++);
+        std::copy(value, value + dimension, uniqueValues + static_cast<size_t>(uniqueIndex) * dimension);
+        slots[slot] = Slot{hash, static_cast<uint32_t>(uniqueCount)};
+        break;
+      }
+      if(slots[slot].hash == hash &&
+         tuplesEqual(uniqueValues + static_cast<size_t>(entry - 1) * dimension, value, dimension))
+      {
+        uniqueIndex = static_cast<int32_t>(entry - 1);
+        break;
+      }
+    }
+
+    uniqueIndices[i] = remapped[index] = uniqueIndex;
+  }
+
+  return uniqueCount;
+}
+
+} // MayaUsdUtils
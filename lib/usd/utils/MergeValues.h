@@ -0,0 +1,53 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <mayaUsdUtils/Api.h>
+
+namespace MayaUsdUtils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  merges the exactly equal values of an indexed array of float tuples, so that all the indices of a given
+///         value refer to a single copy of it.
+/// \param  values the array of valueCount tuples of dimension floats
+/// \param  valueCount the number of tuples in the values array
+/// \param  dimension the number of floats per tuple
+/// \param  indices the array of indices into the values array
+/// \param  indexCount the number of indices
+/// \param  uniqueValues the output array of unique tuples, in order of first use. It must be able to hold
+///         min(valueCount, indexCount) tuples.
+/// \param  uniqueIndices the output array of indexCount indices into the unique values. Indices that are negative or
+///         out of range are copied as is.
+/// \return the number of unique tuples written to uniqueValues
+/// \note   Values are deduplicated with an open addressing hash table sized up front, and indices referring to a value
+///         already seen skip the hashing entirely. Components are compared exactly, with -0 and +0 equal. Tuples
+///         containing NaNs are never merged with another source value, but all the indices of a given source value
+///         still share a single copy of it.
+//----------------------------------------------------------------------------------------------------------------------
+MAYA_USD_UTILS_PUBLIC
+size_t mergeEquivalentIndexedValues(
+    const float* values,
+    size_t valueCount,
+    uint32_t dimension,
+    const int32_t* indices,
+    size_t indexCount,
+    float* uniqueValues,
+    int32_t* uniqueIndices);
+
+} // MayaUsdUtils
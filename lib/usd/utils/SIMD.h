@@ -61,6 +61,13 @@
 
 namespace MayaUsdUtils {
 
+// When the same code is compiled for several instruction sets within one library (see DiffCoreAVX2.cpp), the inline
+// functions below would be emitted with the same mangled name in each translation unit, and the linker would be free
+// to pick any one of them. MAYA_USD_UTILS_SIMD_ISA gives each instruction set its own symbols.
+#ifdef MAYA_USD_UTILS_SIMD_ISA
+inline namespace MAYA_USD_UTILS_SIMD_ISA {
+#endif
+
 #if defined(__SSE__)
 typedef __m128 f128;
 typedef __m128i i128;
@@ -415,5 +422,9 @@ inline f128 loadmask3f(const void* const ptr, size_t count)
 }
 #endif
 
+#ifdef MAYA_USD_UTILS_SIMD_ISA
+} // MAYA_USD_UTILS_SIMD_ISA
+#endif
+
 } // MayaUsdUtils
 
@@ -450,8 +450,9 @@ static void postFileSave(void*)
 {
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("postFileSave\n");
 
+  // The usdc data is kept, so that the next save only serialises the layers that changed
   nodes::LayerManager* layerManager = nodes::LayerManager::findManager();
-  if (layerManager)
+  if (layerManager && nodes::LayerManager::serialisationFormat() != nodes::LayerManager::SerialisationFormat::kUsdc)
   { 
     AL_MAYA_CHECK_ERROR2(layerManager->clearSerialisationAttributes(), "postFileSave");
   }
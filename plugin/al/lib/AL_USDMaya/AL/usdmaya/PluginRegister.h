@@ -202,6 +202,11 @@ MStatus registerPlugin(AFnPlugin& plugin)
     MGlobal::setOptionVarValue("AL_usdmaya_selectionEnabled", true);
   }
 
+  if(!MGlobal::optionVarExists("AL_usdmaya_selectUsingBvh"))
+  {
+    MGlobal::setOptionVarValue("AL_usdmaya_selectUsingBvh", true);
+  }
+
   if(!MGlobal::optionVarExists("AL_usdmaya_pushToPrim"))
   {
     MGlobal::setOptionVarValue("AL_usdmaya_pushToPrim", true);
@@ -336,6 +341,7 @@ MStatus registerPlugin(AFnPlugin& plugin)
   AL::maya::utils::MenuBuilder::addEntry("USD/Animated Geometry/Connect selected meshes to USD (static)", "AL_usdmaya_meshStaticImport");
   AL::maya::utils::MenuBuilder::addEntry("USD/Animated Geometry/Connect selected meshes to USD (animated)", "AL_usdmaya_meshAnimImport");
   AL::maya::utils::MenuBuilder::addEntry("USD/Selection Enabled", "optionVar -iv \\\"AL_usdmaya_selectionEnabled\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_selectionEnabled"));
+  AL::maya::utils::MenuBuilder::addEntry("USD/Selection Uses CPU Picking", "optionVar -iv \\\"AL_usdmaya_selectUsingBvh\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_selectUsingBvh"));
   AL::maya::utils::MenuBuilder::addEntry("USD/Enable pushToPrim", "optionVar -iv \\\"AL_usdmaya_pushToPrim\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_pushToPrim"));
   AL::maya::utils::MenuBuilder::addEntry("USD/Selection Ignore Lock Prims Enabled", "optionVar -iv \\\"AL_usdmaya_ignoreLockPrims\\\" #1", true, MGlobal::optionVarIntValue("AL_usdmaya_ignoreLockPrims"));
   CHECK_MSTATUS(AL::maya::utils::MenuBuilder::generatePluginUI(plugin, "AL_usdmaya"));
@@ -15,28 +15,68 @@
 //
 #include <AL/usdmaya/SelectabilityDB.h>
 
+#include <algorithm>
+
 namespace AL {
 namespace usdmaya {
 
 //----------------------------------------------------------------------------------------------------------------------
 bool SelectabilityDB::isPathUnselectable(const SdfPath& path) const
 {
-  auto begin = m_unselectablePaths.begin();
-  auto end = m_unselectablePaths.end();
-  auto foundPathEntry = end;
-  auto root = SdfPath::AbsoluteRootPath();
-  auto temp(path);
+  if(m_unselectablePaths.empty() || !path.IsAbsolutePath())
+  {
+    return false;
+  }
+  return resolveUnselectable(path);
+}
 
-  while(temp != root)
+//----------------------------------------------------------------------------------------------------------------------
+bool SelectabilityDB::resolveUnselectable(const SdfPath& path) const
+{
+  if(path == SdfPath::AbsoluteRootPath())
   {
-    foundPathEntry = std::lower_bound(begin, foundPathEntry, temp);
-    if(foundPathEntry != end && temp == *foundPathEntry)
-    {
-      return true;
-    }
-    temp = temp.GetParentPath();
+    return false;
   }
-  return false;
+
+  auto found = m_resolved.find(path);
+  if(found != m_resolved.end() && found->second != kUnresolved)
+  {
+    return found->second == kUnselectable;
+  }
+
+  // a path is unselectable if it, or one of its ancestors, is in the list.
+  const bool unselectable = std::binary_search(m_unselectablePaths.begin(), m_unselectablePaths.end(), path) ||
+                            resolveUnselectable(path.GetParentPath());
+  m_resolved[path] = unselectable ? kUnselectable : kSelectable;
+  return unselectable;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SelectabilityDB::invalidateSubtree(const SdfPath& path)
+{
+  auto found = m_resolved.find(path);
+  if(found != m_resolved.end())
+  {
+    // erases the descendants of the path as well.
+    m_resolved.erase(found);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void SelectabilityDB::replaceUnselectablePathsInSubtree(const SdfPath& root, const SdfPathVector& paths)
+{
+  // determine range of unselectable paths we need to replace
+  auto lb = std::lower_bound(m_unselectablePaths.begin(), m_unselectablePaths.end(), root);
+  auto ub = lb;
+  while(ub != m_unselectablePaths.end() && ub->HasPrefix(root))
+  {
+    ++ub;
+  }
+
+  lb = m_unselectablePaths.erase(lb, ub);
+  m_unselectablePaths.insert(lb, paths.begin(), paths.end());
+
+  invalidateSubtree(root);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -57,6 +97,8 @@ void SelectabilityDB::removePathsAsUnselectable(const SdfPathVector& paths)
       if(*temp == path)
       {
         temp = m_unselectablePaths.erase(temp);
+        end = m_unselectablePaths.end();
+        invalidateSubtree(path);
       }
       start = temp;
     }
@@ -82,12 +124,18 @@ void SelectabilityDB::addPathsAsUnselectable(const SdfPathVector& paths)
     if(start == end)
     {
       m_unselectablePaths.insert(end, iter, last);
+      for(; iter != last; ++iter)
+      {
+        invalidateSubtree(*iter);
+      }
       return;
     }
 
     if(*start != *iter)
     {
-      m_unselectablePaths.insert(start, *iter);
+      start = m_unselectablePaths.insert(start, *iter);
+      end = m_unselectablePaths.end();
+      invalidateSubtree(*iter);
     }
   }
 }
@@ -106,6 +154,7 @@ bool SelectabilityDB::removeUnselectablePath(const SdfPath& path)
   if(foundPathEntry != end && *foundPathEntry == path)
   {
     m_unselectablePaths.erase(foundPathEntry);
+    invalidateSubtree(path);
     return true;
   }
   return false;
@@ -121,12 +170,14 @@ bool SelectabilityDB::addUnselectablePath(const SdfPath& path)
     if(*iter != path)
     {
       m_unselectablePaths.insert(iter, path);
+      invalidateSubtree(path);
       return true;
     }
   }
   else
   {
     m_unselectablePaths.push_back(path);
+    invalidateSubtree(path);
     return true;
   }
   return false;
@@ -20,6 +20,7 @@
 
 #include <pxr/pxr.h>
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -28,6 +29,11 @@ namespace usdmaya {
 
 ///---------------------------------------------------------------------------------------------------------------------
 /// \brief  Logic that stores a sorted list of paths which represent Selectable points in the USD hierarchy
+///
+///         The selectability of a path is inherited from its ancestors, which would make each query walk up the
+///         hierarchy. Resolved answers are memoized per path (along with those of the ancestors visited to resolve
+///         them), so repeated queries, and queries of siblings, are answered with a single table lookup. Changing the
+///         selectability of a path only forgets the answers within its subtree.
 ///---------------------------------------------------------------------------------------------------------------------
 class SelectabilityDB
 {
@@ -81,8 +87,17 @@ public:
   {
     m_unselectablePaths = paths;
     std::sort(m_unselectablePaths.begin(), m_unselectablePaths.end());
+    m_resolved.clear();
   }
 
+  //--------------------------------------------------------------------------------------------------------------------
+  /// \brief  Replaces the unselectable paths at or below the root path (e.g. after the subtree was resynced)
+  /// \param  root the root of the subtree to replace
+  /// \param  paths the new unselectable paths within the subtree, which must be sorted.
+  //--------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  void replaceUnselectablePathsInSubtree(const SdfPath& root, const SdfPathVector& paths);
+
   //--------------------------------------------------------------------------------------------------------------------
   /// \brief  Adds a path to the unselectable list
   /// \param  path which will be added as unselectable. All children paths will be also unselectable
@@ -113,9 +128,22 @@ public:
 private:
   bool addUnselectablePath(const SdfPath& path);
   bool removeUnselectablePath(const SdfPath& path);
+  bool resolveUnselectable(const SdfPath& path) const;
+  void invalidateSubtree(const SdfPath& path);
 
 private:
+  enum ResolvedState : char
+  {
+    kUnresolved = 0,
+    kSelectable,
+    kUnselectable
+  };
+
   SdfPathVector m_unselectablePaths;
+
+  // The memoized selectability of paths. The table also holds the (possibly unresolved) ancestors of each entry,
+  // which allows forgetting a subtree with a single erase.
+  mutable SdfPathTable<ResolvedState> m_resolved;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -23,106 +23,292 @@
 #include <maya/MAnimUtil.h>
 #include <maya/MFnAnimCurve.h>
 #include <maya/MFnDagNode.h>
+#include <maya/MFnNumericAttribute.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MMatrix.h>
 #include <maya/MNodeClass.h>
 
+#include <pxr/usd/sdf/changeBlock.h>
+
+#include <memory>
+
 namespace AL {
 namespace usdmaya {
 namespace fileio {
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  a float or double attribute driven by a numeric plug. The values are sampled into a buffer at each frame,
+///         and written into USD once all of the frames have been evaluated.
+struct ScalarChannel
+{
+  MObject m_node;
+  MObject m_attribute;
+  UsdAttribute m_attr;
+  float m_scale;
+  bool m_isDouble;
+  std::vector<double> m_samples;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  an attribute whose values are sampled into a buffer, along with the time codes at which they were sampled
+template<typename T>
+struct SampledChannel
+{
+  UsdAttribute m_attr;
+  std::vector<std::pair<UsdTimeCode, T>> m_samples;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if copyAttributeValue would set the value of the plug with DgNodeHelper::getFloat or getDouble
+bool isScalarPlug(const MPlug& plug, const UsdAttribute& attr, bool& isDouble)
+{
+  if(plug.isArray())
+  {
+    return false;
+  }
+  MObject attribute = plug.attribute();
+  switch(attribute.apiType())
+  {
+  case MFn::kNumericAttribute:
+    switch(MFnNumericAttribute(attribute).unitType())
+    {
+    case MFnNumericData::kFloat:
+    case MFnNumericData::kDouble:
+    case MFnNumericData::kInt:
+    case MFnNumericData::kShort:
+    case MFnNumericData::kInt64:
+    case MFnNumericData::kByte:
+    case MFnNumericData::kChar:
+      break;
+    default:
+      return false;
+    }
+    break;
+
+  case MFn::kTimeAttribute:
+  case MFn::kFloatAngleAttribute:
+  case MFn::kDoubleAngleAttribute:
+  case MFn::kDoubleLinearAttribute:
+  case MFn::kFloatLinearAttribute:
+    break;
+
+  default:
+    return false;
+  }
+
+  switch(usdmaya::utils::getAttributeType(attr))
+  {
+  case usdmaya::utils::UsdDataType::kFloat: isDouble = false; return true;
+  case usdmaya::utils::UsdDataType::kDouble: isDouble = true; return true;
+  default: return false;
+  }
+}
+} // anon
+
 //----------------------------------------------------------------------------------------------------------------------
 void AnimationTranslator::exportAnimation(const ExporterParams& params)
 {
-  auto const startAttrib =  m_animatedPlugs.begin();
-  auto const endAttrib =  m_animatedPlugs.end();
-  auto const startAttribScaled =  m_scaledAnimatedPlugs.begin();
-  auto const endAttribScaled =  m_scaledAnimatedPlugs.end();
-  auto const startTransformAttrib = m_animatedTransformPlugs.begin();
-  auto const endTransformAttrib = m_animatedTransformPlugs.end();
-  auto const startMultiAttrib = m_animatedMultiPlugs.begin();
-  auto const endMultiAttrib = m_animatedMultiPlugs.end();
-  auto const startMesh = m_animatedMeshes.begin();
-  auto const endMesh = m_animatedMeshes.end();
-  auto const startWSM = m_worldSpaceOutputs.begin();
-  auto const endWSM = m_worldSpaceOutputs.end();
-
-  if((startAttrib != endAttrib) ||
-     (startAttribScaled != endAttribScaled) ||
-     (startTransformAttrib != endTransformAttrib) ||
-     (startMultiAttrib != endMultiAttrib) ||
-     (startMesh != endMesh) ||
-     (startWSM != endWSM) ||
-     (!m_animatedNodes.empty()))
-  {
-    double increment = 1.0 / std::max(1U, params.m_subSamples);
-    for(double t = params.m_minFrame, e = params.m_maxFrame + 1e-3f; t < e; t += increment)
+  if(m_animatedPlugs.empty() &&
+     m_scaledAnimatedPlugs.empty() &&
+     m_animatedTransformPlugs.empty() &&
+     m_animatedMultiPlugs.empty() &&
+     m_animatedMeshes.empty() &&
+     m_worldSpaceOutputs.empty() &&
+     m_animatedNodes.empty())
+  {
+    return;
+  }
+
+  // Resolve the plugs and attributes once, into flat tables that are cheap to walk at each frame. Float and double
+  // attributes, world space matrices and clipping ranges are sampled into buffers, and written into USD after the
+  // last frame. The other attributes are copied at each frame.
+  std::vector<ScalarChannel> scalarChannels;
+  std::vector<std::pair<MPlug, UsdAttribute>> plugs;
+  std::vector<std::pair<MPlug, ScaledPair>> scaledPlugs;
+  bool isDouble = false;
+  for(const auto& plugAndAttr : m_animatedPlugs)
+  {
+    if(isScalarPlug(plugAndAttr.first, plugAndAttr.second, isDouble))
+    {
+      scalarChannels.push_back({plugAndAttr.first.node(), plugAndAttr.first.attribute(), plugAndAttr.second, 1.0f, isDouble, {}});
+    }
+    else
+    {
+      plugs.emplace_back(plugAndAttr.first, plugAndAttr.second);
+    }
+  }
+  for(const auto& plugAndAttr : m_scaledAnimatedPlugs)
+  {
+    if(isScalarPlug(plugAndAttr.first, plugAndAttr.second.attr, isDouble))
+    {
+      scalarChannels.push_back({plugAndAttr.first.node(), plugAndAttr.first.attribute(), plugAndAttr.second.attr,
+          plugAndAttr.second.scale, isDouble, {}});
+    }
+    else
+    {
+      scaledPlugs.emplace_back(plugAndAttr.first, plugAndAttr.second);
+    }
+  }
+  std::vector<std::pair<MPlug, UsdAttribute>> transformPlugs(m_animatedTransformPlugs.begin(), m_animatedTransformPlugs.end());
+
+  // Note: so far there is only one attribute need to be treated specially
+  //       we do this special handling for this particular attribute atm,
+  //       will see if we need to generalize once have more requests
+  std::vector<std::pair<std::vector<MPlug>, SampledChannel<GfVec2f>>> clippingRanges;
+  for(const auto& attrAndPlugs : m_animatedMultiPlugs)
+  {
+    if(attrAndPlugs.first.GetName() == UsdGeomTokens->clippingRange && attrAndPlugs.second.size() == 2)
     {
-      MAnimControl::setCurrentTime(t);
-      UsdTimeCode timeCode(t);
-      for(auto it = startAttrib; it != endAttrib; ++it)
+      clippingRanges.emplace_back(attrAndPlugs.second, SampledChannel<GfVec2f>{attrAndPlugs.first, {}});
+    }
+  }
+
+  std::vector<std::pair<MDagPath, SampledChannel<GfMatrix4d>>> worldSpaceMatrices;
+  worldSpaceMatrices.reserve(m_worldSpaceOutputs.size());
+  for(const auto& pathAndAttr : m_worldSpaceOutputs)
+  {
+    worldSpaceMatrices.emplace_back(pathAndAttr.first, SampledChannel<GfMatrix4d>{pathAndAttr.second, {}});
+  }
+
+  // The mesh export contexts are created once, and re-attached to the meshes at each frame
+  std::vector<UsdGeomMesh> meshes;
+  std::vector<std::pair<MDagPath, std::unique_ptr<AL::usdmaya::utils::MeshExportContext>>> meshContexts;
+  meshes.reserve(m_animatedMeshes.size());
+  meshContexts.reserve(m_animatedMeshes.size());
+  for(const auto& pathAndAttr : m_animatedMeshes)
+  {
+    meshes.emplace_back(pathAndAttr.second.GetPrim());
+    std::unique_ptr<AL::usdmaya::utils::MeshExportContext> context(
+        new AL::usdmaya::utils::MeshExportContext(pathAndAttr.first, meshes.back(), UsdTimeCode(params.m_minFrame)));
+    if(*context)
+    {
+      meshContexts.emplace_back(pathAndAttr.first, std::move(context));
+    }
+  }
+
+  std::vector<UsdTimeCode> timeCodes;
+  double increment = 1.0 / std::max(1U, params.m_subSamples);
+  for(double t = params.m_minFrame, e = params.m_maxFrame + 1e-3f; t < e; t += increment)
+  {
+    timeCodes.emplace_back(t);
+  }
+  for(auto& channel : scalarChannels)
+  {
+    channel.m_samples.reserve(timeCodes.size());
+  }
+  for(auto& matrix : worldSpaceMatrices)
+  {
+    matrix.second.m_samples.reserve(timeCodes.size());
+  }
+
+  for(const UsdTimeCode& timeCode : timeCodes)
+  {
+    MAnimControl::setCurrentTime(MTime(timeCode.GetValue()));
+
+    for(auto& channel : scalarChannels)
+    {
+      if(channel.m_isDouble)
       {
-        /// \todo This feels wrong. Split the DgNodeTranslator class into 3 ...
-        ///         maya::Dg
-        ///         usdmaya::Dg
-        ///         usdmaya::fileio::translator::Dg
-        translators::DgNodeTranslator::copyAttributeValue(it->first, it->second, timeCode);
+        double value;
+        translators::DgNodeTranslator::getDouble(channel.m_node, channel.m_attribute, value);
+        channel.m_samples.push_back(value);
       }
-      for(auto it = startAttribScaled; it != endAttribScaled; ++it)
+      else
+      {
+        float value;
+        translators::DgNodeTranslator::getFloat(channel.m_node, channel.m_attribute, value);
+        channel.m_samples.push_back(value);
+      }
+    }
+    for(auto& range : clippingRanges)
+    {
+      MDistance nearDistance;
+      MDistance farDistance;
+      if (range.first[0].getValue(nearDistance) == MStatus::kSuccess && range.first[1].getValue(farDistance) == MStatus::kSuccess)
+      {
+        range.second.m_samples.emplace_back(timeCode, GfVec2f(
+          static_cast<float>(nearDistance.as(MDistance::kCentimeters)),
+          static_cast<float>(farDistance.as(MDistance::kCentimeters))));
+      }
+    }
+    for(auto& matrix : worldSpaceMatrices)
+    {
+      MMatrix mat = matrix.first.inclusiveMatrix();
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif
+      matrix.second.m_samples.emplace_back(timeCode, *(const GfMatrix4d*)&mat);
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+    }
+
+    {
+      // Only time samples are authored here, so the change notifications can safely be sent once per frame
+      SdfChangeBlock changeBlock;
+      for(auto& plugAndAttr : plugs)
       {
         /// \todo This feels wrong. Split the DgNodeTranslator class into 3 ...
         ///         maya::Dg
         ///         usdmaya::Dg
         ///         usdmaya::fileio::translator::Dg
-        translators::DgNodeTranslator::copyAttributeValue(it->first, it->second.attr, it->second.scale, timeCode);
+        translators::DgNodeTranslator::copyAttributeValue(plugAndAttr.first, plugAndAttr.second, timeCode);
       }
-      for (auto it = startTransformAttrib; it != endTransformAttrib; ++it)
+      for(auto& plugAndAttr : scaledPlugs)
       {
-        translators::TransformTranslator::copyAttributeValue(it->first, it->second, timeCode);
+        translators::DgNodeTranslator::copyAttributeValue(plugAndAttr.first, plugAndAttr.second.attr,
+            plugAndAttr.second.scale, timeCode);
       }
-      for (auto it = startMultiAttrib; it != endMultiAttrib; ++it)
+      for(auto& plugAndAttr : transformPlugs)
       {
-        // Note: so far there is only one attribute need to be treated specially
-        //       we do this special handling for this particular attribute atm,
-        //       will see if we need to generalize once have more requests
-        if (it->first.GetName() == UsdGeomTokens->clippingRange && it->second.size() == 2)
-        {
-          const auto& plugs(it->second);
-          MDistance nearDistance;
-          MDistance farDistance;
-          if (plugs[0].getValue(nearDistance) == MStatus::kSuccess && plugs[1].getValue(farDistance) == MStatus::kSuccess)
-          {
-            GfVec2f clippingRange{
-              static_cast<float>(nearDistance.as(MDistance::kCentimeters)),
-              static_cast<float>(farDistance.as(MDistance::kCentimeters))};
-            it->first.Set(clippingRange,timeCode);
-          }
-        }
+        translators::TransformTranslator::copyAttributeValue(plugAndAttr.first, plugAndAttr.second, timeCode);
       }
-      for(auto it = startMesh; it != endMesh; ++it)
+      for(auto& meshContext : meshContexts)
       {
-        UsdGeomMesh mesh(it->second.GetPrim());
-        AL::usdmaya::utils::MeshExportContext context(it->first, mesh, timeCode);
-        context.copyVertexData(timeCode);
+        meshContext.second->getFn().setObject(meshContext.first);
+        meshContext.second->copyVertexData(timeCode);
       }
-      for(auto nodeAnim : m_animatedNodes)
+    }
+
+    for(auto nodeAnim : m_animatedNodes)
+    {
+      nodeAnim.m_translator->exportCustomAnim(nodeAnim.m_path, nodeAnim.m_prim, timeCode);
+    }
+  }
+
+  // Write the buffered samples, with a single change notification
+  SdfChangeBlock changeBlock;
+  for(auto& channel : scalarChannels)
+  {
+    for(size_t i = 0, n = channel.m_samples.size(); i < n; ++i)
+    {
+      if(channel.m_isDouble)
       {
-        nodeAnim.m_translator->exportCustomAnim(nodeAnim.m_path, nodeAnim.m_prim, timeCode);
+        channel.m_attr.Set(channel.m_samples[i] * channel.m_scale, timeCodes[i]);
       }
-      for(auto it = startWSM; it != endWSM; ++it)
+      else
       {
-        MMatrix mat = it->first.inclusiveMatrix();
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstrict-aliasing"
-#endif
-        it->second.Set(*(const GfMatrix4d*)&mat, timeCode);
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
+        channel.m_attr.Set(float(channel.m_samples[i]) * channel.m_scale, timeCodes[i]);
       }
     }
   }
+  for(auto& range : clippingRanges)
+  {
+    for(const auto& sample : range.second.m_samples)
+    {
+      range.second.m_attr.Set(sample.second, sample.first);
+    }
+  }
+  for(auto& matrix : worldSpaceMatrices)
+  {
+    for(const auto& sample : matrix.second.m_samples)
+    {
+      matrix.second.m_attr.Set(sample.second, sample.first);
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -19,6 +19,9 @@
 #include <maya/MSelectionList.h>
 #include <maya/MFnDagNode.h>
 
+#include <pxr/base/tf/hashset.h>
+
+#include <algorithm>
 #include <string>
 
 namespace AL {
@@ -490,12 +493,16 @@ void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& i
   // the the itemsToRemove will be ordered such that the child prims will be destroyed before their parents).
   auto iter = range_end;
   itemsToRemove.reserve(itemsToRemove.size() + range_end - range_begin);
+
+  // preRemoveEntry is often called multiple times before the changes are handled, so hash the paths that are
+  // already queued, rather than searching the whole vector for each child prim.
+  TfHashSet<SdfPath, SdfPath::Hash> queuedPaths(itemsToRemove.begin(), itemsToRemove.end());
   while(iter != range_begin)
   {
     --iter;
     PrimLookup& node = *iter;
 
-    if(std::find(itemsToRemove.begin(), itemsToRemove.end(), node.path()) != itemsToRemove.end())
+    if(!queuedPaths.insert(node.path()).second)
     {
       // Same exact path has already been processed and added to the list of itemsToRemove.
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry skipping path thats already in "
@@ -522,13 +529,18 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
   MDagModifier modifier;
   MStatus status;
 
+  // The entries are only erased from m_primMapping once all of the prims have been unloaded, in a single pass.
+  // Erasing them one at a time shuffles the remainder of the (sorted) vector each time, which becomes quadratic
+  // when a variant switch removes a large hierarchy.
+  TfHashSet<SdfPath, SdfPath::Hash> removedPaths;
+
   // so now we need to unload the prims (itemsToRemove is reverse sorted so we won't nuke parents before children)
   auto iter = itemsToRemove.begin();
   while(iter != itemsToRemove.end())
   {
     auto path = *iter;
     auto node = std::lower_bound(m_primMapping.begin(), m_primMapping.end(), path, value_compare());
-    if(node == m_primMapping.end())
+    if(node == m_primMapping.end() || !removedPaths.insert(path).second)
     {
       ++iter;
       continue;
@@ -541,13 +553,6 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
       unloadPrim(path, node->object());
     }
 
-    // The item might already have been removed by a translator...
-    if(node != m_primMapping.end() && node->path() == path)
-    {
-      // remove nodes from map
-      m_primMapping.erase(node);
-    }
-
     if(isInTransformChain)
     {
       m_proxyShape->removeUsdTransformChain(path, modifier, nodes::ProxyShape::kRequired);
@@ -555,6 +560,16 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
 
     ++iter;
   }
+
+  // remove nodes from map (the item might already have been removed by a translator, in which case it won't be found)
+  if(!removedPaths.empty())
+  {
+    m_primMapping.erase(
+      std::remove_if(m_primMapping.begin(), m_primMapping.end(),
+                     [&removedPaths](const PrimLookup& lookup) { return removedPaths.count(lookup.path()) != 0; }),
+      m_primMapping.end());
+  }
+
   status = modifier.doIt();
   AL_MAYA_CHECK_ERROR2(status, "failed to remove translator prims.");
 }
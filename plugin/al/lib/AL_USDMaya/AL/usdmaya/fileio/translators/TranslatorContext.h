@@ -448,6 +448,10 @@ public:
   inline bool isExcludedGeometryDirty()
     {return m_isExcludedGeometryDirty;}
 
+  /// \brief Flags the excluded geometry as having been pushed to the renderer
+  inline void clearExcludedGeometryDirty()
+    {m_isExcludedGeometryDirty = false;}
+
 private:
   void unloadPrim(
       const SdfPath& primPath,
@@ -495,7 +499,7 @@ private:
 
 
   TranslatorContext(nodes::ProxyShape* proxyShape)
-    : m_proxyShape(proxyShape), m_primMapping()
+    : m_proxyShape(proxyShape), m_primMapping(), m_isExcludedGeometryDirty(false)
     {}
 
   nodes::ProxyShape* m_proxyShape;
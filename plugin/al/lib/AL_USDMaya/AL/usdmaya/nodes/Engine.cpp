@@ -40,8 +40,39 @@ namespace AL {
 namespace usdmaya {
 namespace nodes {
 
-Engine::Engine(const SdfPath& rootPath, const SdfPathVector& excludedPaths)
-  : UsdImagingGLEngine(rootPath, excludedPaths) {}
+namespace {
+SdfPathVector _CombinePaths(const SdfPathVector& a, const SdfPathVector& b) {
+  SdfPathVector paths(a);
+  paths.insert(paths.end(), b.begin(), b.end());
+  return paths;
+}
+}
+
+Engine::Engine(const SdfPath& rootPath, const SdfPathVector& excludedPaths, const SdfPathVector& invisedPaths)
+  : UsdImagingGLEngine(rootPath,
+                       IsHydraEnabled() ? excludedPaths : _CombinePaths(excludedPaths, invisedPaths),
+                       invisedPaths) {}
+
+bool Engine::SetInvisedPrimPaths(const SdfPathVector& invisedPaths) {
+  if (ARCH_UNLIKELY(_legacyImpl)) {
+    return false;
+  }
+
+  // keep a copy in case the render index is (re)populated later on
+  _invisedPrimPaths = invisedPaths;
+  if (!_isPopulated) {
+    return true;
+  }
+
+  // the delegate diffs the new paths against the current ones, and only dirties the visibility of the subtrees
+  // that have been added or removed.
+#if defined(USDIMAGINGGL_API_VERSION) && USDIMAGINGGL_API_VERSION >= 5
+  _GetSceneDelegate()->SetInvisedPrimPaths(invisedPaths);
+#else
+  _delegate->SetInvisedPrimPaths(invisedPaths);
+#endif
+  return true;
+}
 
 bool Engine::TestIntersectionBatch(
   const GfMatrix4d &viewMatrix,
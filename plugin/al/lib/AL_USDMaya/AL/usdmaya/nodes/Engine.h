@@ -26,8 +26,19 @@ namespace nodes {
 
 class Engine : public UsdImagingGLEngine {
 public:
+  /// \brief  the prims beneath the excluded paths are never added to the render index, whereas the prims beneath the
+  ///         invised paths are added but hidden (see SetInvisedPrimPaths). The legacy (non Hydra) engine does not
+  ///         support invised paths, so with that engine both sets of paths are excluded.
   Engine(const SdfPath& rootPath,
-         const SdfPathVector& excludedPaths);
+         const SdfPathVector& excludedPaths,
+         const SdfPathVector& invisedPaths = SdfPathVector());
+
+  /// \brief  hides the prims beneath the specified paths. Unlike the excluded paths, these can be changed at any
+  ///         time without repopulating the render index: only the subtrees whose visibility changes are invalidated.
+  /// \param  invisedPaths the full set of paths to hide
+  /// \return false if the engine does not support invised paths (i.e. it is the legacy engine), in which case the
+  ///         engine needs to be recreated with the new paths instead.
+  bool SetInvisedPrimPaths(const SdfPathVector& invisedPaths);
 
   struct HitInfo {
     GfVec3d worldSpaceHitPoint;
@@ -19,6 +19,10 @@
 #include "AL/usdmaya/TypeIDs.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
 
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/tf/envSetting.h>
+#include <pxr/base/tf/fastCompression.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/usd/sdf/textFileFormat.h>
 #include <pxr/usd/usd/usdaFileFormat.h>
 #include <pxr/usd/usd/usdcFileFormat.h>
@@ -33,8 +37,18 @@
 
 #include <boost/thread.hpp>
 #include <boost/thread/shared_lock_guard.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
 #include <mutex>
 
+PXR_NAMESPACE_OPEN_SCOPE
+TF_DEFINE_ENV_SETTING(AL_USDMAYA_SERIALISE_LAYERS_AS_USDC, false,
+    "Serialise the layers stored by the layer manager as binary usdc data instead of usda text.");
+PXR_NAMESPACE_CLOSE_SCOPE
+
 namespace {
   // Global mutex protecting _findNode / findOrCreateNode.
   // Recursive because we need to get the mutex inside of conditionalCreator,
@@ -102,6 +116,152 @@ namespace {
     }
     return dgmod.doIt();
   }
+
+  // Prefix of the layers serialised as usdc. Cannot be mistaken for usda text, which starts with a '#' comment.
+  const std::string _usdcPrefix = "usdc;lz4;base64,";
+
+  const char _base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::string encodeBase64(const std::string& bytes)
+  {
+    std::string encoded;
+    encoded.reserve(((bytes.size() + 2) / 3) * 4);
+    size_t i = 0;
+    for(; i + 2 < bytes.size(); i += 3)
+    {
+      const uint32_t n = (uint8_t(bytes[i]) << 16) | (uint8_t(bytes[i + 1]) << 8) | uint8_t(bytes[i + 2]);
+      encoded.push_back(_base64Chars[(n >> 18) & 63]);
+      encoded.push_back(_base64Chars[(n >> 12) & 63]);
+      encoded.push_back(_base64Chars[(n >> 6) & 63]);
+      encoded.push_back(_base64Chars[n & 63]);
+    }
+    if(i < bytes.size())
+    {
+      const bool twoBytes = i + 1 < bytes.size();
+      const uint32_t n = (uint8_t(bytes[i]) << 16) | (twoBytes ? uint8_t(bytes[i + 1]) << 8 : 0);
+      encoded.push_back(_base64Chars[(n >> 18) & 63]);
+      encoded.push_back(_base64Chars[(n >> 12) & 63]);
+      encoded.push_back(twoBytes ? _base64Chars[(n >> 6) & 63] : '=');
+      encoded.push_back('=');
+    }
+    return encoded;
+  }
+
+  bool decodeBase64(const char* encoded, size_t size, std::string& bytes)
+  {
+    int8_t values[256];
+    std::fill(std::begin(values), std::end(values), int8_t(-1));
+    for(int8_t i = 0; i < 64; ++i)
+    {
+      values[uint8_t(_base64Chars[i])] = i;
+    }
+
+    bytes.clear();
+    bytes.reserve((size / 4) * 3);
+    uint32_t n = 0;
+    int bits = 0;
+    for(size_t i = 0; i < size && encoded[i] != '='; ++i)
+    {
+      const int8_t value = values[uint8_t(encoded[i])];
+      if(value < 0)
+      {
+        return false;
+      }
+      n = (n << 6) | uint32_t(value);
+      bits += 6;
+      if(bits >= 8)
+      {
+        bits -= 8;
+        bytes.push_back(char((n >> bits) & 0xFF));
+      }
+    }
+    return true;
+  }
+
+  // Removes a temporary file, warning if it could not be, since it would be left behind.
+  void removeTempFile(const std::string& path)
+  {
+    if(std::remove(path.c_str()) != 0)
+    {
+      TF_WARN("LayerManager: failed to remove the temporary file %s", path.c_str());
+    }
+  }
+
+  // SdfLayer can only write usdc data to a file, so the crate goes through a temporary file.
+  bool exportToUsdc(const SdfLayerRefPtr& layer, std::string& bytes)
+  {
+    const std::string tempPath = ArchMakeTmpFileName("AL_usdmaya_layer", ".usdc");
+    bool exported = layer->Export(tempPath);
+    if(exported)
+    {
+      std::ifstream file(tempPath, std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      exported = !file.bad();
+    }
+    removeTempFile(tempPath);
+    return exported;
+  }
+
+  bool importFromUsdc(const SdfLayerRefPtr& layer, const std::string& bytes)
+  {
+    const std::string tempPath = ArchMakeTmpFileName("AL_usdmaya_layer", ".usdc");
+    {
+      std::ofstream file(tempPath, std::ios::binary);
+      file.write(bytes.data(), bytes.size());
+      if(!file)
+      {
+        file.close();
+        removeTempFile(tempPath);
+        return false;
+      }
+    }
+    SdfLayerRefPtr source = SdfLayer::OpenAsAnonymous(tempPath);
+    const bool imported = bool(source);
+    if(imported)
+    {
+      layer->TransferContent(source);
+    }
+    // The crate layer keeps its file open, so release it before removing the file.
+    source = TfNullPtr;
+    removeTempFile(tempPath);
+    return imported;
+  }
+
+  // The compressed data starts with the size of the uncompressed data, as 8 little endian bytes
+  std::string compress(const std::string& bytes)
+  {
+    std::string compressed(8 + TfFastCompression::GetCompressedBufferSize(bytes.size()), '\0');
+    for(int i = 0; i < 8; ++i)
+    {
+      compressed[i] = char((uint64_t(bytes.size()) >> (i * 8)) & 0xFF);
+    }
+    const size_t compressedSize = TfFastCompression::CompressToBuffer(bytes.data(), &compressed[8], bytes.size());
+    compressed.resize(8 + compressedSize);
+    return compressed;
+  }
+
+  bool decompress(const std::string& compressed, std::string& bytes)
+  {
+    if(compressed.size() < 8)
+    {
+      return false;
+    }
+    uint64_t size = 0;
+    for(int i = 0; i < 8; ++i)
+    {
+      size |= uint64_t(uint8_t(compressed[i])) << (i * 8);
+    }
+    bytes.resize(size);
+    return TfFastCompression::DecompressFromBuffer(compressed.data() + 8, &bytes[0], compressed.size() - 8, size) == size;
+  }
+
+  std::atomic<AL::usdmaya::nodes::LayerManager::SerialisationFormat>& _serialisationFormat()
+  {
+    using SerialisationFormat = AL::usdmaya::nodes::LayerManager::SerialisationFormat;
+    static std::atomic<SerialisationFormat> format(TfGetEnvSetting(AL_USDMAYA_SERIALISE_LAYERS_AS_USDC) ?
+        SerialisationFormat::kUsdc : SerialisationFormat::kUsda);
+    return format;
+  }
 }
 
 namespace AL {
@@ -249,6 +409,46 @@ MObject LayerManager::m_identifier = MObject::kNullObj;
 MObject LayerManager::m_serialized = MObject::kNullObj;
 MObject LayerManager::m_anonymous = MObject::kNullObj;
 
+//----------------------------------------------------------------------------------------------------------------------
+LayerManager::LayerManager()
+  : MPxNode(), NodeHelper()
+{
+  TfWeakPtr<LayerManager> me(this);
+  m_layersDidChangeKey = TfNotice::Register(me, &LayerManager::onLayersDidChange);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerManager::~LayerManager()
+{
+  TfNotice::Revoke(m_layersDidChangeKey);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::onLayersDidChange(const SdfNotice::LayersDidChange& notice)
+{
+  std::lock_guard<std::mutex> lock(m_unchangedLayersMutex);
+  if(m_unchangedLayers.empty())
+  {
+    return;
+  }
+  for(const auto& layer : notice.GetLayers())
+  {
+    m_unchangedLayers.erase(layer);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerManager::setSerialisationFormat(SerialisationFormat format)
+{
+  _serialisationFormat() = format;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerManager::SerialisationFormat LayerManager::serialisationFormat()
+{
+  return _serialisationFormat();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void* LayerManager::conditionalCreator()
 {
@@ -414,6 +614,38 @@ MStatus LayerManager::populateSerialisationAttributes()
 
   MStatus status;
   MPlug arrayPlug = layersPlug();
+  const SerialisationFormat format = serialisationFormat();
+
+  // Keep the stored data of the layers that have not changed since the previous save, by identifier
+  std::map<std::string, std::string> unchangedLayers;
+  {
+    std::lock_guard<std::mutex> lock(m_unchangedLayersMutex);
+    if(format == SerialisationFormat::kUsdc)
+    {
+      for(const auto& layer : m_unchangedLayers)
+      {
+        if(layer)
+        {
+          unchangedLayers.emplace(layer->GetIdentifier(), std::string());
+        }
+      }
+    }
+    m_unchangedLayers.clear();
+  }
+  if(!unchangedLayers.empty())
+  {
+    const unsigned int numElements = arrayPlug.numElements();
+    for(unsigned int i = 0; i < numElements; ++i)
+    {
+      MPlug elemPlug = arrayPlug.elementByPhysicalIndex(i, &status);
+      AL_MAYA_CHECK_ERROR_CONTINUE(status, errorString);
+      auto it = unchangedLayers.find(AL::maya::utils::convert(elemPlug.child(m_identifier).asString()));
+      if(it != unchangedLayers.end())
+      {
+        it->second = AL::maya::utils::convert(elemPlug.child(m_serialized).asString());
+      }
+    }
+  }
 
   // First, disconnect any connected attributes
   AL_MAYA_CHECK_ERROR(disconnectCompoundArrayPlug(arrayPlug), errorString);
@@ -425,29 +657,92 @@ MStatus LayerManager::populateSerialisationAttributes()
   AL_MAYA_CHECK_ERROR(status, errorString);
   {
     boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
-    MArrayDataBuilder builder(&dataBlock, layers(), m_layerDatabase.max_size(), &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
-    std::string temp;
+
+    // Serialising the layers is by far the most expensive part of the save, and the layers are independent of each
+    // other: serialise them in parallel, then fill out the attributes on the main thread.
+    std::vector<SdfLayerRefPtr> dirtyLayers;
+    dirtyLayers.reserve(m_layerDatabase.max_size());
     for (const auto& layerAndIds : m_layerDatabase)
     {
-      auto& layer = layerAndIds.first;
+      dirtyLayers.push_back(layerAndIds.first);
+    }
+
+    std::vector<std::string> serialisedLayers(dirtyLayers.size());
+    std::vector<size_t> changedLayers;
+    changedLayers.reserve(dirtyLayers.size());
+    for(size_t i = 0; i < dirtyLayers.size(); ++i)
+    {
+      auto it = unchangedLayers.find(dirtyLayers[i]->GetIdentifier());
+      if(it != unchangedLayers.end() && TfStringStartsWith(it->second, _usdcPrefix))
+      {
+        TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerManager::populateSerialisationAttributes %s unchanged since last save\n",
+            it->first.c_str());
+        serialisedLayers[i].swap(it->second);
+      }
+      else
+      {
+        changedLayers.push_back(i);
+      }
+    }
+    unchangedLayers.clear();
+
+    WorkParallelForN(changedLayers.size(), [&](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        serialisedLayers[changedLayers[i]] = serialiseLayer(dirtyLayers[changedLayers[i]], format);
+      }
+    });
+    m_lastSerialisedLayerCount = changedLayers.size();
+
+    MArrayDataBuilder builder(&dataBlock, layers(), dirtyLayers.size(), &status);
+    AL_MAYA_CHECK_ERROR(status, errorString);
+    for (size_t i = 0; i < dirtyLayers.size(); ++i)
+    {
+      auto& layer = dirtyLayers[i];
       MDataHandle layersElemHandle = builder.addLast(&status);
       AL_MAYA_CHECK_ERROR(status, errorString);
       MDataHandle idHandle = layersElemHandle.child(m_identifier);
       idHandle.setString(AL::maya::utils::convert(layer->GetIdentifier()));
       MDataHandle serializedHandle = layersElemHandle.child(m_serialized);
-      layer->ExportToString(&temp);
-      serializedHandle.setString(AL::maya::utils::convert(temp));
+      serializedHandle.setString(AL::maya::utils::convert(serialisedLayers[i]));
+      // The attribute holds its own copy, release ours as we go
+      std::string().swap(serialisedLayers[i]);
       MDataHandle anonHandle = layersElemHandle.child(m_anonymous);
       anonHandle.setBool(layer->IsAnonymous());
     }
     AL_MAYA_CHECK_ERROR(layersArrayHandle.set(builder), errorString);
+
+    if(format == SerialisationFormat::kUsdc)
+    {
+      std::lock_guard<std::mutex> unchangedLock(m_unchangedLayersMutex);
+      m_unchangedLayers.insert(dirtyLayers.begin(), dirtyLayers.end());
+    }
   }
   AL_MAYA_CHECK_ERROR(layersArrayHandle.setAllClean(), errorString);
   AL_MAYA_CHECK_ERROR(dataBlock.setClean(layers()), errorString);
   return status;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+std::string LayerManager::serialiseLayer(const SdfLayerRefPtr& layer, SerialisationFormat format)
+{
+  std::string serialised;
+  if(format == SerialisationFormat::kUsdc)
+  {
+    std::string bytes;
+    if(exportToUsdc(layer, bytes))
+    {
+      return _usdcPrefix + encodeBase64(compress(bytes));
+    }
+    TF_WARN("LayerManager: failed to serialise layer %s as usdc, falling back to usda",
+        layer->GetIdentifier().c_str());
+  }
+  layer->ExportToString(&serialised);
+  return serialised;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
 MStatus LayerManager::clearSerialisationAttributes()
 {
   TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerManager::clearSerialisationAttributes\n");
@@ -456,6 +751,11 @@ MStatus LayerManager::clearSerialisationAttributes()
   MStatus status;
   MPlug arrayPlug = layersPlug();
 
+  {
+    std::lock_guard<std::mutex> lock(m_unchangedLayersMutex);
+    m_unchangedLayers.clear();
+  }
+
   // First, disconnect any connected attributes
   AL_MAYA_CHECK_ERROR(disconnectCompoundArrayPlug(arrayPlug), errorString);
 
@@ -472,6 +772,7 @@ MStatus LayerManager::clearSerialisationAttributes()
   return status;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
 void LayerManager::loadAllLayers()
 {
   TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerManager::loadAllLayers\n");
@@ -536,7 +837,7 @@ void LayerManager::loadAllLayers()
         // an error. This seems unlikely, but we have a discussion with Pixar to find a way to avoid this.
 
         SdfFileFormatConstPtr fileFormat;
-        if(TfStringStartsWith(serializedVal, "#usda "))
+        if(TfStringStartsWith(serializedVal, "#usda ") || TfStringStartsWith(serializedVal, _usdcPrefix))
         {
           // In order to make the layer reloadable by SdfLayer::Reload(), we need the
           // correct file format from identifier.
@@ -583,7 +884,18 @@ void LayerManager::loadAllLayers()
         layer->GetFileFormat()->GetFormatId().GetText()
         );
 
-    if(!layer->ImportFromString(serializedVal))
+    bool imported = false;
+    if(TfStringStartsWith(serializedVal, _usdcPrefix))
+    {
+      std::string compressed, bytes;
+      imported = decodeBase64(serializedVal.c_str() + _usdcPrefix.size(), serializedVal.size() - _usdcPrefix.size(),
+          compressed) && decompress(compressed, bytes) && importFromUsdc(layer, bytes);
+    }
+    else
+    {
+      imported = layer->ImportFromString(serializedVal);
+    }
+    if(!imported)
     {
       TF_DEBUG(ALUSDMAYA_LAYERS).Msg("Import result: failed!\n"
                                     "################################################\n");
@@ -22,9 +22,13 @@
 
 #include <maya/MPxNode.h>
 
+#include <pxr/base/tf/notice.h>
+#include <pxr/base/tf/weakBase.h>
+#include <pxr/usd/sdf/notice.h>
 #include <pxr/usd/usd/stage.h>
 
 #include <map>
+#include <mutex>
 #include <set>
 
 // On Windows, against certain versions of Maya and with strict compiler
@@ -241,13 +245,25 @@ private:
 //----------------------------------------------------------------------------------------------------------------------
 class LayerManager
   : public MPxNode,
-    public AL::maya::utils::NodeHelper
+    public AL::maya::utils::NodeHelper,
+    public TfWeakBase
 {
 public:
 
+  /// \brief  The encodings used to store the layers in the Maya scene
+  enum class SerialisationFormat
+  {
+    kUsda,    ///< usda text, as returned by SdfLayer::ExportToString
+    kUsdc     ///< base64 encoded, LZ4 compressed usdc crate data, loaded back without parsing any text
+  };
+
   /// \brief  ctor
-  inline LayerManager()
-    : MPxNode(), NodeHelper() {}
+  AL_USDMAYA_PUBLIC
+  LayerManager();
+
+  /// \brief  dtor
+  AL_USDMAYA_PUBLIC
+  ~LayerManager();
 
   /// \brief  Find the already-existing non-referenced LayerManager node in the scene, or return a null MObject
   /// \return the found LayerManager node, or a null MObject
@@ -314,9 +330,15 @@ public:
   void getLayerIdentifiers(MStringArray& outputNames);
 
   /// \brief  Ensures that the layers attribute will be filled out with serialized versions of all tracked layers.
+  ///         With the kUsdc format, the layers that have not changed since the previous call keep the value already
+  ///         stored in the attribute instead of being serialised again.
   AL_USDMAYA_PUBLIC
   MStatus populateSerialisationAttributes();
 
+  /// \brief  Returns how many layers the last call to populateSerialisationAttributes actually serialised.
+  inline size_t lastSerialisedLayerCount() const
+    { return m_lastSerialisedLayerCount; }
+
   /// \brief  Clears the layers attribute.
   AL_USDMAYA_PUBLIC
   MStatus clearSerialisationAttributes();
@@ -325,6 +347,16 @@ public:
   AL_USDMAYA_PUBLIC
   void loadAllLayers();
 
+  /// \brief  Set the encoding used by populateSerialisationAttributes. Layers are loaded whatever their encoding.
+  ///         The default is kUsda, unless the AL_USDMAYA_SERIALISE_LAYERS_AS_USDC environment variable is set.
+  /// \param  format the encoding of the layers in the next saves
+  AL_USDMAYA_PUBLIC
+  static void setSerialisationFormat(SerialisationFormat format);
+
+  /// \brief  Returns the encoding used by populateSerialisationAttributes.
+  AL_USDMAYA_PUBLIC
+  static SerialisationFormat serialisationFormat();
+
   //--------------------------------------------------------------------------------------------------------------------
   /// Type Info & Registration
   //--------------------------------------------------------------------------------------------------------------------
@@ -346,7 +378,8 @@ public:
   // be written from m_layerList; and immediate after open (due to the post-open callback), m_layerList
   // will be initialized from the attributes.  At all other times, the attributes will be OUT OF SYNC
   // (and, in fact, are intentionally set to be "empty", so there's no confusion / someone doesn't
-  // try to use "out of date" information)
+  // try to use "out of date" information). The exception is the kUsdc format, where the attributes are
+  // kept after a save so that the next save can reuse the data of the layers that did not change.
   AL_DECL_ATTRIBUTE(layers);
   // Not using AL_DECL_ATTRIBUTE for these, because we never want a generic, ie, identifierPlug() -
   // they only make sense for a particular index of the parent array-attribute... and it taking up
@@ -358,8 +391,21 @@ public:
 private:
   static MObject _findNode();
 
+  /// \brief  Serialises a layer with the given format. Called from worker threads.
+  static std::string serialiseLayer(const SdfLayerRefPtr& layer, SerialisationFormat format);
+
+  /// \brief  Forgets that the layers which changed are up to date in the layers attribute.
+  void onLayersDidChange(const SdfNotice::LayersDidChange& notice);
+
   LayerDatabase m_layerDatabase;
 
+  // Layers whose usdc serialisation in the layers attribute is still up to date. Only the membership is kept here,
+  // the serialised data itself lives in the attribute.
+  std::set<SdfLayerHandle> m_unchangedLayers;
+  std::mutex m_unchangedLayersMutex;
+  TfNotice::Key m_layersDidChangeKey;
+  size_t m_lastSerialisedLayerCount = 0;
+
   // Note on layerManager / multithreading:
   // I don't know that layerManager will be used in a multihreaded manenr... but I also don't know it COULDN'T be.
   // (I haven't really looked into the way maya's new multi-threaded node evaluation works, for instance.) This is
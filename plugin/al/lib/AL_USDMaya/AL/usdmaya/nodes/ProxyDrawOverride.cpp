@@ -33,6 +33,7 @@
 #if defined(WANT_UFE_BUILD)
 #include "AL/usdmaya/TypeIDs.h"
 #include <pxr/base/arch/env.h>
+#include <pxr/usd/usdGeom/tokens.h>
 #include "ufe/sceneItem.h"
 #include "ufe/runTimeMgr.h"
 #include "ufe/globalSelection.h"
@@ -569,8 +570,12 @@ bool ProxyDrawOverride::userSelect(
 
 
   auto* proxyShape = static_cast<ProxyShape*>(getShape(objPath));
-  auto engine = proxyShape->engine();
-  if (!engine) return false;
+
+  // Picks are either resolved on the CPU against the spatial index of the proxy shape, or by rendering the stage into
+  // an ID buffer with the imaging engine.
+  const bool selectUsingBvh = MGlobal::optionVarIntValue("AL_usdmaya_selectUsingBvh");
+  auto engine = selectUsingBvh ? nullptr : proxyShape->engine();
+  if (!selectUsingBvh && !engine) return false;
 
   // The commands we execute inside this function shouldn't do special
   // processing of the proxy we are currently handling here if they
@@ -584,24 +589,48 @@ bool ProxyDrawOverride::userSelect(
   UsdPrim root = proxyShape->getUsdStage()->GetPseudoRoot();
 
   Engine::HitBatch hitBatch;
-  SdfPathVector rootPath;
-  rootPath.push_back(root.GetPath());
-
-  int resolution = 10;
-  MGlobal::getOptionVarValue("AL_usdmaya_selectResolution", resolution);
-  if (resolution < 10) { resolution = 10; }
-  if (resolution > 1024) { resolution = 1024; }
-
-
-  bool hitSelected = engine->TestIntersectionBatch(
-          GfMatrix4d(worldViewMatrix.matrix),
-          GfMatrix4d(projectionMatrix.matrix),
-          worldToLocalSpace,
-          rootPath,
-          params,
-          resolution,
-          ProxyDrawOverrideSelectionHelper::path_ting,
-          &hitBatch);
+  bool hitSelected = false;
+  if (selectUsingBvh)
+  {
+    // the world view matrix already includes the transform of the proxy shape, so it maps the space of the stage
+    // straight into view space
+    const GfMatrix4d localToWorld(objPath.inclusiveMatrix().matrix);
+    const GfMatrix4d viewProjection = GfMatrix4d(worldViewMatrix.matrix) * GfMatrix4d(projectionMatrix.matrix);
+
+    TfTokenVector purposes = { UsdGeomTokens->default_ };
+    if (params.showProxy) purposes.push_back(UsdGeomTokens->proxy);
+    if (params.showRender) purposes.push_back(UsdGeomTokens->render);
+    if (params.showGuides) purposes.push_back(UsdGeomTokens->guide);
+
+    std::vector<proxy::PrimBvh::Hit> hits;
+    hitSelected = proxyShape->pickPrims(viewProjection, params.frame, purposes, selectInfo.singleSelection(), hits);
+    for (const auto& hit : hits)
+    {
+      Engine::HitInfo& info = hitBatch[hit.path];
+      info.worldSpaceHitPoint = localToWorld.Transform(hit.point);
+      info.hitInstanceIndex = hit.instanceIndex;
+    }
+  }
+  else
+  {
+    SdfPathVector rootPath;
+    rootPath.push_back(root.GetPath());
+
+    int resolution = 10;
+    MGlobal::getOptionVarValue("AL_usdmaya_selectResolution", resolution);
+    if (resolution < 10) { resolution = 10; }
+    if (resolution > 1024) { resolution = 1024; }
+
+    hitSelected = engine->TestIntersectionBatch(
+            GfMatrix4d(worldViewMatrix.matrix),
+            GfMatrix4d(projectionMatrix.matrix),
+            worldToLocalSpace,
+            rootPath,
+            params,
+            resolution,
+            ProxyDrawOverrideSelectionHelper::path_ting,
+            &hitBatch);
+  }
 
   auto selected = false;
 
@@ -269,8 +269,8 @@ void ProxyShape::translatePrimsIntoMaya(
 
   if(context()->isExcludedGeometryDirty())
   {
-    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape:translatePrimsIntoMaya excluded geometry has been modified, reconstructing imaging engine \n");
-    constructExcludedPrims(); //if excluded prims changed, this will call constructGLImagingEngine
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape:translatePrimsIntoMaya excluded geometry has been modified, updating imaging engine \n");
+    updateTranslatedGeometryExclusions();
   }
 }
 //----------------------------------------------------------------------------------------------------------------------
@@ -332,19 +332,16 @@ void ProxyShape::constructGLImagingEngine()
       // delete previous instance
       destroyGLImagingEngine();
 
-      const auto& translatedGeo = m_context->excludedGeometry();
-
       // combine the excluded paths
       SdfPathVector excludedGeometryPaths;
-      excludedGeometryPaths.reserve(m_excludedTaggedGeometry.size() + m_excludedGeometry.size() + translatedGeo.size());
+      excludedGeometryPaths.reserve(m_excludedTaggedGeometry.size() + m_excludedGeometry.size());
       excludedGeometryPaths.assign(m_excludedTaggedGeometry.begin(), m_excludedTaggedGeometry.end());
       excludedGeometryPaths.insert(excludedGeometryPaths.end(), m_excludedGeometry.begin(), m_excludedGeometry.end());
-      for(auto& it : translatedGeo)
-      {
-        excludedGeometryPaths.push_back(it.second);
-      }
 
-      m_engine = new Engine(m_path, excludedGeometryPaths);
+      // The geometry translated into Maya changes whenever a prim is imported or torn down, so it is hidden rather than
+      // excluded. That way it can be updated without repopulating the whole render index.
+      m_engine = new Engine(m_path, excludedGeometryPaths, getTranslatedGeometryPaths());
+      m_context->clearExcludedGeometryDirty();
       // set renderer plugin based on RendererManager setting
       RendererManager* manager = RendererManager::findManager();
       if(manager && m_engine)
@@ -357,6 +354,31 @@ void ProxyShape::constructGLImagingEngine()
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+SdfPathVector ProxyShape::getTranslatedGeometryPaths() const
+{
+  const auto& translatedGeo = m_context->excludedGeometry();
+  SdfPathVector paths;
+  paths.reserve(translatedGeo.size());
+  for(auto& it : translatedGeo)
+  {
+    paths.push_back(it.second);
+  }
+  return paths;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::updateTranslatedGeometryExclusions()
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::updateTranslatedGeometryExclusions\n");
+  if(m_engine && !m_engine->SetInvisedPrimPaths(getTranslatedGeometryPaths()))
+  {
+    // the legacy engine can only exclude prims when it is constructed
+    constructGLImagingEngine();
+  }
+  m_context->clearExcludedGeometryDirty();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus ProxyShape::setDependentsDirty(const MPlug& plugBeingDirtied, MPlugArray& plugs)
 {
@@ -849,6 +871,8 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
 
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::onObjectsChanged called m_compositionHasChanged=%i\n", m_compositionHasChanged);
 
+  _InvalidatePayloadStreaming(SdfPathVector(notice.GetResyncedPaths()));
+
   if (!AL::usd::transaction::TransactionManager::InProgress(sender))
   {
     TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::onObjectsChanged - no transaction in progress - processing all changes\n");
@@ -937,8 +961,6 @@ void ProxyShape::processChangedObjects(const SdfPathVector& resyncedPaths, const
 {
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - processing changes\n");
 
-  bool shouldCleanBBoxCache = false;
-
   if (!m_stage)
   {
     TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - Invalid stage\n");
@@ -964,48 +986,29 @@ void ProxyShape::processChangedObjects(const SdfPathVector& resyncedPaths, const
         continue;
       tmm->setPrim(newPrim, tm); // Might be (invalid/nullptr) but that's OK at least it won't crash
     }
-    else
-    {
-      UsdPrim newPrim = m_stage->GetPrimAtPath(path);
-      if (!newPrim.IsValid())
-      {
-        TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::processChangedObjects - resyncedPaths (2) contains invalid path %s\n", path.GetText());
-        continue;
-      }
-      if(newPrim && newPrim.IsA<UsdGeomXformable>())
-      {
-        shouldCleanBBoxCache = true;
-      }
-    }
   }
 
-  // check to see if any transform ops have been modified (update the bounds accordingly)
-  if(!shouldCleanBBoxCache)
+  // A property change can add or remove time samples on an xform op, so the cached op queries of the transform are
+  // resolved again on its next time change.
+  for(const SdfPath& path : changedOnlyPaths)
   {
-    for(const SdfPath& path : changedOnlyPaths)
-    {
-      UsdPrim changedPrim = m_stage->GetPrimAtPath(path);
-      if(path.IsPrimPropertyPath())
-      {
-        const std::string tokenString = path.GetElementString();
-        if(std::strncmp(tokenString.c_str(), ".xformOp", 8) == 0)
-        {
-          shouldCleanBBoxCache = true;
-          break;
-        }
-      }
-    }
+    auto it = m_requiredPaths.find(path.GetPrimPath());
+    if(it == m_requiredPaths.end())
+      continue;
+    Scope* tm = it->second.getTransformNode();
+    if(!tm)
+      continue;
+    TransformationMatrix* tmm = dynamic_cast<TransformationMatrix*>(tm->transform());
+    if(tmm)
+      tmm->invalidateXformOpQueries();
   }
 
-  // do we need to clear the bounding box cache?
-  if(shouldCleanBBoxCache)
-  {
-    clearBoundingBoxCache();
+  // The cached bounds follow the changes of the stage by themselves, see MayaUsdProxyShapeBoundsCache.
+  m_primBvh.markDirty(resyncedPaths, changedOnlyPaths);
 
-    // Ideally we want to have a way to force maya to call ProxyShape::boundingBox() again to update the bbox attributes.
-    // This may lead to a delay in the bbox updates (e.g. usually you need to reselect the proxy before the bounds will
-    // be updated).
-  }
+  // Ideally we want to have a way to force maya to call ProxyShape::boundingBox() again to update the bbox attributes.
+  // This may lead to a delay in the bbox updates (e.g. usually you need to reselect the proxy before the bounds will
+  // be updated).
 
   if(isLockPrimFeatureActive())
   {
@@ -1140,6 +1143,7 @@ void ProxyShape::loadStage()
 
   AL_BEGIN_PROFILE_SECTION(LoadStage);
   MDataBlock dataBlock = forceCache();
+  m_primBvh.invalidate();
 
   const int stageIdVal = inputInt32Value(dataBlock, m_stageCacheId);
   UsdStageCache::Id stageId = UsdStageCache::Id().FromLongInt(stageIdVal);
@@ -1332,7 +1336,8 @@ void ProxyShape::loadStage()
         {
           UsdStageCacheContext ctx(StageCache::Get());
 
-          bool unloadedFlag = inputBoolValue(dataBlock, m_unloaded);
+          // streamed payloads are loaded once the stage is open, in order of priority
+          bool unloadedFlag = inputBoolValue(dataBlock, m_unloaded) || _IsPayloadStreaming(dataBlock);
           UsdStage::InitialLoadSet loadOperation = unloadedFlag ? UsdStage::LoadNone : UsdStage::LoadAll;
 
           if (sessionLayer)
@@ -1403,6 +1408,9 @@ void ProxyShape::loadStage()
     m_path = rootPath;
   }
 
+  // streamed payloads are loaded by the payload streaming timer, in order of priority
+  _EnablePayloadStreamingTimer(m_stage && _IsPayloadStreaming(dataBlock));
+
   if(m_stage && !MFileIO::isReadingFile())
   {
     AL_BEGIN_PROFILE_SECTION(PostLoadProcess);
@@ -1658,6 +1666,32 @@ bool ProxyShape::setInternalValue(const MPlug& plug, const MDataHandle& dataHand
     return true;
   }
   else
+  if(plug == payloadStreamingAttr)
+  {
+    // can't use dataHandle.datablock(), as this is a temporary datahandle
+    MDataBlock datablock = forceCache();
+    const bool wasStreaming = _IsPayloadStreaming(datablock);
+    AL_MAYA_CHECK_ERROR_RETURN_VAL(outputBoolValue(datablock, payloadStreamingAttr, dataHandle.asBool()),
+        false, "ProxyShape::setInternalValue - error setting payloadStreaming");
+
+    const bool streaming = _IsPayloadStreaming(datablock);
+    if(m_stage && streaming != wasStreaming && !MFileIO::isReadingFile())
+    {
+      // Reload the payloads as loadStage() would: a streamed stage starts with none loaded, otherwise they follow
+      // the unloaded attribute.
+      if(streaming || inputBoolValue(datablock, m_unloaded))
+      {
+        m_stage->Unload(SdfPath::AbsoluteRootPath());
+      }
+      else
+      {
+        m_stage->Load(SdfPath::AbsoluteRootPath());
+      }
+      _EnablePayloadStreamingTimer(streaming);
+    }
+    return true;
+  }
+  else
   if(plug == excludePrimPaths() || plug == m_excludedTranslatedGeometry)
   {
     // can't use dataHandle.datablock(), as this is a temporary datahandle
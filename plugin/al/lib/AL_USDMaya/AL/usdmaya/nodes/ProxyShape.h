@@ -26,6 +26,7 @@
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/nodes/proxy/LockManager.h"
+#include "AL/usdmaya/nodes/proxy/PrimBvh.h"
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
 #include "AL/usdmaya/SelectabilityDB.h"
 
@@ -644,6 +645,27 @@ public:
   AL_USDMAYA_PUBLIC
   bool doSelect(SelectionUndoHelper& helper, const SdfPathVector& orderedPaths);
 
+  /// \brief  Resolves a pick against a CPU side spatial index of the gprims in the stage, rather than rendering the
+  ///         stage into an ID buffer. The index is built lazily, and kept up to date as the stage changes, so this
+  ///         also works in sessions without a display.
+  /// \param  viewProjection the matrix that transforms the space of the stage into the clip space of the pick
+  ///         region (i.e. the world view matrix of the proxy shape, which includes its local to world transform,
+  ///         followed by the projection and pick matrices)
+  /// \param  time the time at which to pick the prims
+  /// \param  purposes the purposes of the prims that may be picked
+  /// \param  singleSelection if true, only the closest prim hit by the ray through the centre of the pick region is
+  ///         returned. Otherwise every prim within the pick region is returned (with a hit point at the centre of its
+  ///         bounds).
+  /// \param  hits the returned hits (in the space of the stage)
+  /// \return true if any prims were hit
+  AL_USDMAYA_PUBLIC
+  bool pickPrims(
+    const GfMatrix4d& viewProjection,
+    UsdTimeCode time,
+    const TfTokenVector& purposes,
+    bool singleSelection,
+    std::vector<proxy::PrimBvh::Hit>& hits);
+
   //--------------------------------------------------------------------------------------------------------------------
   /// \name   UsdImaging
   //--------------------------------------------------------------------------------------------------------------------
@@ -844,6 +866,14 @@ private:
 
   void constructExcludedPrims();
 
+  /// \brief  returns the paths of the geometry that has been translated into Maya (and so should not be drawn by the
+  ///         imaging engine)
+  SdfPathVector getTranslatedGeometryPaths() const;
+
+  /// \brief  pushes the geometry translated into Maya to the imaging engine. Only the prims that have been added to, or
+  ///         removed from, the set since the last update are invalidated in the render index.
+  void updateTranslatedGeometryExclusions();
+
   MObject makeUsdTransformChain_internal(
       const UsdPrim& usdPrim,
       MDagModifier& modifier,
@@ -1087,6 +1117,7 @@ private:
   SdfPathVector m_excludedGeometry;
   SdfPathVector m_excludedTaggedGeometry;
   proxy::LockManager m_lockManager;
+  proxy::PrimBvh m_primBvh;
   static MObject m_transformTranslate;
   static MObject m_transformRotate;
   static MObject m_transformScale;
@@ -17,6 +17,7 @@
 
 #include "AL/maya/utils/Utils.h"
 
+#include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/Metadata.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/Transform.h"
@@ -1425,6 +1426,60 @@ bool ProxyShape::doSelect(SelectionUndoHelper& helper, const SdfPathVector& orde
   return true;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShape::pickPrims(
+  const GfMatrix4d& viewProjection,
+  UsdTimeCode time,
+  const TfTokenVector& purposes,
+  bool singleSelection,
+  std::vector<proxy::PrimBvh::Hit>& hits)
+{
+  TF_DEBUG(ALUSDMAYA_SELECTION).Msg("ProxyShape::pickPrims\n");
+  if(!m_stage)
+    return false;
+
+  m_primBvh.update(m_stage, time, purposes);
+
+  // the same prims that are excluded from the imaging engine can not be picked
+  SdfPathVector excludedPaths(m_excludedTaggedGeometry.begin(), m_excludedTaggedGeometry.end());
+  excludedPaths.insert(excludedPaths.end(), m_excludedGeometry.begin(), m_excludedGeometry.end());
+  for(auto& it : m_context->excludedGeometry())
+  {
+    excludedPaths.push_back(it.second);
+  }
+  // the filter is applied while the index is traversed, so that a prim that can not be picked never hides the ones
+  // behind it
+  auto isPickable = [this, &excludedPaths](const SdfPath& path)
+  {
+    if(!m_path.IsEmpty() && !path.HasPrefix(m_path))
+      return false;
+    for(const SdfPath& excluded : excludedPaths)
+    {
+      if(path.HasPrefix(excluded))
+        return false;
+    }
+    return true;
+  };
+
+  const GfMatrix4d clipToStage = viewProjection.GetInverse();
+  if(singleSelection)
+  {
+    // cast a ray from the near to the far plane through the centre of the pick region
+    const GfVec3d nearPoint = clipToStage.Transform(GfVec3d(0.0, 0.0, -1.0));
+    const GfVec3d farPoint = clipToStage.Transform(GfVec3d(0.0, 0.0, 1.0));
+    proxy::PrimBvh::Hit hit;
+    if(m_primBvh.intersectRay(GfRay(nearPoint, farPoint - nearPoint), hit, isPickable))
+    {
+      hits.push_back(hit);
+    }
+  }
+  else
+  {
+    m_primBvh.intersectFrustum(viewProjection, hits, isPickable);
+  }
+  return !hits.empty();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 } // nodes
 } // usdmaya
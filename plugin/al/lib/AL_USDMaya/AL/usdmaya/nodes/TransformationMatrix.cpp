@@ -48,6 +48,113 @@ bool hasEmptyDefaultValue(const UsdGeomXformOp& op, UsdTimeCode time)
   }
   return false;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+bool readVectorQuery(MVector& result, const UsdAttributeQuery& query, UsdTimeCode timeCode)
+{
+  VtValue value;
+  if(!query.Get(&value, timeCode))
+  {
+    return false;
+  }
+  if(value.IsHolding<GfVec3d>())
+  {
+    const GfVec3d& v = value.UncheckedGet<GfVec3d>();
+    result = MVector(v[0], v[1], v[2]);
+  }
+  else
+  if(value.IsHolding<GfVec3f>())
+  {
+    const GfVec3f& v = value.UncheckedGet<GfVec3f>();
+    result = MVector(v[0], v[1], v[2]);
+  }
+  else
+  if(value.IsHolding<GfVec3h>())
+  {
+    const GfVec3h& v = value.UncheckedGet<GfVec3h>();
+    result = MVector(float(v[0]), float(v[1]), float(v[2]));
+  }
+  else
+  if(value.IsHolding<GfVec3i>())
+  {
+    const GfVec3i& v = value.UncheckedGet<GfVec3i>();
+    result = MVector(v[0], v[1], v[2]);
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double readDoubleQuery(const UsdAttributeQuery& query, UsdTimeCode timeCode)
+{
+  VtValue value;
+  if(query.Get(&value, timeCode))
+  {
+    if(value.IsHolding<double>())
+      return value.UncheckedGet<double>();
+    if(value.IsHolding<float>())
+      return value.UncheckedGet<float>();
+    if(value.IsHolding<GfHalf>())
+      return float(value.UncheckedGet<GfHalf>());
+    if(value.IsHolding<int32_t>())
+      return value.UncheckedGet<int32_t>();
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool readMatrixQuery(GfMatrix4d& result, const UsdAttributeQuery& query, UsdTimeCode timeCode)
+{
+  VtValue value;
+  if(!query.Get(&value, timeCode) || !value.IsHolding<GfMatrix4d>())
+  {
+    return false;
+  }
+  result = value.UncheckedGet<GfMatrix4d>();
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool readRotationQuery(MEulerRotation& result, const UsdAttributeQuery& query, UsdGeomXformOp::Type opType, UsdTimeCode timeCode)
+{
+  const double degToRad = M_PI / 180.0;
+  MEulerRotation::RotationOrder order = MEulerRotation::kXYZ;
+  switch(opType)
+  {
+  case UsdGeomXformOp::TypeRotateX:
+    result.setValue(readDoubleQuery(query, timeCode) * degToRad, 0.0, 0.0, MEulerRotation::kXYZ);
+    return true;
+
+  case UsdGeomXformOp::TypeRotateY:
+    result.setValue(0.0, readDoubleQuery(query, timeCode) * degToRad, 0.0, MEulerRotation::kXYZ);
+    return true;
+
+  case UsdGeomXformOp::TypeRotateZ:
+    result.setValue(0.0, 0.0, readDoubleQuery(query, timeCode) * degToRad, MEulerRotation::kXYZ);
+    return true;
+
+  case UsdGeomXformOp::TypeRotateXYZ: order = MEulerRotation::kXYZ; break;
+  case UsdGeomXformOp::TypeRotateXZY: order = MEulerRotation::kXZY; break;
+  case UsdGeomXformOp::TypeRotateYXZ: order = MEulerRotation::kYXZ; break;
+  case UsdGeomXformOp::TypeRotateYZX: order = MEulerRotation::kYZX; break;
+  case UsdGeomXformOp::TypeRotateZXY: order = MEulerRotation::kZXY; break;
+  case UsdGeomXformOp::TypeRotateZYX: order = MEulerRotation::kZYX; break;
+
+  default:
+    return false;
+  }
+
+  MVector v;
+  if(!readVectorQuery(v, query, timeCode))
+  {
+    return false;
+  }
+  result.setValue(v.x * degToRad, v.y * degToRad, v.z * degToRad, order);
+  return true;
+}
 } // anon
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -933,6 +1040,7 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Scope* transformN
   bool resetsXformStack = false;
   m_xformops = m_xform.GetOrderedXformOps(&resetsXformStack);
   m_orderedOps.resize(m_xformops.size());
+  resolveXformOpQueries();
 
   if(!resetsXformStack)
   {
@@ -1211,6 +1319,21 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Scope* transformN
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void TransformationMatrix::resolveXformOpQueries()
+{
+  TF_DEBUG(ALUSDMAYA_TRANSFORM_MATRIX).Msg("TransformationMatrix::resolveXformOpQueries\n");
+  m_xformOpQueries.clear();
+  m_xformOpQueries.reserve(m_xformops.size());
+  for(const UsdGeomXformOp& op : m_xformops)
+  {
+    UsdAttributeQuery query(op.GetAttr());
+    const bool animated = query.GetNumTimeSamples() >= 1;
+    m_xformOpQueries.push_back(XformOpQuery{std::move(query), op.GetOpType(), animated});
+  }
+  m_xformOpQueriesValid = true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void TransformationMatrix::updateToTime(const UsdTimeCode& time)
 {
@@ -1223,87 +1346,90 @@ void TransformationMatrix::updateToTime(const UsdTimeCode& time)
   if(m_time != time)
   {
     m_time = time;
+
+    // the insert*Op methods add ops without invalidating the queries, hence the size check.
+    if(!m_xformOpQueriesValid || m_xformOpQueries.size() != m_xformops.size())
     {
-      auto opIt = m_orderedOps.begin();
-      for(std::vector<UsdGeomXformOp>::const_iterator it = m_xformops.begin(), e = m_xformops.end(); it != e; ++it, ++opIt)
+      resolveXformOpQueries();
+    }
+
+    const UsdTimeCode timeCode = getTimeCode();
+    auto opIt = m_orderedOps.begin();
+    for(auto it = m_xformOpQueries.begin(), e = m_xformOpQueries.end(); it != e; ++it, ++opIt)
+    {
+      // the values of static ops were read by initialiseToPrim, and don't change with time
+      if(!it->animated)
       {
-        const UsdGeomXformOp& op = *it;
-        switch(*opIt)
-        {
-        case kTranslate:
-          {
-            if(op.GetNumTimeSamples() >= 1)
-            {
-              m_flags |= kAnimatedTranslation;
-              internal_readVector(m_translationFromUsd, op);
-              MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
-            }
-          }
-          break;
+        continue;
+      }
 
-        case kRotate:
-          {
-            if(op.GetNumTimeSamples() >= 1)
-            {
-              m_flags |= kAnimatedRotation;
-              internal_readRotation(m_rotationFromUsd, op);
-              MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
-              MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
-              MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
-              MPxTransformationMatrix::rotationValue.z += m_rotationTweak.z;
-            }
-          }
-          break;
+      const UsdAttributeQuery& query = it->query;
+      switch(*opIt)
+      {
+      case kTranslate:
+        {
+          m_flags |= kAnimatedTranslation;
+          readVectorQuery(m_translationFromUsd, query, timeCode);
+          MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
+        }
+        break;
 
-        case kScale:
-          {
-            if(op.GetNumTimeSamples() >= 1)
-            {
-              m_flags |= kAnimatedScale;
-              internal_readVector(m_scaleFromUsd, op);
-              MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
-            }
-          }
-          break;
+      case kRotate:
+        {
+          m_flags |= kAnimatedRotation;
+          readRotationQuery(m_rotationFromUsd, query, it->opType, timeCode);
+          MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
+          MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
+          MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
+          MPxTransformationMatrix::rotationValue.z += m_rotationTweak.z;
+        }
+        break;
 
-        case kShear:
-          {
-            if(op.GetNumTimeSamples() >= 1)
-            {
-              m_flags |= kAnimatedShear;
-              internal_readShear(m_shearFromUsd, op);
-              MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
-            }
-          }
-          break;
+      case kScale:
+        {
+          m_flags |= kAnimatedScale;
+          readVectorQuery(m_scaleFromUsd, query, timeCode);
+          MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
+        }
+        break;
 
-        case kTransform:
+      case kShear:
+        {
+          m_flags |= kAnimatedShear;
+          GfMatrix4d matrix;
+          if(readMatrixQuery(matrix, query, timeCode))
           {
-            if(op.GetNumTimeSamples() >= 1)
-            {
-              m_flags |= kAnimatedMatrix;
-              GfMatrix4d matrix;
-              op.Get<GfMatrix4d>(&matrix, getTimeCode());
-              double T[3], S[3];
-              AL::usdmaya::utils::matrixToSRT(matrix, S, m_rotationFromUsd, T);
-              m_scaleFromUsd.x = S[0];
-              m_scaleFromUsd.y = S[1];
-              m_scaleFromUsd.z = S[2];
-              m_translationFromUsd.x = T[0];
-              m_translationFromUsd.y = T[1];
-              m_translationFromUsd.z = T[2];
-              MPxTransformationMatrix::rotationValue.x = m_rotationFromUsd.x + m_rotationTweak.x;
-              MPxTransformationMatrix::rotationValue.y = m_rotationFromUsd.y + m_rotationTweak.y;
-              MPxTransformationMatrix::rotationValue.z = m_rotationFromUsd.z + m_rotationTweak.z;
-              MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
-              MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
-            }
+            m_shearFromUsd.x = matrix[1][0];
+            m_shearFromUsd.y = matrix[2][0];
+            m_shearFromUsd.z = matrix[2][1];
           }
-          break;
+          MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
+        }
+        break;
 
-        default:
-          break;
+      case kTransform:
+        {
+          m_flags |= kAnimatedMatrix;
+          GfMatrix4d matrix;
+          readMatrixQuery(matrix, query, timeCode);
+          double T[3], S[3];
+          AL::usdmaya::utils::matrixToSRT(matrix, S, m_rotationFromUsd, T);
+          m_scaleFromUsd.x = S[0];
+          m_scaleFromUsd.y = S[1];
+          m_scaleFromUsd.z = S[2];
+          m_translationFromUsd.x = T[0];
+          m_translationFromUsd.y = T[1];
+          m_translationFromUsd.z = T[2];
+          MPxTransformationMatrix::rotationValue.x = m_rotationFromUsd.x + m_rotationTweak.x;
+          MPxTransformationMatrix::rotationValue.y = m_rotationFromUsd.y + m_rotationTweak.y;
+          MPxTransformationMatrix::rotationValue.z = m_rotationFromUsd.z + m_rotationTweak.z;
+          MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
+          MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
         }
+        break;
+
+      default:
+        break;
       }
     }
   }
@@ -22,6 +22,7 @@
 #include <maya/MPxTransformationMatrix.h>
 #include <maya/MPxTransform.h>
 
+#include <pxr/usd/usd/attributeQuery.h>
 #include <pxr/usd/usdGeom/xformable.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
@@ -51,6 +52,17 @@ class TransformationMatrix
   std::vector<UsdGeomXformOp> m_xformops;
   std::vector<TransformOperation> m_orderedOps;
 
+  // attribute queries of the xform ops (in the same order as m_xformops), resolved once so that updateToTime does not
+  // have to ask USD whether each op is animated on every time change.
+  struct XformOpQuery
+  {
+    UsdAttributeQuery query;
+    UsdGeomXformOp::Type opType;
+    bool animated;
+  };
+  std::vector<XformOpQuery> m_xformOpQueries;
+  bool m_xformOpQueriesValid = false;
+
   // tweak values. These are applied on top of the USD transform values to produce the final result.
   MVector m_scaleTweak;
   MEulerRotation m_rotationTweak;
@@ -110,6 +122,9 @@ class TransformationMatrix
   void insertRotatePivotTranslationOp();
   void insertRotateAxesOp();
 
+  // resolves the attribute queries and animated flags of m_xformops
+  void resolveXformOpQueries();
+
   enum Flags
   {
     // describe which components are animated
@@ -308,6 +323,11 @@ class TransformationMatrix
   /// \param  time the new timecode
   void updateToTime(const UsdTimeCode& time);
 
+  /// \brief  flags the cached xform op queries as out of date, so that they are resolved again on the next time
+  ///         change. Called by the proxy shape when it receives an ObjectsChanged notice for the prim.
+  inline void invalidateXformOpQueries()
+    { m_xformOpQueriesValid = false; }
+
   /// \brief  pushes any modifications on the matrix back onto the UsdPrim
   void pushToPrim();
 
@@ -15,6 +15,8 @@
 //
 #include "AL/usdmaya/nodes/proxy/LockManager.h"
 
+#include <algorithm>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -36,6 +38,8 @@ void LockManager::removeEntries(const SdfPathVector& entries)
     if(lockIt != lockEnd && *lockIt == path)
     {
       lockIt = m_lockedPrims.erase(lockIt);
+      lockEnd = m_lockedPrims.end();
+      invalidateSubtree(path);
     }
   }
 
@@ -46,6 +50,8 @@ void LockManager::removeEntries(const SdfPathVector& entries)
     if(unlockIt != unlockEnd && *unlockIt == path)
     {
       unlockIt = m_unlockedPrims.erase(unlockIt);
+      unlockEnd = m_unlockedPrims.end();
+      invalidateSubtree(path);
     }
   }
 }
@@ -53,6 +59,8 @@ void LockManager::removeEntries(const SdfPathVector& entries)
 //----------------------------------------------------------------------------------------------------------------------
 void LockManager::removeFromRootPath(const SdfPath& path)
 {
+  invalidateSubtree(path);
+
   {
     // find the start of the entries for this path
     auto lb = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
@@ -116,6 +124,7 @@ void LockManager::setLocked(const SdfPath& path)
       return;
   }
   m_lockedPrims.insert(lockIter, path);
+  invalidateSubtree(path);
 
   auto unlockIter = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
   if(unlockIter != m_unlockedPrims.end())
@@ -138,6 +147,7 @@ void LockManager::setUnlocked(const SdfPath& path)
       return;
   }
   m_unlockedPrims.insert(unlockIter, path);
+  invalidateSubtree(path);
 
   auto lockIter = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
   if(lockIter != m_lockedPrims.end())
@@ -161,6 +171,7 @@ void LockManager::setInherited(const SdfPath& path)
       if(*unlockIter == path)
       {
         m_unlockedPrims.erase(unlockIter);
+        invalidateSubtree(path);
       }
     }
   }
@@ -173,73 +184,70 @@ void LockManager::setInherited(const SdfPath& path)
       if(*lockIter == path)
       {
         m_lockedPrims.erase(lockIter);
+        invalidateSubtree(path);
       }
     }
   }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool LockManager::isLocked(const SdfPath& path) const
+void LockManager::sort()
 {
-  if(m_lockedPrims.empty()) 
-    return false;
-
-  auto lockIter = std::lower_bound(m_lockedPrims.begin(), m_lockedPrims.end(), path);
-
-  // first check the edge case where this path is in the locked set
-  if(lockIter != m_lockedPrims.end() && *lockIter == path)
-  {
-    return true;
-  }
-
-  // now attempt to see if a parent of this path is in the locked set
-  bool hasLockedParent = false;
-  if(lockIter != m_lockedPrims.begin())
+  // paths are appended by addLocked and addUnlocked, so only the tail of each array needs sorting.
+  auto sortTail = [](SdfPathVector& paths)
   {
-    --lockIter;
+    auto tail = std::is_sorted_until(paths.begin(), paths.end());
+    if(tail != paths.end())
     {
-      if(path.HasPrefix(*lockIter))
-      {
-        hasLockedParent = true;
-      }
+      std::sort(tail, paths.end());
+      std::inplace_merge(paths.begin(), tail, paths.end());
+      paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
     }
-  }
+  };
+  sortTail(m_lockedPrims);
+  sortTail(m_unlockedPrims);
+}
 
-  // now attempt to see if a parent of this path is in the unlocked set
-  bool hasUnlockedParent = false;
-  auto unlockIter = std::lower_bound(m_unlockedPrims.begin(), m_unlockedPrims.end(), path);
+//----------------------------------------------------------------------------------------------------------------------
+bool LockManager::isLocked(const SdfPath& path) const
+{
+  if(m_lockedPrims.empty() || !path.IsAbsolutePath())
+    return false;
 
-  // first check the edge case where this path is in the locked set
-  if(unlockIter != m_unlockedPrims.end() && *unlockIter == path)
-  {
+  return resolveLocked(path);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LockManager::resolveLocked(const SdfPath& path) const
+{
+  // no entry exists at all (treat as unlocked).
+  if(path == SdfPath::AbsoluteRootPath())
     return false;
-  }
 
-  if(unlockIter != m_unlockedPrims.begin())
+  auto found = m_resolved.find(path);
+  if(found != m_resolved.end() && found->second != kUnresolved)
   {
-    --unlockIter;
-    {
-      if(path.HasPrefix(*unlockIter))
-      {
-        hasUnlockedParent = true;
-      }
-    }
+    return found->second == kLocked;
   }
 
-  // if we have entries in both the locked and unlocked set..... 
-  if(hasLockedParent && hasUnlockedParent)
+  // the closest path in the hierarchy that is in either the locked or unlocked set determines the lock status.
+  bool locked;
+  if(std::binary_search(m_lockedPrims.begin(), m_lockedPrims.end(), path))
+  {
+    locked = true;
+  }
+  else
+  if(std::binary_search(m_unlockedPrims.begin(), m_unlockedPrims.end(), path))
   {
-    // if the locked path is longer than the unlocked path, the closest parent to path is locked.
-    return (lockIter->GetString().size() >= unlockIter->GetString().size());
+    locked = false;
   }
   else
-  if(hasLockedParent)
   {
-    return true;
+    locked = resolveLocked(path.GetParentPath());
   }
 
-  // either the parent is unlocked, or no entry exists at all (treat as unlocked).
-  return false;
+  m_resolved[path] = locked ? kLocked : kUnlocked;
+  return locked;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
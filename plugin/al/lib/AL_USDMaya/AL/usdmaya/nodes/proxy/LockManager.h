@@ -18,6 +18,7 @@
 #include <AL/usdmaya/Api.h>
 
 #include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/pathTable.h>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -28,6 +29,11 @@ namespace proxy {
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class that maintains a list of locked and unlocked prims.
+///
+///         The lock status of a prim is inherited from its closest ancestor that is locked or unlocked. Resolved
+///         statuses are memoized per path (along with those of the ancestors visited to resolve them), so that
+///         isLocked() is a single table lookup once a prim or its parent has been queried. Changing the status of a
+///         path only forgets the statuses within its subtree.
 //----------------------------------------------------------------------------------------------------------------------
 struct LockManager
 {
@@ -58,21 +64,19 @@ struct LockManager
   ///         build up changes in the set of lock prims, and having done that, later sort them by calling sort()
   /// \param  path the path to insert into the locked set
   inline void addLocked(const SdfPath& path)
-    { m_lockedPrims.emplace_back(path); }
+    { m_lockedPrims.emplace_back(path); invalidateSubtree(path); }
 
   /// \brief  adds the specified path to the unlocked prims list. No checking is done by this method to see whether 
   ///         the path is part of the locked or unlocked sets. The intention for this method is to quickly 
   ///         build up changes in the set of lock prims, and having done that, later sort them by calling sort()
   /// \param  path the path to insert into the unlocked set
   inline void addUnlocked(const SdfPath& path)
-    { m_unlockedPrims.emplace_back(path); }
+    { m_unlockedPrims.emplace_back(path); invalidateSubtree(path); }
 
-  /// \brief  sorts the two sets of locked and unlocked prims for fast lookup
-  inline void sort()
-    {
-      std::sort(m_lockedPrims.begin(), m_lockedPrims.end());
-      std::sort(m_unlockedPrims.begin(), m_unlockedPrims.end());
-    }
+  /// \brief  sorts the two sets of locked and unlocked prims for fast lookup. Only the paths added since the last
+  ///         call are sorted, and then merged into the already sorted paths.
+  AL_USDMAYA_PUBLIC
+  void sort();
 
   /// \brief  Will remove the path from both the locked and unlocked sets. The lock status will now be inherited. 
   /// \param  path the path to set as inherited
@@ -86,8 +90,30 @@ struct LockManager
   bool isLocked(const SdfPath& path) const;
 
 private:
+  enum ResolvedState : char
+  {
+    kUnresolved = 0,
+    kUnlocked,
+    kLocked
+  };
+
+  bool resolveLocked(const SdfPath& path) const;
+  void invalidateSubtree(const SdfPath& path)
+    {
+      auto found = m_resolved.find(path);
+      if(found != m_resolved.end())
+      {
+        // erases the descendants of the path as well.
+        m_resolved.erase(found);
+      }
+    }
+
   SdfPathVector m_lockedPrims;
   SdfPathVector m_unlockedPrims;
+
+  // The memoized lock status of paths. The table also holds the (possibly unresolved) ancestors of each entry,
+  // which allows forgetting a subtree with a single erase.
+  mutable SdfPathTable<ResolvedState> m_resolved;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
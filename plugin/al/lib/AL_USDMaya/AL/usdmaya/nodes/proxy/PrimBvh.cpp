@@ -0,0 +1,878 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/PrimBvh.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include <pxr/base/gf/vec4d.h>
+#include <pxr/base/tf/hashset.h>
+#include <pxr/base/work/loops.h>
+#include <pxr/usd/usd/primRange.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
+#include <pxr/usd/usdGeom/gprim.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/pointInstancer.h>
+#include <pxr/usd/usdGeom/xformCache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+namespace {
+
+// the maximum number of gprims stored in a leaf of the hierarchy
+const uint32_t kMaxLeafSize = 4;
+
+//----------------------------------------------------------------------------------------------------------------------
+GfVec3d centroid(const GfRange3d& range)
+{
+  return range.IsEmpty() ? GfVec3d(0.0) : range.GetMidpoint();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// extracts the six planes of the clip space cube from a (row vector) view projection matrix. A point is inside the
+/// frustum when it is on the positive side of every plane.
+void extractFrustumPlanes(const GfMatrix4d& m, GfVec4d planes[6])
+{
+  const GfVec4d column[4] = {
+    GfVec4d(m[0][0], m[1][0], m[2][0], m[3][0]),
+    GfVec4d(m[0][1], m[1][1], m[2][1], m[3][1]),
+    GfVec4d(m[0][2], m[1][2], m[2][2], m[3][2]),
+    GfVec4d(m[0][3], m[1][3], m[2][3], m[3][3])
+  };
+  planes[0] = column[3] + column[0];
+  planes[1] = column[3] - column[0];
+  planes[2] = column[3] + column[1];
+  planes[3] = column[3] - column[1];
+  planes[4] = column[3] + column[2];
+  planes[5] = column[3] - column[2];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline double planeDistance(const GfVec4d& plane, const GfVec3d& p)
+{
+  return plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3];
+}
+
+enum class Containment
+{
+  kOutside,
+  kIntersects,
+  kInside
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+Containment classifyRange(const GfVec4d planes[6], const GfRange3d& range)
+{
+  if(range.IsEmpty())
+    return Containment::kOutside;
+
+  const GfVec3d& lo = range.GetMin();
+  const GfVec3d& hi = range.GetMax();
+  Containment result = Containment::kInside;
+  for(int i = 0; i < 6; ++i)
+  {
+    const GfVec4d& plane = planes[i];
+    const GfVec3d positive(plane[0] >= 0.0 ? hi[0] : lo[0], plane[1] >= 0.0 ? hi[1] : lo[1], plane[2] >= 0.0 ? hi[2] : lo[2]);
+    if(planeDistance(plane, positive) < 0.0)
+      return Containment::kOutside;
+    const GfVec3d negative(plane[0] >= 0.0 ? lo[0] : hi[0], plane[1] >= 0.0 ? lo[1] : hi[1], plane[2] >= 0.0 ? lo[2] : hi[2]);
+    if(planeDistance(plane, negative) < 0.0)
+      result = Containment::kIntersects;
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if part of the segment from a to b is within the frustum, by clipping it against each plane in turn
+bool segmentInFrustum(const GfVec4d planes[6], const GfVec3d& a, const GfVec3d& b)
+{
+  double t0 = 0.0, t1 = 1.0;
+  for(int i = 0; i < 6; ++i)
+  {
+    const double da = planeDistance(planes[i], a);
+    const double db = planeDistance(planes[i], b);
+    if(da < 0.0 && db < 0.0)
+      return false;
+    if(da < 0.0)
+      t0 = std::max(t0, da / (da - db));
+    else if(db < 0.0)
+      t1 = std::min(t1, da / (da - db));
+    if(t0 > t1)
+      return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the eight corners of the frustum in stage space, indexed by the sign bits of their x (1), y (2), and z (4) clip
+/// space coordinates
+void computeFrustumCorners(const GfMatrix4d& viewProjection, GfVec3d corners[8])
+{
+  const GfMatrix4d clipToStage = viewProjection.GetInverse();
+  for(int i = 0; i < 8; ++i)
+  {
+    corners[i] = clipToStage.Transform(GfVec3d(i & 1 ? 1.0 : -1.0, i & 2 ? 1.0 : -1.0, i & 4 ? 1.0 : -1.0));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if the triangle is at least partially within the frustum. Either an edge of the triangle crosses the
+/// frustum, or the triangle is large enough for the frustum to pass through its interior (e.g. a marquee within a
+/// ground plane), in which case one of the edges of the frustum crosses the triangle.
+bool triangleInFrustum(const GfVec4d planes[6], const GfVec3d corners[8], const GfVec3d* tri)
+{
+  if(segmentInFrustum(planes, tri[0], tri[1]) ||
+     segmentInFrustum(planes, tri[1], tri[2]) ||
+     segmentInFrustum(planes, tri[2], tri[0]))
+    return true;
+
+  for(int i = 0; i < 8; ++i)
+  {
+    for(int axis = 1; axis < 8; axis <<= 1)
+    {
+      if(i & axis)
+        continue;
+      const GfRay edge(corners[i], corners[i | axis] - corners[i]);
+      double distance;
+      if(edge.Intersect(tri[0], tri[1], tri[2], &distance, nullptr, nullptr, 1.0))
+        return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if the transform or the visibility of the prim, or of any of its ancestors, may change over time. The
+/// answers are memoized per path, since siblings share their ancestors.
+bool xformOrVisibilityMightBeTimeVarying(const UsdPrim& prim, TfHashMap<SdfPath, bool, SdfPath::Hash>& cache)
+{
+  if(!prim || prim.IsPseudoRoot())
+    return false;
+
+  auto it = cache.find(prim.GetPath());
+  if(it != cache.end())
+    return it->second;
+
+  bool varying = false;
+  UsdGeomImageable imageable(prim);
+  if(imageable)
+  {
+    UsdAttribute visibility = imageable.GetVisibilityAttr();
+    varying = visibility && visibility.ValueMightBeTimeVarying();
+  }
+  UsdGeomXformable xformable(prim);
+  if(!varying && xformable)
+  {
+    varying = xformable.TransformMightBeTimeVarying();
+  }
+  if(!varying)
+  {
+    varying = xformOrVisibilityMightBeTimeVarying(prim.GetParent(), cache);
+  }
+  cache[prim.GetPath()] = varying;
+  return varying;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if any attribute of the prim (e.g. its points, extent, or radius) may change over time
+bool attributesMightBeTimeVarying(const UsdPrim& prim)
+{
+  for(const UsdAttribute& attribute : prim.GetAttributes())
+  {
+    if(attribute.ValueMightBeTimeVarying())
+      return true;
+  }
+  return false;
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::build(const UsdStageRefPtr& stage, UsdTimeCode time, const TfTokenVector& purposes)
+{
+  TF_DEBUG(ALUSDMAYA_SELECTION).Msg("PrimBvh::build\n");
+
+  m_entries.clear();
+  m_nodes.clear();
+  m_instancers.clear();
+  m_dirtyPaths.clear();
+  m_stage = stage;
+  m_time = time;
+  m_purposes = purposes;
+  m_valid = true;
+  if(!stage)
+    return;
+
+  // gather the gprims (including those beneath instances, which are picked via their instance proxy paths). The
+  // prototypes of a point instancer are only drawn at the location of its instances, so they are indexed once per
+  // instance instead of where they are defined.
+  TfHashMap<SdfPath, bool, SdfPath::Hash> timeVarying;
+  UsdPrimRange range = stage->Traverse(UsdTraverseInstanceProxies(UsdPrimDefaultPredicate));
+  for(auto it = range.begin(); it != range.end(); ++it)
+  {
+    const UsdPrim& prim = *it;
+    if(prim.IsA<UsdGeomPointInstancer>())
+    {
+      addInstances(prim, timeVarying);
+      it.PruneChildren();
+    }
+    else if(prim.IsA<UsdGeomGprim>())
+    {
+      Entry entry;
+      entry.path = prim.GetPath();
+      entry.instanceIndex = -1;
+      entry.isMesh = prim.IsA<UsdGeomMesh>();
+      entry.timeVarying = attributesMightBeTimeVarying(prim) || xformOrVisibilityMightBeTimeVarying(prim, timeVarying);
+      entry.hasTriangles = false;
+      m_entries.push_back(std::move(entry));
+    }
+  }
+
+  computeBounds(0, m_entries.size());
+  buildNodes();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::addInstances(const UsdPrim& prim, TfHashMap<SdfPath, bool, SdfPath::Hash>& timeVarying)
+{
+  UsdGeomPointInstancer instancer(prim);
+  SdfPathVector prototypes;
+  instancer.GetPrototypesRel().GetForwardedTargets(&prototypes);
+  VtIntArray protoIndices;
+  UsdAttribute protoIndicesAttr = instancer.GetProtoIndicesAttr();
+  protoIndicesAttr.Get(&protoIndices, m_time);
+
+  // recorded even without instances, so that update() notices when some are added
+  m_instancers[prim.GetPath()] = Instancer{ prototypes, protoIndices, protoIndicesAttr.ValueMightBeTimeVarying() };
+  if(prototypes.empty() || protoIndices.empty())
+    return;
+
+  // the instances move if the instancer does, or if any of its attributes (positions, orientations, invisibleIds...)
+  // is animated
+  const bool instancesTimeVarying = attributesMightBeTimeVarying(prim) ||
+                                    xformOrVisibilityMightBeTimeVarying(prim, timeVarying);
+
+  struct PrototypeGprim
+  {
+    SdfPath path;
+    bool isMesh;
+    bool timeVarying;
+  };
+  UsdStageRefPtr stage = prim.GetStage();
+  std::vector<std::vector<PrototypeGprim> > prototypeGprims(prototypes.size());
+  for(size_t i = 0; i < prototypes.size(); ++i)
+  {
+    UsdPrim prototype = stage->GetPrimAtPath(prototypes[i]);
+    if(!prototype)
+      continue;
+    for(const UsdPrim& gprim : UsdPrimRange(prototype, UsdTraverseInstanceProxies(UsdPrimDefaultPredicate)))
+    {
+      if(gprim.IsA<UsdGeomGprim>())
+      {
+        prototypeGprims[i].push_back(PrototypeGprim{
+          gprim.GetPath(),
+          gprim.IsA<UsdGeomMesh>(),
+          attributesMightBeTimeVarying(gprim) || xformOrVisibilityMightBeTimeVarying(gprim, timeVarying) });
+      }
+    }
+  }
+
+  for(size_t i = 0; i < protoIndices.size(); ++i)
+  {
+    const int protoIndex = protoIndices[i];
+    if(protoIndex < 0 || size_t(protoIndex) >= prototypes.size())
+      continue;
+    for(const PrototypeGprim& gprim : prototypeGprims[protoIndex])
+    {
+      Entry entry;
+      entry.path = gprim.path;
+      entry.instancer = prim.GetPath();
+      entry.prototype = prototypes[protoIndex];
+      entry.instanceIndex = int(i);
+      entry.isMesh = gprim.isMesh;
+      entry.timeVarying = instancesTimeVarying || gprim.timeVarying;
+      entry.hasTriangles = false;
+      m_entries.push_back(std::move(entry));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PrimBvh::instancesChanged(const UsdStageRefPtr& stage, const SdfPath& instancerPath) const
+{
+  UsdGeomPointInstancer instancer(stage->GetPrimAtPath(instancerPath));
+  if(!instancer)
+    return true;
+
+  const Instancer& indexed = m_instancers.find(instancerPath)->second;
+  SdfPathVector prototypes;
+  instancer.GetPrototypesRel().GetForwardedTargets(&prototypes);
+  VtIntArray protoIndices;
+  instancer.GetProtoIndicesAttr().Get(&protoIndices, m_time);
+  return prototypes != indexed.prototypes || protoIndices != indexed.protoIndices;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PrimBvh::isValid(const UsdStageRefPtr& stage, const TfTokenVector& purposes) const
+{
+  return m_valid && get_pointer(m_stage) == get_pointer(stage) && m_purposes == purposes;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t PrimBvh::timeVaryingSize() const
+{
+  return size_t(std::count_if(m_entries.begin(), m_entries.end(), [](const Entry& entry) { return entry.timeVarying; }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::computeBounds(size_t first, size_t count)
+{
+  UsdStageRefPtr stage = m_stage;
+  if(!stage)
+    return;
+
+  // the world space transforms of the instances of the point instancers in the range (a null matrix for the hidden
+  // instances), computed once per instancer up front
+  std::map<SdfPath, VtMatrix4dArray> instanceTransforms;
+  UsdGeomXformCache xformCache(m_time);
+  for(size_t i = first, e = first + count; i < e; ++i)
+  {
+    const SdfPath& instancerPath = m_entries[i].instancer;
+    if(instancerPath.IsEmpty() || instanceTransforms.count(instancerPath))
+      continue;
+    VtMatrix4dArray& transforms = instanceTransforms[instancerPath];
+    UsdGeomPointInstancer instancer(stage->GetPrimAtPath(instancerPath));
+    if(!instancer || !instancer.ComputeInstanceTransformsAtTime(&transforms, m_time, m_time,
+        UsdGeomPointInstancer::IncludeProtoXform, UsdGeomPointInstancer::IgnoreMask))
+    {
+      transforms.clear();
+      continue;
+    }
+    const std::vector<bool> mask = instancer.ComputeMaskAtTime(m_time);
+    const GfMatrix4d instancerToWorld = xformCache.GetLocalToWorldTransform(instancer.GetPrim());
+    for(size_t j = 0; j < transforms.size(); ++j)
+    {
+      transforms[j] = (j < mask.size() && !mask[j]) ? GfMatrix4d(0.0) : transforms[j] * instancerToWorld;
+    }
+  }
+
+  // UsdGeomBBoxCache is not safe to share across threads, so each chunk of prims gets a cache of its own.
+  WorkParallelForN(count, [this, &stage, &instanceTransforms, first](size_t begin, size_t end)
+  {
+    UsdGeomBBoxCache bboxCache(m_time, m_purposes, true);
+    for(size_t i = first + begin, e = first + end; i < e; ++i)
+    {
+      Entry& entry = m_entries[i];
+      entry.bounds = GfRange3d();
+      entry.hasTriangles = false;
+      entry.triangles.clear();
+      UsdPrim prim = stage->GetPrimAtPath(entry.path);
+      if(!prim)
+        continue;
+
+      if(entry.instanceIndex < 0)
+      {
+        entry.bounds = bboxCache.ComputeWorldBound(prim).ComputeAlignedRange();
+        continue;
+      }
+
+      // the bounds of the gprim within its prototype, moved to the instance
+      const VtMatrix4dArray& transforms = instanceTransforms.find(entry.instancer)->second;
+      UsdPrim prototype = stage->GetPrimAtPath(entry.prototype);
+      if(!prototype || size_t(entry.instanceIndex) >= transforms.size() || transforms[entry.instanceIndex] == GfMatrix4d(0.0))
+        continue;
+      entry.instanceToWorld = transforms[entry.instanceIndex];
+      GfBBox3d bounds = bboxCache.ComputeRelativeBound(prim, prototype);
+      bounds.Transform(entry.instanceToWorld);
+      entry.bounds = bounds.ComputeAlignedRange();
+    }
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t PrimBvh::buildNode(uint32_t first, uint32_t count)
+{
+  const uint32_t index = uint32_t(m_nodes.size());
+  m_nodes.push_back(Node());
+
+  GfRange3d bounds;
+  GfRange3d centroids;
+  for(uint32_t i = first; i < first + count; ++i)
+  {
+    bounds.UnionWith(m_entries[i].bounds);
+    centroids.UnionWith(centroid(m_entries[i].bounds));
+  }
+  m_nodes[index].bounds = bounds;
+
+  if(count <= kMaxLeafSize)
+  {
+    m_nodes[index].first = first;
+    m_nodes[index].count = count;
+    return index;
+  }
+
+  // split at the median along the longest axis of the centroids
+  const GfVec3d size = centroids.GetSize();
+  const int axis = (size[0] >= size[1] && size[0] >= size[2]) ? 0 : (size[1] >= size[2] ? 1 : 2);
+  const uint32_t half = count / 2;
+  std::nth_element(
+    m_entries.begin() + first,
+    m_entries.begin() + first + half,
+    m_entries.begin() + first + count,
+    [axis](const Entry& a, const Entry& b) { return centroid(a.bounds)[axis] < centroid(b.bounds)[axis]; });
+
+  buildNode(first, half);
+  const uint32_t right = buildNode(first + half, count - half);
+  m_nodes[index].first = right;
+  m_nodes[index].count = 0;
+  return index;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::buildNodes()
+{
+  m_nodes.clear();
+  if(!m_entries.empty())
+  {
+    m_nodes.reserve(2 * (m_entries.size() / kMaxLeafSize + 1));
+    buildNode(0, uint32_t(m_entries.size()));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::refit()
+{
+  // children are always stored after their parents, so walking backwards updates the children first
+  for(size_t i = m_nodes.size(); i-- > 0; )
+  {
+    Node& node = m_nodes[i];
+    GfRange3d bounds;
+    if(node.count)
+    {
+      for(uint32_t j = node.first; j < node.first + node.count; ++j)
+        bounds.UnionWith(m_entries[j].bounds);
+    }
+    else
+    {
+      bounds.UnionWith(m_nodes[i + 1].bounds);
+      bounds.UnionWith(m_nodes[node.first].bounds);
+    }
+    node.bounds = bounds;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::markDirty(const SdfPathVector& resyncedPaths, const SdfPathVector& changedOnlyPaths)
+{
+  if(!m_valid)
+    return;
+
+  if(!resyncedPaths.empty())
+  {
+    m_valid = false;
+    m_dirtyPaths.clear();
+    return;
+  }
+
+  for(const SdfPath& path : changedOnlyPaths)
+  {
+    m_dirtyPaths.push_back(path.GetAbsoluteRootOrPrimPath());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::update(const UsdStageRefPtr& stage, UsdTimeCode time, const TfTokenVector& purposes)
+{
+  if(!isValid(stage, purposes))
+  {
+    build(stage, time, purposes);
+    return;
+  }
+
+  const bool timeChanged = (m_time != time);
+  if(m_dirtyPaths.empty() && !timeChanged)
+    return;
+  m_time = time;
+
+  TF_DEBUG(ALUSDMAYA_SELECTION).Msg("PrimBvh::update refitting for %zu changed paths%s\n", m_dirtyPaths.size(),
+      timeChanged ? " and a change of time" : "");
+
+  // a change to a prim (e.g. its transform) affects the bounds of every gprim beneath it, and of the instances of a
+  // point instancer beneath it
+  TfHashSet<SdfPath, SdfPath::Hash> dirtyPaths(m_dirtyPaths.begin(), m_dirtyPaths.end());
+  m_dirtyPaths.clear();
+  const bool rootDirty = dirtyPaths.count(SdfPath::AbsoluteRootPath()) != 0;
+  auto isDirty = [&dirtyPaths](SdfPath path)
+  {
+    for(; !path.IsEmpty() && !path.IsAbsoluteRootPath(); path = path.GetParentPath())
+    {
+      if(dirtyPaths.count(path))
+        return true;
+    }
+    return false;
+  };
+
+  // the point instancers whose prototypes or proto indices have changed get their instances indexed again. Their old
+  // entries are dropped and the new ones appended, so the tree has to be rebuilt (over the bounds already computed).
+  SdfPathVector changedInstancers;
+  for(auto& instancer : m_instancers)
+  {
+    const bool instancerDirty = rootDirty || isDirty(instancer.first);
+    if(!instancerDirty && !(timeChanged && instancer.second.protoIndicesTimeVarying))
+      continue;
+    if(instancesChanged(stage, instancer.first))
+    {
+      changedInstancers.push_back(instancer.first);
+    }
+    else
+    if(instancerDirty)
+    {
+      // the proto indices may have been animated without changing their value at the current time
+      UsdAttribute protoIndices = UsdGeomPointInstancer(stage->GetPrimAtPath(instancer.first)).GetProtoIndicesAttr();
+      instancer.second.protoIndicesTimeVarying = protoIndices.ValueMightBeTimeVarying();
+    }
+  }
+  size_t numKept = m_entries.size();
+  if(!changedInstancers.empty())
+  {
+    TF_DEBUG(ALUSDMAYA_SELECTION).Msg("PrimBvh::update re-indexing the instances of %zu point instancers\n",
+        changedInstancers.size());
+
+    TfHashSet<SdfPath, SdfPath::Hash> changed(changedInstancers.begin(), changedInstancers.end());
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [&changed](const Entry& entry) { return !entry.instancer.IsEmpty() && changed.count(entry.instancer); }),
+        m_entries.end());
+    numKept = m_entries.size();
+
+    TfHashMap<SdfPath, bool, SdfPath::Hash> timeVarying;
+    for(const SdfPath& path : changedInstancers)
+    {
+      m_instancers.erase(path);
+      UsdPrim prim = stage->GetPrimAtPath(path);
+      if(prim && prim.IsA<UsdGeomPointInstancer>())
+        addInstances(prim, timeVarying);
+    }
+  }
+
+  // the dirty entries are recomputed in place (moving them would break the tree), a contiguous run at a time. The new
+  // instances are always computed.
+  std::vector<char> dirty(m_entries.size(), rootDirty);
+  std::fill(dirty.begin() + numKept, dirty.end(), 1);
+  bool anyDirty = rootDirty || numKept != m_entries.size();
+  if(!rootDirty)
+  {
+    std::atomic<bool> foundDirty(false);
+    WorkParallelForN(numKept, [this, &isDirty, &dirty, &foundDirty, timeChanged](size_t begin, size_t end)
+    {
+      for(size_t i = begin; i < end; ++i)
+      {
+        const Entry& entry = m_entries[i];
+        dirty[i] = (timeChanged && entry.timeVarying) || isDirty(entry.path) || isDirty(entry.instancer);
+        if(dirty[i])
+          foundDirty = true;
+      }
+    });
+    anyDirty = anyDirty || foundDirty;
+  }
+  if(!anyDirty && changedInstancers.empty())
+    return;
+
+  for(size_t i = 0, n = m_entries.size(); i < n; )
+  {
+    if(!dirty[i])
+    {
+      ++i;
+      continue;
+    }
+    size_t first = i;
+    while(i < n && dirty[i])
+      ++i;
+    computeBounds(first, i - first);
+  }
+
+  if(changedInstancers.empty())
+    refit();
+  else
+    buildNodes();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const std::vector<GfVec3d>& PrimBvh::triangles(Entry& entry)
+{
+  if(entry.hasTriangles)
+    return entry.triangles;
+  entry.hasTriangles = true;
+  entry.triangles.clear();
+
+  UsdStageRefPtr stage = m_stage;
+  if(!stage)
+    return entry.triangles;
+  UsdGeomMesh mesh(stage->GetPrimAtPath(entry.path));
+  if(!mesh)
+    return entry.triangles;
+
+  VtVec3fArray points;
+  VtIntArray faceVertexCounts;
+  VtIntArray faceVertexIndices;
+  mesh.GetPointsAttr().Get(&points, m_time);
+  mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts, m_time);
+  mesh.GetFaceVertexIndicesAttr().Get(&faceVertexIndices, m_time);
+
+  // the transform of an instance applies to the mesh relative to the root of its prototype
+  UsdGeomXformCache xformCache(m_time);
+  GfMatrix4d localToWorld;
+  if(entry.instanceIndex < 0)
+  {
+    localToWorld = xformCache.GetLocalToWorldTransform(mesh.GetPrim());
+  }
+  else
+  {
+    bool resetsXformStack = false;
+    localToWorld = xformCache.ComputeRelativeTransform(mesh.GetPrim(), stage->GetPrimAtPath(entry.prototype),
+        &resetsXformStack) * entry.instanceToWorld;
+  }
+
+  std::vector<GfVec3d> worldPoints(points.size());
+  for(size_t i = 0; i < points.size(); ++i)
+  {
+    worldPoints[i] = localToWorld.Transform(GfVec3d(points[i]));
+  }
+
+  // fan triangulate the faces, skipping any that reference invalid points
+  const int numPoints = int(worldPoints.size());
+  const int numIndices = int(faceVertexIndices.size());
+  int offset = 0;
+  for(const int count : faceVertexCounts)
+  {
+    if(offset + count > numIndices)
+      break;
+    const int* face = faceVertexIndices.cdata() + offset;
+    offset += count;
+    bool validFace = true;
+    for(int i = 0; i < count && validFace; ++i)
+    {
+      validFace = face[i] >= 0 && face[i] < numPoints;
+    }
+    if(!validFace)
+      continue;
+    for(int i = 2; i < count; ++i)
+    {
+      entry.triangles.push_back(worldPoints[face[0]]);
+      entry.triangles.push_back(worldPoints[face[i - 1]]);
+      entry.triangles.push_back(worldPoints[face[i]]);
+    }
+  }
+  return entry.triangles;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool PrimBvh::intersectRay(const GfRay& ray, Hit& hit, const Filter& filter)
+{
+  if(m_nodes.empty())
+    return false;
+
+  double closest = std::numeric_limits<double>::max();
+  Entry* closestEntry = nullptr;
+
+  std::vector<uint32_t> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while(!stack.empty())
+  {
+    const uint32_t nodeIndex = stack.back();
+    const Node& node = m_nodes[nodeIndex];
+    stack.pop_back();
+
+    double enter, exit;
+    if(node.bounds.IsEmpty() || !ray.Intersect(node.bounds, &enter, &exit) || enter > closest)
+      continue;
+
+    if(!node.count)
+    {
+      stack.push_back(node.first);
+      stack.push_back(nodeIndex + 1);
+      continue;
+    }
+
+    for(uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+      Entry& entry = m_entries[i];
+      if(entry.bounds.IsEmpty() || !ray.Intersect(entry.bounds, &enter, &exit) || enter > closest)
+        continue;
+      if(filter && !filter(entry.path))
+        continue;
+
+      if(!entry.isMesh)
+      {
+        // other gprims are picked by their bounds
+        const double distance = std::max(enter, 0.0);
+        if(distance < closest)
+        {
+          closest = distance;
+          closestEntry = &entry;
+        }
+        continue;
+      }
+
+      const std::vector<GfVec3d>& tris = triangles(entry);
+      for(size_t j = 0; j + 2 < tris.size(); j += 3)
+      {
+        double distance;
+        if(ray.Intersect(tris[j], tris[j + 1], tris[j + 2], &distance, nullptr, nullptr, closest) && distance < closest)
+        {
+          closest = distance;
+          closestEntry = &entry;
+        }
+      }
+    }
+  }
+
+  if(!closestEntry)
+    return false;
+
+  hit.path = closestEntry->path;
+  hit.instanceIndex = closestEntry->instanceIndex;
+  hit.distance = closest;
+  hit.point = ray.GetPoint(closest);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::intersectPoint(const GfVec3d& point, SdfPathVector& paths) const
+{
+  if(m_nodes.empty())
+    return;
+
+  std::vector<uint32_t> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while(!stack.empty())
+  {
+    const uint32_t nodeIndex = stack.back();
+    const Node& node = m_nodes[nodeIndex];
+    stack.pop_back();
+
+    if(!node.bounds.Contains(point))
+      continue;
+
+    if(!node.count)
+    {
+      stack.push_back(node.first);
+      stack.push_back(nodeIndex + 1);
+      continue;
+    }
+
+    for(uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+      if(m_entries[i].bounds.Contains(point))
+        paths.push_back(m_entries[i].path);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void PrimBvh::intersectFrustum(const GfMatrix4d& viewProjection, std::vector<Hit>& hits, const Filter& filter)
+{
+  if(m_nodes.empty())
+    return;
+
+  GfVec4d planes[6];
+  extractFrustumPlanes(viewProjection, planes);
+  GfVec3d corners[8];
+  computeFrustumCorners(viewProjection, corners);
+
+  auto addHit = [&hits](const Entry& entry)
+  {
+    Hit hit;
+    hit.path = entry.path;
+    hit.instanceIndex = entry.instanceIndex;
+    hit.point = entry.bounds.GetMidpoint();
+    hit.distance = 0.0;
+    hits.push_back(hit);
+  };
+
+  // (node, inside) pairs: once a node is entirely inside the frustum, its children need no further testing
+  std::vector<std::pair<uint32_t, bool> > stack;
+  stack.reserve(64);
+  stack.emplace_back(0, false);
+  while(!stack.empty())
+  {
+    const uint32_t nodeIndex = stack.back().first;
+    bool inside = stack.back().second;
+    stack.pop_back();
+    const Node& node = m_nodes[nodeIndex];
+
+    if(!inside)
+    {
+      const Containment containment = classifyRange(planes, node.bounds);
+      if(containment == Containment::kOutside)
+        continue;
+      inside = (containment == Containment::kInside);
+    }
+
+    if(!node.count)
+    {
+      stack.emplace_back(node.first, inside);
+      stack.emplace_back(nodeIndex + 1, inside);
+      continue;
+    }
+
+    if(inside)
+    {
+      for(uint32_t i = node.first; i < node.first + node.count; ++i)
+      {
+        if(!m_entries[i].bounds.IsEmpty() && (!filter || filter(m_entries[i].path)))
+          addHit(m_entries[i]);
+      }
+      continue;
+    }
+
+    for(uint32_t i = node.first; i < node.first + node.count; ++i)
+    {
+      Entry& entry = m_entries[i];
+      const Containment containment = classifyRange(planes, entry.bounds);
+      if(containment == Containment::kOutside)
+        continue;
+      if(filter && !filter(entry.path))
+        continue;
+      if(containment == Containment::kIntersects && entry.isMesh)
+      {
+        const std::vector<GfVec3d>& tris = triangles(entry);
+        bool intersects = false;
+        for(size_t j = 0; j + 2 < tris.size() && !intersects; j += 3)
+        {
+          intersects = triangleInFrustum(planes, corners, tris.data() + j);
+        }
+        if(!intersects)
+          continue;
+      }
+      addHit(entry);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
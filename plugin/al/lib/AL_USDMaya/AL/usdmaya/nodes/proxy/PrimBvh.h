@@ -0,0 +1,187 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <AL/usdmaya/Api.h>
+
+#include <pxr/base/gf/matrix4d.h>
+#include <pxr/base/gf/range3d.h>
+#include <pxr/base/gf/ray.h>
+#include <pxr/base/tf/hashmap.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/types.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usd/timeCode.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A CPU side bounding volume hierarchy over the world space bounds of the gprims in a stage, used to resolve
+///         viewport picks without re-rendering the stage into an ID buffer. Meshes are refined to triangles the first
+///         time a query reaches them. All positions are in the space of the stage (i.e. the local space of the proxy
+///         shape). The gprims of the prototypes of a point instancer are indexed once per instance, and returned with
+///         the index of the instance that was hit (as the imaging engine does).
+//----------------------------------------------------------------------------------------------------------------------
+class PrimBvh
+{
+public:
+
+  /// \brief  a single hit returned from a ray query
+  struct Hit
+  {
+    SdfPath path;       ///< the path of the gprim that was hit
+    GfVec3d point;      ///< the point at which the gprim was hit
+    double distance;    ///< the distance along the ray to the hit point
+    int instanceIndex;  ///< the index of the point instancer instance that was hit, or -1
+  };
+
+  /// \brief  a predicate returning true for the paths of the gprims that may be returned by a query. Gprims that are
+  ///         filtered out are ignored during the traversal, so they can not hide the gprims behind them.
+  typedef std::function<bool(const SdfPath&)> Filter;
+
+  /// \brief  (re)builds the hierarchy from the gprims in the stage. The world bounds of the prims are computed in
+  ///         parallel. Nested point instancers (within the prototypes of another point instancer) are not indexed.
+  /// \param  stage the stage to index
+  /// \param  time the time at which to compute the bounds
+  /// \param  purposes the purposes of the prims that should be pickable
+  AL_USDMAYA_PUBLIC
+  void build(const UsdStageRefPtr& stage, UsdTimeCode time, const TfTokenVector& purposes);
+
+  /// \brief  returns true if the hierarchy has been built for the specified stage and purposes, and has not been
+  ///         invalidated since. A change of time does not invalidate the hierarchy: update() only recomputes the
+  ///         bounds of the gprims that may change over time.
+  AL_USDMAYA_PUBLIC
+  bool isValid(const UsdStageRefPtr& stage, const TfTokenVector& purposes) const;
+
+  /// \brief  throws away the hierarchy, so that it will be rebuilt on the next query
+  inline void invalidate()
+    { m_valid = false; }
+
+  /// \brief  processes the paths from an ObjectsChanged notice. Resyncs invalidate the whole hierarchy, whereas the
+  ///         prims beneath a path whose info changed have their bounds recomputed (and the tree refitted) on the next
+  ///         call to update(). The instances of a dirty point instancer are re-indexed if its prototypes or proto
+  ///         indices have changed.
+  /// \param  resyncedPaths the resynced paths of the notice
+  /// \param  changedOnlyPaths the changed info only paths of the notice
+  AL_USDMAYA_PUBLIC
+  void markDirty(const SdfPathVector& resyncedPaths, const SdfPathVector& changedOnlyPaths);
+
+  /// \brief  makes sure the hierarchy matches the stage, either rebuilding it or refitting it for any dirty prims, and
+  ///         for the time varying ones when the time has changed. The point instancers whose instances have changed
+  ///         (because they are dirty, or their proto indices are animated) are re-indexed, and the tree rebuilt over
+  ///         the existing bounds.
+  /// \param  stage the stage to index
+  /// \param  time the time at which to compute the bounds
+  /// \param  purposes the purposes of the prims that should be pickable
+  AL_USDMAYA_PUBLIC
+  void update(const UsdStageRefPtr& stage, UsdTimeCode time, const TfTokenVector& purposes);
+
+  /// \brief  finds the closest gprim hit by the ray
+  /// \param  ray the ray to test (in stage space)
+  /// \param  hit the returned hit
+  /// \param  filter if set, only the gprims for which it returns true can be hit
+  /// \return true if a gprim was hit
+  AL_USDMAYA_PUBLIC
+  bool intersectRay(const GfRay& ray, Hit& hit, const Filter& filter = Filter());
+
+  /// \brief  finds all gprims whose bounds contain the point
+  /// \param  point the point to test (in stage space)
+  /// \param  paths the returned paths of the gprims
+  AL_USDMAYA_PUBLIC
+  void intersectPoint(const GfVec3d& point, SdfPathVector& paths) const;
+
+  /// \brief  finds all gprims that are at least partially within a frustum. Meshes that straddle the frustum are
+  ///         tested against their triangles.
+  /// \param  viewProjection the matrix that transforms stage space into clip space. The frustum is the unit clip
+  ///         space cube.
+  /// \param  hits the returned hits, with the hit point at the centre of the bounds of each gprim
+  /// \param  filter if set, only the gprims for which it returns true are returned
+  AL_USDMAYA_PUBLIC
+  void intersectFrustum(const GfMatrix4d& viewProjection, std::vector<Hit>& hits, const Filter& filter = Filter());
+
+  /// \brief  returns the number of gprims that have been indexed (each instance of a point instancer prototype gprim
+  ///         counts as one)
+  inline size_t size() const
+    { return m_entries.size(); }
+
+  /// \brief  returns the number of indexed gprims whose bounds may change over time
+  AL_USDMAYA_PUBLIC
+  size_t timeVaryingSize() const;
+
+private:
+  struct Entry
+  {
+    SdfPath path;
+    SdfPath instancer;          ///< the point instancer of an instance of a prototype gprim
+    SdfPath prototype;          ///< the root of the prototype of an instance
+    int instanceIndex;          ///< the index of the instance, or -1 for the gprims that are not instanced
+    GfMatrix4d instanceToWorld; ///< the transform of the instance (including the prototype root transform)
+    GfRange3d bounds;
+    bool isMesh;
+    bool timeVarying;
+    bool hasTriangles;
+    std::vector<GfVec3d> triangles;
+  };
+
+  /// the prototypes and proto indices a point instancer was indexed with
+  struct Instancer
+  {
+    SdfPathVector prototypes;
+    VtIntArray protoIndices;
+    bool protoIndicesTimeVarying;
+  };
+
+  struct Node
+  {
+    GfRange3d bounds;
+    uint32_t first;   ///< the first entry of a leaf, or the index of the right child of an internal node
+    uint32_t count;   ///< the number of entries in a leaf, or zero for an internal node (whose left child follows it)
+  };
+
+  void addInstances(const UsdPrim& instancer, TfHashMap<SdfPath, bool, SdfPath::Hash>& timeVarying);
+  bool instancesChanged(const UsdStageRefPtr& stage, const SdfPath& instancerPath) const;
+  uint32_t buildNode(uint32_t first, uint32_t count);
+  void buildNodes();
+  void refit();
+  void computeBounds(size_t first, size_t count);
+  const std::vector<GfVec3d>& triangles(Entry& entry);
+
+  std::vector<Entry> m_entries;
+  std::vector<Node> m_nodes;
+  TfHashMap<SdfPath, Instancer, SdfPath::Hash> m_instancers;
+  SdfPathVector m_dirtyPaths;
+  TfTokenVector m_purposes;
+  UsdStageWeakPtr m_stage;
+  UsdTimeCode m_time = UsdTimeCode::Default();
+  bool m_valid = false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
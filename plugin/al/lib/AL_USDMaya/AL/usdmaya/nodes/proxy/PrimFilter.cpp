@@ -17,6 +17,10 @@
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
 #include "AL/usdmaya/fileio/SchemaPrims.h"
 
+#include <pxr/base/tf/hashset.h>
+
+#include <algorithm>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -28,18 +32,18 @@ PrimFilter::PrimFilter(
   const std::vector<UsdPrim>& newPrimSet,
   PrimFilterInterface* proxy,
   bool forceImport)
-        : m_newPrimSet(newPrimSet), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
+        : m_newPrimSet(), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
 {
-  // copy over original prims
-  m_removedPrimSet.assign(previousPrims.begin(), previousPrims.end());
-  std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
+  // Membership tests against the previous prims (and the prims we end up keeping) are hashed, so that a variant
+  // switch over a large hierarchy remains linear in the number of prims, rather than paying for a vector erase
+  // (and a binary search) per retained prim.
+  TfHashSet<SdfPath, SdfPath::Hash> previousPaths(previousPrims.begin(), previousPrims.end());
+  TfHashSet<SdfPath, SdfPath::Hash> retainedPaths;
+  m_newPrimSet.reserve(newPrimSet.size());
 
-  for(auto it = m_newPrimSet.begin(); it != m_newPrimSet.end(); )
+  for(auto it = newPrimSet.begin(); it != newPrimSet.end(); ++it)
   {
-    UsdPrim prim = *it;
-    auto lastIt = it;
-    ++it;
-
+    const UsdPrim& prim = *it;
     SdfPath path = prim.GetPath();
 
     // check previous prim type (if it exists at all?)
@@ -50,8 +54,7 @@ PrimFilter::PrimFilter(
     // inactive prims should be removed
     if (!prim.IsActive())
     {
-        it = m_newPrimSet.erase(lastIt);
-        continue;
+      continue;
     }
 
     bool supportsUpdate = false;
@@ -61,68 +64,79 @@ PrimFilter::PrimFilter(
 
     if(importableByDefault || forceImport)
     {
+      bool isNewPrim = true;
+
       // if the type remains the same, and the type supports update
-      if(existingTranslatorId == newTranslatorId)
+      if(existingTranslatorId == newTranslatorId && previousPaths.count(path))
       {
-        // locate the path and delete from the removed set (we do not want to delete this prim!
-        // Note that m_removedPrimSet is reverse sorted
-        auto iter = std::lower_bound(m_removedPrimSet.begin(), m_removedPrimSet.end(), path, [](const SdfPath& a, const SdfPath& b){ return b < a; } );
-        if(iter != removedPrimSet().end() && *iter == path)
+        if (supportsUpdate)
         {
-          if (supportsUpdate)
+          // we do not want to delete this prim!
+          retainedPaths.insert(path);
+          if (proxy->isPrimDirty(prim))
           {
-            m_removedPrimSet.erase(iter);
-            if (proxy->isPrimDirty(prim))
-            {
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim will be updated.\n", path.GetText());
-              m_updatablePrimSet.push_back(prim);
-            }
-            else
-            {
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim remains unchanged.\n", path.GetText());
-            }
-            // supporting update means it's not a new prim,
-            // otherwise we still want the prim to be re-created.
-            it = m_newPrimSet.erase(lastIt);
+            TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                "PrimFilter::PrimFilter %s prim will be updated.\n", path.GetText());
+            m_updatablePrimSet.push_back(prim);
+          }
+          else
+          {
+            TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                "PrimFilter::PrimFilter %s prim remains unchanged.\n", path.GetText());
+          }
+          // supporting update means it's not a new prim,
+          // otherwise we still want the prim to be re-created.
+          isNewPrim = false;
 
-            // skip creating transforms in this case.
-            requiresParent = false;
+          // skip creating transforms in this case.
+          requiresParent = false;
+        }
+        else
+        {
+          if (proxy->isPrimDirty(prim))
+          {
+            // prim has been added in "remove prim set", nothing to do here
+            TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                  "PrimFilter::PrimFilter %s prim will be removed and recreated.\n", path.GetText());
           }
           else
           {
-            if (proxy->isPrimDirty(prim))
-            {
-              // prim has been added in "remove prim set", nothing to do here
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                    "PrimFilter::PrimFilter %s prim will be removed and recreated.\n", path.GetText());
-            }
-            else
-            {
-              // prim is clean, no need to remove nor recreate
-              TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim remains unchanged.\n", path.GetText());
-
-              m_removedPrimSet.erase(iter);
-              it = m_newPrimSet.erase(lastIt);
-              // skip creating transforms in this case.
-              requiresParent = false;
-            }
+            // prim is clean, no need to remove nor recreate
+            TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
+                "PrimFilter::PrimFilter %s prim remains unchanged.\n", path.GetText());
+
+            retainedPaths.insert(path);
+            isNewPrim = false;
+            // skip creating transforms in this case.
+            requiresParent = false;
           }
         }
       }
+
+      if(isNewPrim)
+      {
+        m_newPrimSet.push_back(prim);
+      }
+
       // if we need a transform, make a note of it now
       if(requiresParent)
       {
         m_transformsToCreate.push_back(prim);
       }
     }
-    else
+  }
+
+  // whatever was not retained needs removing. Note that m_removedPrimSet is reverse sorted (so that children are
+  // removed before their parents).
+  m_removedPrimSet.reserve(previousPrims.size() - std::min(previousPrims.size(), retainedPaths.size()));
+  for(const SdfPath& path : previousPrims)
+  {
+    if(!retainedPaths.count(path))
     {
-      it = m_newPrimSet.erase(lastIt);
+      m_removedPrimSet.push_back(path);
     }
   }
+  std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -45,28 +45,29 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
     // figure out whether selectability has changed.
     for(const SdfPath& path : changedOnlyPaths)
     {
+      // property changes cannot change the metadata of the prim.
+      if(!path.IsPrimPath())
+      {
+        continue;
+      }
+
       UsdPrim changedPrim = m_stage->GetPrimAtPath(path);
       if(!changedPrim)
       {
         continue;
       }
 
+      // Adding or removing a path only forgets the resolved selectability of its subtree, and does nothing if the
+      // selectability of the prim is unchanged.
       TfToken selectabilityPropertyToken;
-      if(changedPrim.GetMetadata<TfToken>(Metadata::selectability, &selectabilityPropertyToken))
+      if(changedPrim.GetMetadata<TfToken>(Metadata::selectability, &selectabilityPropertyToken) &&
+         selectabilityPropertyToken == Metadata::unselectable)
       {
-        bool hasPath = m_selectabilityDB.containsPath(path);
-        //Check if this prim is unselectable
-        if(selectabilityPropertyToken == Metadata::unselectable)
-        {
-          if(!hasPath)
-          {
-            m_selectabilityDB.addPathAsUnselectable(path);
-          }
-        }
-        if(hasPath)
-        {
-          m_selectabilityDB.removePathAsUnselectable(path);
-        }
+        m_selectabilityDB.addPathAsUnselectable(path);
+      }
+      else
+      {
+        m_selectabilityDB.removePathAsUnselectable(path);
       }
 
       // build up new lock-prim list
@@ -96,8 +97,6 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
   }
   else
   {
-    auto& unselectablePaths = m_selectabilityDB.m_unselectablePaths;
-
     // figure out whether selectability has changed.
     for(const SdfPath& path : resyncedPaths)
     {
@@ -108,17 +107,6 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
         continue;
       }
 
-      // determine range of selectable prims we need to replace in the selectability DB
-      auto lb = std::lower_bound(unselectablePaths.begin(), unselectablePaths.end(), path);
-      auto ub = lb;
-      if(lb != unselectablePaths.end())
-      {
-        while(ub != unselectablePaths.end() && ub->HasPrefix(*lb))
-        {
-          ++ub;
-        }
-      }
-
       m_lockManager.removeFromRootPath(path);
 
       // sort the excluded tagged geom to help searching
@@ -206,25 +194,9 @@ void ProxyShape::processChangedMetaData(const SdfPathVector& resyncedPaths, cons
 
       m_lockManager.sort();
 
-      // sort and merge into previous selectable database
+      // sort and replace the previous unselectable paths of the subtree in the selectable database
       std::sort(newUnselectables.begin(), newUnselectables.end());
-
-      if(lb == unselectablePaths.end())
-      {
-        if(!newUnselectables.empty())
-        {
-          unselectablePaths.insert(unselectablePaths.end(), newUnselectables.begin(), newUnselectables.end());
-        }
-      }
-      else
-      {
-        // TODO: could probably overwrite some of old paths here, and then insert the remaining new elements.
-        lb = unselectablePaths.erase(lb, ub);
-        if(!newUnselectables.empty())
-        {
-          unselectablePaths.insert(lb, newUnselectables.begin(), newUnselectables.end());
-        }
-      }
+      m_selectabilityDB.replaceUnselectablePathsInSubtree(path, newUnselectables);
     }
   }
 
@@ -0,0 +1,402 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/proxy/PrimBvh.h"
+
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/pointInstancer.h>
+#include <pxr/usd/usdGeom/sphere.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xform.h>
+#include <pxr/usd/usdGeom/xformCommonAPI.h>
+
+#include <algorithm>
+
+using AL::usdmaya::nodes::proxy::PrimBvh;
+
+namespace {
+
+// creates a unit cube mesh (from -1 to 1) translated to the specified position
+UsdGeomMesh defineCube(const UsdStageRefPtr& stage, const char* path, const GfVec3d& position)
+{
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath(path));
+  const VtVec3fArray points = {
+    GfVec3f(-1, -1, -1), GfVec3f(1, -1, -1), GfVec3f(1, 1, -1), GfVec3f(-1, 1, -1),
+    GfVec3f(-1, -1,  1), GfVec3f(1, -1,  1), GfVec3f(1, 1,  1), GfVec3f(-1, 1,  1)
+  };
+  const VtIntArray counts = { 4, 4, 4, 4, 4, 4 };
+  const VtIntArray indices = {
+    0, 3, 2, 1,
+    4, 5, 6, 7,
+    0, 1, 5, 4,
+    1, 2, 6, 5,
+    2, 3, 7, 6,
+    3, 0, 4, 7
+  };
+  mesh.CreatePointsAttr(VtValue(points));
+  mesh.CreateFaceVertexCountsAttr(VtValue(counts));
+  mesh.CreateFaceVertexIndicesAttr(VtValue(indices));
+  mesh.CreateExtentAttr(VtValue(VtVec3fArray{ GfVec3f(-1, -1, -1), GfVec3f(1, 1, 1) }));
+  UsdGeomXformCommonAPI(mesh).SetTranslate(position);
+  return mesh;
+}
+
+bool containsPath(const std::vector<PrimBvh::Hit>& hits, const char* path)
+{
+  return std::any_of(hits.begin(), hits.end(), [path](const PrimBvh::Hit& hit) { return hit.path == SdfPath(path); });
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+/// build the hierarchy over a row of cubes, and make sure the ray, point, and frustum queries find the right prims
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, queries)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  defineCube(stage, "/root/cube0", GfVec3d(0, 0, 0));
+  defineCube(stage, "/root/cube1", GfVec3d(5, 0, 0));
+  defineCube(stage, "/root/cube2", GfVec3d(10, 0, 0));
+  UsdGeomSphere sphere = UsdGeomSphere::Define(stage, SdfPath("/root/sphere"));
+  sphere.CreateExtentAttr(VtValue(VtVec3fArray{ GfVec3f(-1, -1, -1), GfVec3f(1, 1, 1) }));
+  UsdGeomXformCommonAPI(sphere).SetTranslate(GfVec3d(0, 10, 0));
+
+  // a hidden cube should never be picked
+  UsdGeomMesh hidden = defineCube(stage, "/root/hidden", GfVec3d(5, 0, -5));
+  hidden.CreateVisibilityAttr(VtValue(UsdGeomTokens->invisible));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.build(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_TRUE(bvh.isValid(stage, purposes));
+  EXPECT_EQ(5u, bvh.size());
+
+  // a ray fired down the x axis should hit the first face of the middle cube
+  {
+    PrimBvh::Hit hit;
+    ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(3, 0.5, 0.25), GfVec3d(1, 0, 0)), hit));
+    EXPECT_EQ(SdfPath("/root/cube1"), hit.path);
+    EXPECT_NEAR(1.0, hit.distance, 1e-6);
+    EXPECT_TRUE(GfIsClose(hit.point, GfVec3d(4, 0.5, 0.25), 1e-6));
+  }
+
+  // the ray passes through the hidden cube, which should be ignored, before it reaches the middle cube
+  {
+    PrimBvh::Hit hit;
+    ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(5, 0, -20), GfVec3d(0, 0, 1)), hit));
+    EXPECT_EQ(SdfPath("/root/cube1"), hit.path);
+    EXPECT_NEAR(19.0, hit.distance, 1e-6);
+    EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(-5, 5, 0), GfVec3d(0, 1, 0)), hit));
+  }
+
+  // the sphere is picked by its bounds
+  {
+    PrimBvh::Hit hit;
+    ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(0, 20, 0), GfVec3d(0, -1, 0)), hit));
+    EXPECT_EQ(SdfPath("/root/sphere"), hit.path);
+    EXPECT_NEAR(9.0, hit.distance, 1e-6);
+  }
+
+  // point queries
+  {
+    SdfPathVector paths;
+    bvh.intersectPoint(GfVec3d(10.5, 0, 0), paths);
+    ASSERT_EQ(1u, paths.size());
+    EXPECT_EQ(SdfPath("/root/cube2"), paths[0]);
+
+    paths.clear();
+    bvh.intersectPoint(GfVec3d(2.5, 0, 0), paths);
+    EXPECT_TRUE(paths.empty());
+  }
+
+  // a frustum that maps the box (3, -2, -2) -> (7, 2, 2) onto the clip space cube only contains the middle cube
+  {
+    GfMatrix4d viewProjection = GfMatrix4d().SetTranslate(GfVec3d(-5, 0, 0)) * GfMatrix4d().SetScale(0.5);
+    std::vector<PrimBvh::Hit> hits;
+    bvh.intersectFrustum(viewProjection, hits);
+    ASSERT_EQ(1u, hits.size());
+    EXPECT_EQ(SdfPath("/root/cube1"), hits[0].path);
+    EXPECT_TRUE(GfIsClose(hits[0].point, GfVec3d(5, 0, 0), 1e-6));
+
+    // widen the frustum so that it straddles the outer cubes too
+    viewProjection = GfMatrix4d().SetTranslate(GfVec3d(-5, 0, 0)) * GfMatrix4d().SetScale(GfVec3d(0.2, 0.5, 0.5));
+    hits.clear();
+    bvh.intersectFrustum(viewProjection, hits);
+    EXPECT_EQ(3u, hits.size());
+    EXPECT_TRUE(containsPath(hits, "/root/cube0"));
+    EXPECT_TRUE(containsPath(hits, "/root/cube1"));
+    EXPECT_TRUE(containsPath(hits, "/root/cube2"));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// make sure the hierarchy follows changes to the stage
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, update)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  UsdGeomMesh cube = defineCube(stage, "/root/cube0", GfVec3d(0, 0, 0));
+  defineCube(stage, "/root/cube1", GfVec3d(5, 0, 0));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_EQ(2u, bvh.size());
+
+  const GfRay ray(GfVec3d(0, 0, 20), GfVec3d(0, 0, -1));
+  PrimBvh::Hit hit;
+  ASSERT_TRUE(bvh.intersectRay(ray, hit));
+  EXPECT_EQ(SdfPath("/root/cube0"), hit.path);
+
+  // moving the cube out of the way only requires the bounds (and triangles) of the cube to be recomputed
+  UsdGeomXformCommonAPI(cube).SetTranslate(GfVec3d(0, 0, 30));
+  bvh.markDirty(SdfPathVector(), { SdfPath("/root/cube0.xformOp:translate") });
+  EXPECT_TRUE(bvh.isValid(stage, purposes));
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_FALSE(bvh.intersectRay(ray, hit));
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(0, 0, 40), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/root/cube0"), hit.path);
+  EXPECT_NEAR(9.0, hit.distance, 1e-6);
+
+  // a change to the parent moves everything beneath it
+  UsdGeomXformCommonAPI(stage->GetPrimAtPath(SdfPath("/root"))).SetTranslate(GfVec3d(0, 100, 0));
+  bvh.markDirty(SdfPathVector(), { SdfPath("/root.xformOp:translate") });
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(5, 0, 20), GfVec3d(0, 0, -1)), hit));
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(5, 100, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/root/cube1"), hit.path);
+
+  // new prims require a rebuild
+  defineCube(stage, "/root/cube2", GfVec3d(10, 0, 0));
+  bvh.markDirty({ SdfPath("/root/cube2") }, SdfPathVector());
+  EXPECT_FALSE(bvh.isValid(stage, purposes));
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_EQ(3u, bvh.size());
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(10, 100, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/root/cube2"), hit.path);
+
+  // as does a change of purposes
+  EXPECT_FALSE(bvh.isValid(stage, { UsdGeomTokens->default_, UsdGeomTokens->proxy }));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// a change of time only recomputes the bounds of the gprims that are animated
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, timeVarying)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  defineCube(stage, "/root/static", GfVec3d(0, 0, 0));
+  UsdGeomXform mover = UsdGeomXform::Define(stage, SdfPath("/root/mover"));
+  defineCube(stage, "/root/mover/cube", GfVec3d(0, 0, 0));
+  UsdGeomXformOp translate = mover.AddTranslateOp();
+  translate.Set(GfVec3d(10, 0, 0), UsdTimeCode(1.0));
+  translate.Set(GfVec3d(20, 0, 0), UsdTimeCode(2.0));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.update(stage, UsdTimeCode(1.0), purposes);
+  EXPECT_EQ(2u, bvh.size());
+  EXPECT_EQ(1u, bvh.timeVaryingSize());
+
+  PrimBvh::Hit hit;
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(10, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/root/mover/cube"), hit.path);
+
+  // the hierarchy is refitted rather than rebuilt, and follows the animated cube
+  bvh.update(stage, UsdTimeCode(2.0), purposes);
+  EXPECT_TRUE(bvh.isValid(stage, purposes));
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(10, 0, 20), GfVec3d(0, 0, -1)), hit));
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(20, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/root/mover/cube"), hit.path);
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(0, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/root/static"), hit.path);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the instances of a point instancer are picked where they are drawn, rather than where their prototype is defined
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, pointInstancer)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomPointInstancer instancer = UsdGeomPointInstancer::Define(stage, SdfPath("/instancer"));
+  UsdGeomXform::Define(stage, SdfPath("/instancer/prototypes"));
+  defineCube(stage, "/instancer/prototypes/cube", GfVec3d(0, 0, 0));
+  instancer.CreatePrototypesRel().AddTarget(SdfPath("/instancer/prototypes/cube"));
+  instancer.CreateProtoIndicesAttr(VtValue(VtIntArray{ 0, 0, 0 }));
+  instancer.CreatePositionsAttr(VtValue(VtVec3fArray{ GfVec3f(10, 0, 0), GfVec3f(20, 0, 0), GfVec3f(30, 0, 0) }));
+  instancer.CreateInvisibleIdsAttr(VtValue(VtInt64Array{ 2 }));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.build(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_EQ(3u, bvh.size());
+
+  // nothing is drawn at the location of the prototype
+  PrimBvh::Hit hit;
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(0, 0, 20), GfVec3d(0, 0, -1)), hit));
+
+  // the instances are hit against the triangles of the prototype
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(20.5, 0.5, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/instancer/prototypes/cube"), hit.path);
+  EXPECT_EQ(1, hit.instanceIndex);
+  EXPECT_NEAR(19.0, hit.distance, 1e-6);
+
+  // the hidden instance can not be picked
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(30, 0, 20), GfVec3d(0, 0, -1)), hit));
+
+  // a frustum around the first instance
+  std::vector<PrimBvh::Hit> hits;
+  bvh.intersectFrustum(GfMatrix4d().SetTranslate(GfVec3d(-10, 0, 0)) * GfMatrix4d().SetScale(0.5), hits);
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(0, hits[0].instanceIndex);
+  EXPECT_TRUE(GfIsClose(hits[0].point, GfVec3d(10, 0, 0), 1e-6));
+
+  // moving the instances refits their bounds
+  instancer.GetPositionsAttr().Set(VtVec3fArray{ GfVec3f(10, 0, 0), GfVec3f(20, 50, 0), GfVec3f(30, 0, 0) });
+  bvh.markDirty(SdfPathVector(), { SdfPath("/instancer.positions") });
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(20, 0, 20), GfVec3d(0, 0, -1)), hit));
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(20, 50, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(1, hit.instanceIndex);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the instances of a point instancer are indexed again when its proto indices change, whether they are edited or
+/// animated
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, pointInstancerProtoIndices)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  defineCube(stage, "/static", GfVec3d(0, 0, 0));
+  UsdGeomPointInstancer instancer = UsdGeomPointInstancer::Define(stage, SdfPath("/instancer"));
+  UsdGeomXform::Define(stage, SdfPath("/instancer/prototypes"));
+  defineCube(stage, "/instancer/prototypes/cube", GfVec3d(0, 0, 0));
+  instancer.CreatePrototypesRel().AddTarget(SdfPath("/instancer/prototypes/cube"));
+  instancer.CreateProtoIndicesAttr(VtValue(VtIntArray{ 0 }));
+  instancer.CreatePositionsAttr(VtValue(VtVec3fArray{ GfVec3f(10, 0, 0) }));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_EQ(2u, bvh.size());
+
+  // adding instances does not resync the stage, but the new instances can be picked
+  PrimBvh::Hit hit;
+  instancer.GetProtoIndicesAttr().Set(VtIntArray{ 0, 0, 0 });
+  instancer.GetPositionsAttr().Set(VtVec3fArray{ GfVec3f(10, 0, 0), GfVec3f(20, 0, 0), GfVec3f(30, 0, 0) });
+  bvh.markDirty(SdfPathVector(), { SdfPath("/instancer.protoIndices"), SdfPath("/instancer.positions") });
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_TRUE(bvh.isValid(stage, purposes));
+  EXPECT_EQ(4u, bvh.size());
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(30, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/instancer/prototypes/cube"), hit.path);
+  EXPECT_EQ(2, hit.instanceIndex);
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(0, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(SdfPath("/static"), hit.path);
+
+  // removing them drops their entries
+  instancer.GetProtoIndicesAttr().Set(VtIntArray{ 0 });
+  bvh.markDirty(SdfPathVector(), { SdfPath("/instancer.protoIndices") });
+  bvh.update(stage, UsdTimeCode::Default(), purposes);
+  EXPECT_EQ(2u, bvh.size());
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(30, 0, 20), GfVec3d(0, 0, -1)), hit));
+
+  // once animated, the proto indices are checked on every change of time
+  instancer.GetProtoIndicesAttr().Set(VtIntArray{ 0 }, UsdTimeCode(1.0));
+  instancer.GetProtoIndicesAttr().Set(VtIntArray{ 0, 0 }, UsdTimeCode(2.0));
+  bvh.markDirty(SdfPathVector(), { SdfPath("/instancer.protoIndices") });
+  bvh.update(stage, UsdTimeCode(1.0), purposes);
+  EXPECT_EQ(2u, bvh.size());
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(20, 0, 20), GfVec3d(0, 0, -1)), hit));
+
+  bvh.update(stage, UsdTimeCode(2.0), purposes);
+  EXPECT_TRUE(bvh.isValid(stage, purposes));
+  EXPECT_EQ(3u, bvh.size());
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(20, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(1, hit.instanceIndex);
+
+  bvh.update(stage, UsdTimeCode(1.0), purposes);
+  EXPECT_EQ(2u, bvh.size());
+  EXPECT_FALSE(bvh.intersectRay(GfRay(GfVec3d(20, 0, 20), GfVec3d(0, 0, -1)), hit));
+  ASSERT_TRUE(bvh.intersectRay(GfRay(GfVec3d(10, 0, 20), GfVec3d(0, 0, -1)), hit));
+  EXPECT_EQ(0, hit.instanceIndex);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// make sure that filtered gprims are ignored during the queries, rather than hiding the gprims behind them
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, filter)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  defineCube(stage, "/root/front", GfVec3d(0, 0, 0));
+  defineCube(stage, "/root/back", GfVec3d(0, 0, -5));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.build(stage, UsdTimeCode::Default(), purposes);
+
+  const PrimBvh::Filter notFront = [](const SdfPath& path) { return path != SdfPath("/root/front"); };
+
+  const GfRay ray(GfVec3d(0, 0, 20), GfVec3d(0, 0, -1));
+  PrimBvh::Hit hit;
+  ASSERT_TRUE(bvh.intersectRay(ray, hit));
+  EXPECT_EQ(SdfPath("/root/front"), hit.path);
+  ASSERT_TRUE(bvh.intersectRay(ray, hit, notFront));
+  EXPECT_EQ(SdfPath("/root/back"), hit.path);
+  EXPECT_NEAR(24.0, hit.distance, 1e-6);
+  EXPECT_FALSE(bvh.intersectRay(ray, hit, [](const SdfPath&) { return false; }));
+
+  const GfMatrix4d viewProjection = GfMatrix4d().SetScale(0.1);
+  std::vector<PrimBvh::Hit> hits;
+  bvh.intersectFrustum(viewProjection, hits, notFront);
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(SdfPath("/root/back"), hits[0].path);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// a frustum that lies within a large face, without containing any of its vertices or crossing any of its edges,
+/// should still select the mesh
+//----------------------------------------------------------------------------------------------------------------------
+TEST(PrimBvh, frustumWithinFace)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh plane = UsdGeomMesh::Define(stage, SdfPath("/plane"));
+  plane.CreatePointsAttr(VtValue(VtVec3fArray{
+    GfVec3f(-50, 0, -50), GfVec3f(50, 0, -50), GfVec3f(50, 0, 50), GfVec3f(-50, 0, 50) }));
+  plane.CreateFaceVertexCountsAttr(VtValue(VtIntArray{ 4 }));
+  plane.CreateFaceVertexIndicesAttr(VtValue(VtIntArray{ 0, 1, 2, 3 }));
+  plane.CreateExtentAttr(VtValue(VtVec3fArray{ GfVec3f(-50, 0, -50), GfVec3f(50, 0, 50) }));
+
+  const TfTokenVector purposes = { UsdGeomTokens->default_ };
+  PrimBvh bvh;
+  bvh.build(stage, UsdTimeCode::Default(), purposes);
+
+  // the unit clip space cube, around the centre of the plane
+  std::vector<PrimBvh::Hit> hits;
+  bvh.intersectFrustum(GfMatrix4d(1.0), hits);
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(SdfPath("/plane"), hits[0].path);
+
+  // the same frustum, moved above the plane
+  hits.clear();
+  bvh.intersectFrustum(GfMatrix4d().SetTranslate(GfVec3d(0, -5, 0)), hits);
+  EXPECT_TRUE(hits.empty());
+}
@@ -36,6 +36,8 @@
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
 
+#include <pxr/base/tf/hashset.h>
+
 #include <fstream>
 #include <set>
 
@@ -326,3 +328,72 @@ TEST(PrimFilter, removedPaths)
     EXPECT_TRUE(filter.transformsToCreate().empty());
   }
 }
+
+/// A mock interface whose lookups are hashed, so that the large hierarchies below do not make the mock quadratic.
+struct HashedMockPrimFilterInterface : public MockPrimFilterInterface
+{
+  TfHashSet<SdfPath, SdfPath::Hash> previousPaths;
+
+  std::string getTranslatorIdForPath(const SdfPath& path) override
+  {
+    return previousPaths.count(path) ? std::string("schematype:Xform") : std::string();
+  }
+};
+
+/// Simulates a variant switch on hierarchies of increasing size: half of the previously translated prims are swapped
+/// out for a new set of prims. The filter should remain linear in the number of prims (see
+/// TranslatorContext.DISABLED_removeEntriesBenchmark for the timings of the removal).
+TEST(PrimFilter, variantSwitchScaling)
+{
+  const size_t primCounts[] = { 1000, 10000, 100000 };
+  const size_t primsPerGroup = 100;
+
+  for(size_t primCount : primCounts)
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    SdfPathVector previous;
+    SdfPathVector current;
+    previous.reserve(primCount);
+    current.reserve(primCount);
+
+    {
+      SdfChangeBlock changeBlock;
+      for(size_t i = 0; i < primCount; ++i)
+      {
+        const SdfPath groupPath(TfStringPrintf("/root/group%zu", i / primsPerGroup));
+        previous.push_back(groupPath.AppendChild(TfToken(TfStringPrintf("old%zu", i))));
+
+        // even prims survive the switch, odd prims are replaced by a prim of the new variant
+        current.push_back((i & 1) ? groupPath.AppendChild(TfToken(TfStringPrintf("new%zu", i))) : previous.back());
+        SdfPrimSpecHandle spec = SdfCreatePrimInLayer(stage->GetRootLayer(), current.back());
+        spec->SetSpecifier(SdfSpecifierDef);
+        spec->SetTypeName("Xform");
+      }
+    }
+
+    std::vector<UsdPrim> prims;
+    prims.reserve(primCount);
+    for(const SdfPath& path : current)
+    {
+      prims.push_back(stage->GetPrimAtPath(path));
+      ASSERT_TRUE(prims.back());
+    }
+
+    HashedMockPrimFilterInterface mockInterface;
+    mockInterface.previousPaths.insert(previous.begin(), previous.end());
+
+    AL::usdmaya::nodes::proxy::PrimFilter filter(previous, prims, &mockInterface, true);
+
+    const size_t removed = primCount / 2;
+    ASSERT_EQ(removed, filter.removedPrimSet().size());
+    EXPECT_EQ(primCount - removed, filter.updatablePrimSet().size());
+    EXPECT_EQ(removed, filter.newPrimSet().size());
+    EXPECT_EQ(removed, filter.transformsToCreate().size());
+
+    // the removed set must remain reverse sorted, so that children are removed before their parents
+    for(size_t i = 1; i < filter.removedPrimSet().size(); ++i)
+    {
+      EXPECT_TRUE(filter.removedPrimSet()[i] < filter.removedPrimSet()[i - 1]);
+    }
+  }
+}
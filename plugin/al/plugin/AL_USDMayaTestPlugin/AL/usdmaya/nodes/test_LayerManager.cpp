@@ -24,11 +24,17 @@
 #include <maya/MGlobal.h>
 #include <maya/MItDependencyNodes.h>
 #include <maya/MSelectionList.h>
+#include <pxr/base/arch/fileSystem.h>
+#include <pxr/base/tf/fileUtils.h>
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/usd/sdf/attributeSpec.h>
 #include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/usd/usdaFileFormat.h>
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdGeom/tokens.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 using AL::maya::test::buildTempPath;
 
@@ -397,6 +403,85 @@ def Scope "blabla"
   { SCOPED_TRACE(""); assertLayersPopulated(); }
 }
 
+TEST(LayerManager, usdcSerialisationRoundTrip)
+{
+  using AL::usdmaya::nodes::LayerManager;
+  constexpr auto LAYER_CONTENTS = R"ESC(#usda 1.0
+
+def Scope "blabla"
+{
+    def Xform "wassup"
+    {
+    }
+}
+
+)ESC";
+
+  MStatus status;
+
+  // The usdc data goes through temporary files, which must not be left behind
+  auto countTempFiles = [] () {
+    const std::vector<std::string> names = TfListDir(ArchGetTmpDir());
+    return std::count_if(names.begin(), names.end(), [] (const std::string& name) {
+      return TfStringStartsWith(TfGetBaseName(name), "AL_usdmaya_layer");
+    });
+  };
+  const auto tempFileCount = countTempFiles();
+
+  MFileIO::newFile(true);
+
+  const auto previousFormat = LayerManager::serialisationFormat();
+  LayerManager::setSerialisationFormat(LayerManager::SerialisationFormat::kUsdc);
+
+  auto *manager = LayerManager::findOrCreateManager();
+  ASSERT_TRUE(manager);
+
+  auto realLayer = SdfLayer::New(
+      SdfFileFormat::FindById(UsdUsdaFileFormatTokens->Id),
+      "/my/usdc/layer.usda");
+  realLayer->ImportFromString(LAYER_CONTENTS);
+  ASSERT_TRUE(manager->addLayer(realLayer));
+
+  auto serializedValue = [&] () {
+    MPlug layersPlug0 = manager->layersPlug().elementByPhysicalIndex(0, &status);
+    MObject tempNonConst = manager->serialized();
+    return std::string(layersPlug0.child(tempNonConst).asString(MDGContext::fsNormal, &status).asChar());
+  };
+
+  manager->populateSerialisationAttributes();
+  ASSERT_EQ(1u, manager->layersPlug().evaluateNumElements());
+  EXPECT_EQ(1u, manager->lastSerialisedLayerCount());
+  const std::string firstSave = serializedValue();
+  EXPECT_TRUE(TfStringStartsWith(firstSave, "usdc;lz4;base64,"));
+
+  // Saving again an unchanged layer skips it and keeps the same data, an edited layer is serialised again
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(0u, manager->lastSerialisedLayerCount());
+  EXPECT_EQ(firstSave, serializedValue());
+  realLayer->GetPrimAtPath(SdfPath("/blabla"))->SetComment("edited");
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(1u, manager->lastSerialisedLayerCount());
+  EXPECT_NE(firstSave, serializedValue());
+
+  // Once the attributes are cleared, there is nothing left to reuse
+  manager->clearSerialisationAttributes();
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(1u, manager->lastSerialisedLayerCount());
+
+  // Loading the layers restores the saved contents
+  realLayer->RemoveRootPrim(realLayer->GetPrimAtPath(SdfPath("/blabla")));
+  ASSERT_FALSE(realLayer->GetPrimAtPath(SdfPath("/blabla/wassup")));
+  manager->loadAllLayers();
+  SdfLayerHandle loadedLayer = manager->findLayer("/my/usdc/layer.usda");
+  ASSERT_TRUE(loadedLayer);
+  EXPECT_TRUE(loadedLayer->GetPrimAtPath(SdfPath("/blabla/wassup")));
+  EXPECT_EQ("edited", loadedLayer->GetPrimAtPath(SdfPath("/blabla"))->GetComment());
+  EXPECT_EQ(tempFileCount, countTempFiles());
+
+  manager->clearSerialisationAttributes();
+  LayerManager::setSerialisationFormat(previousFormat);
+}
+
 TEST(LayerManager, simpleSaveRestore)
 {
   MFileIO::newFile(true);
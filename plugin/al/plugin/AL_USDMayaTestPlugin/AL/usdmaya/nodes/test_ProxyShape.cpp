@@ -30,10 +30,12 @@
 #include <maya/MStringArray.h>
 #include <maya/MCommonSystemUtils.h>
 
+#include <pxr/usd/sdf/payload.h>
 #include <pxr/usd/sdf/types.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/usdaFileFormat.h>
+#include <pxr/usd/usdGeom/cube.h>
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
@@ -1141,7 +1143,61 @@ TEST(ProxyShape, destroyTransformReferences)
 // MBoundingBox boundingBox() const override;
 TEST(ProxyShape, boundingBox)
 {
-  AL_USDMAYA_UNTESTED;
+  MFileIO::newFile(true);
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_boundingBox.usda");
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    UsdGeomXform::Define(stage, SdfPath("/root/a"));
+    UsdGeomXform::Define(stage, SdfPath("/root/b"));
+    UsdGeomXformCommonAPI(stage->GetPrimAtPath(SdfPath("/root/a"))).SetTranslate(GfVec3d(10.0, 0.0, 0.0));
+
+    VtVec3fArray extent(2);
+    extent[0] = GfVec3f(-1.0f);
+    extent[1] = GfVec3f(1.0f);
+    UsdGeomCube::Define(stage, SdfPath("/root/a/cube")).CreateExtentAttr(VtValue(extent));
+    UsdGeomCube::Define(stage, SdfPath("/root/b/cube")).CreateExtentAttr(VtValue(extent));
+    stage->Export(temp_path, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+
+  auto expectBounds = [proxy] (const MPoint& expectedMin, const MPoint& expectedMax)
+  {
+    const MBoundingBox box = proxy->boundingBox();
+    EXPECT_TRUE(box.min().isEquivalent(expectedMin));
+    EXPECT_TRUE(box.max().isEquivalent(expectedMax));
+  };
+
+  expectBounds(MPoint(-1.0, -1.0, -1.0), MPoint(11.0, 1.0, 1.0));
+
+  // moving a prim must update the bounds of its ancestors
+  UsdGeomXformCommonAPI(stage->GetPrimAtPath(SdfPath("/root/b"))).SetTranslate(GfVec3d(0.0, -5.0, 0.0));
+  expectBounds(MPoint(-1.0, -6.0, -1.0), MPoint(11.0, 1.0, 1.0));
+
+  // changing the extent of a gprim
+  VtVec3fArray extent(2);
+  extent[0] = GfVec3f(-2.0f);
+  extent[1] = GfVec3f(2.0f);
+  UsdGeomCube(stage->GetPrimAtPath(SdfPath("/root/a/cube"))).GetExtentAttr().Set(extent);
+  expectBounds(MPoint(-1.0, -6.0, -2.0), MPoint(12.0, 2.0, 2.0));
+
+  // hiding a subtree
+  UsdGeomImageable(stage->GetPrimAtPath(SdfPath("/root/b"))).MakeInvisible();
+  expectBounds(MPoint(8.0, -2.0, -2.0), MPoint(12.0, 2.0, 2.0));
+
+  // deactivating a prim
+  stage->GetPrimAtPath(SdfPath("/root/a/cube")).SetActive(false);
+  UsdGeomImageable(stage->GetPrimAtPath(SdfPath("/root/b"))).MakeVisible();
+  expectBounds(MPoint(-1.0, -6.0, -1.0), MPoint(1.0, -4.0, 1.0));
 }
 
 // std::vector<UsdPrim> huntForNativeNodesUnderPrim(const MDagPath& proxyTransformPath, SdfPath startPath);
@@ -1286,6 +1342,61 @@ TEST(ProxyShape, relativePathSupport)
   MFileIO::newFile(true);
 }
 
+// payloadStreaming. The AL_USDMaya test run sets MAYAUSD_PAYLOAD_STREAMING_NON_INTERACTIVE, so that the attribute
+// applies in batch.
+TEST(ProxyShape, payloadStreaming)
+{
+  MFileIO::newFile(true);
+
+  const std::string payloadPath = buildTempPath("AL_USDMayaTests_payloadStreaming_payload.usda");
+  const std::string rootPath = buildTempPath("AL_USDMayaTests_payloadStreaming.usda");
+  const SdfPath modelPath("/root/model");
+  const SdfPath cubePath("/root/model/cube");
+  {
+    UsdStageRefPtr payloadStage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(payloadStage, modelPath);
+    UsdGeomCube::Define(payloadStage, cubePath);
+    payloadStage->Export(payloadPath, false);
+
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, SdfPath("/root"));
+    UsdPrim model = UsdGeomXform::Define(stage, modelPath).GetPrim();
+    model.GetPayloads().AddPayload(SdfPayload(payloadPath, modelPath));
+    stage->Export(rootPath, false);
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  MPlug payloadStreamingPlug(shape, MayaUsdProxyShapeBase::payloadStreamingAttr);
+
+  // a streamed stage is opened without any payload loaded, the streamer loads them afterwards
+  EXPECT_TRUE(payloadStreamingPlug.setValue(true));
+  proxy->filePathPlug().setString(rootPath.c_str());
+  UsdStageRefPtr stage = proxy->getUsdStage();
+  ASSERT_TRUE(stage);
+  EXPECT_TRUE(stage->GetLoadSet().empty());
+  EXPECT_FALSE(stage->GetPrimAtPath(cubePath));
+
+  // turning streaming off loads all the payloads of the same stage
+  EXPECT_TRUE(payloadStreamingPlug.setValue(false));
+  EXPECT_EQ(stage, proxy->getUsdStage());
+  EXPECT_EQ(SdfPathSet({ modelPath }), stage->GetLoadSet());
+  EXPECT_TRUE(stage->GetPrimAtPath(cubePath));
+
+  // and turning it back on unloads them, until the streamer loads them again
+  EXPECT_TRUE(payloadStreamingPlug.setValue(true));
+  EXPECT_TRUE(stage->GetLoadSet().empty());
+
+  // once streaming is turned off, the payloads follow the unloaded attribute again
+  EXPECT_TRUE(proxy->unloadedPlug().setValue(true));
+  EXPECT_TRUE(payloadStreamingPlug.setValue(false));
+  EXPECT_TRUE(stage->GetLoadSet().empty());
+
+  MFileIO::newFile(true);
+}
+
 // duplication
 TEST(ProxyShape, duplication)
 {
@@ -1325,6 +1325,92 @@ TEST(Transform, getTimeCode)
   }
 }
 
+// Check that an op that was static when the transform was created is read as animated once time samples are added
+// to it, i.e. that the cached xform op queries are refreshed by ObjectsChanged notices.
+TEST(Transform, staticOpBecomesAnimated)
+{
+  auto constructTransformChain = [] ()
+  {
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform a = UsdGeomXform::Define(stage, SdfPath("/tm"));
+    UsdGeomXformOp translate = a.AddTranslateOp(UsdGeomXformOp::PrecisionDouble);
+    translate.Set(GfVec3d(1.0, 2.0, 3.0));
+    return stage;
+  };
+
+  MFileIO::newFile(true);
+
+  // In 'off' (DG) mode, setCurrentTime does not seem to trigger an eval.
+  // Force it to 'parallel' for now.
+  MGlobal::executeCommand(MString("evaluationManager -mode \"parallel\";"));
+
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_transform_staticOpBecomesAnimated.usda");
+
+  // generate some data for the proxy shape
+  {
+    auto stage = constructTransformChain();
+    stage->Export(temp_path, false);
+  }
+  MAnimControl::setCurrentTime(MTime(0, MTime::uiUnit()));
+
+  {
+    MFnDagNode fn;
+    MObject xform = fn.create("transform");
+    MObject shape = fn.create("AL_usdmaya_ProxyShape", xform);
+
+    AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+
+    {
+      MGlobal::executeCommand(MString("connectAttr -f \"time1.outTime\" \"") +  fn.name() + ".time\";");
+    }
+
+    // force the stage to load
+    proxy->filePathPlug().setString(temp_path.c_str());
+
+    auto stage = proxy->getUsdStage();
+
+    MDagModifier modifier1;
+    MDGModifier modifier2;
+
+    // construct a chain of transform nodes
+    MObject leafNode = proxy->makeUsdTransforms(stage->GetPrimAtPath(SdfPath("/tm")), modifier1, AL::usdmaya::nodes::ProxyShape::kRequested, &modifier2);
+
+    EXPECT_FALSE(leafNode == MObject::kNullObj);
+    EXPECT_EQ(MStatus(MS::kSuccess), modifier1.doIt());
+    EXPECT_EQ(MStatus(MS::kSuccess), modifier2.doIt());
+
+    MFnTransform fnx(leafNode);
+    AL::usdmaya::nodes::Transform* transformNode = (AL::usdmaya::nodes::Transform*)fnx.userNode();
+    AL::usdmaya::nodes::TransformationMatrix* transformMatrix = transformNode->getTransMatrix();
+
+    transformNode->pushToPrimPlug().setValue(false);
+    transformNode->readAnimatedValuesPlug().setValue(true);
+    EXPECT_FALSE(transformMatrix->hasAnimatedTranslation());
+
+    // if we don't re-enable the refresh for this test, the scene won't get updated when calling view frame
+    if(MGlobal::kInteractive == MGlobal::mayaState())
+      MGlobal::executeCommand("refresh -suspend false");
+
+    UsdGeomXform usd_xform(stage->GetPrimAtPath(SdfPath("/tm")));
+    bool reset;
+    std::vector<UsdGeomXformOp> ops = usd_xform.GetOrderedXformOps(&reset);
+    ASSERT_EQ(1u, ops.size());
+    ops[0].Set(GfVec3d(10.0, 20.0, 30.0), UsdTimeCode(1));
+    ops[0].Set(GfVec3d(20.0, 40.0, 60.0), UsdTimeCode(2));
+
+    MAnimControl::setCurrentTime(MTime(2, MTime::uiUnit()));
+
+    MVector translation = fnx.getTranslation(MSpace::kTransform);
+    EXPECT_TRUE(transformMatrix->hasAnimatedTranslation());
+    EXPECT_NEAR(20.0, translation.x, 1e-5);
+    EXPECT_NEAR(40.0, translation.y, 1e-5);
+    EXPECT_NEAR(60.0, translation.z, 1e-5);
+
+    if(MGlobal::kInteractive == MGlobal::mayaState())
+      MGlobal::executeCommand("refresh -suspend true");
+  }
+}
+
 // Need to test the behaviour of the transform node when the animation data present is from Matrices rather than
 // TRS components.
 TEST(Transform, matrixAnimationChannels)
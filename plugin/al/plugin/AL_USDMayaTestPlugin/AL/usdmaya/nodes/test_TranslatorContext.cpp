@@ -25,12 +25,16 @@
 #include <maya/MDagModifier.h>
 #include <maya/MFileIO.h>
 
+#include <pxr/base/tf/stringUtils.h>
 #include <pxr/usd/usd/stage.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/primSpec.h>
 #include <pxr/usd/sdf/types.h>
 #include <pxr/usd/usd/attribute.h>
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
+#include <chrono>
 #include <fstream>
 
 using AL::maya::test::buildTempPath;
@@ -263,14 +267,213 @@ TEST(TranslatorContext, TranslatorContext)
 }
 
 
+// bool TranslatorContext::addExcludedGeometry(const SdfPath& newPath);
+// bool TranslatorContext::removeExcludedGeometry(const SdfPath& newPath);
+// bool TranslatorContext::isExcludedGeometryDirty();
+// void TranslatorContext::clearExcludedGeometryDirty();
+TEST(TranslatorContext, excludedGeometry)
+{
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_excludedGeometry.usda");
+  {
+    std::ofstream os(temp_path);
+    os << "#usda 1.0\n"
+          "def Xform \"root\"\n"
+          "{\n"
+          "    def Scope \"geo1\"\n"
+          "    {\n"
+          "    }\n"
+          "    def Scope \"geo2\"\n"
+          "    {\n"
+          "    }\n"
+          "}\n";
+  }
+
+  MFileIO::newFile(true);
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  ASSERT_TRUE(proxy->getUsdStage());
+
+  AL::usdmaya::fileio::translators::TranslatorContextPtr context = proxy->context();
+  AL::usdmaya::fileio::translators::TranslatorParameters params;
+  EXPECT_FALSE(context->isExcludedGeometryDirty());
+
+  // adding geometry flags the exclusions as dirty until the proxy shape has pushed them to the imaging engine
+  EXPECT_TRUE(context->addExcludedGeometry(SdfPath("/root/geo1")));
+  EXPECT_FALSE(context->addExcludedGeometry(SdfPath("/root/geo1")));
+  EXPECT_TRUE(context->isExcludedGeometryDirty());
+  proxy->translatePrimsIntoMaya(UsdPrimVector(), SdfPathVector(), params);
+  EXPECT_FALSE(context->isExcludedGeometryDirty());
+  EXPECT_EQ(1u, context->excludedGeometry().size());
+
+  // as does removing it
+  EXPECT_TRUE(context->addExcludedGeometry(SdfPath("/root/geo2")));
+  EXPECT_TRUE(context->removeExcludedGeometry(SdfPath("/root/geo1")));
+  EXPECT_FALSE(context->removeExcludedGeometry(SdfPath("/root/geo1")));
+  EXPECT_TRUE(context->isExcludedGeometryDirty());
+  proxy->translatePrimsIntoMaya(UsdPrimVector(), SdfPathVector(), params);
+  EXPECT_FALSE(context->isExcludedGeometryDirty());
+  ASSERT_EQ(1u, context->excludedGeometry().size());
+  EXPECT_EQ(SdfPath("/root/geo2"), context->excludedGeometry().begin()->first);
+}
+
+namespace {
+
+/// creates a proxy shape on a stage holding only a root prim, so that prims registered in its context are not
+/// translated by the proxy shape itself
+AL::usdmaya::nodes::ProxyShape* createEmptyProxyShape(const char* fileName)
+{
+  const std::string temp_path = buildTempPath(fileName);
+  {
+    std::ofstream os(temp_path);
+    os << "#usda 1.0\n"
+          "def Xform \"root\"\n"
+          "{\n"
+          "}\n";
+  }
+
+  MFileIO::newFile(true);
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  return proxy;
+}
+
+/// defines untranslated Xform prims at the given paths in a new in memory stage
+UsdStageRefPtr createXformStage(const SdfPathVector& paths)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  SdfChangeBlock changeBlock;
+  for(const SdfPath& path : paths)
+  {
+    SdfPrimSpecHandle spec = SdfCreatePrimInLayer(stage->GetRootLayer(), path);
+    spec->SetSpecifier(SdfSpecifierDef);
+    spec->SetTypeName("Xform");
+  }
+  return stage;
+}
+
+} // anon
+
+// void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& itemsToRemove, bool callPreUnload=true);
+// void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove);
+TEST(TranslatorContext, removeEntries)
+{
+  AL::usdmaya::nodes::ProxyShape* proxy = createEmptyProxyShape("AL_USDMayaTests_removeEntries.usda");
+  ASSERT_TRUE(proxy->getUsdStage());
+  AL::usdmaya::fileio::translators::TranslatorContextPtr context = proxy->context();
+
+  const SdfPath a("/root/a"), ax("/root/a/x"), ay("/root/a/y"), ab("/root/ab"), b("/root/b"), bz("/root/b/z");
+  UsdStageRefPtr stage = createXformStage({ a, ax, ay, ab, b, bz });
+  for(const UsdPrim& prim : stage->Traverse())
+  {
+    context->registerItem(prim, MObjectHandle());
+  }
+  for(const SdfPath& path : { a, ax, ay, ab, b, bz })
+  {
+    EXPECT_FALSE(context->getTranslatorIdForPath(path).empty());
+  }
+
+  // the entries beneath a path are queued children first, and a sibling sharing the prefix of its name is left alone
+  SdfPathVector itemsToRemove;
+  context->preRemoveEntry(a, itemsToRemove, false);
+  EXPECT_EQ(SdfPathVector({ ay, ax, a }), itemsToRemove);
+
+  // paths that are already queued are not queued again
+  context->preRemoveEntry(ax, itemsToRemove, false);
+  context->preRemoveEntry(a, itemsToRemove, false);
+  EXPECT_EQ(3u, itemsToRemove.size());
+
+  context->preRemoveEntry(b, itemsToRemove, false);
+  EXPECT_EQ(SdfPathVector({ ay, ax, a, bz, b }), itemsToRemove);
+
+  context->removeEntries(itemsToRemove);
+  for(const SdfPath& path : itemsToRemove)
+  {
+    EXPECT_TRUE(context->getTranslatorIdForPath(path).empty());
+  }
+  EXPECT_FALSE(context->getTranslatorIdForPath(ab).empty());
+  EXPECT_FALSE(context->getTranslatorIdForPath(SdfPath("/root")).empty());
+
+  // removing entries that have already gone, or duplicated entries, is harmless
+  context->removeEntries(itemsToRemove);
+  context->removeEntries({ ab, ab });
+  EXPECT_TRUE(context->getTranslatorIdForPath(ab).empty());
+  EXPECT_FALSE(context->getTranslatorIdForPath(SdfPath("/root")).empty());
+}
+
+/// Times the removal of the entries of a variant switch, which replaces every other group of prims, on 1k, 10k and
+/// 100k prims. The timings (in microseconds) are recorded as properties of the test in the XML report rather than
+/// printed. Disabled by default, run it with:
+///   AL_maya_test_UnitTestHarness -filter "*Benchmark*" -flag_file <file containing --gtest_also_run_disabled_tests>
+///       -output "xml:<report path>"
+TEST(TranslatorContext, DISABLED_removeEntriesBenchmark)
+{
+  AL::usdmaya::nodes::ProxyShape* proxy = createEmptyProxyShape("AL_USDMayaTests_removeEntriesBenchmark.usda");
+  ASSERT_TRUE(proxy->getUsdStage());
+  AL::usdmaya::fileio::translators::TranslatorContextPtr context = proxy->context();
+
+  const size_t primCounts[] = { 1000, 10000, 100000 };
+  const size_t primsPerGroup = 100;
+  for(size_t primCount : primCounts)
+  {
+    SdfPathVector paths;
+    SdfPathVector switchedGroups;
+    paths.reserve(primCount + primCount / primsPerGroup);
+    for(size_t i = 0; i < primCount; ++i)
+    {
+      const SdfPath groupPath(TfStringPrintf("/root/group%zu", i / primsPerGroup));
+      if(i % primsPerGroup == 0)
+      {
+        paths.push_back(groupPath);
+        if((i / primsPerGroup) & 1)
+          switchedGroups.push_back(groupPath);
+      }
+      paths.push_back(groupPath.AppendChild(TfToken(TfStringPrintf("prim%zu", i))));
+    }
+
+    UsdStageRefPtr stage = createXformStage(paths);
+    context->clearPrimMappings();
+    for(const SdfPath& path : paths)
+    {
+      context->registerItem(stage->GetPrimAtPath(path), MObjectHandle());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    SdfPathVector itemsToRemove;
+    for(const SdfPath& group : switchedGroups)
+    {
+      context->preRemoveEntry(group, itemsToRemove, false);
+    }
+    const auto queued = std::chrono::steady_clock::now();
+    context->removeEntries(itemsToRemove);
+    const auto end = std::chrono::steady_clock::now();
+
+    const size_t removed = switchedGroups.size() * (primsPerGroup + 1);
+    EXPECT_EQ(removed, itemsToRemove.size());
+    EXPECT_TRUE(context->getTranslatorIdForPath(switchedGroups.front()).empty());
+    EXPECT_FALSE(context->getTranslatorIdForPath(SdfPath("/root/group0")).empty());
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    RecordProperty(TfStringPrintf("preRemoveEntry_%zu", primCount),
+                   int(duration_cast<microseconds>(queued - start).count()));
+    RecordProperty(TfStringPrintf("removeEntries_%zu", primCount),
+                   int(duration_cast<microseconds>(end - queued).count()));
+  }
+  context->clearPrimMappings();
+}
+
 // TranslatorContext::~TranslatorContext();
 // void TranslatorContext::updatePrimTypes();
 // void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object);
 // void TranslatorContext::validatePrims();
 // bool TranslatorContext::hasEntry(const SdfPath& path, const TfToken& type);
 // void TranslatorContext::addEntry(const SdfPath& primPath, const MObject& primObj);
-// void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& itemsToRemove, bool callPreUnload=true);
-// void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove);
 TEST(SchemaNodeRefDB, addRemoveEntries)
 {
   AL_USDMAYA_UNTESTED;
@@ -88,3 +88,46 @@ TEST(SelectabilityDB, removePaths)
     EXPECT_TRUE(unselectablePaths.size() == 1);
   }
 }
+
+/*
+ * Test that the memoized selectability of a subtree is updated when an ancestor changes
+ */
+// bool SelectableDB::isPathUnselectable(const SdfPath& path)
+// void SelectableDB::replaceUnselectablePathsInSubtree(const SdfPath& root, const SdfPathVector& paths)
+TEST(SelectabilityDB, resolvedPathsUpdated)
+{
+  SdfPath rootPath        ("/A");
+  SdfPath childPath       ("/A/B");
+  SdfPath grandchildPath  ("/A/B/C");
+  SdfPath secondChildPath ("/A/D");
+  SdfPath otherRootPath   ("/E");
+
+  SelectabilityDB selectable;
+  {
+    selectable.addPathAsUnselectable(otherRootPath);
+    EXPECT_FALSE(selectable.isPathUnselectable(grandchildPath));
+    EXPECT_FALSE(selectable.isPathUnselectable(secondChildPath));
+
+    // changing the parent updates the resolved children
+    selectable.addPathAsUnselectable(rootPath);
+    EXPECT_TRUE(selectable.isPathUnselectable(grandchildPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(secondChildPath));
+
+    selectable.removePathAsUnselectable(rootPath);
+    EXPECT_FALSE(selectable.isPathUnselectable(grandchildPath));
+    EXPECT_FALSE(selectable.isPathUnselectable(secondChildPath));
+
+    // replacing a subtree leaves the paths outside of it untouched
+    selectable.addPathAsUnselectable(secondChildPath);
+    selectable.replaceUnselectablePathsInSubtree(childPath, SdfPathVector{ grandchildPath });
+    EXPECT_FALSE(selectable.isPathUnselectable(childPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(grandchildPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(secondChildPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(otherRootPath));
+
+    selectable.replaceUnselectablePathsInSubtree(childPath, SdfPathVector());
+    EXPECT_FALSE(selectable.isPathUnselectable(grandchildPath));
+    EXPECT_TRUE(selectable.isPathUnselectable(secondChildPath));
+    EXPECT_EQ(2u, selectable.getUnselectablePaths().size());
+  }
+}
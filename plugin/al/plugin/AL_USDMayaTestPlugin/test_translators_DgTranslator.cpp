@@ -24,6 +24,7 @@
 #include <maya/MFloatMatrix.h>
 #include <maya/MFloatPoint.h>
 #include <maya/MFloatVector.h>
+#include <maya/MFnAnimCurve.h>
 #include <maya/MFnAttribute.h>
 #include <maya/MFnData.h>
 #include <maya/MFnDependencyNode.h>
@@ -40,8 +41,10 @@
 #include <maya/MTime.h>
 #include <maya/MVector.h>
 
+#include <pxr/usd/sdf/layer.h>
 #include <pxr/usd/sdf/types.h>
 #include <pxr/usd/usd/attribute.h>
+#include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdGeom/xformCommonAPI.h>
 
@@ -1153,6 +1156,88 @@ TEST(translators_DgNodeTranslator, float_test)
   EXPECT_EQ(orig, result);
 }
 
+// static MStatus setFloatAttrAnims(const std::vector<FloatAttrAnim>& anims, MObjectArray* newAnimCurves);
+TEST(translators_DgNodeTranslator, float_attr_anims)
+{
+  setUp();
+  const uint32_t flags = kCached | kReadable | kWritable | kStorable | kConnectable | kKeyable;
+  EXPECT_EQ(MStatus(MS::kSuccess), NodeHelper::addFloatAttr(m_node, "animFloatA", "afa", 0.0f, flags));
+  EXPECT_EQ(MStatus(MS::kSuccess), NodeHelper::addFloatAttr(m_node, "animFloatB", "afb", 0.0f, flags));
+
+  // the samples of the first attribute are authored in the root layer, and read straight from its time sample map,
+  // whereas those of the second attribute are authored in a sub layer offset by 10 frames, and resolved one at a time
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  SdfLayerRefPtr subLayer = SdfLayer::CreateAnonymous();
+  stage->GetRootLayer()->InsertSubLayerPath(subLayer->GetIdentifier());
+  stage->GetRootLayer()->SetSubLayerOffset(SdfLayerOffset(10.0), 0);
+
+  UsdPrim prim = stage->DefinePrim(SdfPath("/prim"));
+  UsdAttribute attrA = prim.CreateAttribute(TfToken("a"), SdfValueTypeNames->Float);
+  const uint32_t numKeys = 100;
+  for(uint32_t i = 0; i < numKeys; ++i)
+  {
+    attrA.Set(float(i), UsdTimeCode(i));
+  }
+
+  // the sub layer's samples are authored in its own time, which the offset maps to stage times 10 frames later
+  stage->SetEditTarget(UsdEditTarget(subLayer));
+  UsdAttribute attrB = prim.CreateAttribute(TfToken("b"), SdfValueTypeNames->Float);
+  for(uint32_t i = 0; i < numKeys; ++i)
+  {
+    subLayer->SetTimeSample(attrB.GetPath(), double(i), float(i));
+  }
+  stage->SetEditTarget(UsdEditTarget(stage->GetRootLayer()));
+  ASSERT_EQ(size_t(numKeys), stage->GetRootLayer()->GetNumTimeSamplesForPath(attrA.GetPath()));
+  ASSERT_EQ(size_t(0), subLayer->GetNumTimeSamplesForPath(attrA.GetPath()));
+
+  std::vector<DgNodeTranslator::FloatAttrAnim> anims;
+  anims.push_back({m_node, findAttribute("animFloatA"), attrA, 2.0});
+  anims.push_back({m_node, findAttribute("animFloatB"), attrB, 0.5});
+  MObjectArray newAnimCurves;
+  EXPECT_EQ(MStatus(MS::kSuccess), DgNodeTranslator::setFloatAttrAnims(anims, &newAnimCurves));
+  EXPECT_EQ(2u, newAnimCurves.length());
+
+  MFnAnimCurve curveA(MPlug(m_node, findAttribute("animFloatA")));
+  MFnAnimCurve curveB(MPlug(m_node, findAttribute("animFloatB")));
+  ASSERT_EQ(numKeys, curveA.numKeys());
+  ASSERT_EQ(numKeys, curveB.numKeys());
+  for(uint32_t i = 0; i < numKeys; ++i)
+  {
+    EXPECT_NEAR(double(i), curveA.time(i).as(MTime::kFilm), 1e-5);
+    EXPECT_NEAR(2.0 * i, curveA.value(i), 1e-5);
+    EXPECT_NEAR(double(i + 10), curveB.time(i).as(MTime::kFilm), 1e-5);
+    EXPECT_NEAR(0.5 * i, curveB.value(i), 1e-5);
+  }
+}
+
+// static MStatus setFloatAttrAnims(const std::vector<FloatAttrAnim>& anims, MObjectArray* newAnimCurves);
+TEST(translators_DgNodeTranslator, float_attr_anims_without_samples)
+{
+  setUp();
+  const uint32_t flags = kCached | kReadable | kWritable | kStorable | kConnectable | kKeyable;
+  EXPECT_EQ(MStatus(MS::kSuccess), NodeHelper::addFloatAttr(m_node, "animFloatC", "afc", 0.0f, flags));
+  EXPECT_EQ(MStatus(MS::kSuccess), NodeHelper::addFloatAttr(m_node, "animFloatD", "afd", 0.0f, flags));
+
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdPrim prim = stage->DefinePrim(SdfPath("/prim"));
+  UsdAttribute attrC = prim.CreateAttribute(TfToken("c"), SdfValueTypeNames->Float);
+  UsdAttribute attrD = prim.CreateAttribute(TfToken("d"), SdfValueTypeNames->Float);
+  attrC.Set(1.0f);
+  attrD.Set(1.0f, UsdTimeCode(1.0));
+  attrD.Set(2.0f, UsdTimeCode(2.0));
+
+  // as with setFloatAttrAnim, the attribute without samples fails without preventing the other curve's creation
+  std::vector<DgNodeTranslator::FloatAttrAnim> anims;
+  anims.push_back({m_node, findAttribute("animFloatC"), attrC, 1.0});
+  anims.push_back({m_node, findAttribute("animFloatD"), attrD, 1.0});
+  MObjectArray newAnimCurves;
+  EXPECT_EQ(MStatus(MS::kFailure), DgNodeTranslator::setFloatAttrAnims(anims, &newAnimCurves));
+  EXPECT_EQ(1u, newAnimCurves.length());
+  EXPECT_FALSE(MPlug(m_node, findAttribute("animFloatC")).isConnected());
+  MFnAnimCurve curveD(MPlug(m_node, findAttribute("animFloatD")));
+  EXPECT_EQ(2u, curveD.numKeys());
+}
+
 // static MStatus getDouble(MObject node, MObject attr, double& value);
 // static MStatus setDouble(MObject node, MObject attr, double value);
 TEST(translators_DgNodeTranslator, double_test)
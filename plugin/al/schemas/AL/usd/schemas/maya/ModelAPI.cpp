@@ -127,14 +127,13 @@ void AL_usd_ModelAPI::SetSelectability(const TfToken& selectability)
 TfToken AL_usd_ModelAPI::ComputeHierarchical(const UsdPrim& prim,
                                              const ComputeLogic& logic) const
 {
+  // Walk up the hierarchy iteratively, stopping at the first prim that defines the value.
   TfToken value;
-  bool keepLooking = logic(prim, value);
-
-  if(keepLooking)
+  for (UsdPrim current = prim; current; current = current.GetParent())
   {
-    if (UsdPrim parent = prim.GetParent())
+    if (!logic(current, value))
     {
-      return ComputeHierarchical(parent, logic);
+      break;
     }
   }
 
@@ -118,6 +118,9 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
 
   NewNodesCollector collector{context(), prim};
 
+  // the animated attributes are read from USD together, and their curves created in one batch
+  std::vector<DgNodeTranslator::FloatAttrAnim> anims;
+
   // Horizontal film aperture
   auto horizontalApertureAttr = usdCamera.GetHorizontalApertureAttr();
   if(!horizontalApertureAttr.GetNumTimeSamples() || forceDefaultRead)
@@ -128,11 +131,7 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
   }
   else
   {
-    DgNodeTranslator::setFloatAttrAnim(to,
-                                       m_horizontalFilmAperture,
-                                       horizontalApertureAttr,
-                                       mm_to_inches,
-                                       collector.nodeContainerPtr());
+    anims.push_back({to, m_horizontalFilmAperture, horizontalApertureAttr, mm_to_inches});
   }
 
   // Vertical film aperture
@@ -145,11 +144,7 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
   }
   else
   {
-    DgNodeTranslator::setFloatAttrAnim(to,
-                                       m_verticalFilmAperture,
-                                       verticalApertureAttr,
-                                       mm_to_inches,
-                                       collector.nodeContainerPtr());
+    anims.push_back({to, m_verticalFilmAperture, verticalApertureAttr, mm_to_inches});
   }
 
   // Horizontal film aperture offset
@@ -162,11 +157,7 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
   }
   else
   {
-    DgNodeTranslator::setFloatAttrAnim(to,
-                                       m_horizontalFilmApertureOffset,
-                                       horizontalApertureOffsetAttr,
-                                       mm_to_inches,
-                                       collector.nodeContainerPtr());
+    anims.push_back({to, m_horizontalFilmApertureOffset, horizontalApertureOffsetAttr, mm_to_inches});
   }
 
   // Vertical film aperture offset
@@ -179,11 +170,7 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
   }
   else
   {
-    DgNodeTranslator::setFloatAttrAnim(to,
-                                       m_verticalFilmApertureOffset,
-                                       verticalApertureOffsetAttr,
-                                       mm_to_inches,
-                                       collector.nodeContainerPtr());
+    anims.push_back({to, m_verticalFilmApertureOffset, verticalApertureOffsetAttr, mm_to_inches});
   }
 
   // Focal length
@@ -196,7 +183,7 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
   }
   else
   {
-    DgNodeTranslator::setFloatAttrAnim(to, m_focalLength, focalLengthAttr, 1.0f, collector.nodeContainerPtr());
+    anims.push_back({to, m_focalLength, focalLengthAttr, 1.0f});
   }
 
   // Near/far clip planes
@@ -213,6 +200,11 @@ MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
     DgNodeTranslator::setClippingRangeAttrAnim(to, m_nearDistance, m_farDistance, clippingRangeAttr, collector.nodeContainerPtr());
   }
 
+  if(!anims.empty())
+  {
+    DgNodeTranslator::setFloatAttrAnims(anims, collector.nodeContainerPtr());
+  }
+
   return MS::kSuccess;
 }
 
@@ -20,6 +20,7 @@
 #include <mayaUsdUtils/SIMD.h>
 
 #include <maya/MDGModifier.h>
+#include <maya/MDoubleArray.h>
 #include <maya/MFloatArray.h>
 #include <maya/MFloatMatrix.h>
 #include <maya/MFnCompoundAttribute.h>
@@ -33,12 +34,129 @@
 #include <maya/MMatrix.h>
 #include <maya/MMatrixArray.h>
 #include <maya/MObjectArray.h>
+#include <maya/MTimeArray.h>
+
+#include <pxr/base/work/loops.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/schema.h>
+#include <pxr/usd/usd/attributeQuery.h>
+#include <pxr/usd/usd/resolveInfo.h>
 
 #include <iostream>
 
 namespace AL {
 namespace usdmaya {
 namespace utils {
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+bool extractValue(const VtValue& value, T& result)
+{
+  if(value.IsHolding<T>())
+  {
+    result = value.UncheckedGet<T>();
+    return true;
+  }
+  if(value.CanCast<T>())
+  {
+    result = VtValue::Cast<T>(value).UncheckedGet<T>();
+    return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Reads all the time samples of an attribute. When the samples come straight from the time sample map of the
+/// strongest spec (no layer offset, no value clips), the values are copied from that map rather than resolved one
+/// time code at a time.
+template<typename T>
+void readTimeSamples(const UsdAttribute& attr, std::vector<double>& times, std::vector<T>& values)
+{
+  times.clear();
+  values.clear();
+
+  UsdAttributeQuery query(attr);
+  std::vector<double> sampleTimes;
+  if(!query.GetTimeSamples(&sampleTimes) || sampleTimes.empty())
+    return;
+
+  times.reserve(sampleTimes.size());
+  values.reserve(sampleTimes.size());
+
+  T value;
+  if(attr.GetResolveInfo(UsdTimeCode::EarliestTime()).GetSource() == UsdResolveInfoSourceTimeSamples)
+  {
+    for(const SdfPropertySpecHandle& propSpec : attr.GetPropertyStack())
+    {
+      SdfAttributeSpecHandle attrSpec = TfDynamic_cast<SdfAttributeSpecHandle>(propSpec);
+      if(!attrSpec || !attrSpec->HasInfo(SdfFieldKeys->TimeSamples))
+        continue;
+
+      // a layer offset would map the authored times to different stage times
+      const SdfTimeSampleMap samples = attrSpec->GetTimeSampleMap();
+      const bool sameTimes = samples.size() == sampleTimes.size() &&
+          std::equal(samples.begin(), samples.end(), sampleTimes.begin(),
+                     [](const SdfTimeSampleMap::value_type& sample, double time) { return sample.first == time; });
+      if(!sameTimes)
+        break;
+
+      for(const auto& sample : samples)
+      {
+        if(extractValue(sample.second, value))
+        {
+          times.push_back(sample.first);
+          values.push_back(value);
+        }
+      }
+      return;
+    }
+  }
+
+  VtValue sample;
+  for(const double time : sampleTimes)
+  {
+    if(query.Get(&sample, time) && extractValue(sample, value))
+    {
+      times.push_back(time);
+      values.push_back(value);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Converts float key values to doubles, applying the unit conversion factor.
+void scaleKeyValues(const std::vector<float>& values, const double conversionFactor, std::vector<double>& result)
+{
+  const size_t count = values.size();
+  result.resize(count);
+  const float* const input = values.data();
+  double* const output = result.data();
+  size_t i = 0;
+#if defined(__SSE__)
+  const MayaUsdUtils::d128 factor = MayaUsdUtils::splat2d(conversionFactor);
+  for(const size_t count4 = count & ~size_t(3); i < count4; i += 4)
+  {
+    const MayaUsdUtils::f128 v = MayaUsdUtils::loadu4f(input + i);
+    MayaUsdUtils::storeu2d(output + i, MayaUsdUtils::mul2d(factor, MayaUsdUtils::cvt2f_to_2d(v)));
+    MayaUsdUtils::storeu2d(output + i + 2, MayaUsdUtils::mul2d(factor, MayaUsdUtils::cvt2f_to_2d(MayaUsdUtils::movehl4f(v, v))));
+  }
+#endif
+  for(; i < count; ++i)
+  {
+    output[i] = input[i] * conversionFactor;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void readFloatAnimKeys(const UsdAttribute& attr, const double conversionFactor, std::vector<double>& times, std::vector<double>& values)
+{
+  std::vector<float> samples;
+  readTimeSamples(attr, times, samples);
+  scaleKeyValues(samples, conversionFactor, values);
+}
+
+} // anon
 
 //----------------------------------------------------------------------------------------------------------------------
 MStatus DgNodeHelper::setFloat(const MObject node, const MObject attr, float value)
@@ -1042,36 +1160,40 @@ MStatus DgNodeHelper::prepareAnimCurve(const MPlug &plug, MFnAnimCurve &animCurv
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-MStatus DgNodeHelper::setAngleAnim(MObject node, MObject attr, const UsdGeomXformOp op, MObjectArray *newAnimCurves)
+MStatus DgNodeHelper::setAnimKeys(const MPlug& plug, const std::vector<double>& times, const std::vector<double>& values, MObjectArray *newAnimCurves)
 {
-  MStatus status;
-  const char* const errorString = "DgNodeHelper::setAngleAnim";
+  const char* const errorString = "DgNodeHelper::setAnimKeys: Error adding keyframes";
 
-  MPlug plug(node, attr);
   MFnAnimCurve fnCurve;
-  status = prepareAnimCurve(plug, fnCurve, newAnimCurves);
-  if(!status)return MS::kFailure;
-
-  std::vector<double> times;
-  op.GetTimeSamples(&times);
+  if(!prepareAnimCurve(plug, fnCurve, newAnimCurves))
+    return MS::kFailure;
 
-  const float conversionFactor = 0.0174533f;
+  const uint32_t numKeys = uint32_t(std::min(times.size(), values.size()));
+  if(!numKeys)
+    return MS::kSuccess;
 
-  float value = 0;
-  for(auto const& timeValue: times)
+  MTimeArray timeArray(numKeys, MTime());
+  for(uint32_t i = 0; i < numKeys; ++i)
   {
-    const bool retValue = op.GetAs<float>(&value, timeValue);
-    if (!retValue) continue;
-
-    MTime tm(timeValue, MTime::kFilm);
-
-    fnCurve.addKey(tm, value * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
+    timeArray.set(MTime(times[i], MTime::kFilm), i);
   }
+  MDoubleArray valueArray(values.data(), numKeys);
 
+  AL_MAYA_CHECK_ERROR(fnCurve.addKeys(&timeArray, &valueArray, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal), errorString);
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+MStatus DgNodeHelper::setAngleAnim(MObject node, MObject attr, const UsdGeomXformOp op, MObjectArray *newAnimCurves)
+{
+  const double conversionFactor = 0.0174533;
+
+  std::vector<double> times, values;
+  readFloatAnimKeys(op.GetAttr(), conversionFactor, times, values);
+
+  return setAnimKeys(MPlug(node, attr), times, values, newAnimCurves);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus DgNodeHelper::setFloatAttrAnim(const MObject node, const MObject attr, UsdAttribute usdAttr,
                                            double conversionFactor, MObjectArray *newAnimCurves)
@@ -1081,29 +1203,52 @@ MStatus DgNodeHelper::setFloatAttrAnim(const MObject node, const MObject attr, U
     return MS::kFailure;
   }
 
-  const char* const errorString = "DgNodeTranslator::setFloatAttrAnim";
-  MStatus status;
+  std::vector<double> times, values;
+  readFloatAnimKeys(usdAttr, conversionFactor, times, values);
 
-  MPlug plug(node, attr);
-  MFnAnimCurve fnCurve;
-  status = prepareAnimCurve(plug, fnCurve, newAnimCurves);
-  if(!status)return MS::kFailure;
+  return setAnimKeys(MPlug(node, attr), times, values, newAnimCurves);
+}
 
-  std::vector<double> times;
-  usdAttr.GetTimeSamples(&times);
+//----------------------------------------------------------------------------------------------------------------------
+MStatus DgNodeHelper::setFloatAttrAnims(const std::vector<FloatAttrAnim>& anims, MObjectArray *newAnimCurves)
+{
+  struct Keys
+  {
+    std::vector<double> times;
+    std::vector<double> values;
+    bool hasSamples;
+  };
+  std::vector<Keys> keys(anims.size());
 
-  float value;
-  for(auto const& timeValue: times)
+  // Reading from USD is thread safe; creating the curves isn't.
+  WorkParallelForN(anims.size(), [&anims, &keys](size_t begin, size_t end)
   {
-    const bool retValue = usdAttr.Get(&value, timeValue);
-    if(!retValue) continue;
+    for(size_t i = begin; i < end; ++i)
+    {
+      keys[i].hasSamples = anims[i].usdAttr.GetNumTimeSamples() != 0;
+      if(keys[i].hasSamples)
+      {
+        readFloatAnimKeys(anims[i].usdAttr, anims[i].conversionFactor, keys[i].times, keys[i].values);
+      }
+    }
+  });
 
-    MTime tm(timeValue, MTime::kFilm);
-    fnCurve.addKey(tm, value * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
+  // As with setFloatAttrAnim, an attribute without time samples fails, but a curve is still created (possibly
+  // without keys) for the other ones.
+  MStatus result = MS::kSuccess;
+  for(size_t i = 0, n = anims.size(); i < n; ++i)
+  {
+    if(!keys[i].hasSamples)
+    {
+      result = MS::kFailure;
+      continue;
+    }
+    if(!setAnimKeys(MPlug(anims[i].node, anims[i].attr), keys[i].times, keys[i].values, newAnimCurves))
+    {
+      result = MS::kFailure;
+    }
   }
-
-  return MS::kSuccess;
+  return result;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1114,30 +1259,17 @@ MStatus DgNodeHelper::setVisAttrAnim(const MObject node, const MObject attr, con
     return MS::kFailure;
   }
 
-  const char* const errorString = "DgNodeTranslator::setVisAttrAnim: Error adding keyframes";
-  MStatus status;
-
-  MPlug plug(node, attr);
-  MFnAnimCurve fnCurve;
-  status = prepareAnimCurve(plug, fnCurve, newAnimCurves);
-  if(!status)return MS::kFailure;
-
   std::vector<double> times;
-  usdAttr.GetTimeSamples(&times);
+  std::vector<TfToken> samples;
+  readTimeSamples(usdAttr, times, samples);
 
-  TfToken value;
-  for(auto const& timeValue: times)
+  std::vector<double> values(samples.size());
+  for(size_t i = 0, n = samples.size(); i < n; ++i)
   {
-    const bool retValue = usdAttr.Get<TfToken>(&value, timeValue);
-    if(!retValue) continue;
-
-    MTime tm(timeValue, MTime::kFilm);
-
-    fnCurve.addKey(tm, (value == UsdGeomTokens->invisible) ? 0 : 1, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
+    values[i] = (samples[i] == UsdGeomTokens->invisible) ? 0 : 1;
   }
 
-  return MS::kSuccess;
+  return setAnimKeys(MPlug(node, attr), times, values, newAnimCurves);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1148,38 +1280,21 @@ MStatus DgNodeHelper::setClippingRangeAttrAnim(const MObject node, const MObject
     return MS::kFailure;
   }
 
-  const char* const errorString = "DgNodeTranslator::setClippingRangeAttrAnim: Error adding keyframes";
-  MStatus status;
-
-  MPlug nearPlug(node, nearAttr);
-  MFnAnimCurve fnCurveNear;
-  status = prepareAnimCurve(nearPlug, fnCurveNear, newAnimCurves);
-  if(!status)return MS::kFailure;
-
-  MPlug farPlug(node, farAttr);
-  MFnAnimCurve fnCurveFar;
-  status = prepareAnimCurve(farPlug, fnCurveFar, newAnimCurves);
-  if(!status)return MS::kFailure;
-
   std::vector<double> times;
-  usdAttr.GetTimeSamples(&times);
+  std::vector<GfVec2f> samples;
+  readTimeSamples(usdAttr, times, samples);
 
-  GfVec2f clippingRange;
-  for(auto const& timeValue: times)
+  std::vector<double> nearValues(samples.size());
+  std::vector<double> farValues(samples.size());
+  for(size_t i = 0, n = samples.size(); i < n; ++i)
   {
-    if (!usdAttr.Get(&clippingRange, timeValue))
-    {
-      continue;
-    }
-    MTime tm(timeValue, MTime::kFilm);
-
-    fnCurveNear.addKey(tm, clippingRange[0], MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
-    fnCurveFar.addKey(tm, clippingRange[1], MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, errorString);
+    nearValues[i] = samples[i][0];
+    farValues[i] = samples[i][1];
   }
 
-  return MS::kSuccess;
+  if(!setAnimKeys(MPlug(node, nearAttr), times, nearValues, newAnimCurves))
+    return MS::kFailure;
+  return setAnimKeys(MPlug(node, farAttr), times, farValues, newAnimCurves);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -28,6 +28,9 @@
 
 #include <pxr/usd/usdGeom/xformOp.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "AL/maya/utils/MayaHelperMacros.h"
 #include "AL/usdmaya/utils/AttributeType.h"
 
@@ -1225,6 +1228,15 @@ public:
   template<typename T>
   static MStatus setVec3Anim(MObject node, MObject attr, const std::vector<double>& times, VtArray<T>& values, double conversionFactor, MObjectArray *newAnimCurves=nullptr);
 
+  /// \brief  creates an animation curve for the specified plug, and adds all the keys to it in one go
+  /// \param  plug the plug to animate
+  /// \param  times the key times, in film (24fps) frames
+  /// \param  values the key values, one per key time
+  /// \param  newAnimCurves The MObjectArray to contain possibly created animCurve nodes.
+  /// \return MS::kSuccess on success, error code otherwise
+  AL_USDMAYA_UTILS_PUBLIC
+  static MStatus setAnimKeys(const MPlug& plug, const std::vector<double>& times, const std::vector<double>& values, MObjectArray *newAnimCurves=nullptr);
+
   /// \brief  creates animation curves to animate the specified angle attribute
   /// \param  node the node instance the animated attribute belongs to
   /// \param  attr the attribute handle
@@ -1244,6 +1256,25 @@ public:
   AL_USDMAYA_UTILS_PUBLIC
   static MStatus setFloatAttrAnim(MObject node, MObject attr, UsdAttribute usdAttr, double conversionFactor = 1.0, MObjectArray *newAnimCurves=nullptr);
 
+  /// \brief  an animated float attribute to import with setFloatAttrAnims
+  struct FloatAttrAnim
+  {
+    MObject node;                   ///< the node instance the animated attribute belongs to
+    MObject attr;                   ///< the attribute handle
+    UsdAttribute usdAttr;           ///< the USD attribute that contains the keyframe data
+    double conversionFactor;        ///< a scaling to apply to the key frames on import
+  };
+
+  /// \brief  creates animation curves in maya for a set of float attributes. The keyframes of all the attributes are
+  ///         read from USD in parallel, then the curves are created one after the other. Each attribute is handled
+  ///         as setFloatAttrAnim would: no curve is created for an attribute without time samples.
+  /// \param  anims the attributes to animate
+  /// \param  newAnimCurves The MObjectArray to contain possibly created animCurve nodes.
+  /// \return MS::kSuccess on success, MS::kFailure if any of the attributes has no time samples, or its curve could
+  ///         not be created
+  AL_USDMAYA_UTILS_PUBLIC
+  static MStatus setFloatAttrAnims(const std::vector<FloatAttrAnim>& anims, MObjectArray *newAnimCurves=nullptr);
+
   /// \brief  creates animation curves in maya for the visibility attribute
   /// \param  node the node instance the animated attribute belongs to
   /// \param  attr the visibility attribute handle
@@ -2011,33 +2042,27 @@ template<typename T>
 MStatus DgNodeHelper::setVec3Anim(MObject node, MObject attr, const std::vector<double>& times, VtArray<T>& values, double conversionFactor, MObjectArray *newAnimCurves)
 {
   MPlug plug(node, attr);
-  MStatus status;
 
-  MFnAnimCurve xFn, yFn, zFn;
-  status = prepareAnimCurve(plug.child(0), xFn, newAnimCurves);
-  if(!status)return MS::kFailure;
-
-  status = prepareAnimCurve(plug.child(1), yFn, newAnimCurves);
-  if(!status)return MS::kFailure;
-
-  status = prepareAnimCurve(plug.child(2), zFn, newAnimCurves);
-  if(!status)return MS::kFailure;
-
-  const char* const xformErrorEdit = "DgNodeTranslator:setVec3Anim error setting animation curve";
-  size_t timeIndex = 0;
-  for(auto const& timeValue: times)
+  const size_t numKeys = std::min(times.size(), values.size());
+  std::vector<double> keyTimes(times.begin(), times.begin() + numKeys);
+  std::vector<double> keyValues[3];
+  for(int c = 0; c < 3; ++c)
   {
-    MTime tm(timeValue, MTime::kFilm);
-    T &value =  values[timeIndex];
-    xFn.addKey(tm, value[0] * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, xformErrorEdit); 
-    yFn.addKey(tm, value[1] * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, xformErrorEdit); 
-    zFn.addKey(tm, value[2] * conversionFactor, MFnAnimCurve::kTangentGlobal, MFnAnimCurve::kTangentGlobal, NULL, &status);
-    AL_MAYA_CHECK_ERROR(status, xformErrorEdit); 
-    timeIndex ++;
+    keyValues[c].resize(numKeys);
+  }
+  for(size_t i = 0; i < numKeys; ++i)
+  {
+    const T& value = values[i];
+    keyValues[0][i] = value[0] * conversionFactor;
+    keyValues[1][i] = value[1] * conversionFactor;
+    keyValues[2][i] = value[2] * conversionFactor;
   }
 
+  for(int c = 0; c < 3; ++c)
+  {
+    if(!setAnimKeys(plug.child(c), keyTimes, keyValues[c], newAnimCurves))
+      return MS::kFailure;
+  }
   return MS::kSuccess;
 }
 
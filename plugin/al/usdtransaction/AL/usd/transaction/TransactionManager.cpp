@@ -15,6 +15,13 @@
 //
 #include "AL/usd/transaction/TransactionManager.h"
 
+#include <pxr/base/tf/notice.h>
+#include <pxr/usd/sdf/notice.h>
+#include <pxr/usd/sdf/schema.h>
+
+#include <algorithm>
+#include <unordered_set>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -92,8 +99,121 @@ void comparePrims(const SdfPrimSpecHandle& a, const SdfPrimSpecHandle& b, SdfPat
   };
   compareSpecViews(a->GetProperties(), b->GetProperties(), changed, resynced, compareProps);
 }
+
+/// Removes paths that have an ancestor (or themselves) in sorted, topmost-only \p roots
+void removeDescendants(SdfPathVector& paths, const SdfPathVector& roots)
+{
+  if (roots.empty())
+    return;
+  auto isUnderRoot = [&roots](const SdfPath& path)
+  {
+    auto it = std::upper_bound(roots.begin(), roots.end(), path);
+    return it != roots.begin() && path.HasPrefix(*(--it));
+  };
+  paths.erase(std::remove_if(paths.begin(), paths.end(), isUnderRoot), paths.end());
+}
+
+/// Fields which change composition of the prim they are authored on
+bool isCompositionField(const TfToken& field)
+{
+  return field == SdfFieldKeys->VariantSelection ||
+         field == SdfFieldKeys->Payload ||
+         field == SdfFieldKeys->Active ||
+         field == SdfFieldKeys->TypeName ||
+         field == SdfFieldKeys->Specifier ||
+         field == SdfFieldKeys->Instanceable;
+}
 } // anonymous namespace
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Records the paths touched in a layer while a transaction in Mode::kJournal is open.
+//----------------------------------------------------------------------------------------------------------------------
+class TransactionManager::Journal : public TfWeakBase
+{
+public:
+  Journal(const SdfLayerHandle& layer)
+  {
+    TfWeakPtr<Journal> me(this);
+    m_noticeKey = TfNotice::Register(me, &Journal::onLayersChanged, layer);
+  }
+
+  ~Journal()
+  {
+    TfNotice::Revoke(m_noticeKey);
+  }
+
+  /// \brief  builds the close notice lists, matching the shape of the snapshot comparison: only the topmost resynced
+  ///         paths are kept and changed paths below a resynced path are dropped.
+  void collect(SdfPathVector& resynced, SdfPathVector& changed) const
+  {
+    SdfPathVector sorted(m_resynced.begin(), m_resynced.end());
+    std::sort(sorted.begin(), sorted.end());
+    for (const auto& path : sorted)
+    {
+      if (resynced.empty() || !path.HasPrefix(resynced.back()))
+        resynced.push_back(path);
+    }
+
+    changed.assign(m_changed.begin(), m_changed.end());
+    std::sort(changed.begin(), changed.end());
+    removeDescendants(changed, resynced);
+  }
+
+private:
+  void onLayersChanged(const SdfNotice::LayersDidChangeSentPerLayer& notice, const SdfLayerHandle& sender)
+  {
+#if USD_VERSION_NUM > 1911
+    for (const auto& layerChanges : notice.GetChangeListVec())
+#else
+    for (const auto& layerChanges : notice.GetChangeListMap())
+#endif
+    {
+      if (layerChanges.first != sender)
+        continue;
+      for (const auto& entry : layerChanges.second.GetEntryList())
+      {
+        record(entry.first, entry.second);
+      }
+    }
+  }
+
+  void record(const SdfPath& entryPath, const SdfChangeList::Entry& entry)
+  {
+    SdfPath path = entryPath.StripAllVariantSelections();
+    if (path.IsTargetPath())
+      path = path.GetParentPath();
+
+    if (path.IsPropertyPath())
+    {
+      m_changed.insert(path);
+      return;
+    }
+
+    const auto& flags = entry.flags;
+    bool resync = flags.didAddInertPrim || flags.didAddNonInertPrim ||
+                  flags.didRemoveInertPrim || flags.didRemoveNonInertPrim ||
+                  flags.didRename || flags.didReorderChildren ||
+                  flags.didReplaceContent || flags.didReloadContent ||
+                  flags.didChangePrimVariantSets || flags.didChangePrimInheritPaths ||
+                  flags.didChangePrimSpecializes || flags.didChangePrimReferences;
+    for (auto it = entry.infoChanged.begin(), end = entry.infoChanged.end(); !resync && it != end; ++it)
+    {
+      resync = isCompositionField(it->first);
+    }
+
+    if (resync)
+    {
+      m_resynced.insert(path);
+      if (flags.didRename && !entry.oldPath.IsEmpty())
+        m_resynced.insert(entry.oldPath.StripAllVariantSelections());
+    }
+  }
+
+  TfNotice::Key m_noticeKey;
+  std::unordered_set<SdfPath, SdfPath::Hash> m_resynced;
+  std::unordered_set<SdfPath, SdfPath::Hash> m_changed;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 TransactionManager::StageManagerMap& TransactionManager::GetManagers()
 {
@@ -113,17 +233,36 @@ bool TransactionManager::AnyInProgress() const
   return !m_transactions.empty();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool TransactionManager::SetMode(Mode mode)
+{
+  if (AnyInProgress())
+  {
+    TF_WARN("Cannot change transaction mode while a transaction is in progress");
+    return false;
+  }
+  m_mode = mode;
+  return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool TransactionManager::Open(const SdfLayerHandle& layer)
 {
   if (m_stage && layer)
   {
-    auto pair = m_transactions.emplace(get_pointer(layer), TransactionData{nullptr, 1});
+    auto pair = m_transactions.emplace(get_pointer(layer), TransactionData{nullptr, 1, nullptr});
     if (pair.second)
     {
-      auto& base = pair.first->second.base;
-      base = SdfLayer::CreateAnonymous("transaction_base");
-      base->TransferContent(layer);
+      if (m_mode == Mode::kJournal)
+      {
+        pair.first->second.journal = std::make_shared<Journal>(layer);
+      }
+      else
+      {
+        auto& base = pair.first->second.base;
+        base = SdfLayer::CreateAnonymous("transaction_base");
+        base->TransferContent(layer);
+      }
       OpenNotice(layer).Send(m_stage);
     }
     else
@@ -147,7 +286,10 @@ bool TransactionManager::Close(const SdfLayerHandle& layer)
       if (--it->second.count == 0)
       {
         SdfPathVector changedInfo, resynched;
-        comparePrims(it->second.base->GetPseudoRoot(), layer->GetPseudoRoot(), resynched, changedInfo);
+        if (it->second.journal)
+          it->second.journal->collect(resynched, changedInfo);
+        else
+          comparePrims(it->second.base->GetPseudoRoot(), layer->GetPseudoRoot(), resynched, changedInfo);
         CloseNotice(layer, std::move(changedInfo), std::move(resynched)).Send(m_stage);
         m_transactions.erase(it);
       }
@@ -206,6 +348,25 @@ bool TransactionManager::Close(const UsdStageWeakPtr& stage, const SdfLayerHandl
   return false;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+bool TransactionManager::SetMode(const UsdStageWeakPtr& stage, Mode mode)
+{
+  if (!stage)
+  {
+    TF_WARN("Provided stage is invalid");
+    return false;
+  }
+  return Get(stage).SetMode(mode);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TransactionManager::Mode TransactionManager::GetMode(const UsdStageWeakPtr& stage)
+{
+  const auto& managers = GetManagers();
+  auto it = managers.find(stage);
+  return it != managers.end() ? it->second.GetMode() : Mode::kSnapshot;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 } // transaction
 } // usd
@@ -20,6 +20,8 @@
 #include <pxr/pxr.h>
 #include <pxr/base/tf/weakPtr.h>
 
+#include <memory>
+
 namespace AL {
 namespace usd {
 namespace transaction {
@@ -35,12 +37,34 @@ namespace transaction {
 ///         Whenever last transaction targeting given layer for given stage is closed, targetted layer content
 ///         is being compared against previously taken snapshot and CloseNotice is emitted with delta information.
 ///
+///         In Mode::kJournal no snapshot is taken. Instead, paths touched by layer change notices are recorded while
+///         the transaction is open and CloseNotice is built from that journal, so the cost of a transaction scales
+///         with the size of the edit rather than the size of the layer. The journal can over-report: a path that was
+///         edited and then restored to its original state is still reported as changed.
+///
 /// \note   It's user responsibilty to pair Open with Close calls, otherwise clients might not respond to any 
 ///         further changes. As such it's advisable to prefer ScopedTransaction whenever possible.
 //----------------------------------------------------------------------------------------------------------------------
 class TransactionManager
 {
 public:
+  /// \brief  Strategy used to work out what changed during a transaction
+  enum class Mode
+  {
+    kSnapshot, ///< copy the layer on open and compare it against the layer on close
+    kJournal ///< record the paths reported by layer change notices while the transaction is open
+  };
+
+  /// \brief  sets the strategy used by transactions opened from now on.
+  /// \param  mode the strategy to use
+  /// \return true on success, false when a transaction is in progress
+  AL_USD_TRANSACTION_PUBLIC
+  bool SetMode(Mode mode);
+
+  /// \brief  provides the strategy used by transactions of this manager.
+  /// \return the current mode, Mode::kSnapshot by default
+  inline Mode GetMode() const { return m_mode; }
+
   /// \brief  provides information whether transaction was opened and wasn't closed yet.
   /// \param  layer targetted by transaction
   /// \return true when transaction is in progress, otherwise false
@@ -106,18 +130,34 @@ public:
   /// \return true on success, false when layer or stage became invalid or transaction wasn't opened
   AL_USD_TRANSACTION_PUBLIC
   static bool Close(const PXR_NS::UsdStageWeakPtr& stage, const PXR_NS::SdfLayerHandle& layer);
+
+  /// \brief  sets the strategy used by transactions opened from now on for given stage.
+  /// \param  stage that is managed by TransactionManager
+  /// \param  mode the strategy to use
+  /// \return true on success, false when a transaction is in progress
+  AL_USD_TRANSACTION_PUBLIC
+  static bool SetMode(const PXR_NS::UsdStageWeakPtr& stage, Mode mode);
+
+  /// \brief  provides the strategy used by transactions for given stage.
+  /// \param  stage that is managed by TransactionManager
+  /// \return the current mode, Mode::kSnapshot by default
+  AL_USD_TRANSACTION_PUBLIC
+  static Mode GetMode(const PXR_NS::UsdStageWeakPtr& stage);
 private:
   typedef std::map<PXR_NS::UsdStageWeakPtr, TransactionManager> StageManagerMap;
   static StageManagerMap& GetManagers();
 private:
   TransactionManager(const PXR_NS::UsdStageWeakPtr& stage):m_stage(stage) {}
+  class Journal;
   struct TransactionData
   {
     PXR_NS::SdfLayerRefPtr base;
     int count;
+    std::shared_ptr<Journal> journal;
   };
   const PXR_NS::UsdStageWeakPtr m_stage;
   std::unordered_map<PXR_NS::SdfLayer*, TransactionData> m_transactions;
+  Mode m_mode = Mode::kSnapshot;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1,5 +1,6 @@
 #include "AL/usd/transaction/Notice.h"
 #include "AL/usd/transaction/Transaction.h"
+#include "AL/usd/transaction/TransactionManager.h"
 
 #include <pxr/pxr.h>
 #include <pxr/usd/usd/stage.h>
@@ -97,6 +98,7 @@ class TransactionTest : public TfWeakBase, public ::testing::Test {
     }
 
     void TearDown() override {
+      TransactionManager::SetMode(m_stage, TransactionManager::Mode::kSnapshot);
       TfNotice::Revoke(m_openNoticeKey);
       TfNotice::Revoke(m_closeNoticeKey);
     }
@@ -301,3 +303,58 @@ TEST_F(TransactionTest, Clear)
   EXPECT_EQ(sorted(getChanged()), empty());
   EXPECT_EQ(sorted(getResynced()), empty());
 }
+
+/// Test that CloseNotice reports changes recorded by the journal as expected
+TEST_F(TransactionTest, Journal_Changes)
+{
+  ASSERT_TRUE(TransactionManager::SetMode(m_stage, TransactionManager::Mode::kJournal));
+  {
+    ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+    createPrimWithAttribute("/root");
+    createPrimWithAttribute("/root/A");
+    createPrimWithAttribute("/root/A/C");
+    createPrimWithAttribute("/root/B");
+  }
+  EXPECT_EQ(sorted(getChanged()), empty());
+  EXPECT_EQ(sorted(getResynced()), sorted({"/root"}));
+  {
+    ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+    changePrimAttribute("/root", 2);
+    changePrimAttribute("/root/A/C", 2);
+  }
+  EXPECT_EQ(sorted(getChanged()), sorted({"/root.prop", "/root/A/C.prop"}));
+  EXPECT_EQ(sorted(getResynced()), empty());
+  {
+    ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+    createPrimWithAttribute("/root/B", "bar");
+    createPrimWithAttribute("/root/B/E");
+    changePrimAttribute("/root/B/E", 2);
+  }
+  EXPECT_EQ(sorted(getChanged()), sorted({"/root/B.bar"}));
+  EXPECT_EQ(sorted(getResynced()), sorted({"/root/B/E"}));
+  {
+    ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+    m_stage->RemovePrim(SdfPath("/root/A"));
+  }
+  EXPECT_EQ(sorted(getChanged()), empty());
+  EXPECT_EQ(sorted(getResynced()), sorted({"/root/A"}));
+  {
+    ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+    m_stage->GetSessionLayer()->Clear();
+  }
+  EXPECT_EQ(sorted(getChanged()), empty());
+  EXPECT_EQ(sorted(getResynced()), sorted({"/"}));
+}
+
+/// Test that the transaction mode can't be changed while a transaction is in progress
+TEST_F(TransactionTest, Journal_Mode)
+{
+  EXPECT_EQ(TransactionManager::GetMode(m_stage), TransactionManager::Mode::kSnapshot);
+  {
+    ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+    EXPECT_FALSE(TransactionManager::SetMode(m_stage, TransactionManager::Mode::kJournal));
+    EXPECT_EQ(TransactionManager::GetMode(m_stage), TransactionManager::Mode::kSnapshot);
+  }
+  EXPECT_TRUE(TransactionManager::SetMode(m_stage, TransactionManager::Mode::kJournal));
+  EXPECT_EQ(TransactionManager::GetMode(m_stage), TransactionManager::Mode::kJournal);
+}
@@ -0,0 +1,121 @@
+#include "AL/usd/transaction/Notice.h"
+#include "AL/usd/transaction/Transaction.h"
+#include "AL/usd/transaction/TransactionManager.h"
+
+#include <pxr/pxr.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/usd/stage.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace AL::usd::transaction;
+PXR_NAMESPACE_USING_DIRECTIVE
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Compare the cost of snapshot and journal transactions on large layers
+//----------------------------------------------------------------------------------------------------------------------
+
+// The fixture for benchmarking transaction modes.
+class TransactionBenchmark : public TfWeakBase, public ::testing::Test {
+  public:
+    TransactionBenchmark() {}
+    ~TransactionBenchmark() override {}
+
+    /// helper method to fill the session layer with a synthetic hierarchy of groups x children prims
+    void createLayout(size_t groups, size_t children)
+    {
+      SdfLayerHandle layer = m_stage->GetSessionLayer();
+      layer->Clear();
+      SdfChangeBlock block;
+      auto root = SdfPrimSpec::New(layer, "root", SdfSpecifierDef);
+      for (size_t g = 0; g < groups; ++g)
+      {
+        auto group = SdfPrimSpec::New(root, TfStringPrintf("group%zu", g), SdfSpecifierDef);
+        for (size_t c = 0; c < children; ++c)
+        {
+          auto child = SdfPrimSpec::New(group, TfStringPrintf("child%zu", c), SdfSpecifierDef, "Xform");
+          auto attr = SdfAttributeSpec::New(child, "prop", SdfValueTypeNames->Int);
+          attr->SetDefaultValue(VtValue(1));
+        }
+      }
+    }
+
+    /// helper method running a small edit inside a transaction, returns the time spent in milliseconds
+    double timeSmallEdit(TransactionManager::Mode mode, int value)
+    {
+      EXPECT_TRUE(TransactionManager::SetMode(m_stage, mode));
+      const auto start = std::chrono::steady_clock::now();
+      {
+        ScopedTransaction transaction(m_stage, m_stage->GetSessionLayer());
+        m_stage->GetAttributeAtPath(SdfPath("/root/group0/child0.prop")).Set(value);
+        m_stage->GetAttributeAtPath(SdfPath("/root/group1/child3.prop")).Set(value);
+        m_stage->DefinePrim(SdfPath("/root/group2/extra"));
+      }
+      const auto end = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    const SdfPathVector& getChanged() const { return m_changed; }
+    const SdfPathVector& getResynced() const { return m_resynced; }
+
+  protected:
+    void closeNotification(const CloseNotice& notice, const UsdStageWeakPtr& stage)
+    {
+      m_changed = notice.GetChangedInfoOnlyPaths();
+      m_resynced = notice.GetResyncedPaths();
+      std::sort(m_changed.begin(), m_changed.end());
+      std::sort(m_resynced.begin(), m_resynced.end());
+    }
+
+    void SetUp() override
+    {
+      m_stage = UsdStage::CreateInMemory();
+      m_stage->SetEditTarget(m_stage->GetSessionLayer());
+      TfWeakPtr<TransactionBenchmark> self(this);
+      m_closeNoticeKey = TfNotice::Register(self, &TransactionBenchmark::closeNotification, m_stage);
+      ASSERT_TRUE(m_closeNoticeKey);
+    }
+
+    void TearDown() override
+    {
+      TransactionManager::SetMode(m_stage, TransactionManager::Mode::kSnapshot);
+      TfNotice::Revoke(m_closeNoticeKey);
+    }
+
+    UsdStageRefPtr m_stage;
+
+  private:
+    TfNotice::Key m_closeNoticeKey;
+    SdfPathVector m_changed;
+    SdfPathVector m_resynced;
+};
+
+/// Run the same small edit in both modes on growing layers and check both modes report the same paths
+TEST_F(TransactionBenchmark, SmallEditOnLargeLayer)
+{
+  const size_t sizes[][2] = { {10, 100}, {100, 100}, {100, 1000} };
+  for (const auto& size : sizes)
+  {
+    createLayout(size[0], size[1]);
+
+    const double snapshotTime = timeSmallEdit(TransactionManager::Mode::kSnapshot, 2);
+    const SdfPathVector snapshotChanged = getChanged();
+    const SdfPathVector snapshotResynced = getResynced();
+    m_stage->RemovePrim(SdfPath("/root/group2/extra"));
+
+    const double journalTime = timeSmallEdit(TransactionManager::Mode::kJournal, 3);
+    EXPECT_EQ(getChanged(), snapshotChanged);
+    EXPECT_EQ(getResynced(), snapshotResynced);
+    m_stage->RemovePrim(SdfPath("/root/group2/extra"));
+
+    std::cout << "[ BENCHMARK ] " << size[0] * size[1] << " prims: snapshot " << snapshotTime
+              << " ms, journal " << journalTime << " ms" << std::endl;
+  }
+}
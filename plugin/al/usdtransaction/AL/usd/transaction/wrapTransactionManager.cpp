@@ -47,10 +47,20 @@ static bool CloseStageLayer(const UsdStageWeakPtr& stage, const SdfLayerHandle&
   return This::Close(stage, layer);
 }
 
+static bool SetModeStage(const UsdStageWeakPtr& stage, This::Mode mode)
+{
+  return This::SetMode(stage, mode);
+}
+
+static This::Mode GetModeStage(const UsdStageWeakPtr& stage)
+{
+  return This::GetMode(stage);
+}
+
 void wrapTransactionManager()
 {
   {
-    class_<This>("TransactionManager", no_init)
+    scope transactionManager = class_<This>("TransactionManager", no_init)
       .def("InProgress", InProgressStage, (arg("stage")))
       .def("InProgress", InProgressStageLayer, (arg("stage"), arg("layer")))
       .staticmethod("InProgress")
@@ -60,6 +70,17 @@ void wrapTransactionManager()
 
       .def("Close", CloseStageLayer, (arg("stage"), arg("layer")))
       .staticmethod("Close")
+
+      .def("SetMode", SetModeStage, (arg("stage"), arg("mode")))
+      .staticmethod("SetMode")
+
+      .def("GetMode", GetModeStage, (arg("stage")))
+      .staticmethod("GetMode")
+    ;
+
+    enum_<This::Mode>("Mode")
+      .value("Snapshot", This::Mode::kSnapshot)
+      .value("Journal", This::Mode::kJournal)
     ;
   }
 }
@@ -108,6 +108,42 @@ class testPointBasedDeformerNode(unittest.TestCase):
         self._ValidateControlPoint(testCube, 2, Gf.Vec3d(-1.0, 0.0, 1.0))
         self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.0, 1.0, 1.0))
 
+    def testCubeWithDeformerWeights(self):
+        """
+        Tests that the envelope and the per-component weights of a point based
+        deformer node are applied.
+        """
+        OMA.MAnimControl.setAnimationStartEndTime(
+            OM.MTime(self.START_TIMECODE), OM.MTime(self.END_TIMECODE))
+        cmds.currentTime(self.START_TIMECODE)
+
+        testCube = cmds.polyCube(depth=1.0, height=1.0, width=1.0)[0]
+
+        stageNode = cmds.createNode('pxrUsdStageNode')
+        cmds.setAttr('%s.filePath' % stageNode, self._deformingCubeUsdFilePath,
+            type='string')
+
+        cmds.select(testCube, replace=True)
+
+        deformerNode = cmds.deformer(type='pxrUsdPointBasedDeformerNode')[0]
+        cmds.setAttr('%s.primPath' % deformerNode, self._deformingCubePrimPath,
+            type='string')
+        cmds.connectAttr('%s.outUsdStage' % stageNode,
+            '%s.inUsdStage' % deformerNode)
+        cmds.connectAttr('time1.outTime', '%s.time' % deformerNode)
+
+        # Half the envelope blends halfway between the Maya and USD cubes.
+        cmds.setAttr('%s.envelope' % deformerNode, 0.5)
+
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.75, -0.75, 0.75))
+        self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.75, 0.75, 0.75))
+
+        # A zero weight leaves its component untouched.
+        cmds.setAttr('%s.weightList[0].weights[3]' % deformerNode, 0.0)
+
+        self._ValidateControlPoint(testCube, 0, Gf.Vec3d(-0.75, -0.75, 0.75))
+        self._ValidateControlPoint(testCube, 3, Gf.Vec3d(0.5, 0.5, 0.5))
+
 
 if __name__ == '__main__':
     unittest.main(verbosity=2)
@@ -0,0 +1,306 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <mayaUsd/nodes/proxyShapePayloadStreamer.h>
+
+#include <gtest/gtest.h>
+
+#include <pxr/base/gf/vec3f.h>
+#include <pxr/base/tf/stringUtils.h>
+#include <pxr/base/tf/token.h>
+#include <pxr/base/vt/array.h>
+#include <pxr/usd/kind/registry.h>
+#include <pxr/usd/sdf/layer.h>
+#include <pxr/usd/sdf/path.h>
+#include <pxr/usd/sdf/payload.h>
+#include <pxr/usd/usd/modelAPI.h>
+#include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usd/stage.h>
+#include <pxr/usd/usdGeom/modelAPI.h>
+#include <pxr/usd/usdGeom/tokens.h>
+#include <pxr/usd/usdGeom/xform.h>
+
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+using Streamer = MayaUsdProxyShapePayloadStreamer;
+
+// Looking down -Z from the origin, with a 90 degrees field of view.
+const Streamer::Camera camera { GfVec3d(0.0), GfVec3d(0.0, 0.0, -1.0), 1.0 };
+
+const TfTokenVector purposes { UsdGeomTokens->default_ };
+
+// Defines an Xform model prim whose extents hint is a cube of the argument
+// size at the argument center, so that its bound is known while unloaded.
+UsdPrim defineModel(
+        const UsdStageRefPtr& stage,
+        const SdfPath& path,
+        const TfToken& kind,
+        const GfVec3f& center,
+        float size)
+{
+    UsdPrim prim = UsdGeomXform::Define(stage, path).GetPrim();
+    UsdModelAPI(prim).SetKind(kind);
+
+    const GfVec3f halfSize(0.5f * size);
+    UsdGeomModelAPI(prim).SetExtentsHint(
+        VtVec3fArray { center - halfSize, center + halfSize });
+    return prim;
+}
+
+// Creates a layer holding the contents of a payload: a prim at the argument
+// path with numChildren children.
+SdfLayerRefPtr createPayloadLayer(const SdfPath& path, size_t numChildren)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(stage, path);
+    for (size_t i = 0; i < numChildren; ++i) {
+        UsdGeomXform::Define(stage, path.AppendChild(TfToken(TfStringPrintf("child%zu", i))));
+    }
+    return stage->GetRootLayer();
+}
+
+void addPayload(const UsdPrim& prim, const SdfLayerRefPtr& layer)
+{
+    prim.GetPayloads().AddPayload(SdfPayload(layer->GetIdentifier(), prim.GetPath()));
+}
+
+// A stage with one payload per distance along the camera direction, each
+// bringing in a prim with numChildren children.
+struct PayloadStage
+{
+    PayloadStage(const std::vector<float>& distances, size_t numChildren)
+    {
+        stage = UsdStage::CreateInMemory(UsdStage::LoadNone);
+        for (size_t i = 0; i < distances.size(); ++i) {
+            const SdfPath path(TfStringPrintf("/Model%zu", i));
+            payloadLayers.push_back(createPayloadLayer(path, numChildren));
+
+            UsdPrim prim = defineModel(stage, path, KindTokens->component,
+                GfVec3f(0.0f, 0.0f, -distances[i]), 2.0f);
+            addPayload(prim, payloadLayers.back());
+            paths.push_back(path);
+        }
+    }
+
+    UsdStageRefPtr stage;
+    SdfPathVector paths;
+
+    // The payload layers are anonymous, so they must be kept alive.
+    std::vector<SdfLayerRefPtr> payloadLayers;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Payloads are loaded by decreasing screen size, one batch per update.
+//------------------------------------------------------------------------------
+TEST(ProxyShapePayloadStreamer, priority)
+{
+    PayloadStage payloadStage({ 30.0f, 10.0f, 20.0f }, 0);
+    const UsdStageRefPtr& stage = payloadStage.stage;
+    const SdfPathVector& paths = payloadStage.paths;
+
+    Streamer streamer;
+    streamer.SetStage(stage);
+
+    const Streamer::Budget budget { 0, 1 };
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ paths[1] }), stage->GetLoadSet());
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ paths[1], paths[2] }), stage->GetLoadSet());
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet(paths.begin(), paths.end()), stage->GetLoadSet());
+
+    // Everything is loaded, nothing is left to do.
+    EXPECT_FALSE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+
+    // Payloads behind the camera come last.
+    PayloadStage behindStage({ -5.0f, 10.0f }, 0);
+    streamer.SetStage(behindStage.stage);
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ behindStage.paths[1] }), behindStage.stage->GetLoadSet());
+}
+
+//------------------------------------------------------------------------------
+// The prim budget is measured from the loaded payloads, and the lowest
+// priority payloads beyond it are unloaded.
+//------------------------------------------------------------------------------
+TEST(ProxyShapePayloadStreamer, budget)
+{
+    // Each payload brings in two prims.
+    PayloadStage payloadStage({ 10.0f, 20.0f, 30.0f }, 1);
+    const UsdStageRefPtr& stage = payloadStage.stage;
+    const SdfPathVector& paths = payloadStage.paths;
+
+    Streamer streamer;
+    streamer.SetStage(stage);
+
+    const Streamer::Budget budget { 3, 10 };
+
+    // Payloads which have never been loaded count as a single prim, so all
+    // of them fit in the budget at first.
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet(paths.begin(), paths.end()), stage->GetLoadSet());
+
+    // Once their cost is known, only the nearest one fits.
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ paths[0] }), stage->GetLoadSet());
+
+    EXPECT_FALSE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+
+    // Moving the camera to the other end changes which one fits.
+    const Streamer::Camera backCamera {
+        GfVec3d(0.0, 0.0, -40.0), GfVec3d(0.0, 0.0, 1.0), 1.0 };
+    EXPECT_TRUE(streamer.Update(backCamera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ paths[2] }), stage->GetLoadSet());
+
+    // A zero budget loads everything.
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, { 0, 10 }));
+    EXPECT_EQ(SdfPathSet(paths.begin(), paths.end()), stage->GetLoadSet());
+}
+
+//------------------------------------------------------------------------------
+// A payload beyond the budget is kept loaded while a nested payload within it
+// is wanted, since unloading it would unload the nested payload too.
+//------------------------------------------------------------------------------
+TEST(ProxyShapePayloadStreamer, ancestorsAreKept)
+{
+    const SdfPath outerPath("/Outer");
+    const SdfPath innerPath("/Outer/Inner");
+
+    // The inner payload has no children, and is nearer and larger than the
+    // outer one.
+    SdfLayerRefPtr innerLayer = createPayloadLayer(innerPath, 0);
+
+    UsdStageRefPtr outerStage = UsdStage::CreateInMemory();
+    UsdGeomXform::Define(outerStage, outerPath);
+    UsdPrim innerPrim = defineModel(outerStage, innerPath, KindTokens->component,
+        GfVec3f(0.0f, 0.0f, -5.0f), 4.0f);
+    addPayload(innerPrim, innerLayer);
+    SdfLayerRefPtr outerLayer = outerStage->GetRootLayer();
+
+    UsdStageRefPtr stage = UsdStage::CreateInMemory(UsdStage::LoadNone);
+    UsdPrim outerPrim = defineModel(stage, outerPath, KindTokens->assembly,
+        GfVec3f(0.0f, 0.0f, -50.0f), 1.0f);
+    addPayload(outerPrim, outerLayer);
+
+    Streamer streamer;
+    streamer.SetStage(stage);
+
+    // Nested payloads are only found, and loaded, once their parent is.
+    const Streamer::Budget unlimited { 0, 10 };
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, unlimited));
+    EXPECT_EQ(SdfPathSet({ outerPath }), stage->GetLoadSet());
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, unlimited));
+    EXPECT_EQ(SdfPathSet({ outerPath, innerPath }), stage->GetLoadSet());
+
+    // The outer payload costs two prims, and the inner one a single prim,
+    // so only the inner one fits in the budget, but the outer one must stay.
+    const Streamer::Budget budget { 1, 10 };
+    EXPECT_FALSE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ outerPath, innerPath }), stage->GetLoadSet());
+
+    // Seen from behind, the farther inner payload comes last, and the outer
+    // one does not fit, so nothing is wanted and both are unloaded.
+    const Streamer::Camera awayCamera {
+        GfVec3d(0.0, 0.0, -100.0), GfVec3d(0.0, 0.0, -1.0), 1.0 };
+    EXPECT_TRUE(streamer.Update(awayCamera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_TRUE(stage->GetLoadSet().empty());
+}
+
+//------------------------------------------------------------------------------
+// After the first update, only the resynced subtrees are searched for new
+// payloads.
+//------------------------------------------------------------------------------
+TEST(ProxyShapePayloadStreamer, invalidate)
+{
+    PayloadStage payloadStage({ 10.0f }, 0);
+    const UsdStageRefPtr& stage = payloadStage.stage;
+
+    Streamer streamer;
+    streamer.SetStage(stage);
+
+    const Streamer::Budget budget { 0, 10 };
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ payloadStage.paths[0] }), stage->GetLoadSet());
+
+    const SdfPath newPath("/NewModel");
+    SdfLayerRefPtr newLayer = createPayloadLayer(newPath, 0);
+    UsdPrim newPrim = defineModel(stage, newPath, KindTokens->component,
+        GfVec3f(0.0f, 0.0f, -20.0f), 2.0f);
+    addPayload(newPrim, newLayer);
+
+    // The new payload is not found until its path is resynced.
+    EXPECT_FALSE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    streamer.Invalidate({ SdfPath("/Other"), payloadStage.paths[0] });
+    EXPECT_FALSE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+
+    streamer.Invalidate({ newPath });
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ payloadStage.paths[0], newPath }), stage->GetLoadSet());
+}
+
+//------------------------------------------------------------------------------
+// Payloads without an extents hint are prioritized by the bound of their
+// nearest bounded ancestor, and by path when they have none.
+//------------------------------------------------------------------------------
+TEST(ProxyShapePayloadStreamer, noExtentsHint)
+{
+    UsdStageRefPtr stage = UsdStage::CreateInMemory(UsdStage::LoadNone);
+
+    // The nearer group comes last by path.
+    const SdfPath farPath("/A_Far/Model");
+    const SdfPath nearPath("/B_Near/Model");
+    defineModel(stage, farPath.GetParentPath(), KindTokens->group,
+        GfVec3f(0.0f, 0.0f, -30.0f), 2.0f);
+    defineModel(stage, nearPath.GetParentPath(), KindTokens->group,
+        GfVec3f(0.0f, 0.0f, -10.0f), 2.0f);
+
+    // Unbounded payloads under the pseudo-root, defined out of path order.
+    const SdfPath unboundedPathB("/D_Unbounded");
+    const SdfPath unboundedPathA("/C_Unbounded");
+
+    std::vector<SdfLayerRefPtr> payloadLayers;
+    for (const SdfPath& path : { farPath, nearPath, unboundedPathB, unboundedPathA }) {
+        payloadLayers.push_back(createPayloadLayer(path, 0));
+        UsdPrim prim = UsdGeomXform::Define(stage, path).GetPrim();
+        UsdModelAPI(prim).SetKind(KindTokens->component);
+        addPayload(prim, payloadLayers.back());
+    }
+
+    Streamer streamer;
+    streamer.SetStage(stage);
+
+    const Streamer::Budget budget { 0, 1 };
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ nearPath }), stage->GetLoadSet());
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ nearPath, farPath }), stage->GetLoadSet());
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(SdfPathSet({ nearPath, farPath, unboundedPathA }), stage->GetLoadSet());
+
+    EXPECT_TRUE(streamer.Update(camera, UsdTimeCode::Default(), purposes, budget));
+    EXPECT_EQ(4u, stage->GetLoadSet().size());
+}
@@ -0,0 +1,126 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <mayaUsd/render/vp2RenderDelegate/lru_cache.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+
+struct Texture
+{
+    int _id{0};
+};
+
+using Cache = HdVP2LruCache<std::string, Texture>;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// A cached value is shared by all the users of its key.
+//------------------------------------------------------------------------------
+TEST(HdVP2LruCache, hits)
+{
+    Cache cache(100);
+    EXPECT_FALSE(cache.Find("a"));
+
+    Cache::ValueSharedPtr a = cache.Insert("a");
+    ASSERT_TRUE(a);
+    a->_id = 1;
+    EXPECT_EQ(a, cache.Find("a"));
+    EXPECT_FALSE(cache.Find("b"));
+
+    EXPECT_TRUE(cache.SetLoaded("a", 10));
+    EXPECT_EQ(a, cache.Find("a"));
+    EXPECT_EQ(1, cache.Find("a")->_id);
+    EXPECT_EQ(1u, cache.GetSize());
+    EXPECT_EQ(10u, cache.GetTotalBytes());
+
+    EXPECT_FALSE(cache.SetLoaded("b", 10));
+}
+
+//------------------------------------------------------------------------------
+// Loaded values nobody uses are released in least recently used order, when a
+// value is inserted or loaded beyond the budget.
+//------------------------------------------------------------------------------
+TEST(HdVP2LruCache, eviction)
+{
+    Cache cache(100);
+
+    // Three unused values of 40 bytes, "a" being the most recently used.
+    for (const char* key : { "c", "b", "a" }) {
+        cache.Insert(key);
+        EXPECT_TRUE(cache.SetLoaded(key, 40));
+    }
+    EXPECT_EQ(2u, cache.GetSize());
+    EXPECT_EQ(80u, cache.GetTotalBytes());
+    EXPECT_FALSE(cache.Find("c"));
+    EXPECT_TRUE(cache.Find("b"));
+    EXPECT_TRUE(cache.Find("a"));
+
+    // Values in use are kept beyond the budget.
+    Cache::ValueSharedPtr d = cache.Insert("d");
+    Cache::ValueSharedPtr e = cache.Insert("e");
+    EXPECT_TRUE(cache.SetLoaded("d", 60));
+    EXPECT_TRUE(cache.SetLoaded("e", 60));
+    EXPECT_EQ(2u, cache.GetSize());
+    EXPECT_EQ(120u, cache.GetTotalBytes());
+    EXPECT_FALSE(cache.Find("a"));
+
+    // Values loading are kept until loaded.
+    cache.Insert("f");
+    EXPECT_TRUE(cache.Find("f"));
+
+    // Released values are evicted on the next insert, even without a load.
+    d.reset();
+    cache.Insert("g");
+    EXPECT_FALSE(cache.Find("d"));
+    EXPECT_TRUE(cache.Find("e"));
+    EXPECT_TRUE(cache.Find("f"));
+    EXPECT_TRUE(cache.Find("g"));
+    EXPECT_EQ(60u, cache.GetTotalBytes());
+}
+
+//------------------------------------------------------------------------------
+// A value which failed to load is erased, and its next use loads it again.
+//------------------------------------------------------------------------------
+TEST(HdVP2LruCache, failedLoads)
+{
+    Cache cache(100);
+
+    Cache::ValueSharedPtr failed = cache.Insert("a");
+    failed->_id = -1;
+    cache.Erase("a");
+    EXPECT_FALSE(cache.Find("a"));
+    EXPECT_FALSE(cache.SetLoaded("a", 10));
+    EXPECT_EQ(0u, cache.GetSize());
+
+    // The users of the failed value keep it, the retry gets a new one.
+    Cache::ValueSharedPtr retried = cache.Insert("a");
+    EXPECT_NE(failed, retried);
+    EXPECT_EQ(0, retried->_id);
+    EXPECT_EQ(-1, failed->_id);
+
+    EXPECT_TRUE(cache.SetLoaded("a", 10));
+    EXPECT_EQ(retried, cache.Find("a"));
+    EXPECT_EQ(10u, cache.GetTotalBytes());
+
+    cache.Erase("a");
+    EXPECT_EQ(0u, cache.GetTotalBytes());
+}
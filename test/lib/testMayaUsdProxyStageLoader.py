@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import shutil
+import tempfile
+import time
+import unittest
+
+from maya import cmds
+import mayaUsd
+
+# Run with MAYAUSD_ASYNC_STAGE_LOAD and MAYAUSD_ASYNC_STAGE_LOAD_NON_INTERACTIVE
+# set, so that the proxy shapes open their stages in the background.
+
+LAYER_TEXT = \
+"""#usda 1.0
+def Xform "%s"
+{
+}
+"""
+
+# Seconds to wait for a background load to complete.
+LOAD_TIMEOUT = 30.0
+
+def getStage(shapePath):
+    """ Returns the stage of the shape, or None while it is loading. """
+    prim = mayaUsd.lib.GetPrim(shapePath)
+    return prim.GetStage() if prim else None
+
+def pollStage(shapePath, timeout):
+    """
+    Returns the stage of the shape once loaded, or None after timeout seconds.
+    Nothing processes the completion of the load in mayapy, so the cached
+    stage data is dirtied here to pick up the loaded stage.
+    """
+    start = time.time()
+    while True:
+        cmds.dgdirty(shapePath + '.inStageDataCached')
+        stage = getStage(shapePath)
+        if stage or time.time() - start > timeout:
+            return stage
+        time.sleep(0.05)
+
+class MayaUsdProxyStageLoaderTestCase(unittest.TestCase):
+    """ Tests the background loading of proxy shape stages. """
+
+    @classmethod
+    def setUpClass(cls):
+        cmds.loadPlugin('mayaUsdPlugin')
+
+    def setUp(self):
+        cmds.file(new=True, force=True)
+        self._tempDir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        cmds.file(new=True, force=True)
+        shutil.rmtree(self._tempDir, ignore_errors=True)
+
+    def _writeLayer(self, name):
+        # The layers are written as text rather than with Sdf, so that they are
+        # not already open, which would make the proxy shape load them
+        # synchronously.
+        filePath = os.path.join(self._tempDir, name + '.usda')
+        with open(filePath, 'w') as f:
+            f.write(LAYER_TEXT % name)
+        return filePath
+
+    def _createShape(self):
+        cmds.createNode('mayaUsdProxyShape', name='stageShape')
+        return cmds.ls(sl=True, long=True)[0]
+
+    def testLoad(self):
+        """ The stage of a file is loaded in the background. """
+        filePath = self._writeLayer('A')
+        shapePath = self._createShape()
+        cmds.setAttr(shapePath + '.filePath', filePath, type='string')
+
+        stage = pollStage(shapePath, LOAD_TIMEOUT)
+        self.assertIsNotNone(stage)
+        self.assertTrue(stage.GetPrimAtPath('/A'))
+
+    def testSupersededLoad(self):
+        """
+        Changing the file while a stage is loading cancels the load, and the
+        shape ends with the stage of the last file.
+        """
+        filePathA = self._writeLayer('A')
+        filePathB = self._writeLayer('B')
+        shapePath = self._createShape()
+
+        cmds.setAttr(shapePath + '.filePath', filePathA, type='string')
+        # Starts loading A.
+        getStage(shapePath)
+        cmds.setAttr(shapePath + '.filePath', filePathB, type='string')
+
+        stage = pollStage(shapePath, LOAD_TIMEOUT)
+        self.assertIsNotNone(stage)
+        self.assertTrue(stage.GetPrimAtPath('/B'))
+        self.assertFalse(stage.GetPrimAtPath('/A'))
+
+        # The load of A completing later does not replace the stage.
+        time.sleep(0.5)
+        stage = pollStage(shapePath, LOAD_TIMEOUT)
+        self.assertTrue(stage.GetPrimAtPath('/B'))
+        self.assertFalse(stage.GetPrimAtPath('/A'))
+
+    def testCancelledLoad(self):
+        """
+        Clearing the file while a stage is loading cancels the load, and the
+        shape ends with an empty in-memory stage.
+        """
+        filePath = self._writeLayer('A')
+        shapePath = self._createShape()
+
+        cmds.setAttr(shapePath + '.filePath', filePath, type='string')
+        # Starts loading A.
+        getStage(shapePath)
+        cmds.setAttr(shapePath + '.filePath', '', type='string')
+
+        # An empty file path is opened synchronously.
+        stage = getStage(shapePath)
+        self.assertIsNotNone(stage)
+        self.assertTrue(stage.GetRootLayer().anonymous)
+
+        # The cancelled load completing later does not replace the stage.
+        time.sleep(0.5)
+        stage = pollStage(shapePath, LOAD_TIMEOUT)
+        self.assertTrue(stage.GetRootLayer().anonymous)
+        self.assertFalse(stage.GetPrimAtPath('/A'))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,125 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import maya.cmds as cmds
+
+from ufeTestUtils import usdUtils, mayaUtils
+import ufe
+import mayaUsd.ufe
+
+from pxr import Sdf
+
+import unittest
+
+class HasChildrenTestCase(unittest.TestCase):
+    '''Verify that Hierarchy.hasChildren() follows changes to the stage.
+
+    The answers of hasChildren() are cached, so each test queries an item
+    before and after changing the stage.
+    '''
+
+    pluginsLoaded = False
+
+    @classmethod
+    def setUpClass(cls):
+        if not cls.pluginsLoaded:
+            cls.pluginsLoaded = mayaUtils.isMayaUsdPluginLoaded()
+
+    @classmethod
+    def tearDownClass(cls):
+        cmds.file(new=True, force=True)
+
+    def setUp(self):
+        ''' Called initially to set up the Maya test environment '''
+        # Load plugins
+        self.assertTrue(self.pluginsLoaded)
+
+        # Open top_layer.ma scene in test-samples
+        mayaUtils.openTopLayerScene()
+
+        self.proxyShapeSegment = mayaUtils.createUfePathSegment(
+            "|world|transform1|proxyShape1")
+        self.stage = mayaUsd.ufe.getStage(str(self.proxyShapeSegment))
+
+        # A prim without children, to which children are added.
+        self.stage.DefinePrim('/Room_set/Props/Empty', 'Xform')
+
+    def hasChildren(self, usdPath):
+        path = ufe.Path([self.proxyShapeSegment,
+                         usdUtils.createUfePathSegment(usdPath)])
+        item = ufe.Hierarchy.createItem(path)
+        return ufe.Hierarchy.hierarchy(item).hasChildren()
+
+    def testAddRemoveChild(self):
+        '''Adding or removing a child changes hasChildren() of its parent.'''
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty'))
+
+        self.stage.DefinePrim('/Room_set/Props/Empty/Child', 'Xform')
+        self.assertTrue(self.hasChildren('/Room_set/Props/Empty'))
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty/Child'))
+
+        self.stage.DefinePrim('/Room_set/Props/Empty/Child/GrandChild', 'Xform')
+        self.assertTrue(self.hasChildren('/Room_set/Props/Empty/Child'))
+
+        # Removing a prim invalidates its descendants as well.
+        self.stage.RemovePrim('/Room_set/Props/Empty/Child')
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty'))
+
+    def testDeactivateChild(self):
+        '''Inactive children are not shown, so do not count as children.'''
+        self.stage.DefinePrim('/Room_set/Props/Empty/Child', 'Xform')
+        self.assertTrue(self.hasChildren('/Room_set/Props/Empty'))
+
+        self.stage.GetPrimAtPath('/Room_set/Props/Empty/Child').SetActive(False)
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty'))
+
+        self.stage.GetPrimAtPath('/Room_set/Props/Empty/Child').SetActive(True)
+        self.assertTrue(self.hasChildren('/Room_set/Props/Empty'))
+
+    def testLayerStackChanges(self):
+        '''Sub layer changes resync the absolute root, which invalidates all
+        the cached answers of the stage.'''
+        subLayer = Sdf.Layer.CreateAnonymous()
+        subLayer.ImportFromString('''#usda 1.0
+def "Room_set"
+{
+    def "Props"
+    {
+        def "Empty"
+        {
+            def Xform "FromSubLayer"
+            {
+            }
+        }
+    }
+}
+''')
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty'))
+
+        rootLayer = self.stage.GetRootLayer()
+        rootLayer.subLayerPaths.append(subLayer.identifier)
+        self.assertTrue(self.hasChildren('/Room_set/Props/Empty'))
+
+        self.stage.MuteLayer(subLayer.identifier)
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty'))
+
+        self.stage.UnmuteLayer(subLayer.identifier)
+        self.assertTrue(self.hasChildren('/Room_set/Props/Empty'))
+
+        rootLayer.subLayerPaths.remove(subLayer.identifier)
+        self.assertFalse(self.hasChildren('/Room_set/Props/Empty'))
@@ -0,0 +1,148 @@
+#!/usr/bin/env python
+
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import maya.cmds as cmds
+
+from ufeTestUtils import usdUtils, mayaUtils
+from ufeTestUtils.testUtils import assertVectorAlmostEqual
+import ufe
+import mayaUsd.ufe
+
+import unittest
+
+Operation = mayaUsd.ufe.TRSBatchCommand.Operation
+
+class TRSBatchCmdTestCase(unittest.TestCase):
+    '''Verify the batched translate, rotate and scale command.
+
+    The command is created from the global selection, and sets the values of
+    all its items at once.
+    '''
+
+    pluginsLoaded = False
+
+    @classmethod
+    def setUpClass(cls):
+        if not cls.pluginsLoaded:
+            cls.pluginsLoaded = mayaUtils.isMayaUsdPluginLoaded()
+
+    @classmethod
+    def tearDownClass(cls):
+        cmds.file(new=True, force=True)
+
+    def setUp(self):
+        ''' Called initially to set up the Maya test environment '''
+        # Load plugins
+        self.assertTrue(self.pluginsLoaded)
+
+        # Open top_layer.ma scene in test-samples
+        mayaUtils.openTopLayerScene()
+
+        self.proxyShapeSegment = mayaUtils.createUfePathSegment(
+            "|world|transform1|proxyShape1")
+        self.stage = mayaUsd.ufe.getStage(str(self.proxyShapeSegment))
+
+        # Prims defined in the root layer, which can be renamed.
+        self.usdPaths = ['/Room_set/Props/BatchA', '/Room_set/Props/BatchB']
+        for usdPath in self.usdPaths:
+            self.stage.DefinePrim(usdPath, 'Xform')
+
+        # Clear selection to start off.
+        cmds.select(clear=True)
+
+    def ufePath(self, usdPath):
+        return ufe.Path([self.proxyShapeSegment,
+                         usdUtils.createUfePathSegment(usdPath)])
+
+    def selectAll(self):
+        sn = ufe.GlobalSelection.get()
+        sn.clear()
+        for usdPath in self.usdPaths:
+            sn.append(ufe.Hierarchy.createItem(self.ufePath(usdPath)))
+
+    def value(self, usdPath, attrName):
+        return self.stage.GetPrimAtPath(usdPath).GetAttribute(attrName).Get()
+
+    def assertValues(self, usdPaths, attrName, expected):
+        for usdPath in usdPaths:
+            assertVectorAlmostEqual(self, self.value(usdPath, attrName), expected)
+
+    def testOperations(self):
+        '''Set, undo and redo each operation on all the items.'''
+        for operation, attrName, initial, expected in [
+                (Operation.Translate, 'xformOp:translate', [0, 0, 0], [1, 2, 3]),
+                (Operation.Rotate, 'xformOp:rotateXYZ', [0, 0, 0], [10, 20, 30]),
+                (Operation.Scale, 'xformOp:scale', [1, 1, 1], [2, 3, 4])]:
+            self.selectAll()
+            cmd = mayaUsd.ufe.TRSBatchCommand.create(operation)
+            self.assertEqual(cmd.size(), 2)
+
+            # The attribute is added to the items when the command is created.
+            self.assertValues(self.usdPaths, attrName, initial)
+
+            cmd.set(*expected)
+            self.assertValues(self.usdPaths, attrName, expected)
+
+            cmd.undo()
+            self.assertValues(self.usdPaths, attrName, initial)
+
+            cmd.redo()
+            self.assertValues(self.usdPaths, attrName, expected)
+
+    def testNonUsdItems(self):
+        '''Maya items of the selection are left out of the command.'''
+        self.selectAll()
+        cmds.select('|transform1', add=True)
+        self.assertEqual(len(ufe.GlobalSelection.get()), 3)
+
+        cmd = mayaUsd.ufe.TRSBatchCommand.create(Operation.Translate)
+        self.assertEqual(cmd.size(), 2)
+        self.assertEqual(cmd.paths(),
+                         [str(self.ufePath(usdPath)) for usdPath in self.usdPaths])
+
+    def testRename(self):
+        '''The command follows its items when they are renamed.'''
+        self.selectAll()
+        cmd = mayaUsd.ufe.TRSBatchCommand.create(Operation.Translate)
+        cmd.set(1, 2, 3)
+
+        # Rename the first item.
+        sn = ufe.GlobalSelection.get()
+        sn.clear()
+        sn.append(ufe.Hierarchy.createItem(self.ufePath(self.usdPaths[0])))
+        cmds.rename('BatchA_Renamed')
+
+        renamedPaths = ['/Room_set/Props/BatchA_Renamed', self.usdPaths[1]]
+        self.assertFalse(self.stage.GetPrimAtPath(self.usdPaths[0]))
+        self.assertEqual(cmd.paths(),
+                         [str(self.ufePath(usdPath)) for usdPath in renamedPaths])
+
+        # Undo and redo apply to the renamed prim.
+        cmd.undo()
+        self.assertValues(renamedPaths, 'xformOp:translate', [0, 0, 0])
+
+        cmd.redo()
+        self.assertValues(renamedPaths, 'xformOp:translate', [1, 2, 3])
+
+        # Undo the rename, and the command follows the item back.
+        cmds.undo()
+        self.assertEqual(cmd.paths(),
+                         [str(self.ufePath(usdPath)) for usdPath in self.usdPaths])
+
+        cmd.undo()
+        self.assertValues(self.usdPaths, 'xformOp:translate', [0, 0, 0])
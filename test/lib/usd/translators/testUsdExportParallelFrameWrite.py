@@ -0,0 +1,93 @@
+#!/pxrpythonsubst
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import unittest
+
+from maya import cmds
+from maya import standalone
+
+from pxr import Sdf
+
+import fixturesUtils
+
+class testUsdExportParallelFrameWrite(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        cmds.file(new=True, force=True)
+
+        # A mix of animated transforms and animated meshes, with some held
+        # keys so that sparse authoring has samples to skip.
+        for i in range(20):
+            cube = cmds.polyCube(name='cube%d' % i)[0]
+            group = cmds.group(cube, name='group%d' % i)
+            cmds.setKeyframe(group, attribute='translateX', time=1, value=0)
+            cmds.setKeyframe(group, attribute='translateX', time=5, value=i)
+            cmds.setKeyframe(group, attribute='translateX', time=10, value=i)
+            cmds.setKeyframe(group, attribute='rotateY', time=1, value=0)
+            cmds.setKeyframe(group, attribute='rotateY', time=10, value=350)
+            cmds.setKeyframe(cube, attribute='scaleZ', time=3, value=1)
+            cmds.setKeyframe(cube, attribute='scaleZ', time=8, value=2)
+            cmds.setKeyframe('%s.vtx[0]' % cube, attribute='pntx',
+                             time=1, value=0)
+            cmds.setKeyframe('%s.vtx[0]' % cube, attribute='pntx',
+                             time=10, value=1)
+
+    def _export(self, usdFile, **kwargs):
+        cmds.usdExport(file=usdFile, shadingMode='none',
+                       frameRange=(1.0, 10.0), **kwargs)
+        return Sdf.Layer.FindOrOpen(usdFile).ExportToString()
+
+    def testMatchesSerialExport(self):
+        serial = self._export(
+            os.path.abspath('UsdExportParallelFrameWrite_serial.usda'))
+        pipelined = self._export(
+            os.path.abspath('UsdExportParallelFrameWrite_pipelined.usda'),
+            parallelFrameWrite=True)
+        self.assertEqual(serial, pipelined)
+
+    def testMatchesSerialExportWithEulerFilter(self):
+        serial = self._export(
+            os.path.abspath('UsdExportParallelFrameWrite_serialEuler.usda'),
+            eulerFilter=True)
+        pipelined = self._export(
+            os.path.abspath('UsdExportParallelFrameWrite_pipelinedEuler.usda'),
+            eulerFilter=True, parallelFrameWrite=True)
+        self.assertEqual(serial, pipelined)
+
+    def testMatchesSerialExportWithNormals(self):
+        # Polygonal meshes also pipeline their normals.
+        serial = self._export(
+            os.path.abspath('UsdExportParallelFrameWrite_serialNormals.usda'),
+            defaultMeshScheme='none')
+        pipelined = self._export(
+            os.path.abspath('UsdExportParallelFrameWrite_pipelinedNormals.usda'),
+            defaultMeshScheme='none', parallelFrameWrite=True)
+        self.assertEqual(serial, pipelined)
+        self.assertIn('normals.timeSamples', pipelined)
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,80 @@
+#!/pxrpythonsubst
+#
+# Copyright 2020 Autodesk
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from pxr import Usd
+from pxr import UsdGeom
+from pxr import UsdShade
+
+from maya import cmds
+from maya import standalone
+
+import os
+import unittest
+
+import fixturesUtils
+
+class testUsdImportPrefetch(unittest.TestCase):
+    """
+    Tests that the meshes whose data is prefetched ahead of the import walk
+    are only imported when the walk reaches them.
+    """
+
+    @classmethod
+    def setUpClass(cls):
+        fixturesUtils.setUpClass(__file__)
+
+    @classmethod
+    def tearDownClass(cls):
+        standalone.uninitialize()
+
+    def setUp(self):
+        cmds.file(new=True, force=True)
+
+    def _DefineQuad(self, stage, path):
+        mesh = UsdGeom.Mesh.Define(stage, path)
+        mesh.CreatePointsAttr([(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)])
+        mesh.CreateFaceVertexCountsAttr([4])
+        mesh.CreateFaceVertexIndicesAttr([0, 1, 2, 3])
+        return mesh
+
+    def testPrunedSubtree(self):
+        """
+        The children of a material are pruned by its reader, so the mesh
+        under it is prefetched by the look ahead from the first mesh, but
+        never imported. The mesh after the material still is.
+        """
+        usdFile = os.path.abspath('PrunedSubtree.usda')
+        stage = Usd.Stage.CreateNew(usdFile)
+        UsdGeom.Xform.Define(stage, '/Root')
+        self._DefineQuad(stage, '/Root/MeshA')
+        UsdGeom.Scope.Define(stage, '/Root/Looks')
+        UsdShade.Material.Define(stage, '/Root/Looks/Material')
+        self._DefineQuad(stage, '/Root/Looks/Material/PreviewMesh')
+        self._DefineQuad(stage, '/Root/MeshB')
+        stage.GetRootLayer().Save()
+
+        cmds.usdImport(file=usdFile, shadingMode='none')
+
+        self.assertTrue(cmds.objExists('|Root|MeshA'))
+        self.assertTrue(cmds.objExists('|Root|MeshB'))
+        self.assertEqual(cmds.nodeType('|Root|MeshB|MeshBShape'), 'mesh')
+        self.assertFalse(cmds.objExists('PreviewMesh'))
+        self.assertFalse(cmds.objExists('PreviewMeshShape'))
+
+
+if __name__ == '__main__':
+    unittest.main(verbosity=2)
@@ -0,0 +1,198 @@
+//
+// Copyright 2018 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <mayaUsdUtils/DiffCore.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Each benchmark takes two arguments: the number of elements, and the instruction set (see MayaUsdUtils::DiffCoreISA).
+// Instruction sets that are not supported by the CPU are skipped. The arrays always match, so every element is read.
+//----------------------------------------------------------------------------------------------------------------------
+static bool selectISA(benchmark::State& state)
+{
+  if(!MayaUsdUtils::setDiffCoreISA(MayaUsdUtils::DiffCoreISA(state.range(1))))
+  {
+    state.SkipWithError("instruction set not supported");
+    return false;
+  }
+  return true;
+}
+
+static void setProcessed(benchmark::State& state, const size_t bytesPerElement)
+{
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * bytesPerElement);
+}
+
+static void diffCoreArgs(benchmark::internal::Benchmark* b)
+{
+  // the large arrays are compared on several threads, so measure the wall clock time
+  b->UseRealTime();
+  for(int isa : { int(MayaUsdUtils::DiffCoreISA::kBaseline), int(MayaUsdUtils::DiffCoreISA::kAVX2) })
+  {
+    // the last two sizes are above the threshold at which the arrays are split across threads
+    for(int64_t count : { 1 << 6, 1 << 10, 1 << 14, 1 << 18, 1 << 22 })
+    {
+      b->Args({ count, isa });
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_vec3AreAllTheSame(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<float> a(state.range(0) * 3, 1.0f);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::vec3AreAllTheSame(a.data(), state.range(0)));
+  }
+  setProcessed(state, sizeof(float) * 3);
+}
+BENCHMARK(BM_vec3AreAllTheSame)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_vec4AreAllTheSameDouble(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<double> a(state.range(0) * 4, 1.0);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::vec4AreAllTheSame(a.data(), state.range(0)));
+  }
+  setProcessed(state, sizeof(double) * 4);
+}
+BENCHMARK(BM_vec4AreAllTheSameDouble)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareFloatArray(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<float> a(state.range(0), 1.0f), b(state.range(0), 1.0f);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareArray(a.data(), b.data(), a.size(), b.size(), 1e-5f));
+  }
+  setProcessed(state, sizeof(float) * 2);
+}
+BENCHMARK(BM_compareFloatArray)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareDoubleArray(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<double> a(state.range(0), 1.0), b(state.range(0), 1.0);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareArray(a.data(), b.data(), a.size(), b.size(), 1e-5));
+  }
+  setProcessed(state, sizeof(double) * 2);
+}
+BENCHMARK(BM_compareDoubleArray)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareHalfFloatArray(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<GfHalf> a(state.range(0), GfHalf(1.0f));
+  const std::vector<float> b(state.range(0), 1.0f);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareArray(a.data(), b.data(), a.size(), b.size(), 1e-3f));
+  }
+  setProcessed(state, sizeof(GfHalf) + sizeof(float));
+}
+BENCHMARK(BM_compareHalfFloatArray)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareHalfDoubleArray(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<GfHalf> a(state.range(0), GfHalf(1.0f));
+  const std::vector<double> b(state.range(0), 1.0);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareArray(a.data(), b.data(), a.size(), b.size(), 1e-3));
+  }
+  setProcessed(state, sizeof(GfHalf) + sizeof(double));
+}
+BENCHMARK(BM_compareHalfDoubleArray)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareInt32Array(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<int32_t> a(state.range(0), 1), b(state.range(0), 1);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareArray(a.data(), b.data(), a.size(), b.size()));
+  }
+  setProcessed(state, sizeof(int32_t) * 2);
+}
+BENCHMARK(BM_compareInt32Array)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareUvArray(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<float> u(state.range(0), 1.0f), v(state.range(0), 1.0f), uv(state.range(0) * 2, 1.0f);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareUvArray(u.data(), v.data(), uv.data(), u.size(), u.size(), 1e-5f));
+  }
+  setProcessed(state, sizeof(float) * 4);
+}
+BENCHMARK(BM_compareUvArray)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareArray3Dto4D(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<float> a(state.range(0) * 3, 1.0f), b(state.range(0) * 4, 1.0f);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareArray3Dto4D(a.data(), b.data(), state.range(0), state.range(0)));
+  }
+  setProcessed(state, sizeof(float) * 7);
+}
+BENCHMARK(BM_compareArray3Dto4D)->Apply(diffCoreArgs);
+
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_compareRGBAArray(benchmark::State& state)
+{
+  if(!selectISA(state))
+    return;
+  const std::vector<float> rgba(state.range(0) * 4, 1.0f);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::compareRGBAArray(1.0f, 1.0f, 1.0f, 1.0f, rgba.data(), state.range(0)));
+  }
+  setProcessed(state, sizeof(float) * 4);
+}
+BENCHMARK(BM_compareRGBAArray)->Apply(diffCoreArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,58 @@
+//
+// Copyright 2020 Autodesk
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <mayaUsdUtils/MergeValues.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// Face-varying UVs of a dense mesh: one value per face-vertex, a quarter of them distinct. The only argument is the
+// number of face-vertices.
+//----------------------------------------------------------------------------------------------------------------------
+static void BM_mergeEquivalentIndexedValues(benchmark::State& state)
+{
+  const size_t count = size_t(state.range(0));
+  const uint32_t dimension = 2;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<size_t> pickDistinct(0, count / 4);
+  std::uniform_int_distribution<int32_t> pickValue(0, int32_t(count - 1));
+
+  std::vector<float> values(count * dimension);
+  for(size_t i = 0; i < count; ++i)
+  {
+    const size_t d = pickDistinct(rng);
+    values[i * dimension] = float(d) * 0.25f;
+    values[i * dimension + 1] = float(d) * 0.25f + 1.0f;
+  }
+  std::vector<int32_t> indices(count);
+  for(auto& index : indices)
+  {
+    index = pickValue(rng);
+  }
+
+  std::vector<float> uniqueValues(count * dimension);
+  std::vector<int32_t> uniqueIndices(count);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(MayaUsdUtils::mergeEquivalentIndexedValues(
+        values.data(), count, dimension, indices.data(), count, uniqueValues.data(), uniqueIndices.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_mergeEquivalentIndexedValues)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 static inline float randFloat()
 {
   return float(rand()) / RAND_MAX;
@@ -513,3 +515,146 @@ TEST(DiffCore, compareUvArray)
   u[22] -= 1.0f;
 }
 
+
+//----------------------------------------------------------------------------------------------------------------------
+// runs the test once for each instruction set the CPU supports, and then restores the default
+template<typename Test>
+static void forEachISA(const Test& test)
+{
+  const MayaUsdUtils::DiffCoreISA original = MayaUsdUtils::diffCoreISA();
+  for(auto isa : { MayaUsdUtils::DiffCoreISA::kBaseline, MayaUsdUtils::DiffCoreISA::kAVX2 })
+  {
+    if(MayaUsdUtils::setDiffCoreISA(isa))
+    {
+      SCOPED_TRACE(int(isa));
+      EXPECT_EQ(isa, MayaUsdUtils::diffCoreISA());
+      test();
+    }
+  }
+  MayaUsdUtils::setDiffCoreISA(original);
+}
+
+// large enough to be split across threads, and not a multiple of any SIMD width or chunk size
+static const size_t largeCount = (1 << 20) + 3;
+
+// indices that land at the start & end of the array, and either side of a chunk boundary
+static const size_t largeIndices[] = { 0, (1 << 15) - 1, 1 << 15, largeCount / 2, largeCount - 1 };
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, selectISA)
+{
+  // the baseline kernels are always available
+  const MayaUsdUtils::DiffCoreISA original = MayaUsdUtils::diffCoreISA();
+  EXPECT_TRUE(MayaUsdUtils::setDiffCoreISA(MayaUsdUtils::DiffCoreISA::kBaseline));
+  EXPECT_EQ(MayaUsdUtils::DiffCoreISA::kBaseline, MayaUsdUtils::diffCoreISA());
+  EXPECT_TRUE(MayaUsdUtils::setDiffCoreISA(original));
+  EXPECT_EQ(original, MayaUsdUtils::diffCoreISA());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, compareSameBuffer)
+{
+  // a buffer always matches itself
+  std::vector<float> a(37, 1.0f);
+  std::vector<int32_t> b(37, 1);
+  EXPECT_TRUE(MayaUsdUtils::compareArray(a.data(), a.data(), 37, 37, 1e-5f));
+  EXPECT_TRUE(MayaUsdUtils::compareArray(b.data(), b.data(), 37, 37));
+  EXPECT_FALSE(MayaUsdUtils::compareArray(a.data(), a.data(), 36, 37, 1e-5f));
+  EXPECT_FALSE(MayaUsdUtils::compareArray(b.data(), b.data(), 37, 36));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, vecAreAllTheSameLarge)
+{
+  forEachISA([]()
+  {
+    std::vector<float> u(largeCount, 2.0f), v(largeCount, 3.0f);
+    std::vector<float> a3(largeCount * 3, 2.0f);
+    std::vector<double> d4(largeCount * 4, 2.0);
+    EXPECT_TRUE(MayaUsdUtils::vec2AreAllTheSame(u.data(), v.data(), largeCount));
+    EXPECT_TRUE(MayaUsdUtils::vec3AreAllTheSame(a3.data(), largeCount));
+    EXPECT_TRUE(MayaUsdUtils::vec4AreAllTheSame(d4.data(), largeCount));
+
+    for(size_t i : largeIndices)
+    {
+      v[i] = 4.0f;
+      a3[i * 3 + 1] = 4.0f;
+      d4[i * 4 + 3] = 4.0;
+      EXPECT_FALSE(MayaUsdUtils::vec2AreAllTheSame(u.data(), v.data(), largeCount));
+      EXPECT_FALSE(MayaUsdUtils::vec3AreAllTheSame(a3.data(), largeCount));
+      EXPECT_FALSE(MayaUsdUtils::vec4AreAllTheSame(d4.data(), largeCount));
+      v[i] = 3.0f;
+      a3[i * 3 + 1] = 2.0f;
+      d4[i * 4 + 3] = 2.0;
+    }
+
+    // every chunk is uniform on its own, but the chunks differ from each other
+    std::fill(a3.begin() + (1 << 15) * 3, a3.end(), 5.0f);
+    EXPECT_FALSE(MayaUsdUtils::vec3AreAllTheSame(a3.data(), largeCount));
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, compareArrayLarge)
+{
+  forEachISA([]()
+  {
+    std::vector<float> a(largeCount), b(largeCount);
+    std::vector<double> d(largeCount);
+    std::vector<GfHalf> h(largeCount);
+    std::vector<int32_t> ia(largeCount), ib(largeCount);
+    for(size_t i = 0; i < largeCount; ++i)
+    {
+      a[i] = b[i] = randFloat();
+      d[i] = a[i];
+      h[i] = GfHalf(a[i]);
+      ia[i] = ib[i] = rand();
+    }
+    EXPECT_TRUE(MayaUsdUtils::compareArray(a.data(), b.data(), largeCount, largeCount, 1e-5f));
+    EXPECT_TRUE(MayaUsdUtils::compareArray(d.data(), a.data(), largeCount, largeCount, 1e-5f));
+    EXPECT_TRUE(MayaUsdUtils::compareArray(h.data(), a.data(), largeCount, largeCount, 1e-3f));
+    EXPECT_TRUE(MayaUsdUtils::compareArray(ia.data(), ib.data(), largeCount, largeCount));
+
+    for(size_t i : largeIndices)
+    {
+      b[i] += 1.0f;
+      d[i] += 1.0;
+      ib[i] += 1;
+      EXPECT_FALSE(MayaUsdUtils::compareArray(a.data(), b.data(), largeCount, largeCount, 1e-5f));
+      EXPECT_FALSE(MayaUsdUtils::compareArray(d.data(), a.data(), largeCount, largeCount, 1e-5f));
+      EXPECT_FALSE(MayaUsdUtils::compareArray(h.data(), d.data(), largeCount, largeCount, 1e-3));
+      EXPECT_FALSE(MayaUsdUtils::compareArray(ia.data(), ib.data(), largeCount, largeCount));
+      b[i] -= 1.0f;
+      d[i] = a[i];
+      ib[i] -= 1;
+    }
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DiffCore, compare3Dto4DLarge)
+{
+  forEachISA([]()
+  {
+    std::vector<float> a3(largeCount * 3), a4(largeCount * 4, 0.0f);
+    std::vector<double> d4(largeCount * 4, 0.0);
+    for(size_t i = 0; i < largeCount; ++i)
+    {
+      for(size_t j = 0; j < 3; ++j)
+      {
+        a3[i * 3 + j] = a4[i * 4 + j] = randFloat();
+        d4[i * 4 + j] = a3[i * 3 + j];
+      }
+    }
+    EXPECT_TRUE(MayaUsdUtils::compareArray3Dto4D(a3.data(), a4.data(), largeCount, largeCount));
+    EXPECT_TRUE(MayaUsdUtils::compareArrayFloat3DtoDouble4D(a3.data(), d4.data(), largeCount, largeCount));
+
+    for(size_t i : largeIndices)
+    {
+      a3[i * 3 + 2] += 1.0f;
+      EXPECT_FALSE(MayaUsdUtils::compareArray3Dto4D(a3.data(), a4.data(), largeCount, largeCount));
+      EXPECT_FALSE(MayaUsdUtils::compareArrayFloat3DtoDouble4D(a3.data(), d4.data(), largeCount, largeCount));
+      a3[i * 3 + 2] -= 1.0f;
+    }
+  });
+}
@@ -0,0 +1,286 @@
+#include <mayaUsdUtils/MergeValues.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+// Reference implementation, a copy of the std::unordered_map based merge UsdMayaUtil used before the kernel. Values are
+// compared with GfIsClose(a, b, 1e-9), and zeros are hashed alike, as boost::hash_value does for floats.
+constexpr double referenceTolerance = 1e-9;
+
+struct Tuple
+{
+  float v[4];
+  uint32_t dimension;
+};
+
+struct TupleEqual
+{
+  bool operator () (const Tuple& a, const Tuple& b) const
+  {
+    // GfIsClose compares a float by its absolute difference, and a vector by the length of its difference.
+    double lengthSq = 0.0;
+    for(uint32_t i = 0; i < a.dimension; ++i)
+    {
+      const double d = double(a.v[i]) - double(b.v[i]);
+      lengthSq += d * d;
+    }
+    return lengthSq <= referenceTolerance * referenceTolerance;
+  }
+};
+
+struct TupleHash
+{
+  size_t operator () (const Tuple& t) const
+  {
+    size_t hash = 0;
+    for(uint32_t i = 0; i < t.dimension; ++i)
+    {
+      hash = hash * 31 + std::hash<float>()(t.v[i] == 0.0f ? 0.0f : t.v[i]);
+    }
+    return hash;
+  }
+};
+
+size_t referenceMerge(
+    const std::vector<float>& values,
+    uint32_t dimension,
+    const std::vector<int32_t>& indices,
+    std::vector<float>& uniqueValues,
+    std::vector<int32_t>& uniqueIndices)
+{
+  const size_t valueCount = values.size() / dimension;
+  std::unordered_map<Tuple, int32_t, TupleHash, TupleEqual> valuesMap;
+  uniqueValues.clear();
+  uniqueIndices.clear();
+  for(int32_t index : indices)
+  {
+    if(index < 0 || static_cast<size_t>(index) >= valueCount)
+    {
+      uniqueIndices.push_back(index);
+      continue;
+    }
+    Tuple t = {};
+    t.dimension = dimension;
+    std::memcpy(t.v, values.data() + index * dimension, dimension * sizeof(float));
+    auto inserted = valuesMap.insert(std::make_pair(t, int32_t(uniqueValues.size() / dimension)));
+    if(inserted.second)
+    {
+      uniqueValues.insert(uniqueValues.end(), t.v, t.v + dimension);
+    }
+    uniqueIndices.push_back(inserted.first->second);
+  }
+  return uniqueValues.size() / dimension;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t kernelMerge(
+    const std::vector<float>& values,
+    uint32_t dimension,
+    const std::vector<int32_t>& indices,
+    std::vector<float>& uniqueValues,
+    std::vector<int32_t>& uniqueIndices)
+{
+  // sized as UsdMayaUtil sizes them
+  const size_t valueCount = values.size() / dimension;
+  uniqueValues.assign(std::min(valueCount, indices.size()) * dimension, 0.0f);
+  uniqueIndices.assign(indices.size(), 0);
+  const size_t count = MayaUsdUtils::mergeEquivalentIndexedValues(
+      values.data(), valueCount, dimension, indices.data(), indices.size(), uniqueValues.data(), uniqueIndices.data());
+  uniqueValues.resize(count * dimension);
+  return count;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Synthetic face-varying data: valueCount values drawn from distinctCount distinct tuples, and indexCount indices
+// referring to them, like the UVs of a dense mesh that were not shared in Maya. A few indices are unassigned or out
+// of range. The components are random, but either zero (of both signs) or at least 1/64 in magnitude: two distinct
+// floats that large are always further apart than the 1e-9 tolerance of the reference.
+void makeData(
+    uint32_t seed,
+    uint32_t dimension,
+    size_t valueCount,
+    size_t distinctCount,
+    size_t indexCount,
+    std::vector<float>& values,
+    std::vector<int32_t>& indices)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> pickMagnitude(1.0f / 64.0f, 1000.0f);
+  std::uniform_int_distribution<int> pickKind(0, 15);
+  std::uniform_int_distribution<size_t> pickDistinct(0, distinctCount - 1);
+  std::uniform_int_distribution<int32_t> pickIndex(-2, int32_t(valueCount + 1));
+
+  std::vector<float> distinct(distinctCount * dimension);
+  for(float& component : distinct)
+  {
+    switch(pickKind(rng))
+    {
+    case 0: component = 0.0f; break;
+    case 1: component = -0.0f; break;
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+    case 6: component = -pickMagnitude(rng); break;
+    default: component = pickMagnitude(rng); break;
+    }
+  }
+
+  values.resize(valueCount * dimension);
+  for(size_t i = 0; i < valueCount; ++i)
+  {
+    const size_t d = pickDistinct(rng);
+    std::copy(distinct.data() + d * dimension, distinct.data() + (d + 1) * dimension, values.data() + i * dimension);
+  }
+
+  indices.resize(indexCount);
+  for(size_t i = 0; i < indexCount; ++i)
+  {
+    indices[i] = pickIndex(rng);
+  }
+}
+
+void checkSameAsReference(
+    const std::vector<float>& values,
+    uint32_t dimension,
+    const std::vector<int32_t>& indices)
+{
+  std::vector<float> expectedValues;
+  std::vector<int32_t> expectedIndices;
+  const size_t expectedCount = referenceMerge(values, dimension, indices, expectedValues, expectedIndices);
+
+  std::vector<float> uniqueValues;
+  std::vector<int32_t> uniqueIndices;
+  const size_t count = kernelMerge(values, dimension, indices, uniqueValues, uniqueIndices);
+
+  ASSERT_EQ(expectedCount, count);
+  EXPECT_EQ(expectedIndices, uniqueIndices);
+  EXPECT_EQ(0, std::memcmp(expectedValues.data(), uniqueValues.data(), count * dimension * sizeof(float)));
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+// Outside of the cases covered by the differences below, the kernel gives exactly the output of the reference.
+TEST(MergeValues, sameAsReference)
+{
+  for(uint32_t seed = 0; seed < 20; ++seed)
+  {
+    for(uint32_t dimension = 1; dimension <= 4; ++dimension)
+    {
+      std::vector<float> values;
+      std::vector<int32_t> indices;
+      makeData(seed, dimension, 5000, 50 + seed * 100, 20000, values, indices);
+      checkSameAsReference(values, dimension, indices);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Accepted difference: distinct values closer than the 1e-9 tolerance. The reference only merged them when their
+// hashes, computed from the exact bits, happened to land in the same bucket, so its output depended on the bucket
+// count. The kernel compares exactly and never merges them.
+TEST(MergeValues, differenceCloseValues)
+{
+  const std::vector<float> values = { 1e-10f, 2e-10f, 1.0f, 1e-10f };
+  const std::vector<int32_t> indices = { 0, 1, 2, 3 };
+
+  std::vector<float> uniqueValues;
+  std::vector<int32_t> uniqueIndices;
+  EXPECT_EQ(3u, kernelMerge(values, 1, indices, uniqueValues, uniqueIndices));
+  EXPECT_EQ(std::vector<int32_t>({ 0, 1, 2, 0 }), uniqueIndices);
+
+  // the reference considers them equal, whether or not it finds them in the same bucket
+  Tuple a = { { 1e-10f }, 1 };
+  Tuple b = { { 2e-10f }, 1 };
+  EXPECT_TRUE(TupleEqual()(a, b));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Accepted difference: NaN values. A NaN never compared equal in the reference, so every use of it added a new copy,
+// and the output could outgrow min(valueCount, indexCount). The kernel shares a single copy between the uses of a
+// given source value, and still never merges two source values containing NaNs.
+TEST(MergeValues, differenceNan)
+{
+  const float nan = std::nanf("");
+  const std::vector<float> values = { nan, 1.0f, nan };
+  const std::vector<int32_t> indices = { 0, 1, 2, 0, 1, 2, 0 };
+
+  std::vector<float> expectedValues;
+  std::vector<int32_t> expectedIndices;
+  EXPECT_EQ(6u, referenceMerge(values, 1, indices, expectedValues, expectedIndices));
+  EXPECT_EQ(std::vector<int32_t>({ 0, 1, 2, 3, 1, 4, 5 }), expectedIndices);
+
+  std::vector<float> uniqueValues;
+  std::vector<int32_t> uniqueIndices;
+  EXPECT_EQ(3u, kernelMerge(values, 1, indices, uniqueValues, uniqueIndices));
+  EXPECT_EQ(std::vector<int32_t>({ 0, 1, 2, 0, 1, 2, 0 }), uniqueIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MergeValues, unassignedIndices)
+{
+  const std::vector<float> values = { 0.0f, 1.0f, 0.0f, 1.0f, 2.0f, -0.0f };
+  const std::vector<int32_t> indices = { -1, 0, 1, 2, 3, 6, 2, 4, 5 };
+
+  std::vector<float> uniqueValues(values.size());
+  std::vector<int32_t> uniqueIndices(indices.size());
+  const size_t count = MayaUsdUtils::mergeEquivalentIndexedValues(
+      values.data(), values.size(), 1, indices.data(), indices.size(), uniqueValues.data(), uniqueIndices.data());
+
+  EXPECT_EQ(3u, count);
+  EXPECT_EQ(0.0f, uniqueValues[0]);
+  EXPECT_EQ(1.0f, uniqueValues[1]);
+  EXPECT_EQ(2.0f, uniqueValues[2]);
+  EXPECT_EQ(std::vector<int32_t>({ -1, 0, 1, 0, 1, 6, 0, 2, 0 }), uniqueIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MergeValues, nanAreNotMerged)
+{
+  const float nan = std::nanf("");
+  const std::vector<float> values = { nan, 1.0f, nan };
+  const std::vector<int32_t> indices = { 0, 1, 2, 0, 1, 2, 0 };
+
+  std::vector<float> uniqueValues(std::min(values.size(), indices.size()));
+  std::vector<int32_t> uniqueIndices(indices.size());
+  const size_t count = MayaUsdUtils::mergeEquivalentIndexedValues(
+      values.data(), values.size(), 1, indices.data(), indices.size(), uniqueValues.data(), uniqueIndices.data());
+
+  // the two NaNs stay distinct, but all the uses of each one share a single copy
+  EXPECT_EQ(3u, count);
+  EXPECT_TRUE(std::isnan(uniqueValues[0]));
+  EXPECT_EQ(1.0f, uniqueValues[1]);
+  EXPECT_TRUE(std::isnan(uniqueValues[2]));
+  EXPECT_EQ(std::vector<int32_t>({ 0, 1, 2, 0, 1, 2, 0 }), uniqueIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(MergeValues, manyNanUses)
+{
+  // more uses of NaN values than there are values, and than the initial size of the table
+  const float nan = std::nanf("");
+  const std::vector<float> values = { nan, nan, nan, nan, 1.0f, -1.0f };
+  std::vector<int32_t> indices(100);
+  for(size_t i = 0; i < indices.size(); ++i)
+  {
+    indices[i] = int32_t(i % values.size());
+  }
+
+  std::vector<float> uniqueValues(std::min(values.size(), indices.size()));
+  std::vector<int32_t> uniqueIndices(indices.size());
+  const size_t count = MayaUsdUtils::mergeEquivalentIndexedValues(
+      values.data(), values.size(), 1, indices.data(), indices.size(), uniqueValues.data(), uniqueIndices.data());
+
+  EXPECT_EQ(values.size(), count);
+  EXPECT_EQ(indices, uniqueIndices);
+}